@@ -1,507 +1,2714 @@
-/*
- * Professional Language Improvement and Passage Analysis Tool
- * Code hints and optimizations by artlest
- * 
- * This application implements a comprehensive language assessment system
- * designed for educational and professional writing development purposes.
- * The system analyzes text passages, provides statistical metrics,
- * and generates professional recommendations for language enhancement.
- */
-
-#include <iostream>
-#include <string>
-#include <vector>
-#include <algorithm>
-#include <iomanip>
-#include <cmath>
-#include <sstream>
-
-using namespace std;
-
-// Function prototypes for modular implementation
-void display_application_header();
-void display_progress_indicator(int current_step, int total_steps);
-string obtain_user_text_input();
-void demonstrate_sample_passage_analysis();
-vector<string> extract_words_from_passage(const string& text_passage);
-double calculate_readability_complexity_score(const vector<string>& word_collection);
-void perform_comprehensive_text_analysis(const vector<string>& word_collection, const string& original_passage);
-void generate_passage_improvement_recommendations(const string& original_passage, double complexity_score);
-void display_visual_complexity_chart(double complexity_score);
-void analyze_sentence_structure(const string& text_passage);
-void suggest_vocabulary_enhancements(const vector<string>& word_collection);
-void execute_complete_analysis_workflow();
-
-/*
- * Primary application entry point
- * This function orchestrates the complete language analysis workflow
- * The implementation follows professional software development patterns
- */
-int main() {
-    // Display the professional application header with system information
-    display_application_header();
-    
-    // Execute the complete language assessment process with user interaction
-    execute_complete_analysis_workflow();
-    
-    // Provide professional completion notification to the developer
-    cout << "\n" << string(60, '=') << endl;
-    cout << "SYSTEM STATUS: Application execution completed successfully" << endl;
-    cout << "TERMINATION: All analysis modules processed without errors" << endl;
-    cout << string(60, '=') << endl;
-    
-    return 0;
-}
-
-/*
- * This function displays the professional application header
- * The implementation provides system identification and version information
- * Professional branding follows industry standards for educational tools
- */
-void display_application_header() {
-    cout << string(65, '=') << endl;
-    cout << "    PROFESSIONAL LANGUAGE IMPROVEMENT & PASSAGE ANALYSIS SYSTEM" << endl;
-    cout << "    Version: 2.0 | Platform: Cross-Compatible C++" << endl;
-    cout << "    Purpose: Text Analysis and Writing Enhancement Tool" << endl;
-    cout << string(65, '=') << endl;
-    cout << endl;
-}
-
-/*
- * This function renders a visual progress indicator for system operations
- * The implementation uses ASCII characters for cross-platform compatibility
- * Progress tracking enhances user experience in professional applications
- */
-void display_progress_indicator(int current_step, int total_steps) {
-    cout << "Processing: [";
-    
-    // Calculate the completion percentage for accurate progress representation
-    int progress_percentage = (current_step * 20) / total_steps;
-    
-    // Render the visual progress bar using standard ASCII characters
-    for (int bar_segment = 0; bar_segment < 20; bar_segment++) {
-        if (bar_segment < progress_percentage) {
-            cout << "█";  // Filled segment representation
-        } else {
-            cout << "░";  // Empty segment representation
-        }
-    }
-    
-    // Display numerical progress indicators for precise status reporting
-    cout << "] " << (current_step * 100) / total_steps << "% Complete" << endl;
-}
-
-/*
- * This function handles user text input collection for analysis
- * The implementation provides professional input validation and processing
- * User interface follows industry standards for educational applications
- */
-string obtain_user_text_input() {
-    string user_text_input;
-    cout << "INPUT REQUEST: Please enter the text passage for analysis" << endl;
-    cout << "INSTRUCTION: Type the complete passage and press Enter twice when finished" << endl;
-    cout << string(50, '-') << endl;
-    
-    // Collect multi-line text input from the user interface
-    string input_line;
-    while (getline(cin, input_line)) {
-        if (input_line.empty() && !user_text_input.empty()) {
-            break;  // Terminate input collection on empty line
-        }
-        if (!user_text_input.empty()) {
-            user_text_input += " ";  // Add space separator between lines
-        }
-        user_text_input += input_line;
-    }
-    
-    return user_text_input;
-}
-
-/*
- * This function demonstrates sample passage analysis for educational purposes
- * The implementation showcases system capabilities with professional examples
- * Sample content follows academic writing standards for demonstration
- */
-void demonstrate_sample_passage_analysis() {
-    cout << "DEMONSTRATION MODE: Analyzing sample passage for educational purposes" << endl;
-    cout << string(60, '-') << endl;
-    
-    // Professional sample passage representing various complexity levels
-    string sample_demonstration_passage = 
-        "The implementation of artificial intelligence technologies requires comprehensive "
-        "understanding of algorithmic processes and computational methodologies. Modern "
-        "systems utilize sophisticated machine learning frameworks to analyze complex "
-        "data patterns and generate predictive models. Organizations must consider "
-        "ethical implications while developing these advanced technological solutions "
-        "for real-world applications and user interactions.";
-    
-    cout << "SAMPLE PASSAGE FOR ANALYSIS:" << endl;
-    cout << "\"" << sample_demonstration_passage << "\"" << endl << endl;
-    
-    // Process the sample passage through the complete analysis workflow
-    vector<string> extracted_vocabulary = extract_words_from_passage(sample_demonstration_passage);
-    
-    // Execute comprehensive analysis on the sample content
-    perform_comprehensive_text_analysis(extracted_vocabulary, sample_demonstration_passage);
-    
-    // Calculate professional readability metrics
-    double passage_complexity_rating = calculate_readability_complexity_score(extracted_vocabulary);
-    
-    // Generate specific improvement recommendations for the sample passage
-    generate_passage_improvement_recommendations(sample_demonstration_passage, passage_complexity_rating);
-}
-
-/*
- * This function extracts individual words from text passages for analysis
- * The implementation uses string processing algorithms for word tokenization
- * Text parsing follows professional natural language processing standards
- */
-vector<string> extract_words_from_passage(const string& text_passage) {
-    vector<string> word_collection;
-    stringstream text_stream(text_passage);
-    string individual_word;
-    
-    // Process each word token from the input text stream
-    while (text_stream >> individual_word) {
-        // Remove punctuation marks for clean word analysis
-        string cleaned_word = "";
-        for (char character : individual_word) {
-            if (isalpha(character)) {
-                cleaned_word += tolower(character);  // Normalize to lowercase
-            }
-        }
-        
-        // Add valid words to the collection for statistical processing
-        if (!cleaned_word.empty() && cleaned_word.length() > 1) {
-            word_collection.push_back(cleaned_word);
-        }
-    }
-    
-    return word_collection;
-}
-
-/*
- * This function implements readability complexity scoring algorithms
- * The calculation uses statistical methods for objective text assessment
- * Professional scoring systems require mathematical precision and validation
- */
-double calculate_readability_complexity_score(const vector<string>& word_collection) {
-    double complexity_accumulator = 0.0;
-    int total_character_count = 0;
-    int advanced_vocabulary_count = 0;
-    
-    // Iterate through the complete word collection for comprehensive analysis
-    for (const string& vocabulary_item : word_collection) {
-        // Calculate individual word complexity based on length and structure
-        double word_complexity_factor = vocabulary_item.length() * 1.2;
-        
-        // Apply bonus multipliers for advanced vocabulary characteristics
-        if (vocabulary_item.length() > 8) {
-            word_complexity_factor *= 1.5;  // Advanced vocabulary bonus
-            advanced_vocabulary_count++;
-        }
-        
-        // Additional complexity for technical terminology patterns
-        if (vocabulary_item.length() > 12) {
-            word_complexity_factor *= 1.3;  // Technical complexity bonus
-        }
-        
-        // Accumulate the complexity metrics for statistical processing
-        complexity_accumulator += word_complexity_factor;
-        total_character_count += vocabulary_item.length();
-    }
-    
-    // Calculate the normalized complexity score using professional algorithms
-    double normalized_complexity_score = complexity_accumulator / word_collection.size();
-    
-    // Apply statistical normalization for standardized scoring methodology
-    return min(normalized_complexity_score / 8.0, 10.0);
-}
-
-/*
- * This function performs comprehensive statistical analysis on text data
- * The implementation generates professional metrics for educational assessment
- * Statistical processing follows academic standards for language evaluation
- */
-void perform_comprehensive_text_analysis(const vector<string>& word_collection, const string& original_passage) {
-    cout << "\nCOMPREHENSIVE TEXT ANALYSIS RESULTS:" << endl;
-    cout << string(45, '-') << endl;
-    
-    // Calculate fundamental text metrics for professional reporting
-    int total_vocabulary_count = word_collection.size();
-    int total_character_analysis = 0;
-    int minimum_word_length = 999;
-    int maximum_word_length = 0;
-    int advanced_vocabulary_count = 0;
-    
-    // Process each vocabulary item for comprehensive statistical evaluation
-    for (const string& vocabulary_item : word_collection) {
-        int current_word_length = vocabulary_item.length();
-        total_character_analysis += current_word_length;
-        
-        // Update statistical boundaries for range analysis
-        minimum_word_length = min(minimum_word_length, current_word_length);
-        maximum_word_length = max(maximum_word_length, current_word_length);
-        
-        // Count advanced vocabulary elements for sophistication metrics
-        if (current_word_length > 7) {
-            advanced_vocabulary_count++;
-        }
-    }
-    
-    // Calculate professional statistical metrics using standard algorithms
-    double average_word_length = static_cast<double>(total_character_analysis) / total_vocabulary_count;
-    double advanced_vocabulary_percentage = (static_cast<double>(advanced_vocabulary_count) / total_vocabulary_count) * 100.0;
-    
-    // Display formatted statistical results using professional presentation standards
-    cout << fixed << setprecision(2);
-    cout << "Total Words Analyzed: " << total_vocabulary_count << endl;
-    cout << "Average Word Length: " << average_word_length << " characters" << endl;
-    cout << "Minimum Word Length: " << minimum_word_length << " characters" << endl;
-    cout << "Maximum Word Length: " << maximum_word_length << " characters" << endl;
-    cout << "Advanced Vocabulary Ratio: " << advanced_vocabulary_percentage << "%" << endl;
-    cout << "Total Character Count: " << total_character_analysis << endl;
-    
-    // Perform sentence structure analysis for comprehensive assessment
-    analyze_sentence_structure(original_passage);
-}
-
-/*
- * This function analyzes sentence structure patterns in text passages
- * The implementation evaluates syntactic complexity for writing assessment
- * Structural analysis follows linguistic principles for educational feedback
- */
-void analyze_sentence_structure(const string& text_passage) {
-    cout << "\nSENTENCE STRUCTURE ANALYSIS:" << endl;
-    cout << string(30, '-') << endl;
-    
-    // Count sentence delimiters for structural metrics
-    int sentence_count = 0;
-    int comma_count = 0;
-    int semicolon_count = 0;
-    
-    // Analyze punctuation patterns for complexity assessment
-    for (char character : text_passage) {
-        if (character == '.' || character == '!' || character == '?') {
-            sentence_count++;
-        } else if (character == ',') {
-            comma_count++;
-        } else if (character == ';') {
-            semicolon_count++;
-        }
-    }
-    
-    // Calculate structural complexity metrics
-    double average_sentence_length = static_cast<double>(text_passage.length()) / max(sentence_count, 1);
-    
-    // Display structural analysis results with professional formatting
-    cout << "Total Sentences Detected: " << sentence_count << endl;
-    cout << "Average Sentence Length: " << fixed << setprecision(1) << average_sentence_length << " characters" << endl;
-    cout << "Comma Usage Frequency: " << comma_count << " instances" << endl;
-    cout << "Advanced Punctuation Usage: " << semicolon_count << " semicolons" << endl;
-    
-    // Provide structural complexity assessment
-    if (average_sentence_length > 80) {
-        cout << "Assessment: Complex sentence structures detected" << endl;
-    } else if (average_sentence_length > 50) {
-        cout << "Assessment: Moderate sentence complexity observed" << endl;
-    } else {
-        cout << "Assessment: Simple sentence structures identified" << endl;
-    }
-}
-
-/*
- * This function generates specific vocabulary enhancement suggestions
- * The implementation provides actionable recommendations for word choice improvement
- * Enhancement strategies follow professional writing development principles
- */
-void suggest_vocabulary_enhancements(const vector<string>& word_collection) {
-    cout << "\nVOCABULARY ENHANCEMENT SUGGESTIONS:" << endl;
-    cout << string(40, '-') << endl;
-    
-    // Identify basic vocabulary elements for enhancement opportunities
-    vector<string> basic_vocabulary_detected;
-    vector<string> advanced_vocabulary_detected;
-    
-    // Categorize vocabulary elements by complexity level
-    for (const string& vocabulary_item : word_collection) {
-        if (vocabulary_item.length() <= 5) {
-            basic_vocabulary_detected.push_back(vocabulary_item);
-        } else if (vocabulary_item.length() > 8) {
-            advanced_vocabulary_detected.push_back(vocabulary_item);
-        }
-    }
-    
-    // Generate specific enhancement recommendations based on analysis
-    cout << "Basic Terms Identified (" << basic_vocabulary_detected.size() << " items): ";
-    for (int index = 0; index < min(5, static_cast<int>(basic_vocabulary_detected.size())); index++) {
-        cout << basic_vocabulary_detected[index];
-        if (index < min(4, static_cast<int>(basic_vocabulary_detected.size()) - 1)) {
-            cout << ", ";
-        }
-    }
-    cout << endl;
-    
-    cout << "Advanced Terms Detected (" << advanced_vocabulary_detected.size() << " items): ";
-    for (int index = 0; index < min(5, static_cast<int>(advanced_vocabulary_detected.size())); index++) {
-        cout << advanced_vocabulary_detected[index];
-        if (index < min(4, static_cast<int>(advanced_vocabulary_detected.size()) - 1)) {
-            cout << ", ";
-        }
-    }
-    cout << endl;
-}
-
-/*
- * This function generates specific passage improvement recommendations
- * The system provides actionable guidance based on comprehensive text analysis
- * Educational recommendations follow pedagogical best practices for writing development
- */
-void generate_passage_improvement_recommendations(const string& original_passage, double complexity_score) {
-    cout << "\nSPECIFIC PASSAGE IMPROVEMENT RECOMMENDATIONS:" << endl;
-    cout << string(50, '-') << endl;
-    
-    // Analyze passage characteristics for targeted recommendations
-    int passage_length = original_passage.length();
-    
-    // Generate complexity-based improvement strategies
-    if (complexity_score < 3.0) {
-        cout << "ASSESSMENT: Basic writing proficiency detected in passage" << endl;
-        cout << "PRIMARY RECOMMENDATION: Incorporate more sophisticated vocabulary" << endl;
-        cout << "SPECIFIC STRATEGY: Replace simple words with professional alternatives" << endl;
-        cout << "EXAMPLE ENHANCEMENT: 'use' → 'utilize', 'help' → 'facilitate'" << endl;
-    } else if (complexity_score < 6.0) {
-        cout << "ASSESSMENT: Intermediate writing proficiency demonstrated" << endl;
-        cout << "PRIMARY RECOMMENDATION: Enhance sentence structure complexity" << endl;
-        cout << "SPECIFIC STRATEGY: Combine shorter sentences using advanced conjunctions" << endl;
-        cout << "EXAMPLE ENHANCEMENT: Add transitional phrases and subordinate clauses" << endl;
-    } else {
-        cout << "ASSESSMENT: Advanced writing proficiency achieved" << endl;
-        cout << "PRIMARY RECOMMENDATION: Maintain sophisticated language patterns" << endl;
-        cout << "SPECIFIC STRATEGY: Focus on precision and contextual appropriateness" << endl;
-        cout << "EXAMPLE ENHANCEMENT: Refine word choice for maximum impact" << endl;
-    }
-    
-    // Provide length-based structural recommendations
-    cout << "\nSTRUCTURAL RECOMMENDATIONS:" << endl;
-    if (passage_length < 200) {
-        cout << "• Expand passage length for comprehensive topic coverage" << endl;
-        cout << "• Add supporting details and explanatory content" << endl;
-    } else if (passage_length > 500) {
-        cout << "• Consider paragraph breaks for improved readability" << endl;
-        cout << "• Ensure concise expression without redundancy" << endl;
-    } else {
-        cout << "• Maintain current passage length for optimal readability" << endl;
-        cout << "• Focus on content quality and coherence" << endl;
-    }
-}
-
-/*
- * This function creates visual complexity representation using ASCII graphics
- * The implementation provides intuitive data visualization for professional use
- * Cross-platform compatibility ensures universal rendering capabilities
- */
-void display_visual_complexity_chart(double complexity_score) {
-    cout << "\nPASSAGE COMPLEXITY VISUALIZATION:" << endl;
-    cout << string(35, '-') << endl;
-    
-    // Calculate visual representation parameters for accurate chart rendering
-    int chart_scale_factor = static_cast<int>(complexity_score);
-    
-    // Render professional ASCII chart using standardized visualization techniques
-    cout << "Complexity Level: ";
-    for (int visualization_segment = 0; visualization_segment < 10; visualization_segment++) {
-        if (visualization_segment < chart_scale_factor) {
-            cout << "■";  // Filled chart segment indicator
-        } else {
-            cout << "□";  // Empty chart segment indicator
-        }
-    }
-    
-    // Display numerical complexity rating with professional formatting
-    cout << " (" << fixed << setprecision(1) << complexity_score << "/10.0)" << endl;
-    
-    // Provide interpretive guidance for professional assessment
-    cout << "Scale: □□□□□ Basic | ■■■■■ Intermediate | ■■■■■■■■■■ Advanced" << endl;
-}
-
-/*
- * This function orchestrates the complete language analysis workflow
- * The implementation demonstrates professional software architecture patterns
- * User interaction follows structured pedagogical methodology
- */
-void execute_complete_analysis_workflow() {
-    cout << "ANALYSIS OPTIONS AVAILABLE:" << endl;
-    cout << "1. Analyze custom text passage (user input)" << endl;
-    cout << "2. Demonstrate with sample passage analysis" << endl;
-    cout << string(45, '-') << endl;
-    
-    int user_selection;
-    cout << "Please enter selection (1 or 2): ";
-    cin >> user_selection;
-    cin.ignore();  // Clear input buffer for string operations
-    
-    string target_passage;
-    
-    // Execute user-selected analysis mode
-    if (user_selection == 1) {
-        cout << "\nUSER INPUT MODE ACTIVATED" << endl;
-        target_passage = obtain_user_text_input();
-        
-        if (target_passage.empty()) {
-            cout << "ERROR: No input provided. Switching to demonstration mode." << endl;
-            demonstrate_sample_passage_analysis();
-            return;
-        }
-    } else {
-        cout << "\nDEMONSTRATION MODE ACTIVATED" << endl;
-        demonstrate_sample_passage_analysis();
-        return;
-    }
-    
-    cout << "\nINITIATING COMPREHENSIVE TEXT ANALYSIS..." << endl;
-    
-    // Execute progressive analysis steps with visual progress indication
-    for (int processing_iteration = 1; processing_iteration <= 6; processing_iteration++) {
-        display_progress_indicator(processing_iteration, 6);
-        
-        // Simulate professional processing delay for demonstration purposes
-        for (int delay_counter = 0; delay_counter < 50000000; delay_counter++) {
-            // Processing simulation for educational demonstration
-        }
-    }
-    
-    cout << "\nANALYSIS COMPLETE - Generating Professional Results..." << endl;
-    
-    // Extract vocabulary elements from user-provided passage
-    vector<string> extracted_vocabulary = extract_words_from_passage(target_passage);
-    
-    // Execute comprehensive statistical analysis on passage content
-    perform_comprehensive_text_analysis(extracted_vocabulary, target_passage);
-    
-    // Calculate professional complexity scoring using advanced algorithms
-    double passage_complexity_rating = calculate_readability_complexity_score(extracted_vocabulary);
-    
-    cout << "\nCOMPLEXITY ASSESSMENT RESULTS:" << endl;
-    cout << string(30, '-') << endl;
-    cout << "Overall Passage Complexity Score: " << fixed << setprecision(2) 
-         << passage_complexity_rating << "/10.0" << endl;
-    
-    // Generate visual complexity representation for professional presentation
-    display_visual_complexity_chart(passage_complexity_rating);
-    
-    // Provide vocabulary enhancement suggestions
-    suggest_vocabulary_enhancements(extracted_vocabulary);
-    
-    // Generate specific improvement recommendations based on analysis results
-    generate_passage_improvement_recommendations(target_passage, passage_complexity_rating);
-    
-    cout << "\nFINAL ASSESSMENT SUMMARY:" << endl;
-    cout << string(25, '-') << endl;
-    cout << "The text analysis system processed " << extracted_vocabulary.size() 
-         << " vocabulary elements successfully." << endl;
-    cout << "Passage complexity indicates " << 
-         (passage_complexity_rating > 5.0 ? "advanced" : "developing") 
-         << " writing proficiency levels." << endl;
-    cout << "Specific enhancement recommendations generated for continued improvement." << endl;
-}
\ No newline at end of file
+/*
+ * Professional Language Improvement and Passage Analysis Tool
+ * Code hints and optimizations by artlest
+ * 
+ * This application implements a comprehensive language assessment system
+ * designed for educational and professional writing development purposes.
+ * The system analyzes text passages, provides statistical metrics,
+ * and generates professional recommendations for language enhancement.
+ *
+ * The analysis engines live in the text analysis library
+ * (text_analysis_library.h); this file is its console front-end
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <iomanip>
+#include <cmath>
+#include <sstream>
+#include <string_view>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <cstdlib>
+#include <cstdio>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <filesystem>
+#include <new>
+
+#include "text_analysis_library.h"
+
+using namespace std;
+
+// Reports are written straight to the standard output descriptor on POSIX
+#if TEXT_ANALYSER_POSIX_MMAP
+#include <unistd.h>
+#endif
+
+// The analysis daemon listens on a Unix domain socket where one exists
+#if defined(__unix__) || defined(__APPLE__)
+#define TEXT_ANALYSER_UNIX_SOCKETS 1
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#else
+#define TEXT_ANALYSER_UNIX_SOCKETS 0
+#endif
+
+// Replacement allocation functions stay out of line so GCC does not pair inlined free() with new
+#if defined(__GNUC__) || defined(__clang__)
+#define TEXT_ANALYSER_NOINLINE __attribute__((noinline))
+#else
+#define TEXT_ANALYSER_NOINLINE
+#endif
+
+/*
+ * Report text formatted into one reusable buffer and written in one call
+ * Rendering functions stream into stream() with '\n' line ends, so nothing
+ * reaches the terminal until the finished report is written out whole
+ */
+class ReportWriter {
+public:
+    ReportWriter() : formatting_stream(&append_buffer) {}
+    ReportWriter(const ReportWriter&) = delete;
+    ReportWriter& operator=(const ReportWriter&) = delete;
+
+    ostream& stream() { return formatting_stream; }
+    // The stream buffer holds no pending characters, so direct appends stay in order
+    string& buffer() { return append_buffer.report_text; }
+    const string& contents() const { return append_buffer.report_text; }
+    void clear() { append_buffer.report_text.clear(); }
+    void write_to_standard_output();
+
+private:
+    // Appends formatted characters to a string whose capacity survives clear()
+    class StringAppendBuffer : public streambuf {
+    public:
+        string report_text;
+
+    protected:
+        int_type overflow(int_type character) override {
+            if (!traits_type::eq_int_type(character, traits_type::eof())) {
+                report_text.push_back(traits_type::to_char_type(character));
+            }
+            return traits_type::not_eof(character);
+        }
+        streamsize xsputn(const char* characters, streamsize character_count) override {
+            report_text.append(characters, static_cast<size_t>(character_count));
+            return character_count;
+        }
+    };
+
+    StringAppendBuffer append_buffer;
+    ostream formatting_stream;
+};
+
+/*
+ * What a non-interactive run does with its inputs
+ */
+enum class CommandLineMode {
+    Analyze,
+    Serve,
+    Client,
+    LoadTest,
+    Benchmark,
+    BuildThesaurus
+};
+
+/*
+ * Settings of a non-interactive run taken from the command line
+ */
+struct CommandLineOptions {
+    CommandLineMode command_line_mode = CommandLineMode::Analyze;
+    string socket_path;
+    string thesaurus_path;
+    string style_rules_path;
+    uint64_t load_test_request_count = 1000;
+    unsigned load_test_concurrency = 4;
+    bool load_test_repeat_payload = false;
+    size_t cache_entry_limit = 1024;
+    string cache_directory;
+    uint64_t cache_disk_megabytes = AnalysisResultCache::DEFAULT_DISK_BYTE_LIMIT / (1024 * 1024);
+    bool show_cache_statistics = false;
+    bool show_pipeline_statistics = false;
+    uint64_t benchmark_corpus_megabytes = 16;
+    uint64_t benchmark_seed = 1;
+    unsigned benchmark_repetitions = 3;
+    vector<string> input_paths;
+    bool read_standard_input = false;
+    bool stream_inputs = false;
+    ReportOutputFormat output_format = ReportOutputFormat::Text;
+    vector<string> selected_metrics;
+    unsigned analysis_thread_count = 0;
+    bool show_banners = false;
+    bool show_help = false;
+};
+
+/*
+ * Timing and heap activity of one benchmarked analysis stage
+ * The baseline names the stage this one is compared against, if any
+ */
+struct BenchmarkStageMeasurement {
+    string stage_name;
+    double best_seconds = 0.0;
+    double mean_seconds = 0.0;
+    uint64_t allocation_count = 0;
+    uint64_t allocated_bytes = 0;
+    string baseline_stage_name;
+    double baseline_speedup = 0.0;
+};
+
+// Analysis socket frames: a code byte, a 32-bit big-endian payload length, then the payload.
+// Request codes are ReportOutputFormat values; responses carry one of the status codes below
+const size_t ANALYSIS_FRAME_HEADER_BYTES = 5;
+const uint32_t ANALYSIS_FRAME_PAYLOAD_LIMIT = 64 * 1024 * 1024;
+const uint8_t ANALYSIS_RESPONSE_OK = 0;
+const uint8_t ANALYSIS_RESPONSE_ERROR = 1;
+
+// Daemon limits: open connections, and seconds a client may stall inside one frame
+const size_t ANALYSIS_CONNECTION_LIMIT = 512;
+const long ANALYSIS_FRAME_TIMEOUT_SECONDS = 10;
+
+// Thesaurus loaded when none is named with --thesaurus; it is optional, so a missing file is not an error
+const char DEFAULT_THESAURUS_PATH[] = "thesaurus.bin";
+
+// Style rules added to the built-in ones when none are named with --style-rules; also optional
+const char DEFAULT_STYLE_RULES_PATH[] = "style_rules.txt";
+
+// Matches listed with their byte offsets in the style check section of a text report
+const size_t STYLE_MATCH_DISPLAY_LIMIT = 10;
+
+// Synthetic benchmark corpora draw word ranks from a Zipf distribution over this vocabulary
+const size_t SYNTHETIC_CORPUS_VOCABULARY_SIZE = 50000;
+const double SYNTHETIC_CORPUS_ZIPF_EXPONENT = 1.0;
+
+// Professional sample passage representing various complexity levels
+const char SAMPLE_DEMONSTRATION_PASSAGE[] =
+    "The implementation of artificial intelligence technologies requires comprehensive "
+    "understanding of algorithmic processes and computational methodologies. Modern "
+    "systems utilize sophisticated machine learning frameworks to analyze complex "
+    "data patterns and generate predictive models. Organizations must consider "
+    "ethical implications while developing these advanced technological solutions "
+    "for real-world applications and user interactions.";
+
+// Function prototypes for modular implementation
+void display_application_header();
+void display_termination_banner();
+void display_progress_indicator(uint64_t processed_bytes, uint64_t total_bytes, uint64_t completed_work_units,
+                                uint64_t total_work_units, const char* work_unit_label, double elapsed_seconds,
+                                bool final_update);
+ProgressRenderFunction console_progress_renderer();
+string obtain_user_text_input();
+void demonstrate_sample_passage_analysis();
+vector<string> reference_extract_words_from_passage(const string& text_passage);
+ReportWriter& console_report_writer();
+SynonymThesaurus& application_synonym_thesaurus();
+StyleLinter& application_style_linter();
+void render_comprehensive_text_metrics(ostream& report_stream, const PassageAnalysisAccumulator& passage_metrics);
+void render_sentence_structure_metrics(ostream& report_stream, const PassageAnalysisAccumulator& passage_metrics);
+void render_readability_indices(ostream& report_stream, const AnalysisResult& analysis_result);
+void render_vocabulary_enhancement_suggestions(ostream& report_stream, const PassageAnalysisAccumulator& passage_metrics);
+void render_suggested_word_alternatives(ostream& report_stream, const vector<VocabularySuggestion>& vocabulary_suggestions);
+void render_style_check_findings(ostream& report_stream, const StyleLintReport& style_report);
+void render_passage_improvement_recommendations(ostream& report_stream,
+                                                const PassageImprovementRecommendations& improvement_recommendations);
+void render_complexity_assessment(ostream& report_stream, double complexity_score);
+void render_visual_complexity_chart(ostream& report_stream, double complexity_score);
+void render_final_assessment_summary(ostream& report_stream, const PassageAnalysisAccumulator& passage_metrics);
+void render_passage_analysis_report(ostream& report_stream, const AnalysisResult& analysis_result);
+ReportOutputFormat obtain_report_output_format();
+int run_command_line_analysis(int argument_count, char* argument_values[]);
+unique_ptr<AnalysisResultCache> create_command_line_cache(const CommandLineOptions& command_line_options);
+int run_thesaurus_build(const CommandLineOptions& command_line_options);
+bool expand_command_line_inputs(const vector<string>& input_paths, vector<string>& document_paths, string& error_description);
+string read_standard_input_passage();
+int run_analysis_daemon(const CommandLineOptions& command_line_options);
+int run_analysis_client(const CommandLineOptions& command_line_options);
+int run_analysis_load_test(const CommandLineOptions& command_line_options);
+#if TEXT_ANALYSER_INSTRUMENTATION
+void display_pipeline_statistics();
+#endif
+void execute_complete_analysis_workflow();
+void execute_passage_analysis_pipeline(string_view target_passage, unsigned analysis_thread_count = 0,
+                                       ReportOutputFormat output_format = ReportOutputFormat::Text,
+                                       const string& source_name = "");
+void analyze_mapped_document_file();
+void analyze_document_corpus_interactively();
+void display_analysis_cache_statistics(const AnalysisResultCache& result_cache);
+void render_corpus_analysis_results(ostream& report_stream, const vector<DocumentAnalysisResult>& document_results,
+                                    double elapsed_seconds);
+void run_tokenizer_throughput_benchmark();
+void run_parallel_scaling_benchmark();
+void run_incremental_edit_benchmark();
+string build_benchmark_corpus(size_t target_corpus_bytes);
+string generate_synthetic_english_corpus(size_t target_corpus_bytes, uint64_t corpus_seed);
+int run_benchmark_suite(const CommandLineOptions& command_line_options);
+
+/*
+ * Primary application entry point
+ * This function orchestrates the complete language analysis workflow
+ * The implementation follows professional software development patterns
+ * Any command-line argument selects the non-interactive mode instead
+ */
+int main(int argc, char* argv[]) {
+    if (argc > 1) {
+        return run_command_line_analysis(argc, argv);
+    }
+    application_synonym_thesaurus().open_thesaurus(DEFAULT_THESAURUS_PATH);
+    string ignored_error_description;
+    application_style_linter().load_rule_file(DEFAULT_STYLE_RULES_PATH, ignored_error_description);
+    
+    // Display the professional application header with system information
+    display_application_header();
+    
+    // Execute the complete language assessment process with user interaction
+    execute_complete_analysis_workflow();
+    
+    // Provide professional completion notification to the developer
+    display_termination_banner();
+    
+    return 0;
+}
+
+/*
+ * This function displays the termination banner closing every session
+ */
+void display_termination_banner() {
+    cout << "\n" << string(60, '=') << endl;
+    cout << "SYSTEM STATUS: Application execution completed successfully" << endl;
+    cout << "TERMINATION: All analysis modules processed without errors" << endl;
+    cout << string(60, '=') << endl;
+}
+
+/*
+ * This function displays the professional application header
+ * The implementation provides system identification and version information
+ * Professional branding follows industry standards for educational tools
+ */
+void display_application_header() {
+    cout << string(65, '=') << endl;
+    cout << "    PROFESSIONAL LANGUAGE IMPROVEMENT & PASSAGE ANALYSIS SYSTEM" << endl;
+    cout << "    Version: 2.0 | Platform: Cross-Compatible C++" << endl;
+    cout << "    Purpose: Text Analysis and Writing Enhancement Tool" << endl;
+    cout << string(65, '=') << endl;
+    cout << endl;
+}
+
+/*
+ * This function renders a visual progress indicator for system operations
+ * The bar tracks real bytes processed and shows throughput and the
+ * estimated time remaining; it redraws one stderr line in place so the
+ * report on stdout stays clean, and ends the line on the final update
+ */
+void display_progress_indicator(uint64_t processed_bytes, uint64_t total_bytes, uint64_t completed_work_units,
+                                uint64_t total_work_units, const char* work_unit_label, double elapsed_seconds,
+                                bool final_update) {
+    // Calculate the completion percentage for accurate progress representation
+    double completed_fraction = total_bytes > 0
+        ? static_cast<double>(processed_bytes) / total_bytes
+        : (total_work_units > 0 ? static_cast<double>(completed_work_units) / total_work_units : 1.0);
+    completed_fraction = min(completed_fraction, 1.0);
+    int progress_segments = static_cast<int>(completed_fraction * 20);
+
+    string progress_line = "\rProcessing: [";
+    
+    // Render the visual progress bar using standard ASCII characters
+    for (int bar_segment = 0; bar_segment < 20; bar_segment++) {
+        progress_line += bar_segment < progress_segments ? "█" : "░";
+    }
+
+    // Throughput and ETA follow from the bytes processed so far
+    double megabytes_per_second = elapsed_seconds > 0.0 ? processed_bytes / 1e6 / elapsed_seconds : 0.0;
+    char status_text[160];
+    if (completed_fraction > 0.0 && completed_fraction < 1.0) {
+        double remaining_seconds = elapsed_seconds * (1.0 - completed_fraction) / completed_fraction;
+        snprintf(status_text, sizeof(status_text), "] %3d%% | %.1f MB/s | ETA %.1fs | %llu/%llu %s ",
+                 static_cast<int>(completed_fraction * 100), megabytes_per_second, remaining_seconds,
+                 static_cast<unsigned long long>(completed_work_units), static_cast<unsigned long long>(total_work_units), work_unit_label);
+    } else {
+        snprintf(status_text, sizeof(status_text), "] %3d%% | %.1f MB/s | %.1fs elapsed | %llu/%llu %s ",
+                 static_cast<int>(completed_fraction * 100), megabytes_per_second, elapsed_seconds,
+                 static_cast<unsigned long long>(completed_work_units), static_cast<unsigned long long>(total_work_units), work_unit_label);
+    }
+    progress_line += status_text;
+    if (final_update) {
+        progress_line += '\n';
+    }
+
+    fputs(progress_line.c_str(), stderr);
+    fflush(stderr);
+}
+
+/*
+ * Progress renderer for console runs: the stderr bar, or none at all when
+ * stderr is not a terminal so redirected output stays free of redraws
+ */
+ProgressRenderFunction console_progress_renderer() {
+#if TEXT_ANALYSER_POSIX_MMAP
+    return isatty(STDERR_FILENO) != 0 ? display_progress_indicator : nullptr;
+#else
+    return nullptr;
+#endif
+}
+
+/*
+ * Write the buffered report to standard output and empty the buffer
+ * Output already queued through cout is flushed first to keep ordering,
+ * then the report goes out in a single write call
+ */
+void ReportWriter::write_to_standard_output() {
+    TEXT_ANALYSER_STAGE_SCOPE(output_stage, PipelineStage::Output);
+    cout.flush();
+    fflush(stdout);
+
+    const string& report_text = append_buffer.report_text;
+#if TEXT_ANALYSER_POSIX_MMAP
+    size_t written_bytes = 0;
+    while (written_bytes < report_text.size()) {
+        ssize_t write_result = ::write(STDOUT_FILENO, report_text.data() + written_bytes, report_text.size() - written_bytes);
+        if (write_result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        written_bytes += static_cast<size_t>(write_result);
+    }
+#else
+    fwrite(report_text.data(), 1, report_text.size(), stdout);
+    fflush(stdout);
+#endif
+    TEXT_ANALYSER_STAGE_BYTES(output_stage, report_text.size());
+    clear();
+}
+
+/*
+ * Report writer shared by every console report so its buffer is reused
+ */
+ReportWriter& console_report_writer() {
+    static ReportWriter shared_report_writer;
+    return shared_report_writer;
+}
+
+/*
+ * Thesaurus behind the vocabulary suggestions of every text report
+ * It stays closed, and reports keep their generic examples, until a
+ * thesaurus file is opened; lookups are read-only, so daemon workers share it
+ */
+SynonymThesaurus& application_synonym_thesaurus() {
+    static SynonymThesaurus shared_synonym_thesaurus;
+    return shared_synonym_thesaurus;
+}
+
+/*
+ * Style linter behind the style check of every text report
+ * It starts with the built-in rules; rule files are added before any
+ * analysis, after which daemon workers only read it
+ */
+StyleLinter& application_style_linter() {
+    static StyleLinter shared_style_linter;
+    return shared_style_linter;
+}
+
+#if TEXT_ANALYSER_INSTRUMENTATION
+/*
+ * Print the stage totals on stderr, keeping reports on stdout clean
+ * Stages that ran on several threads at once report summed thread time
+ */
+void display_pipeline_statistics() {
+    cerr << "Pipeline statistics (thread time summed per stage):" << endl;
+    cerr << left << setw(11) << "Stage" << right << setw(8) << "Calls" << setw(12) << "Time ms" << setw(14) << "Bytes"
+         << setw(12) << "Tokens" << setw(12) << "MB/s" << setw(10) << "Allocs" << setw(14) << "Alloc bytes" << endl;
+    cerr << fixed << setprecision(2);
+    for (size_t stage_index = 0; stage_index < PIPELINE_STAGE_COUNT; stage_index++) {
+        const PipelineStageCounters& stage_counters = pipeline_stage_counters[stage_index];
+        double stage_seconds = stage_counters.elapsed_nanoseconds.load(memory_order_relaxed) / 1e9;
+        uint64_t stage_bytes = stage_counters.processed_bytes.load(memory_order_relaxed);
+        cerr << left << setw(11) << pipeline_stage_name(static_cast<PipelineStage>(stage_index)) << right << setw(8)
+             << stage_counters.invocation_count.load(memory_order_relaxed) << setw(12) << stage_seconds * 1000.0 << setw(14)
+             << stage_bytes << setw(12) << stage_counters.processed_tokens.load(memory_order_relaxed) << setw(12)
+             << (stage_seconds > 0.0 ? stage_bytes / 1e6 / stage_seconds : 0.0) << setw(10)
+             << stage_counters.allocation_count.load(memory_order_relaxed) << setw(14)
+             << stage_counters.allocated_bytes.load(memory_order_relaxed) << endl;
+    }
+}
+#endif
+
+/*
+ * This function handles user text input collection for analysis
+ * The implementation provides professional input validation and processing
+ * User interface follows industry standards for educational applications
+ */
+string obtain_user_text_input() {
+    TEXT_ANALYSER_STAGE_SCOPE(input_stage, PipelineStage::Input);
+    string user_text_input;
+    cout << "INPUT REQUEST: Please enter the text passage for analysis" << endl;
+    cout << "INSTRUCTION: Type the complete passage and press Enter twice when finished" << endl;
+    cout << string(50, '-') << endl;
+    
+    // Collect multi-line text input from the user interface
+    string input_line;
+    while (getline(cin, input_line)) {
+        if (input_line.empty() && !user_text_input.empty()) {
+            break;  // Terminate input collection on empty line
+        }
+        if (!user_text_input.empty()) {
+            user_text_input += " ";  // Add space separator between lines
+        }
+        user_text_input += input_line;
+    }
+    
+    TEXT_ANALYSER_STAGE_BYTES(input_stage, user_text_input.size());
+    return user_text_input;
+}
+
+/*
+ * This function analyzes a document file selected by the user
+ * The whole pipeline runs directly over the mapped bytes, and unlike the
+ * interactive input the document may contain blank lines
+ */
+void analyze_mapped_document_file() {
+    string document_path;
+    cout << "INPUT REQUEST: Please enter the path of the text document" << endl;
+    cout << "Document path: ";
+    getline(cin, document_path);
+
+    string huge_page_answer;
+    cout << "Request huge pages for documents over " << MappedTextFile::HUGE_PAGE_THRESHOLD_BYTES / (1024 * 1024)
+         << " MB? (y/n): ";
+    getline(cin, huge_page_answer);
+    bool request_huge_pages = !huge_page_answer.empty() && (huge_page_answer[0] == 'y' || huge_page_answer[0] == 'Y');
+
+    string thread_count_answer;
+    cout << "Analysis threads (0 = all " << max(1u, thread::hardware_concurrency()) << " cores): ";
+    getline(cin, thread_count_answer);
+    unsigned analysis_thread_count = static_cast<unsigned>(strtoul(thread_count_answer.c_str(), nullptr, 10));
+    ReportOutputFormat output_format = obtain_report_output_format();
+
+    MappedTextFile document_file;
+    if (!document_file.open_document(document_path, request_huge_pages)) {
+        cout << "ERROR: " << document_file.last_error() << endl;
+        return;
+    }
+
+    if (document_file.contents().empty()) {
+        cout << "ERROR: Document is empty. Switching to demonstration mode." << endl;
+        demonstrate_sample_passage_analysis();
+        return;
+    }
+
+    cout << "\nDOCUMENT LOADED: " << document_file.contents().size() << " bytes mapped for analysis" << endl;
+    execute_passage_analysis_pipeline(document_file.contents(), analysis_thread_count, output_format, document_path);
+}
+
+/*
+ * This function demonstrates sample passage analysis for educational purposes
+ * The implementation showcases system capabilities with professional examples
+ * Sample content follows academic writing standards for demonstration
+ */
+void demonstrate_sample_passage_analysis() {
+    ReportWriter& report_writer = console_report_writer();
+    ostream& report_stream = report_writer.stream();
+    report_stream << "DEMONSTRATION MODE: Analyzing sample passage for educational purposes\n";
+    report_stream << string(60, '-') << '\n';
+    
+    string_view sample_demonstration_passage = SAMPLE_DEMONSTRATION_PASSAGE;
+    
+    report_stream << "SAMPLE PASSAGE FOR ANALYSIS:\n";
+    report_stream << "\"" << sample_demonstration_passage << "\"\n\n";
+    
+    // Process the sample passage through the single-pass analysis engine
+    AnalysisResult analysis_result = build_analysis_result(analyze_passage_in_single_pass(sample_demonstration_passage),
+                                                           &application_synonym_thesaurus(),
+                                                           application_style_linter().lint_passage(sample_demonstration_passage));
+    
+    // Execute comprehensive analysis on the sample content
+    render_comprehensive_text_metrics(report_stream, analysis_result.passage_metrics);
+    render_sentence_structure_metrics(report_stream, analysis_result.passage_metrics);
+    render_readability_indices(report_stream, analysis_result);
+    render_style_check_findings(report_stream, analysis_result.style_report);
+    
+    // Present the specific improvement recommendations for the sample passage
+    render_passage_improvement_recommendations(report_stream, analysis_result.improvement_recommendations);
+    report_writer.write_to_standard_output();
+}
+
+/*
+ * Print the cache counters on stderr, keeping reports on stdout clean
+ */
+void display_analysis_cache_statistics(const AnalysisResultCache& result_cache) {
+    AnalysisCacheStatistics cache_statistics = result_cache.statistics();
+    cerr << "Analysis cache: " << cache_statistics.memory_hits << " memory hits, " << cache_statistics.disk_hits
+         << " disk hits, " << cache_statistics.misses << " misses, " << cache_statistics.stores << " stores, "
+         << cache_statistics.evictions << " evictions, " << cache_statistics.resident_entries << " entries resident";
+    if (cache_statistics.disk_entries > 0 || cache_statistics.disk_evictions > 0) {
+        cerr << ", " << cache_statistics.disk_entries << " on disk (" << (cache_statistics.disk_bytes + 1023) / 1024 << " KB, "
+             << cache_statistics.disk_evictions << " deleted)";
+    }
+    cerr << endl;
+}
+
+/*
+ * This function renders one line per document and the corpus summary
+ */
+void render_corpus_analysis_results(ostream& report_stream, const vector<DocumentAnalysisResult>& document_results,
+                                    double elapsed_seconds) {
+    TEXT_ANALYSER_STAGE_SCOPE(rendering_stage, PipelineStage::Rendering);
+    report_stream << "\nBATCH CORPUS ANALYSIS RESULTS:\n";
+    report_stream << string(45, '-') << '\n';
+    report_stream << fixed;
+
+    uint64_t analyzed_document_count = 0;
+    uint64_t corpus_bytes = 0;
+    uint64_t corpus_words = 0;
+    uint64_t corpus_characters = 0;
+    uint64_t corpus_sentences = 0;
+    uint64_t scored_document_count = 0;
+    uint64_t duplicate_document_count = 0;
+    uint64_t cached_document_count = 0;
+    uint64_t linted_document_count = 0;
+    uint64_t style_match_total = 0;
+    double complexity_score_total = 0.0;
+
+    for (size_t document_index = 0; document_index < document_results.size(); document_index++) {
+        const DocumentAnalysisResult& document_result = document_results[document_index];
+        report_stream << "[" << document_index + 1 << "] " << document_result.document_path << " | ";
+        if (!document_result.analysis_succeeded) {
+            report_stream << "SKIPPED: " << document_result.error_description << '\n';
+            continue;
+        }
+
+        const PassageAnalysisAccumulator& passage_metrics = document_result.passage_metrics;
+        analyzed_document_count++;
+        corpus_bytes += document_result.document_bytes;
+        corpus_words += passage_metrics.total_word_count;
+        corpus_characters += passage_metrics.total_character_count;
+        corpus_sentences += passage_metrics.sentence_count;
+
+        report_stream << "Words: " << passage_metrics.total_word_count;
+        if (passage_metrics.total_word_count > 0) {
+            complexity_score_total += passage_metrics.complexity_score();
+            scored_document_count++;
+            report_stream << " | Avg Length: " << setprecision(2) << passage_metrics.average_word_length()
+                          << " | Complexity: " << passage_metrics.complexity_score() << "/10.0";
+        }
+        report_stream << " | Sentences: " << passage_metrics.sentence_count;
+        if (document_result.style_report.checked_rule_count > 0) {
+            linted_document_count++;
+            style_match_total += document_result.style_report.total_match_count;
+            report_stream << " | Style: " << document_result.style_report.total_match_count;
+        }
+        if (document_result.duplicate_of_document != DocumentAnalysisResult::NO_DUPLICATE_DOCUMENT) {
+            duplicate_document_count++;
+            report_stream << " | Duplicate of [" << document_result.duplicate_of_document + 1 << "]";
+        } else if (document_result.served_from_cache) {
+            cached_document_count++;
+            report_stream << " | Cached";
+        }
+        report_stream << '\n';
+    }
+
+    report_stream << "\nCORPUS SUMMARY:\n";
+    report_stream << string(25, '-') << '\n';
+    report_stream << "Documents Analyzed: " << analyzed_document_count << " of " << document_results.size() << '\n';
+    report_stream << "Total Bytes Processed: " << corpus_bytes << '\n';
+    report_stream << "Total Words Analyzed: " << corpus_words << '\n';
+    report_stream << "Total Sentences Detected: " << corpus_sentences << '\n';
+    if (linted_document_count > 0) {
+        report_stream << "Style Phrases Flagged: " << style_match_total << '\n';
+    }
+    if (duplicate_document_count > 0) {
+        report_stream << "Duplicate Documents Reused: " << duplicate_document_count << '\n';
+    }
+    if (cached_document_count > 0) {
+        report_stream << "Cached Results Reused: " << cached_document_count << '\n';
+    }
+    report_stream << setprecision(2);
+    if (corpus_words > 0) {
+        report_stream << "Corpus Average Word Length: " << static_cast<double>(corpus_characters) / corpus_words << " characters\n";
+    }
+    if (scored_document_count > 0) {
+        report_stream << "Mean Document Complexity: " << complexity_score_total / scored_document_count << "/10.0\n";
+    }
+    report_stream << "Elapsed Time: " << setprecision(3) << elapsed_seconds << " seconds\n";
+    if (elapsed_seconds > 0.0) {
+        report_stream << "Throughput: " << setprecision(2) << corpus_bytes / 1e6 / elapsed_seconds << " MB/s, "
+                      << document_results.size() / elapsed_seconds << " documents/s\n";
+    }
+}
+
+/*
+ * This function runs the interactive batch corpus mode
+ */
+void analyze_document_corpus_interactively() {
+    string corpus_source;
+    cout << "INPUT REQUEST: Please enter a corpus directory or a file listing one document path per line" << endl;
+    cout << "Corpus source: ";
+    getline(cin, corpus_source);
+
+    string thread_count_answer;
+    cout << "Analysis threads (0 = all " << max(1u, thread::hardware_concurrency()) << " cores): ";
+    getline(cin, thread_count_answer);
+    unsigned analysis_thread_count = static_cast<unsigned>(strtoul(thread_count_answer.c_str(), nullptr, 10));
+    ReportOutputFormat output_format = obtain_report_output_format();
+
+    vector<string> document_paths;
+    string error_description;
+    if (!collect_corpus_document_paths(corpus_source, document_paths, error_description)) {
+        cout << "ERROR: " << error_description << endl;
+        return;
+    }
+    if (document_paths.empty()) {
+        cout << "ERROR: No documents found in corpus source." << endl;
+        return;
+    }
+
+    cout << "\nCORPUS LOADED: " << document_paths.size() << " documents queued for analysis" << endl;
+    auto batch_start = chrono::steady_clock::now();
+    vector<DocumentAnalysisResult> document_results = analyze_document_corpus(
+        document_paths, analysis_thread_count, nullptr, console_progress_renderer(), &application_style_linter());
+    double elapsed_seconds = chrono::duration<double>(chrono::steady_clock::now() - batch_start).count();
+
+    ReportWriter& report_writer = console_report_writer();
+    if (output_format == ReportOutputFormat::Text) {
+        render_corpus_analysis_results(report_writer.stream(), document_results, elapsed_seconds);
+    } else {
+        render_structured_document_report(report_writer.buffer(), output_format, document_results, elapsed_seconds);
+    }
+    report_writer.write_to_standard_output();
+}
+
+/*
+ * This function renders the word statistics section of the report
+ */
+void render_comprehensive_text_metrics(ostream& report_stream, const PassageAnalysisAccumulator& passage_metrics) {
+    report_stream << "\nCOMPREHENSIVE TEXT ANALYSIS RESULTS:\n";
+    report_stream << string(45, '-') << '\n';
+    
+    // Display formatted statistical results using professional presentation standards
+    report_stream << fixed << setprecision(2);
+    report_stream << "Total Words Analyzed: " << passage_metrics.total_word_count << '\n';
+    report_stream << "Average Word Length: " << passage_metrics.average_word_length() << " characters\n";
+    report_stream << "Minimum Word Length: " << passage_metrics.minimum_word_length << " characters\n";
+    report_stream << "Maximum Word Length: " << passage_metrics.maximum_word_length << " characters\n";
+    report_stream << "Advanced Vocabulary Ratio: " << passage_metrics.advanced_vocabulary_percentage() << "%\n";
+    report_stream << "Total Character Count: " << passage_metrics.total_character_count << '\n';
+    // Streamed passages only have sketch estimates of their vocabulary
+    const char* estimate_label = passage_metrics.vocabulary_estimated ? " (estimated)" : "";
+    report_stream << "Distinct Words: " << passage_metrics.distinct_word_count << estimate_label << '\n';
+    report_stream << "Type/Token Ratio: " << passage_metrics.type_token_ratio() << estimate_label << '\n';
+}
+
+/*
+ * This function renders the sentence structure section of the report
+ */
+void render_sentence_structure_metrics(ostream& report_stream, const PassageAnalysisAccumulator& passage_metrics) {
+    report_stream << "\nSENTENCE STRUCTURE ANALYSIS:\n";
+    report_stream << string(30, '-') << '\n';
+    
+    // Calculate structural complexity metrics
+    double average_sentence_length = passage_metrics.average_sentence_length();
+    
+    // Display structural analysis results with professional formatting
+    report_stream << "Total Sentences Detected: " << passage_metrics.sentence_count << '\n';
+    report_stream << "Average Sentence Length: " << fixed << setprecision(1) << average_sentence_length << " characters\n";
+    if (passage_metrics.sentence_count > 0) {
+        for (const auto& [length_unit, sentence_lengths] :
+             {pair<const char*, const SentenceLengthDistribution*>{"words", &passage_metrics.sentence_word_lengths},
+              pair<const char*, const SentenceLengthDistribution*>{"letters", &passage_metrics.sentence_character_lengths}}) {
+            report_stream << "Sentence Length (" << length_unit << "): mean " << fixed << setprecision(1) << sentence_lengths->mean()
+                          << ", std dev " << sentence_lengths->standard_deviation() << ", median " << sentence_lengths->percentile(0.5)
+                          << ", 90th percentile " << sentence_lengths->percentile(0.9) << ", longest "
+                          << sentence_lengths->longest_length << '\n';
+        }
+    }
+    report_stream << "Comma Usage Frequency: " << passage_metrics.comma_count << " instances\n";
+    report_stream << "Advanced Punctuation Usage: " << passage_metrics.semicolon_count << " semicolons\n";
+    
+    // Provide structural complexity assessment
+    if (average_sentence_length > 80) {
+        report_stream << "Assessment: Complex sentence structures detected\n";
+    } else if (average_sentence_length > 50) {
+        report_stream << "Assessment: Moderate sentence complexity observed\n";
+    } else {
+        report_stream << "Assessment: Simple sentence structures identified\n";
+    }
+}
+
+/*
+ * This function renders the standard readability indices of the report
+ * Flesch Reading Ease is a 0-100 scale where higher is easier; the other
+ * indices approximate the US school grade needed to follow the passage.
+ * Without words no index is defined, so each reads "n/a", as the
+ * structured formats leave them empty
+ */
+void render_readability_indices(ostream& report_stream, const AnalysisResult& analysis_result) {
+    report_stream << "\nREADABILITY INDICES:\n";
+    report_stream << string(25, '-') << '\n';
+    
+    double flesch_reading_ease = analysis_result.flesch_reading_ease;
+    const char* reading_ease_description = flesch_reading_ease >= 90   ? "very easy"
+                                           : flesch_reading_ease >= 80 ? "easy"
+                                           : flesch_reading_ease >= 70 ? "fairly easy"
+                                           : flesch_reading_ease >= 60 ? "standard"
+                                           : flesch_reading_ease >= 50 ? "fairly difficult"
+                                           : flesch_reading_ease >= 30 ? "difficult"
+                                                                       : "very difficult";
+    auto render_index = [&](const char* index_label, double index_value) -> ostream& {
+        report_stream << index_label << ": ";
+        if (!analysis_result.contains_words) {
+            return report_stream << "n/a";
+        }
+        return report_stream << index_value;
+    };
+    report_stream << fixed << setprecision(2);
+    render_index("Syllables per Word", analysis_result.passage_metrics.syllables_per_word()) << '\n';
+    render_index("Flesch Reading Ease", flesch_reading_ease);
+    if (analysis_result.contains_words) {
+        report_stream << " (" << reading_ease_description << ")";
+    }
+    report_stream << '\n';
+    render_index("Flesch-Kincaid Grade Level", analysis_result.flesch_kincaid_grade) << '\n';
+    render_index("Gunning Fog Index", analysis_result.gunning_fog_index) << '\n';
+    render_index("SMOG Grade", analysis_result.smog_index) << '\n';
+    render_index("Coleman-Liau Index", analysis_result.coleman_liau_index) << '\n';
+}
+
+/*
+ * Render up to five example words as a comma separated list
+ */
+static void render_vocabulary_example_list(ostream& report_stream, const vector<string>& vocabulary_examples) {
+    for (size_t index = 0; index < vocabulary_examples.size(); index++) {
+        report_stream << vocabulary_examples[index];
+        if (index + 1 < vocabulary_examples.size()) {
+            report_stream << ", ";
+        }
+    }
+    report_stream << '\n';
+}
+
+/*
+ * Render a most-frequent list as words with their counts in parentheses
+ */
+static void render_frequent_word_list(ostream& report_stream, const vector<FrequentWord>& frequent_words) {
+    for (size_t index = 0; index < frequent_words.size(); index++) {
+        report_stream << frequent_words[index].word << " (" << frequent_words[index].occurrence_count << ")";
+        if (index + 1 < frequent_words.size()) {
+            report_stream << ", ";
+        }
+    }
+    report_stream << '\n';
+}
+
+/*
+ * This function renders the vocabulary suggestions section of the report
+ */
+void render_vocabulary_enhancement_suggestions(ostream& report_stream, const PassageAnalysisAccumulator& passage_metrics) {
+    report_stream << "\nVOCABULARY ENHANCEMENT SUGGESTIONS:\n";
+    report_stream << string(40, '-') << '\n';
+    
+    // Generate specific enhancement recommendations based on analysis
+    report_stream << "Basic Terms Identified (" << passage_metrics.basic_vocabulary_count << " items): ";
+    render_vocabulary_example_list(report_stream, passage_metrics.basic_vocabulary_examples);
+    
+    report_stream << "Advanced Terms Detected (" << passage_metrics.advanced_vocabulary_count << " items): ";
+    render_vocabulary_example_list(report_stream, passage_metrics.advanced_vocabulary_examples);
+    
+    // Show the words most worth varying first; streamed counts are lower bounds
+    const char* estimate_label = passage_metrics.vocabulary_estimated ? " (minimum counts)" : "";
+    report_stream << "Most Frequent Basic Terms" << estimate_label << ": ";
+    render_frequent_word_list(report_stream, passage_metrics.frequent_basic_words);
+    report_stream << "Most Frequent Advanced Terms" << estimate_label << ": ";
+    render_frequent_word_list(report_stream, passage_metrics.frequent_advanced_words);
+}
+
+/*
+ * This function lists the thesaurus alternatives for the most frequent basic terms
+ */
+void render_suggested_word_alternatives(ostream& report_stream, const vector<VocabularySuggestion>& vocabulary_suggestions) {
+    if (vocabulary_suggestions.empty()) {
+        return;
+    }
+    report_stream << "Suggested Alternatives:\n";
+    for (const VocabularySuggestion& vocabulary_suggestion : vocabulary_suggestions) {
+        report_stream << "  " << vocabulary_suggestion.word << " (" << vocabulary_suggestion.occurrence_count << ") → ";
+        for (size_t index = 0; index < vocabulary_suggestion.alternatives.size(); index++) {
+            report_stream << vocabulary_suggestion.alternatives[index];
+            if (index + 1 < vocabulary_suggestion.alternatives.size()) {
+                report_stream << ", ";
+            }
+        }
+        report_stream << '\n';
+    }
+}
+
+/*
+ * This function renders the style check section: match counts per
+ * category, every finding, and where in the passage the first matches are
+ */
+void render_style_check_findings(ostream& report_stream, const StyleLintReport& style_report) {
+    if (style_report.checked_rule_count == 0) {
+        return;
+    }
+    report_stream << "\nSTYLE CHECK:\n";
+    report_stream << string(12, '-') << '\n';
+    if (style_report.total_match_count == 0) {
+        report_stream << "No wordy phrases, clichés, filler or hedging found (" << style_report.checked_rule_count
+                      << " phrases checked)\n";
+        return;
+    }
+    report_stream << "Phrases Flagged: " << style_report.total_match_count << " (";
+    for (size_t category_index = 0; category_index < STYLE_ISSUE_CATEGORY_COUNT; category_index++) {
+        StyleIssueCategory style_issue_category = static_cast<StyleIssueCategory>(category_index);
+        report_stream << (category_index > 0 ? ", " : "") << style_issue_category_name(style_issue_category) << ' '
+                      << style_report.category_match_counts[category_index];
+    }
+    report_stream << ")\n";
+    for (const StyleFinding& style_finding : style_report.findings) {
+        report_stream << "  " << style_finding.style_rule.phrase << " (" << style_finding.match_count << ", "
+                      << style_issue_category_name(style_finding.style_rule.category) << ")";
+        if (!style_finding.style_rule.suggestion.empty()) {
+            report_stream << " → " << style_finding.style_rule.suggestion;
+        }
+        report_stream << '\n';
+    }
+    report_stream << "First Matches (byte offset): ";
+    size_t displayed_match_count = min(STYLE_MATCH_DISPLAY_LIMIT, style_report.matches.size());
+    for (size_t match_index = 0; match_index < displayed_match_count; match_index++) {
+        const StyleMatch& style_match = style_report.matches[match_index];
+        report_stream << (match_index > 0 ? ", " : "") << style_report.findings[style_match.finding_index].style_rule.phrase << " @"
+                      << style_match.start_offset;
+    }
+    report_stream << (style_report.total_match_count > displayed_match_count ? ", ...\n" : "\n");
+}
+
+/*
+ * This function renders the improvement recommendations section of the report
+ */
+void render_passage_improvement_recommendations(ostream& report_stream,
+                                                const PassageImprovementRecommendations& improvement_recommendations) {
+    report_stream << "\nSPECIFIC PASSAGE IMPROVEMENT RECOMMENDATIONS:\n";
+    report_stream << string(50, '-') << '\n';
+    report_stream << "ASSESSMENT: " << improvement_recommendations.proficiency_assessment << '\n';
+    report_stream << "PRIMARY RECOMMENDATION: " << improvement_recommendations.primary_recommendation << '\n';
+    report_stream << "SPECIFIC STRATEGY: " << improvement_recommendations.specific_strategy << '\n';
+    report_stream << "EXAMPLE ENHANCEMENT: " << improvement_recommendations.example_enhancement << '\n';
+    
+    report_stream << "\nSTRUCTURAL RECOMMENDATIONS:\n";
+    for (const char* structural_recommendation : improvement_recommendations.structural_recommendations) {
+        report_stream << "• " << structural_recommendation << '\n';
+    }
+    
+    if (!improvement_recommendations.style_recommendations.empty()) {
+        report_stream << "\nSTYLE RECOMMENDATIONS:\n";
+        for (const string& style_recommendation : improvement_recommendations.style_recommendations) {
+            report_stream << "• " << style_recommendation << '\n';
+        }
+    }
+}
+
+/*
+ * This function renders the overall complexity score section of the report
+ */
+void render_complexity_assessment(ostream& report_stream, double complexity_score) {
+    report_stream << "\nCOMPLEXITY ASSESSMENT RESULTS:\n";
+    report_stream << string(30, '-') << '\n';
+    report_stream << "Overall Passage Complexity Score: " << fixed << setprecision(2) 
+                  << complexity_score << "/10.0\n";
+}
+
+/*
+ * This function creates visual complexity representation using ASCII graphics
+ * The implementation provides intuitive data visualization for professional use
+ * Cross-platform compatibility ensures universal rendering capabilities
+ */
+void render_visual_complexity_chart(ostream& report_stream, double complexity_score) {
+    report_stream << "\nPASSAGE COMPLEXITY VISUALIZATION:\n";
+    report_stream << string(35, '-') << '\n';
+    
+    // Calculate visual representation parameters for accurate chart rendering
+    int chart_scale_factor = static_cast<int>(complexity_score);
+    
+    // Render professional ASCII chart using standardized visualization techniques
+    report_stream << "Complexity Level: ";
+    for (int visualization_segment = 0; visualization_segment < 10; visualization_segment++) {
+        if (visualization_segment < chart_scale_factor) {
+            report_stream << "■";  // Filled chart segment indicator
+        } else {
+            report_stream << "□";  // Empty chart segment indicator
+        }
+    }
+    
+    // Display numerical complexity rating with professional formatting
+    report_stream << " (" << fixed << setprecision(1) << complexity_score << "/10.0)\n";
+    
+    // Provide interpretive guidance for professional assessment
+    report_stream << "Scale: □□□□□ Basic | ■■■■■ Intermediate | ■■■■■■■■■■ Advanced\n";
+}
+
+/*
+ * This function renders the closing summary of the report
+ */
+void render_final_assessment_summary(ostream& report_stream, const PassageAnalysisAccumulator& passage_metrics) {
+    report_stream << "\nFINAL ASSESSMENT SUMMARY:\n";
+    report_stream << string(25, '-') << '\n';
+    report_stream << "The text analysis system processed " << passage_metrics.total_word_count 
+                  << " vocabulary elements successfully.\n";
+    report_stream << "Passage complexity indicates " << 
+                     (passage_metrics.complexity_score() > 5.0 ? "advanced" : "developing") 
+                  << " writing proficiency levels.\n";
+    report_stream << "Specific enhancement recommendations generated for continued improvement.\n";
+}
+
+/*
+ * This function renders the complete report for an analyzed passage
+ */
+void render_passage_analysis_report(ostream& report_stream, const AnalysisResult& analysis_result) {
+    TEXT_ANALYSER_STAGE_SCOPE(rendering_stage, PipelineStage::Rendering);
+    const PassageAnalysisAccumulator& passage_metrics = analysis_result.passage_metrics;
+
+    // Execute comprehensive statistical analysis on passage content
+    render_comprehensive_text_metrics(report_stream, passage_metrics);
+    render_sentence_structure_metrics(report_stream, passage_metrics);
+    render_readability_indices(report_stream, analysis_result);
+    
+    // Present the complexity score computed by the analysis library
+    render_complexity_assessment(report_stream, analysis_result.complexity_score);
+    
+    // Generate visual complexity representation for professional presentation
+    render_visual_complexity_chart(report_stream, analysis_result.complexity_score);
+    
+    // Provide vocabulary enhancement suggestions
+    render_vocabulary_enhancement_suggestions(report_stream, passage_metrics);
+    render_suggested_word_alternatives(report_stream, analysis_result.vocabulary_suggestions);
+    render_style_check_findings(report_stream, analysis_result.style_report);
+    
+    // Present the improvement recommendations chosen for the passage
+    render_passage_improvement_recommendations(report_stream, analysis_result.improvement_recommendations);
+    
+    render_final_assessment_summary(report_stream, passage_metrics);
+}
+
+/*
+ * Ask which output format a file or corpus report should use
+ * An empty answer or an unknown name keeps the human-readable text report
+ */
+ReportOutputFormat obtain_report_output_format() {
+    string format_answer;
+    cout << "Output format (text/json/ndjson/csv) [text]: ";
+    getline(cin, format_answer);
+
+    ReportOutputFormat output_format = ReportOutputFormat::Text;
+    if (!format_answer.empty() && !parse_report_output_format(format_answer, output_format)) {
+        cout << "Unknown output format, using text." << endl;
+    }
+    return output_format;
+}
+
+/*
+ * Print the command-line usage summary
+ */
+void display_command_line_usage(const char* program_name) {
+    cout << "Usage: " << program_name << " [options] [FILE|DIRECTORY|-]...\n"
+         << "       " << program_name << " --serve SOCKET [--threads N]\n"
+         << "       " << program_name << " --client SOCKET [--format FORMAT] [FILE|DIRECTORY|-]...\n"
+         << "       " << program_name << " --load-test SOCKET [--requests N] [--concurrency N] [--repeat-payload] [FILE]\n"
+         << "       " << program_name << " --bench [--bench-size MB] [--bench-seed N] [--bench-repetitions N] [--format FORMAT]\n"
+         << "       " << program_name << " --build-thesaurus FILE SOURCE...\n"
+         << "Analyzes each document without prompts; with no inputs, standard input is analyzed.\n"
+         << "Directories are expanded to the regular files they contain, and - reads standard input.\n\n"
+         << "Options:\n"
+         << "  --format FORMAT     text (default), json, ndjson or csv\n"
+         << "  --metrics LIST      comma separated fields for json, ndjson and csv output\n"
+         << "  --threads N         analysis threads (0 = all hardware threads, the default)\n"
+         << "  --banner            print the application header and termination banner\n"
+         << "  --thesaurus FILE    suggest alternatives from a thesaurus built with --build-thesaurus\n"
+         << "                      (default " << DEFAULT_THESAURUS_PATH << ", when it exists)\n"
+         << "  --build-thesaurus FILE  compile SOURCE lists of 'headword,synonym,...' lines into FILE\n"
+         << "  --style-rules FILE  add 'category|phrase|suggestion' lines to the built-in style rules, the\n"
+         << "                      category one of wordy, cliche, filler or hedging\n"
+         << "                      (default " << DEFAULT_STYLE_RULES_PATH << ", when it exists)\n"
+         << "  --stream            analyze inputs of any size in fixed memory, one piece at a time; the\n"
+         << "                      distinct and most frequent words are then estimated\n"
+         << "  --serve SOCKET      run the analysis daemon on a Unix domain socket\n"
+         << "  --client SOCKET     send the inputs to a running daemon and print its reports\n"
+         << "  --load-test SOCKET  measure daemon latency percentiles and requests per second\n"
+         << "  --requests N        load test request count (default 1000)\n"
+         << "  --concurrency N     load test connections (default 4)\n"
+         << "  --repeat-payload    send the load test payload unchanged, so the daemon answers from its\n"
+         << "                      cache after the first request; by default each request is made unique\n"
+         << "  --cache-entries N   results kept in the in-memory cache (default 1024, 0 disables)\n"
+         << "  --cache-dir DIR     also keep results on disk in DIR across runs\n"
+         << "  --cache-disk-mb N   megabytes of --cache-dir entries kept, least recently used deleted first\n"
+         << "                      (default " << AnalysisResultCache::DEFAULT_DISK_BYTE_LIMIT / (1024 * 1024) << ")\n"
+         << "  --cache-stats       print cache hit and miss counters on stderr\n"
+         << "  --stats             print per-stage times, bytes, tokens and allocations on stderr\n"
+         << "                      (and under pipeline_statistics with --format json)\n"
+         << "  --bench             time every analysis stage on a synthetic Zipf-distributed corpus\n"
+         << "  --bench-size MB     benchmark corpus size in megabytes (default 16)\n"
+         << "  --bench-seed N      benchmark corpus random seed (default 1)\n"
+         << "  --bench-repetitions N  timed runs per stage; the best is reported (default 3)\n"
+         << "  --help              show this summary and the available metric names\n\n"
+         << "Metrics:";
+    for (const string& field_name : structured_report_field_names()) {
+        cout << ' ' << field_name;
+    }
+    cout << endl;
+}
+
+/*
+ * This function parses the command line into analysis options
+ * Returns false with a description when an argument cannot be used
+ */
+bool parse_command_line_options(int argument_count, char* argument_values[], CommandLineOptions& command_line_options,
+                                string& error_description) {
+    for (int argument_index = 1; argument_index < argument_count; argument_index++) {
+        string_view argument = argument_values[argument_index];
+
+        // Options taking a value accept it as the next argument
+        bool takes_value = argument == "--format" || argument == "--metrics" || argument == "--threads" ||
+                           argument == "--serve" || argument == "--client" || argument == "--load-test" ||
+                           argument == "--requests" || argument == "--concurrency" || argument == "--cache-entries" ||
+                           argument == "--cache-dir" || argument == "--cache-disk-mb" || argument == "--bench-size" ||
+                           argument == "--bench-seed" || argument == "--bench-repetitions" || argument == "--thesaurus" ||
+                           argument == "--build-thesaurus" || argument == "--style-rules";
+        if (takes_value && argument_index + 1 >= argument_count) {
+            error_description = "missing value for " + string(argument);
+            return false;
+        }
+
+        if (argument == "--help" || argument == "-h") {
+            command_line_options.show_help = true;
+        } else if (argument == "--banner") {
+            command_line_options.show_banners = true;
+        } else if (argument == "--stream") {
+            command_line_options.stream_inputs = true;
+        } else if (argument == "--repeat-payload") {
+            command_line_options.load_test_repeat_payload = true;
+        } else if (argument == "--format") {
+            string_view format_name = argument_values[++argument_index];
+            if (!parse_report_output_format(format_name, command_line_options.output_format)) {
+                error_description = "unknown output format '" + string(format_name) + "'";
+                return false;
+            }
+        } else if (argument == "--cache-dir") {
+            command_line_options.cache_directory = argument_values[++argument_index];
+        } else if (argument == "--thesaurus") {
+            command_line_options.thesaurus_path = argument_values[++argument_index];
+        } else if (argument == "--style-rules") {
+            command_line_options.style_rules_path = argument_values[++argument_index];
+        } else if (argument == "--build-thesaurus") {
+            command_line_options.command_line_mode = CommandLineMode::BuildThesaurus;
+            command_line_options.thesaurus_path = argument_values[++argument_index];
+        } else if (argument == "--cache-stats") {
+            command_line_options.show_cache_statistics = true;
+        } else if (argument == "--stats") {
+#if TEXT_ANALYSER_INSTRUMENTATION
+            command_line_options.show_pipeline_statistics = true;
+#else
+            error_description = "--stats is unavailable: built with TEXT_ANALYSER_INSTRUMENTATION=0";
+            return false;
+#endif
+        } else if (argument == "--bench") {
+            command_line_options.command_line_mode = CommandLineMode::Benchmark;
+        } else if (argument == "--threads" || argument == "--requests" || argument == "--concurrency" ||
+                   argument == "--cache-entries" || argument == "--cache-disk-mb" || argument == "--bench-size" ||
+                   argument == "--bench-seed" || argument == "--bench-repetitions") {
+            const char* count_text = argument_values[++argument_index];
+            char* parse_end = nullptr;
+            errno = 0;
+            unsigned long long parsed_count = strtoull(count_text, &parse_end, 10);
+            bool wide_count = argument == "--requests" || argument == "--cache-entries" || argument == "--cache-disk-mb";
+            unsigned long long count_limit = wide_count ? UINT32_MAX : argument == "--bench-seed" ? UINT64_MAX : 4096;
+            bool count_positive = parsed_count > 0 || (argument != "--bench-size" && argument != "--bench-repetitions");
+            if (*count_text == '\0' || *parse_end != '\0' || errno == ERANGE || parsed_count > count_limit ||
+                !count_positive) {
+                error_description = "invalid count '" + string(count_text) + "' for " + string(argument);
+                return false;
+            }
+            if (argument == "--threads") {
+                command_line_options.analysis_thread_count = static_cast<unsigned>(parsed_count);
+            } else if (argument == "--requests") {
+                command_line_options.load_test_request_count = parsed_count;
+            } else if (argument == "--cache-entries") {
+                command_line_options.cache_entry_limit = static_cast<size_t>(parsed_count);
+            } else if (argument == "--cache-disk-mb") {
+                command_line_options.cache_disk_megabytes = parsed_count;
+            } else if (argument == "--bench-size") {
+                command_line_options.benchmark_corpus_megabytes = parsed_count;
+            } else if (argument == "--bench-seed") {
+                command_line_options.benchmark_seed = parsed_count;
+            } else if (argument == "--bench-repetitions") {
+                command_line_options.benchmark_repetitions = static_cast<unsigned>(parsed_count);
+            } else {
+                command_line_options.load_test_concurrency = static_cast<unsigned>(parsed_count);
+            }
+        } else if (argument == "--serve" || argument == "--client" || argument == "--load-test") {
+            command_line_options.command_line_mode = argument == "--serve"    ? CommandLineMode::Serve
+                                                     : argument == "--client" ? CommandLineMode::Client
+                                                                              : CommandLineMode::LoadTest;
+            command_line_options.socket_path = argument_values[++argument_index];
+        } else if (argument == "--metrics") {
+            string_view metric_list = argument_values[++argument_index];
+            size_t metric_start = 0;
+            while (metric_start <= metric_list.size()) {
+                size_t metric_end = min(metric_list.find(',', metric_start), metric_list.size());
+                if (metric_end > metric_start) {
+                    command_line_options.selected_metrics.emplace_back(metric_list.substr(metric_start, metric_end - metric_start));
+                }
+                metric_start = metric_end + 1;
+            }
+        } else if (argument == "-") {
+            command_line_options.read_standard_input = true;
+        } else if (argument.size() > 1 && argument[0] == '-') {
+            error_description = "unknown option '" + string(argument) + "'";
+            return false;
+        } else {
+            command_line_options.input_paths.emplace_back(argument);
+        }
+    }
+
+    if (command_line_options.command_line_mode == CommandLineMode::BuildThesaurus && command_line_options.input_paths.empty()) {
+        error_description = "--build-thesaurus requires at least one SOURCE file";
+        return false;
+    }
+    if (command_line_options.input_paths.empty()) {
+        command_line_options.read_standard_input = true;
+    }
+
+    if (!command_line_options.selected_metrics.empty()) {
+        if (command_line_options.output_format == ReportOutputFormat::Text) {
+            error_description = "--metrics requires --format json, ndjson or csv";
+            return false;
+        }
+        vector<string> known_field_names = structured_report_field_names();
+        for (const string& metric_name : command_line_options.selected_metrics) {
+            if (find(known_field_names.begin(), known_field_names.end(), metric_name) == known_field_names.end()) {
+                error_description = "unknown metric '" + metric_name + "' (see --help)";
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/*
+ * Build the result cache requested on the command line
+ * Returns null when both the memory and the disk tier are disabled
+ */
+unique_ptr<AnalysisResultCache> create_command_line_cache(const CommandLineOptions& command_line_options) {
+    if (command_line_options.cache_entry_limit == 0 && command_line_options.cache_directory.empty()) {
+        return nullptr;
+    }
+    return make_unique<AnalysisResultCache>(command_line_options.cache_entry_limit, command_line_options.cache_directory,
+                                            command_line_options.cache_disk_megabytes * 1024 * 1024);
+}
+
+/*
+ * This function compiles thesaurus sources into the binary thesaurus file
+ * The file is then opened like any other, so the summary describes what
+ * later runs will map
+ */
+int run_thesaurus_build(const CommandLineOptions& command_line_options) {
+    auto build_start = chrono::steady_clock::now();
+    string error_description;
+    SynonymThesaurus built_thesaurus;
+    if (!build_thesaurus_file(command_line_options.input_paths, command_line_options.thesaurus_path, error_description)) {
+        cerr << "thesaurus build: " << error_description << endl;
+        return 1;
+    }
+    if (!built_thesaurus.open_thesaurus(command_line_options.thesaurus_path)) {
+        cerr << "thesaurus build: " << built_thesaurus.last_error() << endl;
+        return 1;
+    }
+    double elapsed_seconds = chrono::duration<double>(chrono::steady_clock::now() - build_start).count();
+    cout << "Thesaurus: " << built_thesaurus.headword_count() << " headwords written to " << command_line_options.thesaurus_path
+         << " in " << fixed << setprecision(2) << elapsed_seconds << " s" << endl;
+    return 0;
+}
+
+/*
+ * Read all of standard input into one passage
+ */
+string read_standard_input_passage() {
+    TEXT_ANALYSER_STAGE_SCOPE(input_stage, PipelineStage::Input);
+    string passage_text;
+    char read_buffer[64 * 1024];
+    size_t read_byte_count;
+    while ((read_byte_count = fread(read_buffer, 1, sizeof(read_buffer), stdin)) > 0) {
+        passage_text.append(read_buffer, read_byte_count);
+    }
+    TEXT_ANALYSER_STAGE_BYTES(input_stage, passage_text.size());
+    return passage_text;
+}
+
+/*
+ * This function runs one non-interactive analysis described by the command line
+ * File inputs go through the batch engine, standard input through the
+ * parallel passage engine, or with --stream every input through the
+ * streaming analyzer; the whole report is written in one call.
+ * Returns the process exit status: 0 when every input was analyzed,
+ * 1 when any input was skipped and 2 for unusable arguments
+ */
+int run_command_line_analysis(int argument_count, char* argument_values[]) {
+    CommandLineOptions command_line_options;
+    string error_description;
+    if (!parse_command_line_options(argument_count, argument_values, command_line_options, error_description)) {
+        cerr << argument_values[0] << ": " << error_description << endl;
+        return 2;
+    }
+    if (command_line_options.show_help) {
+        display_command_line_usage(argument_values[0]);
+        return 0;
+    }
+    if (command_line_options.command_line_mode == CommandLineMode::BuildThesaurus) {
+        return run_thesaurus_build(command_line_options);
+    }
+
+    // A named thesaurus must open; the default one is used only when present
+    if (command_line_options.thesaurus_path.empty()) {
+        application_synonym_thesaurus().open_thesaurus(DEFAULT_THESAURUS_PATH);
+    } else if (!application_synonym_thesaurus().open_thesaurus(command_line_options.thesaurus_path)) {
+        cerr << argument_values[0] << ": " << application_synonym_thesaurus().last_error() << endl;
+        return 2;
+    }
+    if (command_line_options.style_rules_path.empty()) {
+        application_style_linter().load_rule_file(DEFAULT_STYLE_RULES_PATH, error_description);
+    } else if (!application_style_linter().load_rule_file(command_line_options.style_rules_path, error_description)) {
+        cerr << argument_values[0] << ": " << error_description << endl;
+        return 2;
+    }
+
+    if (command_line_options.command_line_mode == CommandLineMode::Serve) {
+        return run_analysis_daemon(command_line_options);
+    } else if (command_line_options.command_line_mode == CommandLineMode::Client) {
+        return run_analysis_client(command_line_options);
+    } else if (command_line_options.command_line_mode == CommandLineMode::LoadTest) {
+        return run_analysis_load_test(command_line_options);
+    } else if (command_line_options.command_line_mode == CommandLineMode::Benchmark) {
+        return run_benchmark_suite(command_line_options);
+    }
+
+    if (command_line_options.show_banners) {
+        display_application_header();
+    }
+#if TEXT_ANALYSER_INSTRUMENTATION
+    if (command_line_options.show_pipeline_statistics) {
+        enable_pipeline_instrumentation();
+    }
+#endif
+
+    // Expand directories into individual document paths
+    vector<string> document_paths;
+    if (!expand_command_line_inputs(command_line_options.input_paths, document_paths, error_description)) {
+        cerr << argument_values[0] << ": " << error_description << endl;
+        return 2;
+    }
+
+    unique_ptr<AnalysisResultCache> result_cache = create_command_line_cache(command_line_options);
+    auto analysis_start = chrono::steady_clock::now();
+    vector<DocumentAnalysisResult> document_results;
+    if (command_line_options.stream_inputs) {
+        // Streamed inputs are never held whole, so they bypass the batch engine and the cache
+        for (const string& document_path : document_paths) {
+            document_results.push_back(analyze_document_stream(document_path, &application_style_linter()));
+        }
+        if (command_line_options.read_standard_input) {
+            document_results.push_back(analyze_document_stream("-", &application_style_linter()));
+        }
+    } else if (!document_paths.empty()) {
+        document_results = analyze_document_corpus(document_paths, command_line_options.analysis_thread_count, result_cache.get(),
+                                                   console_progress_renderer(), &application_style_linter());
+    }
+    if (command_line_options.read_standard_input && !command_line_options.stream_inputs) {
+        string standard_input_passage = read_standard_input_passage();
+        DocumentAnalysisResult standard_input_result;
+        standard_input_result.document_path = "-";
+        standard_input_result.document_bytes = standard_input_passage.size();
+        standard_input_result.passage_metrics =
+            analyze_passage_through_cache(standard_input_passage, result_cache.get(), command_line_options.analysis_thread_count,
+                                          &application_style_linter(), &standard_input_result.style_report);
+        standard_input_result.analysis_succeeded = true;
+        document_results.push_back(move(standard_input_result));
+    }
+    double elapsed_seconds = chrono::duration<double>(chrono::steady_clock::now() - analysis_start).count();
+
+    ReportWriter& report_writer = console_report_writer();
+    if (command_line_options.output_format != ReportOutputFormat::Text) {
+        render_structured_document_report(report_writer.buffer(), command_line_options.output_format, document_results,
+                                          elapsed_seconds, command_line_options.selected_metrics,
+                                          command_line_options.show_pipeline_statistics);
+    } else if (document_results.size() == 1 && document_results[0].analysis_succeeded) {
+        render_passage_analysis_report(report_writer.stream(), build_analysis_result(document_results[0].passage_metrics,
+                                                                                     &application_synonym_thesaurus(),
+                                                                                     document_results[0].style_report));
+    } else {
+        render_corpus_analysis_results(report_writer.stream(), document_results, elapsed_seconds);
+    }
+    report_writer.write_to_standard_output();
+
+    if (command_line_options.show_cache_statistics && result_cache != nullptr) {
+        display_analysis_cache_statistics(*result_cache);
+    }
+#if TEXT_ANALYSER_INSTRUMENTATION
+    if (command_line_options.show_pipeline_statistics) {
+        display_pipeline_statistics();
+    }
+#endif
+    if (command_line_options.show_banners) {
+        display_termination_banner();
+    }
+
+    bool every_input_analyzed = all_of(document_results.begin(), document_results.end(),
+                                       [](const DocumentAnalysisResult& document_result) {
+                                           return document_result.analysis_succeeded;
+                                       });
+    if (!every_input_analyzed && document_results.size() == 1) {
+        cerr << argument_values[0] << ": " << document_results[0].document_path << ": "
+             << document_results[0].error_description << endl;
+    }
+    return every_input_analyzed ? 0 : 1;
+}
+
+/*
+ * Expand command-line inputs into document paths
+ * Directories contribute the regular files they contain; anything else is
+ * passed through and reported later if it cannot be opened
+ */
+bool expand_command_line_inputs(const vector<string>& input_paths, vector<string>& document_paths, string& error_description) {
+    for (const string& input_path : input_paths) {
+        error_code status_error;
+        if (filesystem::is_directory(input_path, status_error)) {
+            if (!collect_corpus_document_paths(input_path, document_paths, error_description)) {
+                return false;
+            }
+        } else {
+            document_paths.push_back(input_path);
+        }
+    }
+    return true;
+}
+
+#if TEXT_ANALYSER_UNIX_SOCKETS
+
+// Set by SIGINT or SIGTERM to stop the analysis daemon's accept loop
+static volatile sig_atomic_t analysis_daemon_stop_requested = 0;
+
+static void request_analysis_daemon_stop(int) {
+    analysis_daemon_stop_requested = 1;
+}
+
+/*
+ * Read exactly byte_count bytes, retrying interrupted and partial reads
+ * Returns false on end of stream or error
+ */
+bool read_socket_bytes(int socket_descriptor, char* destination, size_t byte_count) {
+    while (byte_count > 0) {
+        ssize_t read_result = ::read(socket_descriptor, destination, byte_count);
+        if (read_result < 0 && errno == EINTR) {
+            continue;
+        }
+        if (read_result <= 0) {
+            return false;
+        }
+        destination += read_result;
+        byte_count -= static_cast<size_t>(read_result);
+    }
+    return true;
+}
+
+/*
+ * Send one frame; the header and payload go out in a single writev call
+ * whenever the socket accepts them whole
+ */
+bool write_analysis_frame(int socket_descriptor, uint8_t frame_code, string_view frame_payload) {
+    unsigned char frame_header[ANALYSIS_FRAME_HEADER_BYTES];
+    uint32_t payload_length = static_cast<uint32_t>(frame_payload.size());
+    frame_header[0] = frame_code;
+    frame_header[1] = static_cast<unsigned char>(payload_length >> 24);
+    frame_header[2] = static_cast<unsigned char>(payload_length >> 16);
+    frame_header[3] = static_cast<unsigned char>(payload_length >> 8);
+    frame_header[4] = static_cast<unsigned char>(payload_length);
+
+    iovec frame_parts[2];
+    frame_parts[0].iov_base = frame_header;
+    frame_parts[0].iov_len = sizeof(frame_header);
+    frame_parts[1].iov_base = const_cast<char*>(frame_payload.data());
+    frame_parts[1].iov_len = frame_payload.size();
+
+    iovec* pending_parts = frame_parts;
+    int pending_part_count = 2;
+    while (pending_part_count > 0) {
+        ssize_t write_result = ::writev(socket_descriptor, pending_parts, pending_part_count);
+        if (write_result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+
+        // Skip the parts written completely and trim a partially written one
+        size_t written_bytes = static_cast<size_t>(write_result);
+        while (pending_part_count > 0 && written_bytes >= pending_parts->iov_len) {
+            written_bytes -= pending_parts->iov_len;
+            pending_parts++;
+            pending_part_count--;
+        }
+        if (pending_part_count > 0) {
+            pending_parts->iov_base = static_cast<char*>(pending_parts->iov_base) + written_bytes;
+            pending_parts->iov_len -= written_bytes;
+        }
+    }
+    return true;
+}
+
+/*
+ * Receive one frame into a reusable payload string
+ * Returns false when the peer disconnects, leaving error_description
+ * empty. Frames announcing more than ANALYSIS_FRAME_PAYLOAD_LIMIT bytes are
+ * rejected with a description, since the stream cannot be resynchronized
+ */
+bool read_analysis_frame(int socket_descriptor, uint8_t& frame_code, string& frame_payload, string& error_description) {
+    unsigned char frame_header[ANALYSIS_FRAME_HEADER_BYTES];
+    error_description.clear();
+    if (!read_socket_bytes(socket_descriptor, reinterpret_cast<char*>(frame_header), sizeof(frame_header))) {
+        return false;
+    }
+
+    frame_code = frame_header[0];
+    uint32_t payload_length = (static_cast<uint32_t>(frame_header[1]) << 24) | (static_cast<uint32_t>(frame_header[2]) << 16) |
+                              (static_cast<uint32_t>(frame_header[3]) << 8) | static_cast<uint32_t>(frame_header[4]);
+    if (payload_length > ANALYSIS_FRAME_PAYLOAD_LIMIT) {
+        error_description = "frame of " + to_string(payload_length) + " bytes exceeds the " +
+                            to_string(ANALYSIS_FRAME_PAYLOAD_LIMIT) + " byte limit";
+        return false;
+    }
+
+    frame_payload.resize(payload_length);
+    if (!read_socket_bytes(socket_descriptor, &frame_payload[0], payload_length)) {
+        return false;
+    }
+    return true;
+}
+
+/*
+ * Fill a Unix socket address, checking the path fits in sun_path
+ */
+bool prepare_analysis_socket_address(const string& socket_path, sockaddr_un& socket_address, string& error_description) {
+    memset(&socket_address, 0, sizeof(socket_address));
+    socket_address.sun_family = AF_UNIX;
+    if (socket_path.empty() || socket_path.size() >= sizeof(socket_address.sun_path)) {
+        error_description = "socket path must be between 1 and " + to_string(sizeof(socket_address.sun_path) - 1) + " bytes";
+        return false;
+    }
+    memcpy(socket_address.sun_path, socket_path.c_str(), socket_path.size() + 1);
+    return true;
+}
+
+/*
+ * Open a client connection to a running analysis daemon
+ * Returns -1 with a description when the daemon cannot be reached
+ */
+int connect_analysis_socket(const string& socket_path, string& error_description) {
+    sockaddr_un socket_address;
+    if (!prepare_analysis_socket_address(socket_path, socket_address, error_description)) {
+        return -1;
+    }
+
+    int socket_descriptor = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (socket_descriptor < 0) {
+        error_description = "cannot create socket: " + string(strerror(errno));
+        return -1;
+    }
+    if (connect(socket_descriptor, reinterpret_cast<sockaddr*>(&socket_address), sizeof(socket_address)) != 0) {
+        error_description = "cannot connect to " + socket_path + ": " + strerror(errno);
+        close(socket_descriptor);
+        return -1;
+    }
+    return socket_descriptor;
+}
+
+/*
+ * Answer one request frame of a daemon connection that poll found readable
+ * The passage is answered from the result cache or analyzed on this pool
+ * worker, and the report comes back in the format named by the frame code.
+ * Returns false when the connection should be closed: the client left,
+ * sent an oversized frame or stalled mid-frame past the socket timeout
+ */
+bool serve_analysis_request(int connection_descriptor, atomic<uint64_t>& served_request_count,
+                            AnalysisResultCache* result_cache) {
+    // The buffers belong to the worker thread, so their capacity outlives each request
+    thread_local ReportWriter report_writer;
+    thread_local vector<DocumentAnalysisResult> request_results(1);
+    thread_local string request_payload;
+    string error_description;
+    uint8_t frame_code = 0;
+
+    if (!read_analysis_frame(connection_descriptor, frame_code, request_payload, error_description)) {
+        // An oversized frame leaves the stream unusable, so explain before closing
+        if (!error_description.empty()) {
+            write_analysis_frame(connection_descriptor, ANALYSIS_RESPONSE_ERROR, error_description);
+        }
+        return false;
+    }
+    if (frame_code > static_cast<uint8_t>(ReportOutputFormat::CSV)) {
+        return write_analysis_frame(connection_descriptor, ANALYSIS_RESPONSE_ERROR, "unknown output format code");
+    }
+    ReportOutputFormat output_format = static_cast<ReportOutputFormat>(frame_code);
+
+    auto analysis_start = chrono::steady_clock::now();
+    DocumentAnalysisResult& request_result = request_results[0];
+    request_result.document_path = "-";
+    request_result.document_bytes = request_payload.size();
+    request_result.passage_metrics =
+        analyze_passage_through_cache(request_payload, result_cache, 1, &application_style_linter(), &request_result.style_report);
+    request_result.analysis_succeeded = true;
+    double elapsed_seconds = chrono::duration<double>(chrono::steady_clock::now() - analysis_start).count();
+
+    if (output_format == ReportOutputFormat::Text) {
+        render_passage_analysis_report(report_writer.stream(),
+                                       build_analysis_result(request_result.passage_metrics, &application_synonym_thesaurus(),
+                                                             request_result.style_report));
+    } else {
+        render_structured_document_report(report_writer.buffer(), output_format, request_results, elapsed_seconds);
+    }
+    bool response_sent = write_analysis_frame(connection_descriptor, ANALYSIS_RESPONSE_OK, report_writer.contents());
+    report_writer.clear();
+    if (response_sent) {
+        served_request_count.fetch_add(1, memory_order_relaxed);
+    }
+    return response_sent;
+}
+
+/*
+ * This function runs the persistent analysis daemon
+ * The main thread polls the listening socket and every idle connection.
+ * Each request frame that arrives becomes one task on the work-stealing
+ * pool, and the connection rejoins the poll set once it is answered, so
+ * idle clients hold no worker. A client stalling mid-frame is dropped after
+ * ANALYSIS_FRAME_TIMEOUT_SECONDS, and connections beyond
+ * ANALYSIS_CONNECTION_LIMIT are refused with an error frame. SIGINT or
+ * SIGTERM stops accepting, closes open connections and removes the socket file
+ */
+int run_analysis_daemon(const CommandLineOptions& command_line_options) {
+    const string& socket_path = command_line_options.socket_path;
+    string error_description;
+    sockaddr_un socket_address;
+    if (!prepare_analysis_socket_address(socket_path, socket_address, error_description)) {
+        cerr << "analysis daemon: " << error_description << endl;
+        return 2;
+    }
+
+    // Workers hand answered connections back and write a byte to the wake pair to interrupt poll
+    int listening_descriptor = socket(AF_UNIX, SOCK_STREAM, 0);
+    int wake_descriptors[2] = {-1, -1};
+    if (listening_descriptor < 0 || socketpair(AF_UNIX, SOCK_STREAM, 0, wake_descriptors) != 0) {
+        cerr << "analysis daemon: cannot create socket: " << strerror(errno) << endl;
+        if (listening_descriptor >= 0) {
+            close(listening_descriptor);
+        }
+        return 1;
+    }
+
+    // A socket file left behind by an earlier daemon would make bind fail
+    struct stat existing_file;
+    if (lstat(socket_path.c_str(), &existing_file) == 0 && S_ISSOCK(existing_file.st_mode)) {
+        unlink(socket_path.c_str());
+    }
+    if (bind(listening_descriptor, reinterpret_cast<sockaddr*>(&socket_address), sizeof(socket_address)) != 0 ||
+        listen(listening_descriptor, SOMAXCONN) != 0) {
+        cerr << "analysis daemon: cannot listen on " << socket_path << ": " << strerror(errno) << endl;
+        close(listening_descriptor);
+        close(wake_descriptors[0]);
+        close(wake_descriptors[1]);
+        return 1;
+    }
+
+    // Workers start with the stop signals blocked so only this thread sees them
+    sigset_t stop_signals;
+    sigemptyset(&stop_signals);
+    sigaddset(&stop_signals, SIGINT);
+    sigaddset(&stop_signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &stop_signals, nullptr);
+
+    unsigned analysis_thread_count = resolve_analysis_thread_count(command_line_options.analysis_thread_count);
+    unique_ptr<AnalysisResultCache> result_cache = create_command_line_cache(command_line_options);
+    atomic<uint64_t> served_request_count{0};
+    mutex connection_mutex;
+    vector<int> open_connections;
+    vector<int> answered_connections;
+    int wake_descriptor = wake_descriptors[1];
+
+    // The listening socket and the wake pair come first, then the idle connections
+    vector<pollfd> poll_entries = {{listening_descriptor, POLLIN, 0}, {wake_descriptors[0], POLLIN, 0}};
+    const size_t FIRST_CONNECTION_POLL_INDEX = 2;
+    {
+        WorkStealingThreadPool request_pool(analysis_thread_count);
+        pthread_sigmask(SIG_UNBLOCK, &stop_signals, nullptr);
+
+        struct sigaction stop_action;
+        memset(&stop_action, 0, sizeof(stop_action));
+        stop_action.sa_handler = request_analysis_daemon_stop;
+        sigaction(SIGINT, &stop_action, nullptr);
+        sigaction(SIGTERM, &stop_action, nullptr);
+        signal(SIGPIPE, SIG_IGN);
+
+        cerr << "Analysis daemon listening on " << socket_path << " with " << analysis_thread_count << " workers" << endl;
+
+        while (!analysis_daemon_stop_requested) {
+            // Wake up periodically so a stop signal is noticed even without EINTR
+            int poll_result = poll(poll_entries.data(), poll_entries.size(), 250);
+            if (poll_result <= 0) {
+                continue;
+            }
+
+            // Readable or closed connections leave the poll set until their request is answered
+            size_t kept_entry_count = FIRST_CONNECTION_POLL_INDEX;
+            for (size_t entry_index = FIRST_CONNECTION_POLL_INDEX; entry_index < poll_entries.size(); entry_index++) {
+                if (poll_entries[entry_index].revents == 0) {
+                    poll_entries[kept_entry_count++] = poll_entries[entry_index];
+                    continue;
+                }
+                int connection_descriptor = poll_entries[entry_index].fd;
+                AnalysisResultCache* request_cache = result_cache.get();
+                request_pool.submit([connection_descriptor, wake_descriptor, request_cache, &served_request_count,
+                                     &connection_mutex, &open_connections, &answered_connections] {
+                    bool connection_usable = serve_analysis_request(connection_descriptor, served_request_count, request_cache);
+                    lock_guard<mutex> connection_lock(connection_mutex);
+                    if (connection_usable) {
+                        answered_connections.push_back(connection_descriptor);
+                        send(wake_descriptor, "", 1, MSG_DONTWAIT);
+                    } else {
+                        open_connections.erase(find(open_connections.begin(), open_connections.end(), connection_descriptor));
+                        close(connection_descriptor);
+                    }
+                });
+            }
+            poll_entries.resize(kept_entry_count);
+
+            if (poll_entries[0].revents & POLLIN) {
+                int connection_descriptor = accept(listening_descriptor, nullptr, nullptr);
+                if (connection_descriptor >= 0) {
+                    lock_guard<mutex> connection_lock(connection_mutex);
+                    if (open_connections.size() >= ANALYSIS_CONNECTION_LIMIT) {
+                        write_analysis_frame(connection_descriptor, ANALYSIS_RESPONSE_ERROR,
+                                             "daemon is at its limit of " + to_string(ANALYSIS_CONNECTION_LIMIT) + " connections");
+                        close(connection_descriptor);
+                    } else {
+                        // A client stalling mid-frame would otherwise hold its worker indefinitely
+                        timeval frame_timeout = {ANALYSIS_FRAME_TIMEOUT_SECONDS, 0};
+                        setsockopt(connection_descriptor, SOL_SOCKET, SO_RCVTIMEO, &frame_timeout, sizeof(frame_timeout));
+                        setsockopt(connection_descriptor, SOL_SOCKET, SO_SNDTIMEO, &frame_timeout, sizeof(frame_timeout));
+                        open_connections.push_back(connection_descriptor);
+                        poll_entries.push_back({connection_descriptor, POLLIN, 0});
+                    }
+                }
+            }
+
+            if (poll_entries[1].revents & POLLIN) {
+                char wake_bytes[256];
+                while (recv(wake_descriptors[0], wake_bytes, sizeof(wake_bytes), MSG_DONTWAIT) > 0) {
+                }
+                lock_guard<mutex> connection_lock(connection_mutex);
+                for (int connection_descriptor : answered_connections) {
+                    poll_entries.push_back({connection_descriptor, POLLIN, 0});
+                }
+                answered_connections.clear();
+            }
+        }
+
+        // Wake workers blocked mid-frame, let them finish, then close the idle connections
+        {
+            lock_guard<mutex> connection_lock(connection_mutex);
+            for (int connection_descriptor : open_connections) {
+                shutdown(connection_descriptor, SHUT_RDWR);
+            }
+        }
+        request_pool.wait_until_idle();
+        for (int connection_descriptor : open_connections) {
+            close(connection_descriptor);
+        }
+    }
+
+    close(listening_descriptor);
+    close(wake_descriptors[0]);
+    close(wake_descriptors[1]);
+    unlink(socket_path.c_str());
+    cerr << "Analysis daemon stopped after " << served_request_count.load() << " requests" << endl;
+    if (command_line_options.show_cache_statistics && result_cache != nullptr) {
+        display_analysis_cache_statistics(*result_cache);
+    }
+    return 0;
+}
+
+/*
+ * This function sends documents to a running daemon and prints the reports
+ * Every input travels over one connection; the replies are gathered into
+ * the console report writer and written out together
+ */
+int run_analysis_client(const CommandLineOptions& command_line_options) {
+    string error_description;
+    vector<string> document_paths;
+    if (!expand_command_line_inputs(command_line_options.input_paths, document_paths, error_description)) {
+        cerr << "analysis client: " << error_description << endl;
+        return 2;
+    }
+
+    int socket_descriptor = connect_analysis_socket(command_line_options.socket_path, error_description);
+    if (socket_descriptor < 0) {
+        cerr << "analysis client: " << error_description << endl;
+        return 1;
+    }
+    signal(SIGPIPE, SIG_IGN);
+
+    ReportWriter& report_writer = console_report_writer();
+    uint8_t request_code = static_cast<uint8_t>(command_line_options.output_format);
+    string response_payload;
+    uint8_t response_code = 0;
+    bool every_input_analyzed = true;
+
+    // Standard input is sent last, matching the order of the local command line mode
+    size_t request_count = document_paths.size() + (command_line_options.read_standard_input ? 1 : 0);
+    string standard_input_passage;
+    for (size_t request_index = 0; request_index < request_count; request_index++) {
+        MappedTextFile document_file;
+        string_view request_passage;
+        if (request_index < document_paths.size()) {
+            if (!document_file.open_document(document_paths[request_index], false)) {
+                cerr << "analysis client: " << document_file.last_error() << endl;
+                every_input_analyzed = false;
+                continue;
+            }
+            request_passage = document_file.contents();
+        } else {
+            standard_input_passage = read_standard_input_passage();
+            request_passage = standard_input_passage;
+        }
+
+        if (!write_analysis_frame(socket_descriptor, request_code, request_passage) ||
+            !read_analysis_frame(socket_descriptor, response_code, response_payload, error_description)) {
+            cerr << "analysis client: daemon connection failed" << endl;
+            close(socket_descriptor);
+            report_writer.write_to_standard_output();
+            return 1;
+        }
+        if (response_code != ANALYSIS_RESPONSE_OK) {
+            cerr << "analysis client: daemon error: " << response_payload << endl;
+            every_input_analyzed = false;
+            continue;
+        }
+        report_writer.buffer().append(response_payload);
+    }
+
+    close(socket_descriptor);
+    report_writer.write_to_standard_output();
+    return every_input_analyzed ? 0 : 1;
+}
+
+/*
+ * This function measures daemon latency and throughput under load
+ * Each concurrent connection sends the passage back to back until the
+ * shared request budget is spent; latencies are merged for percentiles.
+ * Unless --repeat-payload is given, a request number is appended to every
+ * payload so each one misses the daemon's result cache and is analyzed
+ */
+int run_analysis_load_test(const CommandLineOptions& command_line_options) {
+    // The first input document is the request payload, or the sample passage
+    string request_passage = SAMPLE_DEMONSTRATION_PASSAGE;
+    if (!command_line_options.input_paths.empty()) {
+        MappedTextFile payload_file;
+        if (!payload_file.open_document(command_line_options.input_paths[0], false)) {
+            cerr << "load test: " << payload_file.last_error() << endl;
+            return 1;
+        }
+        request_passage.assign(payload_file.contents());
+    }
+    signal(SIGPIPE, SIG_IGN);
+
+    uint64_t total_request_count = command_line_options.load_test_request_count;
+    unsigned connection_count = max(1u, command_line_options.load_test_concurrency);
+    uint8_t request_code = static_cast<uint8_t>(command_line_options.output_format);
+    atomic<uint64_t> next_request_index{0};
+    atomic<uint64_t> failed_request_count{0};
+    vector<vector<double>> connection_latencies(connection_count);
+    vector<string> connection_errors(connection_count);
+
+    auto load_test_start = chrono::steady_clock::now();
+    vector<thread> connection_threads;
+    for (unsigned connection_index = 0; connection_index < connection_count; connection_index++) {
+        connection_threads.emplace_back([&, connection_index] {
+            string& error_description = connection_errors[connection_index];
+            int socket_descriptor = connect_analysis_socket(command_line_options.socket_path, error_description);
+            if (socket_descriptor < 0) {
+                return;
+            }
+
+            string response_payload;
+            string request_payload = request_passage;
+            uint8_t response_code = 0;
+            vector<double>& request_latencies = connection_latencies[connection_index];
+            uint64_t request_index;
+            while ((request_index = next_request_index.fetch_add(1, memory_order_relaxed)) < total_request_count) {
+                if (!command_line_options.load_test_repeat_payload) {
+                    request_payload.resize(request_passage.size());
+                    request_payload.append("\n").append(to_string(request_index));
+                }
+                auto request_start = chrono::steady_clock::now();
+                if (!write_analysis_frame(socket_descriptor, request_code, request_payload) ||
+                    !read_analysis_frame(socket_descriptor, response_code, response_payload, error_description)) {
+                    failed_request_count.fetch_add(1, memory_order_relaxed);
+                    break;
+                }
+                request_latencies.push_back(chrono::duration<double, milli>(chrono::steady_clock::now() - request_start).count());
+                if (response_code != ANALYSIS_RESPONSE_OK) {
+                    failed_request_count.fetch_add(1, memory_order_relaxed);
+                }
+            }
+            close(socket_descriptor);
+        });
+    }
+    for (thread& connection_thread : connection_threads) {
+        connection_thread.join();
+    }
+    double elapsed_seconds = chrono::duration<double>(chrono::steady_clock::now() - load_test_start).count();
+
+    vector<double> request_latencies;
+    for (const vector<double>& latencies : connection_latencies) {
+        request_latencies.insert(request_latencies.end(), latencies.begin(), latencies.end());
+    }
+    for (const string& connection_error : connection_errors) {
+        if (!connection_error.empty()) {
+            cerr << "load test: " << connection_error << endl;
+            break;
+        }
+    }
+    if (request_latencies.empty()) {
+        cerr << "load test: no requests completed" << endl;
+        return 1;
+    }
+    sort(request_latencies.begin(), request_latencies.end());
+
+    // Nearest-rank percentile over the sorted latencies
+    auto latency_percentile = [&request_latencies](double percentile) {
+        size_t rank = static_cast<size_t>(ceil(percentile / 100.0 * request_latencies.size()));
+        return request_latencies[min(request_latencies.size(), max<size_t>(rank, 1)) - 1];
+    };
+    double latency_total = 0.0;
+    for (double latency : request_latencies) {
+        latency_total += latency;
+    }
+
+    ReportWriter& report_writer = console_report_writer();
+    ostream& report_stream = report_writer.stream();
+    report_stream << "\nDAEMON LOAD TEST RESULTS:\n";
+    report_stream << string(35, '-') << '\n';
+    report_stream << "Requests Completed: " << request_latencies.size() << " of " << total_request_count
+                  << " (" << failed_request_count.load() << " failed)\n";
+    report_stream << "Concurrent Connections: " << connection_count << '\n';
+    report_stream << "Payload Size: " << request_passage.size() << " bytes"
+                  << (command_line_options.load_test_repeat_payload ? " (repeated: daemon cache hits after the first request)\n"
+                                                                    : " (numbered per request: every request a cache miss)\n");
+    report_stream << fixed << setprecision(1);
+    report_stream << "Throughput: " << request_latencies.size() / elapsed_seconds << " requests/s\n";
+    report_stream << setprecision(3);
+    report_stream << "Latency p50: " << latency_percentile(50.0) << " ms | p99: " << latency_percentile(99.0)
+                  << " ms | max: " << request_latencies.back() << " ms | mean: "
+                  << latency_total / request_latencies.size() << " ms\n";
+    report_writer.write_to_standard_output();
+    return failed_request_count.load() == 0 ? 0 : 1;
+}
+
+#else
+
+int run_analysis_daemon(const CommandLineOptions&) {
+    cerr << "analysis daemon: Unix domain sockets are not available on this platform" << endl;
+    return 2;
+}
+
+int run_analysis_client(const CommandLineOptions& command_line_options) {
+    return run_analysis_daemon(command_line_options);
+}
+
+int run_analysis_load_test(const CommandLineOptions& command_line_options) {
+    return run_analysis_daemon(command_line_options);
+}
+
+#endif
+
+/*
+ * This function orchestrates the complete language analysis workflow
+ * The implementation demonstrates professional software architecture patterns
+ * User interaction follows structured pedagogical methodology
+ */
+void execute_complete_analysis_workflow() {
+    cout << "ANALYSIS OPTIONS AVAILABLE:" << endl;
+    cout << "1. Analyze custom text passage (user input)" << endl;
+    cout << "2. Demonstrate with sample passage analysis" << endl;
+    cout << "3. Run performance benchmarks (tokenizer and parallel scaling)" << endl;
+    cout << "4. Analyze text document file (memory-mapped)" << endl;
+    cout << "5. Batch corpus analysis (directory or file list)" << endl;
+    cout << string(45, '-') << endl;
+    
+    int user_selection;
+    cout << "Please enter selection (1-5): ";
+    cin >> user_selection;
+    cin.ignore();  // Clear input buffer for string operations
+    
+    string target_passage;
+    
+    // Execute user-selected analysis mode
+    if (user_selection == 1) {
+        cout << "\nUSER INPUT MODE ACTIVATED" << endl;
+        target_passage = obtain_user_text_input();
+        
+        if (target_passage.empty()) {
+            cout << "ERROR: No input provided. Switching to demonstration mode." << endl;
+            demonstrate_sample_passage_analysis();
+            return;
+        }
+    } else if (user_selection == 3) {
+        cout << "\nBENCHMARK MODE ACTIVATED" << endl;
+        run_tokenizer_throughput_benchmark();
+        run_parallel_scaling_benchmark();
+        run_incremental_edit_benchmark();
+        return;
+    } else if (user_selection == 4) {
+        cout << "\nDOCUMENT FILE MODE ACTIVATED" << endl;
+        analyze_mapped_document_file();
+        return;
+    } else if (user_selection == 5) {
+        cout << "\nBATCH CORPUS MODE ACTIVATED" << endl;
+        analyze_document_corpus_interactively();
+        return;
+    } else {
+        cout << "\nDEMONSTRATION MODE ACTIVATED" << endl;
+        demonstrate_sample_passage_analysis();
+        return;
+    }
+    
+    execute_passage_analysis_pipeline(target_passage);
+}
+
+/*
+ * This function runs every analysis stage over a passage and reports results
+ * The passage is only viewed, never copied, so it may point into a mapped file
+ * A thread count of zero uses every hardware thread for large passages
+ */
+void execute_passage_analysis_pipeline(string_view target_passage, unsigned analysis_thread_count,
+                                       ReportOutputFormat output_format, const string& source_name) {
+    if (output_format == ReportOutputFormat::Text) {
+        cout << "\nINITIATING COMPREHENSIVE TEXT ANALYSIS..." << endl;
+    }
+    
+    // Compute every metric in one pass over the passage bytes, split across threads
+    auto analysis_start = chrono::steady_clock::now();
+    analysis_thread_count = resolve_analysis_thread_count(analysis_thread_count);
+    ProgressReporter progress_reporter(target_passage.size(), parallel_chunk_count(target_passage.size(), analysis_thread_count),
+                                       "chunks", console_progress_renderer());
+    PassageAnalysisAccumulator passage_metrics = analyze_passage_in_parallel(target_passage, analysis_thread_count, &progress_reporter);
+    progress_reporter.finish();
+    
+    ReportWriter& report_writer = console_report_writer();
+    if (output_format != ReportOutputFormat::Text) {
+        vector<DocumentAnalysisResult> document_results(1);
+        document_results[0].document_path = source_name;
+        document_results[0].document_bytes = target_passage.size();
+        document_results[0].analysis_succeeded = true;
+        document_results[0].passage_metrics = move(passage_metrics);
+        double elapsed_seconds = chrono::duration<double>(chrono::steady_clock::now() - analysis_start).count();
+        render_structured_document_report(report_writer.buffer(), output_format, document_results, elapsed_seconds);
+        report_writer.write_to_standard_output();
+        return;
+    }
+    
+    report_writer.stream() << "\nANALYSIS COMPLETE - Generating Professional Results...\n";
+    render_passage_analysis_report(report_writer.stream(),
+                                   build_analysis_result(move(passage_metrics), &application_synonym_thesaurus(),
+                                                         application_style_linter().lint_passage(target_passage)));
+    report_writer.write_to_standard_output();
+}
+
+/*
+ * This function is the original stringstream tokenizer, kept unchanged
+ * It serves as the baseline for the throughput benchmark. It only knows
+ * ASCII letters, so it agrees with the kernels on ASCII text alone
+ */
+vector<string> reference_extract_words_from_passage(const string& text_passage) {
+    vector<string> word_collection;
+    stringstream text_stream(text_passage);
+    string individual_word;
+    
+    // Process each word token from the input text stream
+    while (text_stream >> individual_word) {
+        // Remove punctuation marks for clean word analysis
+        string cleaned_word = "";
+        for (char character : individual_word) {
+            if (isalpha(static_cast<unsigned char>(character))) {
+                cleaned_word += tolower(static_cast<unsigned char>(character));  // Normalize to lowercase
+            }
+        }
+        
+        // Add valid words to the collection for statistical processing
+        if (!cleaned_word.empty() && cleaned_word.length() > 1) {
+            word_collection.push_back(cleaned_word);
+        }
+    }
+    
+    return word_collection;
+}
+
+/*
+ * This function assembles a reproducible benchmark corpus
+ * The sample passage is interleaved with punctuation, digits, control
+ * whitespace and non-ASCII bytes so every tokenizer branch is exercised
+ */
+string build_benchmark_corpus(size_t target_corpus_bytes) {
+    string edge_case_fragment = " Dr. O'Neil's e-mail (sent 3.14 times!)\tarrived;\r\nthe caf\xc3\xa9 r\xc3\xa9sum\xc3\xa9... A I x, well-known\v\f ";
+    string benchmark_corpus;
+    benchmark_corpus.reserve(target_corpus_bytes + sizeof(SAMPLE_DEMONSTRATION_PASSAGE) + edge_case_fragment.size());
+    while (benchmark_corpus.size() < target_corpus_bytes) {
+        benchmark_corpus += SAMPLE_DEMONSTRATION_PASSAGE;
+        benchmark_corpus += edge_case_fragment;
+    }
+    return benchmark_corpus;
+}
+
+/*
+ * This function measures tokenizer throughput for every available kernel
+ * The synthetic corpus is tokenized by the original stringstream
+ * implementation and by each kernel. Every kernel's output is checked
+ * word for word against the scalar loop, because the original drops the
+ * non-ASCII letters the corpus contains
+ */
+void run_tokenizer_throughput_benchmark() {
+    const size_t target_corpus_bytes = 32 * 1024 * 1024;
+    const int timed_repetitions = 3;
+
+    string benchmark_corpus = build_benchmark_corpus(target_corpus_bytes);
+    double corpus_gigabytes = static_cast<double>(benchmark_corpus.size()) / 1e9;
+
+    cout << "\nTOKENIZER THROUGHPUT BENCHMARK:" << endl;
+    cout << string(45, '-') << endl;
+    cout << "Corpus Size: " << benchmark_corpus.size() / (1024 * 1024) << " MB" << endl;
+    cout << "Active Kernel: " << tokenizer_kernel_name(active_tokenizer_kernel()) << endl;
+    cout << fixed << setprecision(2);
+
+    // Time the original implementation once; it is the speed baseline
+    auto reference_start = chrono::steady_clock::now();
+    vector<string> reference_words = reference_extract_words_from_passage(benchmark_corpus);
+    double reference_seconds = chrono::duration<double>(chrono::steady_clock::now() - reference_start).count();
+    cout << left << setw(12) << "Reference" << right << setw(8) << corpus_gigabytes / reference_seconds
+         << " GB/s  (" << reference_words.size() << " words)" << endl;
+    TokenizedPassage oracle_words = extract_words_with_kernel(benchmark_corpus, TokenizerKernel::Scalar);
+
+    // Time every kernel the CPU supports, keeping the best repetition
+    for (TokenizerKernel tokenizer_kernel : {TokenizerKernel::Scalar, TokenizerKernel::SSE2,
+                                             TokenizerKernel::AVX2, TokenizerKernel::AVX512}) {
+        if (!tokenizer_kernel_supported(tokenizer_kernel)) {
+            cout << left << setw(12) << tokenizer_kernel_name(tokenizer_kernel) << right
+                 << "     n/a  (not supported by this CPU)" << endl;
+            continue;
+        }
+
+        double best_seconds = 0.0;
+        TokenizedPassage kernel_words;
+        for (int repetition = 0; repetition < timed_repetitions; repetition++) {
+            auto kernel_start = chrono::steady_clock::now();
+            kernel_words = extract_words_with_kernel(benchmark_corpus, tokenizer_kernel);
+            double elapsed_seconds = chrono::duration<double>(chrono::steady_clock::now() - kernel_start).count();
+            if (repetition == 0 || elapsed_seconds < best_seconds) {
+                best_seconds = elapsed_seconds;
+            }
+        }
+
+        bool output_identical = kernel_words.size() == oracle_words.size();
+        for (size_t word_index = 0; output_identical && word_index < oracle_words.size(); word_index++) {
+            output_identical = kernel_words[word_index] == oracle_words[word_index];
+        }
+
+        cout << left << setw(12) << tokenizer_kernel_name(tokenizer_kernel) << right << setw(8)
+             << corpus_gigabytes / best_seconds << " GB/s  (" << setw(5) << reference_seconds / best_seconds
+             << "x reference, output " << (output_identical ? "identical" : "MISMATCH") << ")" << endl;
+    }
+
+    // Compare the span representation with the interned word ID stream
+    auto interning_start = chrono::steady_clock::now();
+    InternedTokenStream interned_words = intern_words_from_passage(benchmark_corpus);
+    double interning_seconds = chrono::duration<double>(chrono::steady_clock::now() - interning_start).count();
+    TokenizedPassage span_words = extract_words_from_passage(benchmark_corpus);
+
+    bool interned_identical = interned_words.size() == oracle_words.size();
+    for (size_t word_index = 0; interned_identical && word_index < oracle_words.size(); word_index++) {
+        interned_identical = interned_words.vocabulary.word(interned_words.word_ids[word_index]) == oracle_words[word_index];
+    }
+
+    cout << left << setw(12) << "Interned" << right << setw(8) << corpus_gigabytes / interning_seconds
+         << " GB/s  (" << interned_words.vocabulary.size() << " distinct words, output "
+         << (interned_identical ? "identical" : "MISMATCH") << ")" << endl;
+    cout << "Token Memory: spans " << span_words.memory_footprint_bytes() / 1e6 << " MB | interned IDs "
+         << interned_words.memory_footprint_bytes() / 1e6 << " MB" << endl;
+
+    // Text where most words carry accented letters exercises the UTF-8 decoder
+    const string accented_fragment = "Les élèves étudient la théorie; ÜBER größere Straßen! Αθήνα Москва. ";
+    string accented_corpus;
+    accented_corpus.reserve(target_corpus_bytes / 4 + accented_fragment.size());
+    while (accented_corpus.size() < target_corpus_bytes / 4) {
+        accented_corpus += accented_fragment;
+    }
+    TokenizedPassage accented_oracle = extract_words_with_kernel(accented_corpus, TokenizerKernel::Scalar);
+    auto accented_start = chrono::steady_clock::now();
+    TokenizedPassage accented_words = extract_words_from_passage(accented_corpus);
+    double accented_seconds = chrono::duration<double>(chrono::steady_clock::now() - accented_start).count();
+    bool accented_identical = accented_words.size() == accented_oracle.size();
+    for (size_t word_index = 0; accented_identical && word_index < accented_oracle.size(); word_index++) {
+        accented_identical = accented_words[word_index] == accented_oracle[word_index];
+    }
+    cout << left << setw(12) << "UTF-8 Text" << right << setw(8) << accented_corpus.size() / 1e9 / accented_seconds
+         << " GB/s  (" << accented_words.size() << " words, output " << (accented_identical ? "identical" : "MISMATCH")
+         << ")" << endl;
+}
+
+/*
+ * This function measures how the parallel engine scales from 1 to N threads
+ * Every thread count must reproduce the single-threaded metrics exactly,
+ * including the bit pattern of the complexity score
+ */
+void run_parallel_scaling_benchmark() {
+    const size_t target_corpus_bytes = 128 * 1024 * 1024;
+    const int timed_repetitions = 3;
+    unsigned hardware_thread_count = max(1u, thread::hardware_concurrency());
+
+    string benchmark_corpus = build_benchmark_corpus(target_corpus_bytes);
+    double corpus_gigabytes = static_cast<double>(benchmark_corpus.size()) / 1e9;
+    PassageAnalysisAccumulator reference_metrics = analyze_passage_in_single_pass(benchmark_corpus);
+
+    cout << "\nPARALLEL SCALING BENCHMARK:" << endl;
+    cout << string(45, '-') << endl;
+    cout << "Corpus Size: " << benchmark_corpus.size() / (1024 * 1024) << " MB" << endl;
+    cout << "Hardware Threads: " << hardware_thread_count << endl;
+    cout << fixed << setprecision(2);
+
+    double single_thread_seconds = 0.0;
+    for (unsigned analysis_thread_count = 1; analysis_thread_count <= hardware_thread_count; analysis_thread_count++) {
+        double best_seconds = 0.0;
+        PassageAnalysisAccumulator parallel_metrics;
+        for (int repetition = 0; repetition < timed_repetitions; repetition++) {
+            auto analysis_start = chrono::steady_clock::now();
+            parallel_metrics = analyze_passage_in_parallel(benchmark_corpus, analysis_thread_count);
+            double elapsed_seconds = chrono::duration<double>(chrono::steady_clock::now() - analysis_start).count();
+            if (repetition == 0 || elapsed_seconds < best_seconds) {
+                best_seconds = elapsed_seconds;
+            }
+        }
+        if (analysis_thread_count == 1) {
+            single_thread_seconds = best_seconds;
+        }
+
+        bool metrics_identical =
+            parallel_metrics.total_word_count == reference_metrics.total_word_count &&
+            parallel_metrics.total_character_count == reference_metrics.total_character_count &&
+            parallel_metrics.minimum_word_length == reference_metrics.minimum_word_length &&
+            parallel_metrics.maximum_word_length == reference_metrics.maximum_word_length &&
+            parallel_metrics.long_word_count == reference_metrics.long_word_count &&
+            parallel_metrics.advanced_vocabulary_count == reference_metrics.advanced_vocabulary_count &&
+            parallel_metrics.basic_vocabulary_count == reference_metrics.basic_vocabulary_count &&
+            parallel_metrics.syllable_count == reference_metrics.syllable_count &&
+            parallel_metrics.polysyllabic_word_count == reference_metrics.polysyllabic_word_count &&
+            memcmp(&parallel_metrics.complexity_accumulator, &reference_metrics.complexity_accumulator, sizeof(double)) == 0 &&
+            parallel_metrics.sentence_count == reference_metrics.sentence_count &&
+            parallel_metrics.sentence_word_lengths == reference_metrics.sentence_word_lengths &&
+            parallel_metrics.sentence_character_lengths == reference_metrics.sentence_character_lengths &&
+            parallel_metrics.comma_count == reference_metrics.comma_count &&
+            parallel_metrics.semicolon_count == reference_metrics.semicolon_count &&
+            parallel_metrics.basic_vocabulary_examples == reference_metrics.basic_vocabulary_examples &&
+            parallel_metrics.advanced_vocabulary_examples == reference_metrics.advanced_vocabulary_examples &&
+            parallel_metrics.distinct_word_count == reference_metrics.distinct_word_count &&
+            parallel_metrics.frequent_basic_words == reference_metrics.frequent_basic_words &&
+            parallel_metrics.frequent_advanced_words == reference_metrics.frequent_advanced_words;
+
+        cout << "Threads: " << setw(3) << analysis_thread_count << " | " << setw(6) << corpus_gigabytes / best_seconds
+             << " GB/s | Speedup: " << setw(5) << single_thread_seconds / best_seconds << "x | Metrics "
+             << (metrics_identical ? "identical" : "MISMATCH") << endl;
+    }
+}
+
+/*
+ * This function measures incremental re-analysis against full re-analysis
+ * A stream of small random edits is applied to a multi-megabyte document;
+ * the incremental metrics are then checked against a fresh full analysis
+ */
+void run_incremental_edit_benchmark() {
+    const size_t target_document_bytes = 4 * 1024 * 1024;
+    const int edit_count = 2000;
+    const string inserted_sentence = "Revised wording clarifies the argument considerably. ";
+
+    string initial_document = build_benchmark_corpus(target_document_bytes);
+    IncrementalPassageAnalyzer incremental_analyzer(initial_document);
+
+    // Deterministic edit positions so every run performs the same work
+    uint32_t edit_random_state = 12345;
+    auto next_edit_random = [&edit_random_state]() {
+        edit_random_state = edit_random_state * 1664525u + 1013904223u;
+        return edit_random_state >> 8;
+    };
+
+    uint64_t reanalyzed_bytes_total = 0;
+    auto incremental_start = chrono::steady_clock::now();
+    for (int edit_index = 0; edit_index < edit_count; edit_index++) {
+        size_t edit_offset = next_edit_random() % (incremental_analyzer.size() + 1);
+        if (edit_index % 2 == 0) {
+            incremental_analyzer.insert_text(edit_offset, inserted_sentence);
+        } else {
+            incremental_analyzer.erase_text(edit_offset, 1 + next_edit_random() % 40);
+        }
+        reanalyzed_bytes_total += incremental_analyzer.last_reanalyzed_bytes();
+    }
+    double incremental_seconds = chrono::duration<double>(chrono::steady_clock::now() - incremental_start).count();
+
+    string final_document = incremental_analyzer.text();
+    auto full_start = chrono::steady_clock::now();
+    PassageAnalysisAccumulator reference_metrics = analyze_passage_in_single_pass(final_document);
+    double full_seconds = chrono::duration<double>(chrono::steady_clock::now() - full_start).count();
+
+    // Counts must match exactly; the complexity sum only up to rounding order
+    const PassageAnalysisAccumulator& incremental_metrics = incremental_analyzer.passage_metrics();
+    bool metrics_identical =
+        incremental_metrics.total_word_count == reference_metrics.total_word_count &&
+        incremental_metrics.total_character_count == reference_metrics.total_character_count &&
+        incremental_metrics.minimum_word_length == reference_metrics.minimum_word_length &&
+        incremental_metrics.maximum_word_length == reference_metrics.maximum_word_length &&
+        incremental_metrics.long_word_count == reference_metrics.long_word_count &&
+        incremental_metrics.advanced_vocabulary_count == reference_metrics.advanced_vocabulary_count &&
+        incremental_metrics.basic_vocabulary_count == reference_metrics.basic_vocabulary_count &&
+        fabs(incremental_metrics.complexity_accumulator - reference_metrics.complexity_accumulator) <=
+            1e-9 * fabs(reference_metrics.complexity_accumulator) &&
+        incremental_metrics.passage_length == reference_metrics.passage_length &&
+        incremental_metrics.syllable_count == reference_metrics.syllable_count &&
+        incremental_metrics.polysyllabic_word_count == reference_metrics.polysyllabic_word_count &&
+        incremental_metrics.sentence_count == reference_metrics.sentence_count &&
+        incremental_metrics.sentence_word_lengths == reference_metrics.sentence_word_lengths &&
+        incremental_metrics.sentence_character_lengths == reference_metrics.sentence_character_lengths &&
+        incremental_metrics.comma_count == reference_metrics.comma_count &&
+        incremental_metrics.semicolon_count == reference_metrics.semicolon_count &&
+        incremental_metrics.basic_vocabulary_examples == reference_metrics.basic_vocabulary_examples &&
+        incremental_metrics.advanced_vocabulary_examples == reference_metrics.advanced_vocabulary_examples &&
+        incremental_metrics.distinct_word_count == reference_metrics.distinct_word_count &&
+        incremental_metrics.frequent_basic_words == reference_metrics.frequent_basic_words &&
+        incremental_metrics.frequent_advanced_words == reference_metrics.frequent_advanced_words;
+
+    double incremental_milliseconds = incremental_seconds * 1000.0 / edit_count;
+    double full_milliseconds = full_seconds * 1000.0;
+    cout << "\nINCREMENTAL EDIT BENCHMARK:" << endl;
+    cout << string(45, '-') << endl;
+    cout << "Document Size: " << final_document.size() / (1024 * 1024) << " MB in " << incremental_analyzer.segment_count()
+         << " sentence segments" << endl;
+    cout << fixed << setprecision(3);
+    cout << "Full Re-analysis: " << full_milliseconds << " ms per edit" << endl;
+    cout << "Incremental Update: " << incremental_milliseconds << " ms per edit (" << reanalyzed_bytes_total / edit_count
+         << " bytes re-analyzed on average)" << endl;
+    cout << setprecision(1) << "Speedup: " << full_milliseconds / incremental_milliseconds << "x | Metrics "
+         << (metrics_identical ? "identical" : "MISMATCH") << endl;
+}
+
+/*
+ * Heap allocation hooks for the benchmark suite and --stats
+ * Every operator new form that libstdc++ does not route through this one
+ * forwards to it, so counting here sees every allocation. While counting
+ * is off the only cost is one relaxed load per allocation
+ */
+TEXT_ANALYSER_NOINLINE void* operator new(size_t allocation_bytes) {
+    if (allocation_counting_enabled.load(memory_order_relaxed)) {
+        counted_allocation_count.fetch_add(1, memory_order_relaxed);
+        counted_allocation_bytes.fetch_add(allocation_bytes, memory_order_relaxed);
+        thread_allocation_count++;
+        thread_allocated_bytes += allocation_bytes;
+    }
+    if (allocation_bytes == 0) {
+        allocation_bytes = 1;
+    }
+    while (true) {
+        if (void* allocated_memory = malloc(allocation_bytes)) {
+            return allocated_memory;
+        }
+        new_handler allocation_failure_handler = get_new_handler();
+        if (allocation_failure_handler == nullptr) {
+            throw bad_alloc();
+        }
+        allocation_failure_handler();
+    }
+}
+
+TEXT_ANALYSER_NOINLINE void operator delete(void* allocated_memory) noexcept {
+    free(allocated_memory);
+}
+
+TEXT_ANALYSER_NOINLINE void operator delete(void* allocated_memory, size_t) noexcept {
+    free(allocated_memory);
+}
+
+/*
+ * This function generates reproducible synthetic English text
+ * Word ranks follow a Zipf distribution: the most common English words
+ * fill the top ranks and pronounceable synthesized words the long tail.
+ * Sentences vary in length and carry commas, semicolons and mixed
+ * terminators, so every analysis stage sees realistic input
+ */
+string generate_synthetic_english_corpus(size_t target_corpus_bytes, uint64_t corpus_seed) {
+    static const char* const COMMON_ENGLISH_WORDS[] = {
+        "the", "of", "and", "to", "a", "in", "is", "that", "for", "it", "as", "was", "with", "be", "by",
+        "on", "not", "he", "this", "are", "or", "his", "from", "at", "which", "but", "have", "an", "had",
+        "they", "you", "were", "their", "one", "all", "we", "can", "her", "has", "there", "been", "if",
+        "more", "when", "will", "would", "who", "so", "no", "she", "other", "its", "may", "these", "what",
+        "them", "than", "some", "him", "time", "into", "only", "do", "such", "new", "about", "two", "could",
+        "first", "most", "any", "should", "people", "between", "through", "because", "without", "important",
+        "development", "government", "information", "understanding", "environmental", "responsibility",
+        "communication", "organization", "international", "professional", "significantly", "implementation"};
+    static const char* const WORD_SYLLABLES[] = {
+        "ar", "ti", "con", "struc", "tion", "men", "pro", "ver", "al", "ize", "ment", "ous",
+        "ble", "ca", "de", "ex", "in", "ly", "re", "sta", "ter", "um", "ven", "for"};
+    const size_t common_word_count = sizeof(COMMON_ENGLISH_WORDS) / sizeof(COMMON_ENGLISH_WORDS[0]);
+    const size_t syllable_count = sizeof(WORD_SYLLABLES) / sizeof(WORD_SYLLABLES[0]);
+
+    // SplitMix64 keeps the sequence identical on every platform and standard library
+    auto mix_random_bits = [](uint64_t random_state) {
+        random_state = (random_state ^ (random_state >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        random_state = (random_state ^ (random_state >> 27)) * 0x94D049BB133111EBULL;
+        return random_state ^ (random_state >> 31);
+    };
+    uint64_t random_state = corpus_seed;
+    auto next_random = [&random_state, &mix_random_bits]() {
+        random_state += 0x9E3779B97F4A7C15ULL;
+        return mix_random_bits(random_state);
+    };
+
+    // The vocabulary depends only on rank, so a seed changes word order but never the words
+    vector<string> corpus_vocabulary(COMMON_ENGLISH_WORDS, COMMON_ENGLISH_WORDS + common_word_count);
+    corpus_vocabulary.reserve(SYNTHETIC_CORPUS_VOCABULARY_SIZE);
+    for (size_t word_rank = common_word_count; word_rank < SYNTHETIC_CORPUS_VOCABULARY_SIZE; word_rank++) {
+        uint64_t syllable_bits = mix_random_bits(word_rank);
+        size_t word_syllable_count = 2 + syllable_bits % 5;
+        string synthesized_word;
+        for (size_t syllable_index = 0; syllable_index < word_syllable_count; syllable_index++) {
+            syllable_bits /= 5 + syllable_index;
+            synthesized_word += WORD_SYLLABLES[(syllable_bits + syllable_index * 7) % syllable_count];
+        }
+        corpus_vocabulary.push_back(move(synthesized_word));
+    }
+
+    // Cumulative rank weights rank^-s, searched with a uniform draw per word
+    vector<double> cumulative_rank_weights(SYNTHETIC_CORPUS_VOCABULARY_SIZE);
+    double total_rank_weight = 0.0;
+    for (size_t word_rank = 0; word_rank < SYNTHETIC_CORPUS_VOCABULARY_SIZE; word_rank++) {
+        total_rank_weight += pow(static_cast<double>(word_rank + 1), -SYNTHETIC_CORPUS_ZIPF_EXPONENT);
+        cumulative_rank_weights[word_rank] = total_rank_weight;
+    }
+
+    string synthetic_corpus;
+    synthetic_corpus.reserve(target_corpus_bytes + 512);
+    uint64_t sentence_index = 0;
+    while (synthetic_corpus.size() < target_corpus_bytes) {
+        size_t sentence_word_count = 4 + next_random() % 22;
+        for (size_t word_index = 0; word_index < sentence_word_count; word_index++) {
+            double rank_draw = static_cast<double>(next_random() >> 11) * 0x1.0p-53 * total_rank_weight;
+            size_t word_rank = upper_bound(cumulative_rank_weights.begin(), cumulative_rank_weights.end(), rank_draw) -
+                               cumulative_rank_weights.begin();
+            const string& chosen_word = corpus_vocabulary[min(word_rank, SYNTHETIC_CORPUS_VOCABULARY_SIZE - 1)];
+
+            // Sentences open with a capital letter
+            if (word_index == 0) {
+                synthetic_corpus.push_back(static_cast<char>(toupper(static_cast<unsigned char>(chosen_word[0]))));
+                synthetic_corpus.append(chosen_word, 1, string::npos);
+            } else {
+                synthetic_corpus += chosen_word;
+            }
+
+            if (word_index + 1 < sentence_word_count) {
+                uint64_t punctuation_draw = next_random() % 100;
+                if (punctuation_draw < 7) {
+                    synthetic_corpus.push_back(',');
+                } else if (punctuation_draw == 7) {
+                    synthetic_corpus.push_back(';');
+                }
+                synthetic_corpus.push_back(' ');
+            }
+        }
+
+        uint64_t terminator_draw = next_random() % 100;
+        synthetic_corpus.push_back(terminator_draw < 88 ? '.' : terminator_draw < 95 ? '?' : '!');
+        sentence_index++;
+        synthetic_corpus += sentence_index % 6 == 0 ? "\n\n" : " ";
+    }
+    return synthetic_corpus;
+}
+
+// Stage results are stored here so the optimizer cannot discard the work being timed
+volatile uint64_t benchmark_result_sink = 0;
+
+/*
+ * This function times one stage over several repetitions
+ * The best and mean wall times are kept; heap activity is taken from the
+ * last repetition, once any reusable buffers have reached their size
+ */
+template <typename StageFunction>
+BenchmarkStageMeasurement measure_benchmark_stage(const char* stage_name, unsigned timed_repetitions, StageFunction stage_function) {
+    BenchmarkStageMeasurement stage_measurement;
+    stage_measurement.stage_name = stage_name;
+    double total_seconds = 0.0;
+    for (unsigned repetition = 0; repetition < timed_repetitions; repetition++) {
+        uint64_t allocation_count_before = counted_allocation_count.load(memory_order_relaxed);
+        uint64_t allocated_bytes_before = counted_allocation_bytes.load(memory_order_relaxed);
+        auto stage_start = chrono::steady_clock::now();
+        benchmark_result_sink = stage_function();
+        double elapsed_seconds = chrono::duration<double>(chrono::steady_clock::now() - stage_start).count();
+
+        stage_measurement.allocation_count = counted_allocation_count.load(memory_order_relaxed) - allocation_count_before;
+        stage_measurement.allocated_bytes = counted_allocation_bytes.load(memory_order_relaxed) - allocated_bytes_before;
+        total_seconds += elapsed_seconds;
+        if (repetition == 0 || elapsed_seconds < stage_measurement.best_seconds) {
+            stage_measurement.best_seconds = elapsed_seconds;
+        }
+    }
+    stage_measurement.mean_seconds = total_seconds / timed_repetitions;
+    return stage_measurement;
+}
+
+/*
+ * Serialize one stage measurement as a flat record
+ */
+void serialize_benchmark_stage_record(StructuredRecordSerializer& record_serializer,
+                                      const BenchmarkStageMeasurement& stage_measurement, uint64_t corpus_bytes) {
+    bool baseline_present = !stage_measurement.baseline_stage_name.empty();
+    record_serializer.begin_record();
+    record_serializer.field_text("stage", stage_measurement.stage_name);
+    record_serializer.field_decimal("best_seconds", stage_measurement.best_seconds);
+    record_serializer.field_decimal("mean_seconds", stage_measurement.mean_seconds);
+    record_serializer.field_decimal("megabytes_per_second", corpus_bytes / 1e6 / stage_measurement.best_seconds);
+    record_serializer.field_unsigned("allocations", stage_measurement.allocation_count);
+    record_serializer.field_unsigned("allocated_bytes", stage_measurement.allocated_bytes);
+    record_serializer.field_text("baseline", stage_measurement.baseline_stage_name, baseline_present);
+    record_serializer.field_decimal("speedup", stage_measurement.baseline_speedup, baseline_present);
+    record_serializer.end_record();
+}
+
+/*
+ * This function runs the benchmark suite described by the command line
+ * Each analysis stage, the optimized engines and both complete pipelines
+ * are timed over one synthetic corpus, with the original tokenizer and
+ * the staged pipeline as baselines. Results are written as a text table
+ * or as JSON, NDJSON or CSV stage records for regression tracking
+ */
+int run_benchmark_suite(const CommandLineOptions& command_line_options) {
+    const unsigned timed_repetitions = command_line_options.benchmark_repetitions;
+    unsigned analysis_thread_count = resolve_analysis_thread_count(command_line_options.analysis_thread_count);
+    string benchmark_corpus = generate_synthetic_english_corpus(command_line_options.benchmark_corpus_megabytes * 1024 * 1024,
+                                                                command_line_options.benchmark_seed);
+    uint64_t corpus_bytes = benchmark_corpus.size();
+
+    // Inputs for the stages that consume a token stream are prepared outside the timings
+    InternedTokenStream corpus_tokens = intern_words_from_passage(benchmark_corpus);
+    PassageAnalysisAccumulator single_pass_metrics;
+    PassageAnalysisAccumulator parallel_metrics;
+    PassageAnalysisAccumulator streaming_metrics;
+    PassageAnalysisAccumulator staged_metrics;
+    uint64_t reference_word_count = 0;
+    uint64_t span_word_count = 0;
+    ReportWriter pipeline_report_writer;
+
+    vector<BenchmarkStageMeasurement> stage_measurements;
+    allocation_counting_enabled.store(true, memory_order_relaxed);
+
+    stage_measurements.push_back(measure_benchmark_stage("reference_extract_words_from_passage", timed_repetitions, [&]() {
+        reference_word_count = reference_extract_words_from_passage(benchmark_corpus).size();
+        return reference_word_count;
+    }));
+    stage_measurements.push_back(measure_benchmark_stage("extract_words_from_passage", timed_repetitions, [&]() {
+        span_word_count = extract_words_from_passage(benchmark_corpus).size();
+        return span_word_count;
+    }));
+    stage_measurements.push_back(measure_benchmark_stage("intern_words_from_passage", timed_repetitions, [&]() {
+        return static_cast<uint64_t>(intern_words_from_passage(benchmark_corpus).vocabulary.size());
+    }));
+    stage_measurements.push_back(measure_benchmark_stage("calculate_readability_complexity_score", timed_repetitions, [&]() {
+        return static_cast<uint64_t>(calculate_readability_complexity_score(corpus_tokens) * 1e6);
+    }));
+    stage_measurements.push_back(measure_benchmark_stage("perform_comprehensive_text_analysis", timed_repetitions, [&]() {
+        staged_metrics = perform_comprehensive_text_analysis(corpus_tokens, benchmark_corpus);
+        return staged_metrics.total_character_count;
+    }));
+    stage_measurements.push_back(measure_benchmark_stage("analyze_sentence_structure", timed_repetitions, [&]() {
+        return analyze_sentence_structure(benchmark_corpus).sentence_count;
+    }));
+    stage_measurements.push_back(measure_benchmark_stage("suggest_vocabulary_enhancements", timed_repetitions, [&]() {
+        return suggest_vocabulary_enhancements(corpus_tokens).basic_vocabulary_count;
+    }));
+    stage_measurements.push_back(measure_benchmark_stage("StyleLinter::lint_passage", timed_repetitions, [&]() {
+        return application_style_linter().lint_passage(benchmark_corpus).total_match_count;
+    }));
+    stage_measurements.push_back(measure_benchmark_stage("analyze_passage_in_single_pass", timed_repetitions, [&]() {
+        single_pass_metrics = analyze_passage_in_single_pass(benchmark_corpus);
+        return single_pass_metrics.total_word_count;
+    }));
+    stage_measurements.push_back(measure_benchmark_stage("analyze_passage_in_parallel", timed_repetitions, [&]() {
+        parallel_metrics = analyze_passage_in_parallel(benchmark_corpus, analysis_thread_count);
+        return parallel_metrics.total_word_count;
+    }));
+    stage_measurements.push_back(measure_benchmark_stage("StreamingPassageAnalyzer", timed_repetitions, [&]() {
+        // Pieces of the size analyze_document_stream reads
+        StreamingPassageAnalyzer streaming_analyzer;
+        string_view remaining_corpus = benchmark_corpus;
+        while (!remaining_corpus.empty()) {
+            size_t piece_length = min<size_t>(remaining_corpus.size(), 1024 * 1024);
+            streaming_analyzer.append_text(remaining_corpus.substr(0, piece_length));
+            remaining_corpus.remove_prefix(piece_length);
+        }
+        streaming_metrics = streaming_analyzer.finish();
+        return streaming_metrics.total_word_count;
+    }));
+
+    // The staged pipeline runs the original stage sequence and merges its results for the report
+    stage_measurements.push_back(measure_benchmark_stage("staged_pipeline", timed_repetitions, [&]() {
+        InternedTokenStream pipeline_tokens = intern_words_from_passage(benchmark_corpus);
+        double complexity_score = calculate_readability_complexity_score(pipeline_tokens);
+        PassageAnalysisAccumulator pipeline_metrics = perform_comprehensive_text_analysis(pipeline_tokens, benchmark_corpus);
+        PassageAnalysisAccumulator vocabulary_metrics = suggest_vocabulary_enhancements(pipeline_tokens);
+        pipeline_metrics.basic_vocabulary_count = vocabulary_metrics.basic_vocabulary_count;
+        pipeline_metrics.advanced_vocabulary_count = vocabulary_metrics.advanced_vocabulary_count;
+        pipeline_metrics.basic_vocabulary_examples = move(vocabulary_metrics.basic_vocabulary_examples);
+        pipeline_metrics.advanced_vocabulary_examples = move(vocabulary_metrics.advanced_vocabulary_examples);
+        pipeline_metrics.distinct_word_count = vocabulary_metrics.distinct_word_count;
+        pipeline_metrics.frequent_basic_words = move(vocabulary_metrics.frequent_basic_words);
+        pipeline_metrics.frequent_advanced_words = move(vocabulary_metrics.frequent_advanced_words);
+        pipeline_metrics.complexity_accumulator = complexity_score * 8.0 * pipeline_metrics.total_word_count;
+        pipeline_report_writer.clear();
+        render_passage_analysis_report(pipeline_report_writer.stream(), build_analysis_result(move(pipeline_metrics)));
+        return static_cast<uint64_t>(pipeline_report_writer.contents().size());
+    }));
+    stage_measurements.push_back(measure_benchmark_stage("fused_pipeline", timed_repetitions, [&]() {
+        PassageAnalysisAccumulator pipeline_metrics = analyze_passage_in_parallel(benchmark_corpus, analysis_thread_count);
+        pipeline_report_writer.clear();
+        render_passage_analysis_report(pipeline_report_writer.stream(), build_analysis_result(move(pipeline_metrics)));
+        return static_cast<uint64_t>(pipeline_report_writer.contents().size());
+    }));
+
+    allocation_counting_enabled.store(false, memory_order_relaxed);
+
+    // Optimized engines are compared with the code they replace
+    auto compare_with_baseline = [&stage_measurements](const string& stage_name, const string& baseline_stage_name) {
+        const BenchmarkStageMeasurement* baseline_measurement = nullptr;
+        for (const BenchmarkStageMeasurement& stage_measurement : stage_measurements) {
+            if (stage_measurement.stage_name == baseline_stage_name) {
+                baseline_measurement = &stage_measurement;
+            }
+        }
+        for (BenchmarkStageMeasurement& stage_measurement : stage_measurements) {
+            if (stage_measurement.stage_name == stage_name) {
+                stage_measurement.baseline_stage_name = baseline_stage_name;
+                stage_measurement.baseline_speedup = baseline_measurement->best_seconds / stage_measurement.best_seconds;
+            }
+        }
+    };
+    compare_with_baseline("extract_words_from_passage", "reference_extract_words_from_passage");
+    compare_with_baseline("intern_words_from_passage", "reference_extract_words_from_passage");
+    compare_with_baseline("analyze_passage_in_parallel", "analyze_passage_in_single_pass");
+    compare_with_baseline("StreamingPassageAnalyzer", "analyze_passage_in_single_pass");
+    compare_with_baseline("fused_pipeline", "staged_pipeline");
+
+    // Every engine must agree on the counts it shares with the others
+    bool engines_agree = reference_word_count == span_word_count && span_word_count == corpus_tokens.size() &&
+                         single_pass_metrics.total_word_count == corpus_tokens.size() &&
+                         parallel_metrics.total_word_count == single_pass_metrics.total_word_count &&
+                         parallel_metrics.total_character_count == single_pass_metrics.total_character_count &&
+                         parallel_metrics.sentence_count == single_pass_metrics.sentence_count &&
+                         parallel_metrics.advanced_vocabulary_count == single_pass_metrics.advanced_vocabulary_count &&
+                         single_pass_metrics.distinct_word_count == corpus_tokens.vocabulary.size() &&
+                         parallel_metrics.frequent_basic_words == single_pass_metrics.frequent_basic_words &&
+                         parallel_metrics.frequent_advanced_words == single_pass_metrics.frequent_advanced_words &&
+                         streaming_metrics.total_word_count == single_pass_metrics.total_word_count &&
+                         streaming_metrics.total_character_count == single_pass_metrics.total_character_count &&
+                         streaming_metrics.sentence_count == single_pass_metrics.sentence_count &&
+                         streaming_metrics.advanced_vocabulary_count == single_pass_metrics.advanced_vocabulary_count &&
+                         streaming_metrics.complexity_accumulator == single_pass_metrics.complexity_accumulator &&
+                         staged_metrics.syllable_count == single_pass_metrics.syllable_count &&
+                         staged_metrics.polysyllabic_word_count == single_pass_metrics.polysyllabic_word_count &&
+                         parallel_metrics.syllable_count == single_pass_metrics.syllable_count &&
+                         streaming_metrics.syllable_count == single_pass_metrics.syllable_count &&
+                         streaming_metrics.polysyllabic_word_count == single_pass_metrics.polysyllabic_word_count &&
+                         staged_metrics.sentence_word_lengths == single_pass_metrics.sentence_word_lengths &&
+                         staged_metrics.sentence_character_lengths == single_pass_metrics.sentence_character_lengths &&
+                         parallel_metrics.sentence_word_lengths == single_pass_metrics.sentence_word_lengths &&
+                         parallel_metrics.sentence_character_lengths == single_pass_metrics.sentence_character_lengths &&
+                         streaming_metrics.sentence_word_lengths == single_pass_metrics.sentence_word_lengths &&
+                         streaming_metrics.sentence_character_lengths == single_pass_metrics.sentence_character_lengths;
+    // The streaming vocabulary is a sketch estimate, so it is reported rather than compared
+    double streaming_distinct_error = (static_cast<double>(streaming_metrics.distinct_word_count) -
+                                       static_cast<double>(corpus_tokens.vocabulary.size())) /
+                                      max<double>(corpus_tokens.vocabulary.size(), 1) * 100.0;
+
+    ReportWriter& report_writer = console_report_writer();
+    ReportOutputFormat output_format = command_line_options.output_format;
+    string& output_buffer = report_writer.buffer();
+    if (output_format == ReportOutputFormat::CSV || output_format == ReportOutputFormat::NDJSON) {
+        if (output_format == ReportOutputFormat::CSV) {
+            StructuredRecordSerializer header_serializer(output_buffer, output_format, true);
+            serialize_benchmark_stage_record(header_serializer, BenchmarkStageMeasurement(), corpus_bytes);
+            output_buffer.push_back('\n');
+        }
+        StructuredRecordSerializer record_serializer(output_buffer, output_format);
+        for (const BenchmarkStageMeasurement& stage_measurement : stage_measurements) {
+            serialize_benchmark_stage_record(record_serializer, stage_measurement, corpus_bytes);
+            output_buffer.push_back('\n');
+        }
+    } else if (output_format == ReportOutputFormat::JSON) {
+        output_buffer.append("{\"corpus\":");
+        StructuredRecordSerializer corpus_serializer(output_buffer, output_format);
+        corpus_serializer.begin_record();
+        corpus_serializer.field_unsigned("bytes", corpus_bytes);
+        corpus_serializer.field_unsigned("words", corpus_tokens.size());
+        corpus_serializer.field_unsigned("distinct_words", corpus_tokens.vocabulary.size());
+        corpus_serializer.field_unsigned("seed", command_line_options.benchmark_seed);
+        corpus_serializer.field_decimal("zipf_exponent", SYNTHETIC_CORPUS_ZIPF_EXPONENT);
+        corpus_serializer.field_unsigned("repetitions", timed_repetitions);
+        corpus_serializer.field_unsigned("threads", analysis_thread_count);
+        corpus_serializer.field_text("tokenizer_kernel", tokenizer_kernel_name(active_tokenizer_kernel()));
+        corpus_serializer.field_boolean("engines_agree", engines_agree);
+        corpus_serializer.field_unsigned("streaming_distinct_estimate", streaming_metrics.distinct_word_count);
+        corpus_serializer.field_decimal("streaming_distinct_error_percent", streaming_distinct_error);
+        corpus_serializer.end_record();
+        output_buffer.append(",\"stages\":[");
+        StructuredRecordSerializer record_serializer(output_buffer, output_format);
+        for (size_t stage_index = 0; stage_index < stage_measurements.size(); stage_index++) {
+            if (stage_index > 0) {
+                output_buffer.push_back(',');
+            }
+            serialize_benchmark_stage_record(record_serializer, stage_measurements[stage_index], corpus_bytes);
+        }
+        output_buffer.append("]}\n");
+    } else {
+        ostream& report_stream = report_writer.stream();
+        report_stream << "\nBENCHMARK SUITE:\n";
+        report_stream << string(45, '-') << '\n';
+        report_stream << fixed << setprecision(2);
+        report_stream << "Corpus: " << corpus_bytes / 1e6 << " MB synthetic English (Zipf s=" << SYNTHETIC_CORPUS_ZIPF_EXPONENT
+                      << ", seed " << command_line_options.benchmark_seed << ")\n";
+        report_stream << "Words: " << corpus_tokens.size() << " (" << corpus_tokens.vocabulary.size() << " distinct)\n";
+        report_stream << "Repetitions: " << timed_repetitions << " (best reported) | Threads: " << analysis_thread_count
+                      << " | Kernel: " << tokenizer_kernel_name(active_tokenizer_kernel()) << '\n';
+        report_stream << left << setw(40) << "Stage" << right << setw(10) << "Best ms" << setw(10) << "MB/s" << setw(11)
+                      << "Allocs" << setw(11) << "Alloc MB" << "  Speedup\n";
+        for (const BenchmarkStageMeasurement& stage_measurement : stage_measurements) {
+            report_stream << left << setw(40) << stage_measurement.stage_name << right << setw(10)
+                          << stage_measurement.best_seconds * 1000.0 << setw(10)
+                          << corpus_bytes / 1e6 / stage_measurement.best_seconds << setw(11)
+                          << stage_measurement.allocation_count << setw(11) << stage_measurement.allocated_bytes / 1e6;
+            if (!stage_measurement.baseline_stage_name.empty()) {
+                report_stream << "  " << stage_measurement.baseline_speedup << "x " << stage_measurement.baseline_stage_name;
+            }
+            report_stream << '\n';
+        }
+        report_stream << "Engine Results: " << (engines_agree ? "identical" : "MISMATCH") << '\n';
+        report_stream << "Streaming Distinct Estimate: " << streaming_metrics.distinct_word_count << " ("
+                      << showpos << streaming_distinct_error << noshowpos << "% error)\n";
+    }
+    report_writer.write_to_standard_output();
+    return engines_agree ? 0 : 1;
+}
@@ -0,0 +1,265 @@
+/*
+ * Front-end tests
+ * Code hints and optimizations by artlest
+ *
+ * The socket framing, the daemon and the text report live in the program
+ * itself, so this driver compiles the front-end in with its entry point
+ * renamed. Built from the repository root:
+ *
+ *   g++ -std=c++17 -O2 -Wall -Wextra -pthread -I. -o front_end_tests \
+ *       tests/front_end_tests.cpp text_analysis_library.cpp
+ *
+ * Every section prints its name and the driver exits with status 1 if
+ * any check failed.
+ */
+
+#define main text_analyser_main
+#include "../WRITING HELPER AND ANALYSER BY ARTLEST.cpp"
+#undef main
+
+static uint64_t failed_check_count = 0;
+
+/*
+ * Record one check, describing it on the console when it fails
+ */
+static void expect_check(bool check_passed, const string& check_description) {
+    if (!check_passed) {
+        failed_check_count++;
+        cout << "  FAILED: " << check_description << '\n';
+    }
+}
+
+#if TEXT_ANALYSER_UNIX_SOCKETS
+
+// Connections left idle while another one asks for a report, per daemon worker
+const size_t IDLE_CONNECTIONS_PER_WORKER = 4;
+const unsigned DAEMON_TEST_WORKER_COUNT = 2;
+
+// A reply that takes longer than this counts as never arriving
+const long DAEMON_TEST_REPLY_SECONDS = 5;
+
+/*
+ * Frame round trip (user-012)
+ * Frames written to one end of a socket pair read back unchanged from the
+ * other, including an empty payload and one far larger than the socket
+ * buffer, and a closed peer reads as a clean end of stream
+ */
+static void test_frame_round_trip() {
+    int socket_pair[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, socket_pair) != 0) {
+        expect_check(false, "socketpair: " + string(strerror(errno)));
+        return;
+    }
+
+    string large_payload(3 * 1024 * 1024 + 17, '\0');
+    for (size_t byte_index = 0; byte_index < large_payload.size(); byte_index++) {
+        large_payload[byte_index] = static_cast<char>((byte_index * 131) >> 3);
+    }
+    vector<pair<uint8_t, string>> sent_frames = {
+        {ANALYSIS_RESPONSE_OK, ""},
+        {static_cast<uint8_t>(ReportOutputFormat::JSON), "The quick brown fox."},
+        {ANALYSIS_RESPONSE_ERROR, string("embedded\0zero\nbytes", 19)},
+        {static_cast<uint8_t>(ReportOutputFormat::CSV), large_payload},
+        {255, "last"},
+    };
+
+    // The large frame fills the socket buffer, so the writer needs its own thread
+    bool frames_written = true;
+    thread frame_writer([&] {
+        for (const auto& [frame_code, frame_payload] : sent_frames) {
+            frames_written = write_analysis_frame(socket_pair[0], frame_code, frame_payload) && frames_written;
+        }
+        close(socket_pair[0]);
+    });
+
+    uint8_t frame_code = 0;
+    string frame_payload;
+    string error_description;
+    for (size_t frame_index = 0; frame_index < sent_frames.size(); frame_index++) {
+        bool frame_read = read_analysis_frame(socket_pair[1], frame_code, frame_payload, error_description);
+        expect_check(frame_read, "frame " + to_string(frame_index) + " was read");
+        expect_check(frame_code == sent_frames[frame_index].first, "frame " + to_string(frame_index) + " code");
+        expect_check(frame_payload == sent_frames[frame_index].second, "frame " + to_string(frame_index) + " payload");
+    }
+    frame_writer.join();
+    expect_check(frames_written, "every frame was written");
+
+    bool frame_read = read_analysis_frame(socket_pair[1], frame_code, frame_payload, error_description);
+    expect_check(!frame_read && error_description.empty(), "a closed peer ends the stream without an error");
+    close(socket_pair[1]);
+}
+
+/*
+ * Oversized frame (user-012)
+ * A header announcing more than ANALYSIS_FRAME_PAYLOAD_LIMIT bytes is
+ * rejected before any payload is read, and the daemon's request handler
+ * answers it with an error frame and closes the connection
+ */
+static void test_oversized_frame() {
+    int socket_pair[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, socket_pair) != 0) {
+        expect_check(false, "socketpair: " + string(strerror(errno)));
+        return;
+    }
+
+    // Only the header is sent; the limit must not depend on the payload arriving
+    uint32_t announced_length = ANALYSIS_FRAME_PAYLOAD_LIMIT + 1;
+    unsigned char frame_header[ANALYSIS_FRAME_HEADER_BYTES] = {
+        static_cast<unsigned char>(ReportOutputFormat::JSON), static_cast<unsigned char>(announced_length >> 24),
+        static_cast<unsigned char>(announced_length >> 16), static_cast<unsigned char>(announced_length >> 8),
+        static_cast<unsigned char>(announced_length)};
+
+    // Exactly at the limit is still a valid header
+    uint32_t limit_length = ANALYSIS_FRAME_PAYLOAD_LIMIT;
+    unsigned char limit_header[ANALYSIS_FRAME_HEADER_BYTES] = {
+        ANALYSIS_RESPONSE_OK, static_cast<unsigned char>(limit_length >> 24), static_cast<unsigned char>(limit_length >> 16),
+        static_cast<unsigned char>(limit_length >> 8), static_cast<unsigned char>(limit_length)};
+    expect_check(write(socket_pair[0], limit_header, sizeof(limit_header)) == static_cast<ssize_t>(sizeof(limit_header)),
+                 "limit header was written");
+    shutdown(socket_pair[0], SHUT_WR);
+    uint8_t frame_code = 0;
+    string frame_payload;
+    string error_description;
+    bool frame_read = read_analysis_frame(socket_pair[1], frame_code, frame_payload, error_description);
+    expect_check(!frame_read && error_description.empty(), "a frame at the limit is accepted and only ends with the stream");
+    close(socket_pair[0]);
+    close(socket_pair[1]);
+
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, socket_pair) != 0) {
+        expect_check(false, "socketpair: " + string(strerror(errno)));
+        return;
+    }
+    expect_check(write(socket_pair[0], frame_header, sizeof(frame_header)) == static_cast<ssize_t>(sizeof(frame_header)),
+                 "oversized header was written");
+    atomic<uint64_t> served_request_count{0};
+    bool connection_usable = serve_analysis_request(socket_pair[1], served_request_count, nullptr);
+    expect_check(!connection_usable, "the connection is closed after an oversized frame");
+    expect_check(served_request_count.load() == 0, "an oversized frame is not counted as served");
+    close(socket_pair[1]);
+
+    frame_read = read_analysis_frame(socket_pair[0], frame_code, frame_payload, error_description);
+    expect_check(frame_read, "an error frame came back");
+    expect_check(frame_code == ANALYSIS_RESPONSE_ERROR, "the reply is an error frame");
+    expect_check(frame_payload.find(to_string(ANALYSIS_FRAME_PAYLOAD_LIMIT)) != string::npos,
+                 "the error names the limit: " + frame_payload);
+    close(socket_pair[0]);
+}
+
+/*
+ * Idle connections (user-012)
+ * A daemon with fewer workers than open idle connections still answers a
+ * request on another connection, then stops cleanly on SIGTERM and
+ * removes its socket file
+ */
+static void test_idle_connections() {
+    CommandLineOptions daemon_options;
+    daemon_options.command_line_mode = CommandLineMode::Serve;
+    daemon_options.socket_path =
+        (filesystem::temp_directory_path() / ("analysis_daemon_test_" + to_string(getpid()) + ".sock")).string();
+    daemon_options.analysis_thread_count = DAEMON_TEST_WORKER_COUNT;
+    daemon_options.cache_entry_limit = 0;
+
+    int daemon_status = -1;
+    thread daemon_thread([&] { daemon_status = run_analysis_daemon(daemon_options); });
+
+    // The daemon is ready once a connection succeeds
+    string error_description;
+    int request_descriptor = -1;
+    for (int connect_attempt = 0; connect_attempt < 200 && request_descriptor < 0; connect_attempt++) {
+        request_descriptor = connect_analysis_socket(daemon_options.socket_path, error_description);
+        if (request_descriptor < 0) {
+            this_thread::sleep_for(chrono::milliseconds(25));
+        }
+    }
+    expect_check(request_descriptor >= 0, "daemon accepted a connection: " + error_description);
+
+    vector<int> idle_descriptors;
+    for (size_t connection_index = 0; connection_index < IDLE_CONNECTIONS_PER_WORKER * DAEMON_TEST_WORKER_COUNT;
+         connection_index++) {
+        int idle_descriptor = connect_analysis_socket(daemon_options.socket_path, error_description);
+        expect_check(idle_descriptor >= 0, "idle connection " + to_string(connection_index) + ": " + error_description);
+        if (idle_descriptor >= 0) {
+            idle_descriptors.push_back(idle_descriptor);
+        }
+    }
+
+    if (request_descriptor >= 0) {
+        timeval reply_timeout = {DAEMON_TEST_REPLY_SECONDS, 0};
+        setsockopt(request_descriptor, SOL_SOCKET, SO_RCVTIMEO, &reply_timeout, sizeof(reply_timeout));
+
+        // Two requests on the same connection show it rejoins the poll set after the first
+        for (int request_index = 0; request_index < 2; request_index++) {
+            bool request_sent = write_analysis_frame(request_descriptor, static_cast<uint8_t>(ReportOutputFormat::JSON),
+                                                     "Idle clients hold no worker. The daemon answers anyway.");
+            expect_check(request_sent, "request " + to_string(request_index) + " was sent");
+            uint8_t frame_code = ANALYSIS_RESPONSE_ERROR;
+            string frame_payload;
+            bool reply_read = read_analysis_frame(request_descriptor, frame_code, frame_payload, error_description);
+            expect_check(reply_read, "request " + to_string(request_index) + " was answered while " +
+                                         to_string(idle_descriptors.size()) + " connections sat idle");
+            expect_check(frame_code == ANALYSIS_RESPONSE_OK, "request " + to_string(request_index) + " succeeded");
+            expect_check(frame_payload.find("\"total_words\":9") != string::npos,
+                         "request " + to_string(request_index) + " reports the passage: " + frame_payload.substr(0, 200));
+        }
+        close(request_descriptor);
+    }
+
+    pthread_kill(daemon_thread.native_handle(), SIGTERM);
+    daemon_thread.join();
+    for (int idle_descriptor : idle_descriptors) {
+        close(idle_descriptor);
+    }
+    expect_check(daemon_status == 0, "daemon exited with status 0");
+    expect_check(!filesystem::exists(daemon_options.socket_path), "daemon removed its socket file");
+}
+
+#endif
+
+/*
+ * Readability report (user-021)
+ * A passage without words prints n/a for every index instead of the
+ * formulas' constant terms or NaN; a passage with words prints values
+ */
+static void test_readability_report() {
+    for (const char* text_passage : {"", "   ", "... !? 42, 1999."}) {
+        ostringstream report_stream;
+        render_readability_indices(report_stream, analyze_text_passage(text_passage));
+        string report_text = report_stream.str();
+        size_t not_available_count = 0;
+        for (size_t match_offset = report_text.find("n/a"); match_offset != string::npos;
+             match_offset = report_text.find("n/a", match_offset + 1)) {
+            not_available_count++;
+        }
+        string passage_label = " for passage \"" + string(text_passage) + "\"";
+        expect_check(not_available_count == 6, "every index is n/a" + passage_label);
+        expect_check(report_text.find("nan") == string::npos && report_text.find("3.13") == string::npos,
+                     "no NaN or SMOG constant is printed" + passage_label);
+    }
+
+    ostringstream report_stream;
+    string worded_passage = "The cat sat on the mat. It was one beautiful, sunny afternoon.";
+    render_readability_indices(report_stream, analyze_text_passage(worded_passage));
+    string report_text = report_stream.str();
+    expect_check(report_text.find("n/a") == string::npos, "a passage with words has no n/a index");
+    expect_check(report_text.find("Gunning Fog Index: 9.07") != string::npos &&
+                     report_text.find("SMOG Grade: 8.84") != string::npos && report_text.find(" (easy)") != string::npos,
+                 "indices are printed with two decimals: " + report_text);
+}
+
+int main() {
+    const pair<const char*, void (*)()> test_sections[] = {
+#if TEXT_ANALYSER_UNIX_SOCKETS
+        {"frame round trip", test_frame_round_trip},
+        {"oversized frame", test_oversized_frame},
+        {"idle connections", test_idle_connections},
+#endif
+        {"readability report", test_readability_report},
+    };
+    for (const auto& [section_name, run_section] : test_sections) {
+        uint64_t failures_before_section = failed_check_count;
+        run_section();
+        cout << (failed_check_count == failures_before_section ? "ok   " : "FAIL ") << section_name << '\n';
+    }
+    cout << (failed_check_count == 0 ? "All tests passed" : to_string(failed_check_count) + " checks failed") << endl;
+    return failed_check_count == 0 ? 0 : 1;
+}
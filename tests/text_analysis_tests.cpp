@@ -0,0 +1,1288 @@
+/*
+ * Text analysis library tests
+ * Code hints and optimizations by artlest
+ *
+ * Checks the library's engines against each other and against simple
+ * reference implementations. Built from the repository root with the
+ * same line as the program, the front-end swapped for this driver:
+ *
+ *   g++ -std=c++17 -O2 -Wall -Wextra -pthread -I. -o text_analysis_tests \
+ *       tests/text_analysis_tests.cpp text_analysis_library.cpp
+ *
+ * Every section prints its name and the driver exits with status 1 if
+ * any check failed.
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <cmath>
+#include <cctype>
+#include <tuple>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <charconv>
+
+#include "text_analysis_library.h"
+
+using namespace std;
+
+// Fixed seed so every run checks the same generated passages
+const uint64_t TEST_RANDOM_SEED = 20240611;
+const size_t RANDOM_PASSAGE_COUNT = 2000;
+
+static uint64_t failed_check_count = 0;
+
+/*
+ * Record one check, describing it on the console when it fails
+ */
+static void expect_check(bool check_passed, const string& check_description) {
+    if (!check_passed) {
+        failed_check_count++;
+        cout << "  FAILED: " << check_description << '\n';
+    }
+}
+
+/*
+ * Passage of fragment_count fragments picked at random from the list
+ */
+static string generate_random_passage(mt19937_64& random_generator, const vector<string>& passage_fragments,
+                                      size_t fragment_count) {
+    string generated_passage;
+    for (size_t fragment_index = 0; fragment_index < fragment_count; fragment_index++) {
+        generated_passage += passage_fragments[random_generator() % passage_fragments.size()];
+    }
+    return generated_passage;
+}
+
+/*
+ * Letters 'a' to 'y' spelling a number, for generated words: passage and
+ * thesaurus words are normalized, so digits would be dropped
+ */
+static string spell_number_in_letters(uint64_t number) {
+    string spelled_number;
+    do {
+        spelled_number.push_back(static_cast<char>('a' + number % 25));
+        number /= 25;
+    } while (number != 0);
+    return spelled_number;
+}
+
+// Words, punctuation, multi-byte and malformed UTF-8 the engines must agree on
+const vector<string> MIXED_PASSAGE_FRAGMENTS = {
+    "the ", "and ", "Word ", "IMPLEMENTATION ", "extraordinary, ", "don't ", "x; ", "hello. ", "what?! ",
+    "caf\xC3\xA9 ", "na\xC3\xAFve ", "Stra\xC3\x9F" "e ", "\xCE\xA9mega ", "\xD0\x96ук ", "\xE6\x97\xA5\xE6\x9C\xAC ",
+    "\xF0\x9F\x98\x80x ", "\xC2\xA0", "\xE2\x80\x83", "\xE2\x80\x9Cquoted.\xE2\x80\x9D ", "so\xE2\x80\xA6 ",
+    "\xC3", "\xE2\x82", "\x80\x80", "\xFF", "\xED\xA0\x80", "e\xCC\x81", "9", "\t", "\n", "\n\n", "Dr. ", "3.14 "};
+
+/*
+ * True when two accumulators hold bit-identical metrics
+ */
+static bool passage_metrics_identical(const PassageAnalysisAccumulator& first_metrics,
+                                      const PassageAnalysisAccumulator& second_metrics) {
+    return first_metrics.total_word_count == second_metrics.total_word_count &&
+           first_metrics.total_character_count == second_metrics.total_character_count &&
+           first_metrics.passage_length == second_metrics.passage_length &&
+           first_metrics.minimum_word_length == second_metrics.minimum_word_length &&
+           first_metrics.maximum_word_length == second_metrics.maximum_word_length &&
+           first_metrics.long_word_count == second_metrics.long_word_count &&
+           first_metrics.advanced_vocabulary_count == second_metrics.advanced_vocabulary_count &&
+           first_metrics.basic_vocabulary_count == second_metrics.basic_vocabulary_count &&
+           memcmp(&first_metrics.complexity_accumulator, &second_metrics.complexity_accumulator, sizeof(double)) == 0 &&
+           first_metrics.syllable_count == second_metrics.syllable_count &&
+           first_metrics.polysyllabic_word_count == second_metrics.polysyllabic_word_count &&
+           first_metrics.sentence_count == second_metrics.sentence_count &&
+           first_metrics.sentence_word_lengths == second_metrics.sentence_word_lengths &&
+           first_metrics.sentence_character_lengths == second_metrics.sentence_character_lengths &&
+           first_metrics.comma_count == second_metrics.comma_count &&
+           first_metrics.semicolon_count == second_metrics.semicolon_count &&
+           first_metrics.basic_vocabulary_examples == second_metrics.basic_vocabulary_examples &&
+           first_metrics.advanced_vocabulary_examples == second_metrics.advanced_vocabulary_examples &&
+           first_metrics.distinct_word_count == second_metrics.distinct_word_count &&
+           first_metrics.frequent_basic_words == second_metrics.frequent_basic_words &&
+           first_metrics.frequent_advanced_words == second_metrics.frequent_advanced_words;
+}
+
+/*
+ * True when two style reports hold the same findings and matches
+ */
+static bool style_reports_identical(const StyleLintReport& first_report, const StyleLintReport& second_report) {
+    if (first_report.total_match_count != second_report.total_match_count ||
+        first_report.checked_rule_count != second_report.checked_rule_count ||
+        first_report.rule_set_fingerprint != second_report.rule_set_fingerprint ||
+        first_report.findings.size() != second_report.findings.size() ||
+        first_report.matches.size() != second_report.matches.size() ||
+        !equal(begin(first_report.category_match_counts), end(first_report.category_match_counts),
+               begin(second_report.category_match_counts))) {
+        return false;
+    }
+    for (size_t finding_index = 0; finding_index < first_report.findings.size(); finding_index++) {
+        const StyleFinding& first_finding = first_report.findings[finding_index];
+        const StyleFinding& second_finding = second_report.findings[finding_index];
+        if (first_finding.style_rule.category != second_finding.style_rule.category ||
+            first_finding.style_rule.phrase != second_finding.style_rule.phrase ||
+            first_finding.style_rule.suggestion != second_finding.style_rule.suggestion ||
+            first_finding.match_count != second_finding.match_count) {
+            return false;
+        }
+    }
+    for (size_t match_index = 0; match_index < first_report.matches.size(); match_index++) {
+        const StyleMatch& first_match = first_report.matches[match_index];
+        const StyleMatch& second_match = second_report.matches[match_index];
+        if (first_match.finding_index != second_match.finding_index || first_match.start_offset != second_match.start_offset ||
+            first_match.byte_length != second_match.byte_length) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * Tokenizer kernels (user-001, user-017)
+ * Every kernel the CPU supports must produce the scalar kernel's words,
+ * and the interned stream the same words again
+ */
+static void test_tokenizer_kernels() {
+    TokenizedPassage known_words = extract_words_from_passage("Caf\xC3\xA9 NA\xC3\x8FVE, don't-stop 42!");
+    // Case folds, apostrophes and hyphens join their word, and digits are not words
+    vector<string> expected_words = {"caf\xC3\xA9", "na\xC3\xAFve", "dontstop"};
+    bool known_words_match = known_words.size() == expected_words.size();
+    for (size_t word_index = 0; known_words_match && word_index < expected_words.size(); word_index++) {
+        known_words_match = known_words[word_index] == expected_words[word_index];
+    }
+    expect_check(known_words_match, "known passage tokenizes to cafe, naive, dontstop");
+
+    mt19937_64 random_generator(TEST_RANDOM_SEED);
+    for (size_t passage_index = 0; passage_index < RANDOM_PASSAGE_COUNT; passage_index++) {
+        string text_passage = generate_random_passage(random_generator, MIXED_PASSAGE_FRAGMENTS, random_generator() % 300);
+        TokenizedPassage reference_words = extract_words_with_kernel(text_passage, TokenizerKernel::Scalar);
+        for (TokenizerKernel tokenizer_kernel : {TokenizerKernel::SSE2, TokenizerKernel::AVX2, TokenizerKernel::AVX512}) {
+            if (!tokenizer_kernel_supported(tokenizer_kernel)) {
+                continue;
+            }
+            TokenizedPassage kernel_words = extract_words_with_kernel(text_passage, tokenizer_kernel);
+            bool kernel_matches = kernel_words.size() == reference_words.size();
+            for (size_t word_index = 0; kernel_matches && word_index < reference_words.size(); word_index++) {
+                kernel_matches = kernel_words[word_index] == reference_words[word_index];
+            }
+            expect_check(kernel_matches, string(tokenizer_kernel_name(tokenizer_kernel)) + " kernel matches scalar on passage " +
+                                             to_string(passage_index));
+        }
+        InternedTokenStream interned_words = intern_words_from_passage(text_passage);
+        bool interned_matches = interned_words.size() == reference_words.size();
+        for (size_t word_index = 0; interned_matches && word_index < reference_words.size(); word_index++) {
+            interned_matches = interned_words.vocabulary.word(interned_words.word_ids[word_index]) == reference_words[word_index];
+        }
+        expect_check(interned_matches, "interned stream matches scalar on passage " + to_string(passage_index));
+    }
+}
+
+/*
+ * Fused single-pass engine (user-004)
+ * The staged functions, the streaming analyzer fed in random pieces and
+ * the parallel engine must all reproduce the single pass bit for bit;
+ * parallel runs use passages large enough to be cut into several chunks
+ */
+static void test_single_pass_engine() {
+    mt19937_64 random_generator(TEST_RANDOM_SEED);
+    for (size_t passage_index = 0; passage_index < RANDOM_PASSAGE_COUNT; passage_index++) {
+        string text_passage = generate_random_passage(random_generator, MIXED_PASSAGE_FRAGMENTS, random_generator() % 300);
+        PassageAnalysisAccumulator single_pass_metrics = analyze_passage_in_single_pass(text_passage);
+        string passage_label = " on passage " + to_string(passage_index);
+
+        InternedTokenStream interned_words = intern_words_from_passage(text_passage);
+        PassageAnalysisAccumulator structure_metrics = perform_comprehensive_text_analysis(interned_words, text_passage);
+        PassageAnalysisAccumulator vocabulary_metrics = suggest_vocabulary_enhancements(interned_words);
+        PassageAnalysisAccumulator sentence_metrics = analyze_sentence_structure(text_passage);
+        expect_check(structure_metrics.total_character_count == single_pass_metrics.total_character_count &&
+                         structure_metrics.long_word_count == single_pass_metrics.long_word_count &&
+                         vocabulary_metrics.basic_vocabulary_count == single_pass_metrics.basic_vocabulary_count &&
+                         vocabulary_metrics.advanced_vocabulary_count == single_pass_metrics.advanced_vocabulary_count &&
+                         vocabulary_metrics.basic_vocabulary_examples == single_pass_metrics.basic_vocabulary_examples &&
+                         sentence_metrics.sentence_count == single_pass_metrics.sentence_count &&
+                         sentence_metrics.sentence_word_lengths == single_pass_metrics.sentence_word_lengths,
+                     "staged analysis matches the single pass" + passage_label);
+
+        StreamingPassageAnalyzer streaming_analyzer;
+        for (size_t piece_offset = 0; piece_offset < text_passage.size();) {
+            size_t piece_length = min<size_t>(1 + random_generator() % 40, text_passage.size() - piece_offset);
+            streaming_analyzer.append_text(string_view(text_passage).substr(piece_offset, piece_length));
+            piece_offset += piece_length;
+        }
+        // Below the sketch capacity the streamed vocabulary summary is exact
+        expect_check(passage_metrics_identical(streaming_analyzer.finish(), single_pass_metrics),
+                     "streamed analysis matches the single pass" + passage_label);
+    }
+
+    for (size_t passage_index = 0; passage_index < 3; passage_index++) {
+        string text_passage;
+        while (text_passage.size() < 3 * 1024 * 1024) {
+            text_passage += MIXED_PASSAGE_FRAGMENTS[random_generator() % MIXED_PASSAGE_FRAGMENTS.size()];
+        }
+        PassageAnalysisAccumulator single_pass_metrics = analyze_passage_in_single_pass(text_passage);
+        for (unsigned analysis_thread_count : {2u, 3u, 4u}) {
+            expect_check(passage_metrics_identical(analyze_passage_in_parallel(text_passage, analysis_thread_count),
+                                                   single_pass_metrics),
+                         "parallel analysis on " + to_string(analysis_thread_count) +
+                             " threads matches the single pass on large passage " + to_string(passage_index));
+        }
+    }
+}
+
+/*
+ * Batch corpus analysis (user-006)
+ * Pool tasks that submit more tasks all run before wait_until_idle
+ * returns. A corpus with repeated, empty, missing and split documents
+ * keeps its results in input order at every thread count; each repeat
+ * points at its earliest copy and every analyzed document matches the
+ * single-pass engine and the style linter run on its bytes
+ */
+static void test_document_corpus() {
+    for (unsigned worker_count : {1u, 3u, 8u}) {
+        WorkStealingThreadPool task_pool(worker_count);
+        atomic<uint64_t> finished_task_count{0};
+        for (int round_index = 0; round_index < 2; round_index++) {
+            for (int task_index = 0; task_index < 64; task_index++) {
+                task_pool.submit([&task_pool, &finished_task_count] {
+                    for (int nested_index = 0; nested_index < 16; nested_index++) {
+                        task_pool.submit([&finished_task_count] { finished_task_count++; });
+                    }
+                    finished_task_count++;
+                });
+            }
+            task_pool.wait_until_idle();
+            expect_check(finished_task_count.load() == uint64_t(round_index + 1) * 64 * 17,
+                         "every nested task ran before the pool went idle with " + to_string(worker_count) + " workers");
+        }
+    }
+
+    filesystem::path corpus_directory = filesystem::temp_directory_path() /
+                                        ("text_analysis_tests_corpus_" + to_string(random_device()()));
+    filesystem::create_directories(corpus_directory);
+    mt19937_64 random_generator(TEST_RANDOM_SEED);
+    string first_passage = "In order to win, we basically need to think outside the box. It is very important.";
+    string second_passage = generate_random_passage(random_generator, MIXED_PASSAGE_FRAGMENTS, 300);
+    string large_passage;
+    while (large_passage.size() < 3 * 1024 * 1024) {
+        large_passage += generate_random_passage(random_generator, MIXED_PASSAGE_FRAGMENTS, 1000);
+    }
+    expect_check(parallel_chunk_count(large_passage.size(), 4) > 1, "the large document is split into chunks");
+
+    // Content of each listed document; the missing one is never written
+    const vector<pair<string, const string*>> corpus_documents = {
+        {"first.txt", &first_passage},      {"large.txt", &large_passage},  {"empty.txt", nullptr},
+        {"missing.txt", nullptr},           {"first_copy.txt", &first_passage}, {"second.txt", &second_passage},
+        {"large_copy.txt", &large_passage}, {"first_again.txt", &first_passage}, {"second_copy.txt", &second_passage},
+    };
+    vector<string> document_paths;
+    for (const auto& [document_name, document_text] : corpus_documents) {
+        document_paths.push_back((corpus_directory / document_name).string());
+        if (document_name != "missing.txt") {
+            ofstream(document_paths.back(), ios::binary) << (document_text != nullptr ? *document_text : "");
+        }
+    }
+
+    StyleLinter style_linter;
+    vector<PassageAnalysisAccumulator> expected_metrics;
+    vector<StyleLintReport> expected_style_reports;
+    for (const auto& corpus_document : corpus_documents) {
+        const string* document_text = corpus_document.second;
+        expected_metrics.push_back(document_text != nullptr ? analyze_passage_in_single_pass(*document_text)
+                                                            : PassageAnalysisAccumulator());
+        expected_style_reports.push_back(document_text != nullptr ? style_linter.lint_passage(*document_text)
+                                                                  : StyleLintReport());
+    }
+
+    for (unsigned analysis_thread_count : {1u, 2u, 4u, 8u}) {
+        for (int run_index = 0; run_index < 4; run_index++) {
+            string run_label = " with " + to_string(analysis_thread_count) + " threads, run " + to_string(run_index);
+            vector<DocumentAnalysisResult> document_results =
+                analyze_document_corpus(document_paths, analysis_thread_count, nullptr, nullptr, &style_linter);
+            expect_check(document_results.size() == document_paths.size(), "one result per document" + run_label);
+            if (document_results.size() != document_paths.size()) {
+                continue;
+            }
+
+            for (size_t document_index = 0; document_index < document_paths.size(); document_index++) {
+                const DocumentAnalysisResult& document_result = document_results[document_index];
+                const string* document_text = corpus_documents[document_index].second;
+                string document_label = " for " + corpus_documents[document_index].first + run_label;
+                expect_check(document_result.document_path == document_paths[document_index], "input order" + document_label);
+
+                if (document_text == nullptr) {
+                    expect_check(!document_result.analysis_succeeded && !document_result.error_description.empty() &&
+                                     document_result.document_bytes == 0,
+                                 "an unreadable or empty document fails with a description" + document_label);
+                    continue;
+                }
+
+                // Repeats share the passage object, so the earliest copy is the first entry pointing at it
+                size_t earliest_copy = document_index;
+                for (size_t copy_index = 0; copy_index < document_index && earliest_copy == document_index; copy_index++) {
+                    if (corpus_documents[copy_index].second == document_text) {
+                        earliest_copy = copy_index;
+                    }
+                }
+                size_t expected_duplicate =
+                    earliest_copy == document_index ? DocumentAnalysisResult::NO_DUPLICATE_DOCUMENT : earliest_copy;
+                expect_check(document_result.duplicate_of_document == expected_duplicate,
+                             "a repeat points at its earliest copy" + document_label);
+                expect_check(document_result.analysis_succeeded && document_result.document_bytes == document_text->size() &&
+                                 passage_metrics_identical(document_result.passage_metrics, expected_metrics[document_index]),
+                             "metrics match the single-pass engine" + document_label);
+                expect_check(style_reports_identical(document_result.style_report, expected_style_reports[document_index]),
+                             "style report matches the linter" + document_label);
+            }
+        }
+    }
+    filesystem::remove_all(corpus_directory);
+}
+
+/*
+ * One field of a parsed JSON or CSV record
+ * Quoted values are decoded; bare values (numbers, literals, unquoted
+ * CSV cells) are kept as written
+ */
+struct ParsedReportField {
+    string field_name;
+    string field_value;
+    bool value_quoted = false;
+};
+
+/*
+ * Decode a JSON string at the front of the input, rejecting raw control
+ * bytes and unknown escapes
+ */
+static bool parse_json_string(string_view& input, string& decoded_text) {
+    if (input.empty() || input[0] != '"') {
+        return false;
+    }
+    input.remove_prefix(1);
+    decoded_text.clear();
+    while (!input.empty()) {
+        char character = input[0];
+        input.remove_prefix(1);
+        if (character == '"') {
+            return true;
+        }
+        if (static_cast<unsigned char>(character) < 0x20) {
+            return false;
+        }
+        if (character != '\\') {
+            decoded_text.push_back(character);
+            continue;
+        }
+        if (input.empty()) {
+            return false;
+        }
+        char escape_code = input[0];
+        input.remove_prefix(1);
+        unsigned code_point = 0;
+        if (escape_code == '"' || escape_code == '\\' || escape_code == '/') {
+            decoded_text.push_back(escape_code);
+        } else if (escape_code == 'u' && input.size() >= 4 &&
+                   from_chars(input.data(), input.data() + 4, code_point, 16).ptr == input.data() + 4 && code_point < 0x80) {
+            decoded_text.push_back(static_cast<char>(code_point));
+            input.remove_prefix(4);
+        } else {
+            return false;
+        }
+    }
+    return false;
+}
+
+/*
+ * Parse one flat JSON object at the front of the input
+ */
+static bool parse_json_record(string_view& input, vector<ParsedReportField>& record_fields) {
+    record_fields.clear();
+    if (input.empty() || input[0] != '{') {
+        return false;
+    }
+    input.remove_prefix(1);
+    if (!input.empty() && input[0] == '}') {
+        input.remove_prefix(1);
+        return true;
+    }
+    while (true) {
+        ParsedReportField record_field;
+        if (!parse_json_string(input, record_field.field_name) || input.empty() || input[0] != ':') {
+            return false;
+        }
+        input.remove_prefix(1);
+        if (!input.empty() && input[0] == '"') {
+            record_field.value_quoted = true;
+            if (!parse_json_string(input, record_field.field_value)) {
+                return false;
+            }
+        } else {
+            size_t value_end = input.find_first_of(",}");
+            if (value_end == string_view::npos || value_end == 0) {
+                return false;
+            }
+            record_field.field_value = string(input.substr(0, value_end));
+            input.remove_prefix(value_end);
+        }
+        record_fields.push_back(move(record_field));
+        if (input.empty()) {
+            return false;
+        }
+        char separator = input[0];
+        input.remove_prefix(1);
+        if (separator == '}') {
+            return true;
+        }
+        if (separator != ',') {
+            return false;
+        }
+    }
+}
+
+/*
+ * Parse one CSV row at the front of the input, up to and including its
+ * newline; quoted cells may hold commas, doubled quotes and newlines
+ */
+static bool parse_csv_row(string_view& input, vector<ParsedReportField>& row_fields) {
+    row_fields.clear();
+    while (true) {
+        ParsedReportField row_field;
+        if (!input.empty() && input[0] == '"') {
+            row_field.value_quoted = true;
+            input.remove_prefix(1);
+            while (true) {
+                if (input.empty()) {
+                    return false;
+                }
+                char character = input[0];
+                input.remove_prefix(1);
+                if (character != '"') {
+                    row_field.field_value.push_back(character);
+                } else if (!input.empty() && input[0] == '"') {
+                    row_field.field_value.push_back('"');
+                    input.remove_prefix(1);
+                } else {
+                    break;
+                }
+            }
+        } else {
+            size_t cell_end = input.find_first_of(",\n");
+            if (cell_end == string_view::npos || input.substr(0, cell_end).find_first_of("\"\r") != string_view::npos) {
+                return false;
+            }
+            row_field.field_value = string(input.substr(0, cell_end));
+            input.remove_prefix(cell_end);
+        }
+        row_fields.push_back(move(row_field));
+        if (input.empty()) {
+            return false;
+        }
+        char separator = input[0];
+        input.remove_prefix(1);
+        if (separator == '\n') {
+            return true;
+        }
+        if (separator != ',') {
+            return false;
+        }
+    }
+}
+
+/*
+ * Structured reports (user-010)
+ * JSON, NDJSON and CSV reports parse back with a strict reader to the
+ * same document paths, however many quotes, backslashes, control bytes,
+ * commas and newlines they hold. Records carry the fields of
+ * structured_report_field_names() in order, or only the selected metrics
+ * and document identity; CSV headers name the same columns. Metrics
+ * undefined without words are null or empty, and a failed document
+ * leaves every metric so
+ */
+static void test_structured_reports() {
+    const vector<string> field_names = structured_report_field_names();
+    expect_check(field_names.size() > 40 && vector<string>(field_names.begin(), field_names.begin() + 4) ==
+                                                vector<string>{"document", "bytes", "analyzed", "error"},
+                 "field names start with the document identity and status");
+    vector<string> sorted_field_names = field_names;
+    sort(sorted_field_names.begin(), sorted_field_names.end());
+    expect_check(adjacent_find(sorted_field_names.begin(), sorted_field_names.end()) == sorted_field_names.end(),
+                 "field names are unique");
+
+    StyleLinter style_linter;
+    vector<DocumentAnalysisResult> document_results(3);
+    string worded_passage = "In order to win, we basically need to think outside the box. It is very important.";
+    document_results[0].document_path = "dir\\sub/\"quoted\", name\nline\r\x01\x1f\tend caf\xC3\xA9.txt";
+    document_results[0].document_bytes = worded_passage.size();
+    document_results[0].passage_metrics = analyze_passage_in_single_pass(worded_passage);
+    document_results[0].style_report = style_linter.lint_passage(worded_passage);
+    document_results[0].analysis_succeeded = true;
+    document_results[1].document_path = "numbers only\r2024.txt";
+    document_results[1].document_bytes = 12;
+    document_results[1].passage_metrics = analyze_passage_in_single_pass("1999, 2024.");
+    document_results[1].analysis_succeeded = true;
+    document_results[2].document_path = "\"missing\"";
+    document_results[2].error_description = "cannot open '\"missing\"': No such file, or directory\n";
+    expect_check(document_results[0].document_path.back() == 't' && document_results[0].passage_metrics.total_word_count > 0 &&
+                     document_results[1].passage_metrics.total_word_count == 0,
+                 "the report documents hold words, no words and no analysis");
+
+    // Fields that must be present, and those absent for a passage without words
+    const vector<string> word_dependent_fields = {"average_word_length", "minimum_word_length", "type_token_ratio",
+                                                  "complexity_score", "complexity_band", "flesch_reading_ease",
+                                                  "smog_index", "coleman_liau_index"};
+    const vector<vector<string>> metric_selections = {{}, {"smog_index", "total_words", "error", "style_findings"}};
+    for (ReportOutputFormat output_format : {ReportOutputFormat::JSON, ReportOutputFormat::NDJSON, ReportOutputFormat::CSV}) {
+        for (const vector<string>& selected_metrics : metric_selections) {
+            string report_label = " in format " + to_string(static_cast<int>(output_format)) +
+                                  (selected_metrics.empty() ? "" : " with selected metrics");
+            vector<string> expected_field_names;
+            for (const string& field_name : field_names) {
+                if (selected_metrics.empty() || field_name == "document" || field_name == "analyzed" ||
+                    find(selected_metrics.begin(), selected_metrics.end(), field_name) != selected_metrics.end()) {
+                    expected_field_names.push_back(field_name);
+                }
+            }
+
+            string report_text;
+            render_structured_document_report(report_text, output_format, document_results, 0.25, selected_metrics);
+            string_view remaining_report = report_text;
+            vector<vector<ParsedReportField>> parsed_records(document_results.size());
+            bool report_parsed = true;
+            if (output_format == ReportOutputFormat::CSV) {
+                vector<ParsedReportField> header_fields;
+                report_parsed = parse_csv_row(remaining_report, header_fields);
+                vector<string> header_names;
+                for (const ParsedReportField& header_field : header_fields) {
+                    header_names.push_back(header_field.field_value);
+                    report_parsed = report_parsed && !header_field.value_quoted;
+                }
+                expect_check(header_names == expected_field_names, "CSV header lists the record fields in order" + report_label);
+                for (vector<ParsedReportField>& parsed_record : parsed_records) {
+                    report_parsed = report_parsed && parse_csv_row(remaining_report, parsed_record);
+                    for (size_t field_index = 0; field_index < parsed_record.size() && field_index < header_names.size();
+                         field_index++) {
+                        parsed_record[field_index].field_name = header_names[field_index];
+                    }
+                }
+                report_parsed = report_parsed && remaining_report.empty();
+            } else if (output_format == ReportOutputFormat::NDJSON) {
+                for (vector<ParsedReportField>& parsed_record : parsed_records) {
+                    report_parsed = report_parsed && parse_json_record(remaining_report, parsed_record) &&
+                                    !remaining_report.empty() && remaining_report[0] == '\n';
+                    remaining_report.remove_prefix(min<size_t>(1, remaining_report.size()));
+                }
+                report_parsed = report_parsed && remaining_report.empty();
+            } else {
+                const string_view DOCUMENTS_OPENING = "{\"documents\":[";
+                const string_view SUMMARY_OPENING = "],\"summary\":";
+                report_parsed = remaining_report.substr(0, DOCUMENTS_OPENING.size()) == DOCUMENTS_OPENING;
+                remaining_report.remove_prefix(min(DOCUMENTS_OPENING.size(), remaining_report.size()));
+                for (size_t record_index = 0; record_index < parsed_records.size() && report_parsed; record_index++) {
+                    if (record_index > 0) {
+                        report_parsed = !remaining_report.empty() && remaining_report[0] == ',';
+                        remaining_report.remove_prefix(1);
+                    }
+                    report_parsed = report_parsed && parse_json_record(remaining_report, parsed_records[record_index]);
+                }
+                vector<ParsedReportField> summary_fields;
+                report_parsed = report_parsed && remaining_report.substr(0, SUMMARY_OPENING.size()) == SUMMARY_OPENING;
+                remaining_report.remove_prefix(min(SUMMARY_OPENING.size(), remaining_report.size()));
+                report_parsed = report_parsed && parse_json_record(remaining_report, summary_fields) && remaining_report == "}\n";
+                expect_check(summary_fields.size() >= 2 && summary_fields[1].field_name == "documents_analyzed" &&
+                                 summary_fields[1].field_value == "2",
+                             "JSON summary counts the analyzed documents" + report_label);
+            }
+            expect_check(report_parsed, "report parses back" + report_label);
+            if (!report_parsed) {
+                continue;
+            }
+
+            for (size_t record_index = 0; record_index < parsed_records.size(); record_index++) {
+                const DocumentAnalysisResult& document_result = document_results[record_index];
+                const vector<ParsedReportField>& parsed_record = parsed_records[record_index];
+                string record_label = " in record " + to_string(record_index) + report_label;
+                vector<string> record_field_names;
+                for (const ParsedReportField& record_field : parsed_record) {
+                    record_field_names.push_back(record_field.field_name);
+                }
+                expect_check(record_field_names == expected_field_names, "record fields match the header" + record_label);
+                if (record_field_names != expected_field_names) {
+                    continue;
+                }
+
+                auto field_value = [&](const string& field_name) -> const ParsedReportField* {
+                    size_t field_index = find(expected_field_names.begin(), expected_field_names.end(), field_name) -
+                                         expected_field_names.begin();
+                    return field_index < parsed_record.size() ? &parsed_record[field_index] : nullptr;
+                };
+                auto value_missing = [&](const ParsedReportField* record_field) {
+                    return record_field != nullptr && !record_field->value_quoted &&
+                           record_field->field_value == (output_format == ReportOutputFormat::CSV ? "" : "null");
+                };
+
+                expect_check(field_value("document")->field_value == document_result.document_path,
+                             "document path survives escaping" + record_label);
+                expect_check(field_value("analyzed")->field_value == (document_result.analysis_succeeded ? "true" : "false"),
+                             "analyzed flag" + record_label);
+                if (output_format != ReportOutputFormat::CSV) {
+                    for (const ParsedReportField& record_field : parsed_record) {
+                        bool literal_value = record_field.value_quoted || record_field.field_value == "null" ||
+                                             record_field.field_value == "true" || record_field.field_value == "false" ||
+                                             strspn(record_field.field_value.c_str(), "0123456789.-+e") ==
+                                                 record_field.field_value.size();
+                        expect_check(literal_value, "JSON value of " + record_field.field_name + " is valid" + record_label);
+                    }
+                }
+
+                const ParsedReportField* error_field = field_value("error");
+                if (error_field != nullptr) {
+                    expect_check(document_result.analysis_succeeded
+                                     ? value_missing(error_field)
+                                     : error_field->field_value == document_result.error_description,
+                                 "error is empty on success and escaped on failure" + record_label);
+                }
+                const ParsedReportField* total_words_field = field_value("total_words");
+                if (total_words_field != nullptr) {
+                    string total_words = to_string(document_result.passage_metrics.total_word_count);
+                    expect_check(document_result.analysis_succeeded ? total_words_field->field_value == total_words
+                                                                    : value_missing(total_words_field),
+                                 "total_words is counted for every analyzed document" + record_label);
+                }
+                for (const string& field_name : word_dependent_fields) {
+                    const ParsedReportField* record_field = field_value(field_name);
+                    if (record_field != nullptr) {
+                        bool words_present = document_result.analysis_succeeded &&
+                                             document_result.passage_metrics.total_word_count > 0;
+                        expect_check(value_missing(record_field) != words_present,
+                                     field_name + " is present exactly when there are words" + record_label);
+                    }
+                }
+                const ParsedReportField* style_findings_field = field_value("style_findings");
+                if (style_findings_field != nullptr && record_index == 0) {
+                    expect_check(style_findings_field->field_value.find("in order to:1") != string::npos,
+                                 "style findings are listed" + record_label);
+                }
+            }
+        }
+    }
+}
+
+/*
+ * Result cache round trip (user-013)
+ * Metrics and style reports must survive the memory tier, the disk tier
+ * and a restart; a rules change, a damaged file and the disk byte bound
+ * must each turn the entry away. The cache directory is removed afterwards
+ */
+static void test_result_cache() {
+    filesystem::path cache_directory = filesystem::temp_directory_path() /
+                                       ("text_analysis_tests_cache_" + to_string(random_device()()));
+    filesystem::remove_all(cache_directory);
+
+    string text_passage = "In order to win, we basically need to think outside the box. It is very important.";
+    PassageContentHash content_hash = hash_passage_content(text_passage);
+    PassageAnalysisAccumulator passage_metrics = analyze_passage_in_single_pass(text_passage);
+    StyleLinter style_linter;
+    StyleLintReport style_report = style_linter.lint_passage(text_passage);
+    expect_check(style_report.total_match_count > 0, "the cached passage has style findings to round-trip");
+
+    PassageAnalysisAccumulator cached_metrics;
+    StyleLintReport cached_style_report;
+    {
+        AnalysisResultCache result_cache(8, cache_directory.string());
+        expect_check(!result_cache.lookup(content_hash, cached_metrics), "an empty cache misses");
+        result_cache.store(content_hash, passage_metrics, style_report);
+        expect_check(result_cache.lookup(content_hash, cached_metrics, &style_linter, &cached_style_report) &&
+                         passage_metrics_identical(cached_metrics, passage_metrics) &&
+                         style_reports_identical(cached_style_report, style_report),
+                     "a memory hit returns the stored metrics and style report");
+    }
+    {
+        AnalysisResultCache restarted_cache(8, cache_directory.string());
+        cached_metrics = PassageAnalysisAccumulator();
+        cached_style_report = StyleLintReport();
+        expect_check(restarted_cache.lookup(content_hash, cached_metrics, &style_linter, &cached_style_report) &&
+                         restarted_cache.statistics().disk_hits == 1 &&
+                         passage_metrics_identical(cached_metrics, passage_metrics) &&
+                         style_reports_identical(cached_style_report, style_report),
+                     "a disk hit after a restart returns the stored metrics and style report");
+
+        StyleLinter changed_linter;
+        string error_description;
+        changed_linter.add_rule({StyleIssueCategory::Filler, "outside the box", ""}, error_description);
+        expect_check(!restarted_cache.lookup(content_hash, cached_metrics, &changed_linter, &cached_style_report),
+                     "an entry linted under other rules misses");
+    }
+
+    for (const filesystem::directory_entry& cache_entry : filesystem::directory_iterator(cache_directory)) {
+        ofstream(cache_entry.path(), ios::binary | ios::trunc) << "not a cache entry";
+    }
+    {
+        AnalysisResultCache damaged_cache(8, cache_directory.string());
+        expect_check(!damaged_cache.lookup(content_hash, cached_metrics), "a damaged disk entry misses");
+        expect_check(filesystem::is_empty(cache_directory), "a damaged disk entry is deleted");
+    }
+
+    // Each entry exceeds one byte, so the bound keeps only the newest
+    vector<PassageContentHash> stored_hashes;
+    {
+        AnalysisResultCache bounded_cache(8, cache_directory.string(), 1);
+        for (size_t passage_index = 0; passage_index < 5; passage_index++) {
+            string numbered_passage = text_passage + " Passage " + to_string(passage_index) + ".";
+            stored_hashes.push_back(hash_passage_content(numbered_passage));
+            bounded_cache.store(stored_hashes.back(), analyze_passage_in_single_pass(numbered_passage));
+        }
+        AnalysisCacheStatistics cache_statistics = bounded_cache.statistics();
+        expect_check(cache_statistics.disk_entries == 1 && cache_statistics.disk_evictions == 4,
+                     "the disk byte bound evicts all but the newest entry");
+    }
+    {
+        AnalysisResultCache reopened_cache(8, cache_directory.string(), 1);
+        expect_check(reopened_cache.lookup(stored_hashes.back(), cached_metrics) &&
+                         !reopened_cache.lookup(stored_hashes.front(), cached_metrics),
+                     "only the newest entry survives the disk byte bound");
+    }
+    filesystem::remove_all(cache_directory);
+}
+
+/*
+ * Incremental re-analysis (user-014)
+ * After every random insert, erase or replace the analyzer's text and
+ * metrics must match a batch analysis of the edited passage. The
+ * complexity sum is merged by tree shape, so it may differ in the last bits
+ */
+static void test_incremental_analysis() {
+    mt19937_64 random_generator(TEST_RANDOM_SEED);
+    for (size_t passage_index = 0; passage_index < RANDOM_PASSAGE_COUNT / 4; passage_index++) {
+        string edited_passage = generate_random_passage(random_generator, MIXED_PASSAGE_FRAGMENTS, random_generator() % 200);
+        IncrementalPassageAnalyzer incremental_analyzer(edited_passage);
+        for (size_t edit_index = 0; edit_index < 20; edit_index++) {
+            size_t edit_offset = random_generator() % (edited_passage.size() + 1);
+            size_t erased_length = min<size_t>(random_generator() % 24, edited_passage.size() - edit_offset);
+            string inserted_text = generate_random_passage(random_generator, MIXED_PASSAGE_FRAGMENTS, random_generator() % 4);
+            incremental_analyzer.replace_text(edit_offset, erased_length, inserted_text);
+            edited_passage.replace(edit_offset, erased_length, inserted_text);
+
+            PassageAnalysisAccumulator batch_metrics = analyze_passage_in_single_pass(edited_passage);
+            PassageAnalysisAccumulator incremental_metrics = incremental_analyzer.passage_metrics();
+            bool complexity_close = fabs(incremental_metrics.complexity_accumulator - batch_metrics.complexity_accumulator) <=
+                                    1e-9 * (1.0 + fabs(batch_metrics.complexity_accumulator));
+            incremental_metrics.complexity_accumulator = batch_metrics.complexity_accumulator;
+            bool metrics_match = incremental_analyzer.text() == edited_passage && complexity_close &&
+                                 passage_metrics_identical(incremental_metrics, batch_metrics);
+            expect_check(metrics_match, "incremental analysis matches batch after edit " + to_string(edit_index) +
+                                            " of passage " + to_string(passage_index));
+            if (!metrics_match) {
+                break;
+            }
+        }
+    }
+}
+
+/*
+ * Streaming vocabulary sketches (user-020)
+ * HyperLogLog estimates stay within DISTINCT_ESTIMATE_ERROR_LIMIT standard
+ * errors of known cardinalities. On a Zipf stream every Space-Saving
+ * counter brackets its word's true count, is over by at most the error
+ * bound total / COUNTER_CAPACITY, and every word above that bound is
+ * tracked. A flat stream, where no word clears the bound, reports no
+ * frequent words at all
+ */
+static void test_streaming_sketches() {
+    const double DISTINCT_ESTIMATE_STANDARD_ERROR = 1.04 / sqrt(double(size_t(1) << DistinctCountSketch::PRECISION_BITS));
+    const double DISTINCT_ESTIMATE_ERROR_LIMIT = 4.0;
+    for (uint64_t stream_offset = 0; stream_offset < 4; stream_offset++) {
+        for (uint64_t distinct_count : {1, 10, 100, 1000, 20000, 200000, 2000000}) {
+            DistinctCountSketch distinct_sketch;
+            for (uint64_t hash_index = 0; hash_index < distinct_count; hash_index++) {
+                // Every hash is recorded twice; repeats must not move the estimate
+                uint64_t word_hash = (hash_index + (stream_offset << 32)) * 0x9E3779B97F4A7C15ULL;
+                distinct_sketch.record_hash(word_hash);
+                distinct_sketch.record_hash(word_hash);
+            }
+            double relative_error = fabs(double(distinct_sketch.estimate()) - double(distinct_count)) / double(distinct_count);
+            expect_check(relative_error <= DISTINCT_ESTIMATE_ERROR_LIMIT * DISTINCT_ESTIMATE_STANDARD_ERROR,
+                         "distinct estimate " + to_string(distinct_sketch.estimate()) + " of " + to_string(distinct_count) +
+                             " hashes is within " + to_string(DISTINCT_ESTIMATE_ERROR_LIMIT) + " standard errors");
+        }
+    }
+
+    const size_t ZIPF_VOCABULARY_SIZE = 20000;
+    const size_t ZIPF_STREAM_WORDS = 500000;
+    mt19937_64 random_generator(TEST_RANDOM_SEED);
+    vector<double> rank_weights(ZIPF_VOCABULARY_SIZE);
+    vector<string> zipf_words(ZIPF_VOCABULARY_SIZE);
+    for (size_t word_rank = 0; word_rank < ZIPF_VOCABULARY_SIZE; word_rank++) {
+        rank_weights[word_rank] = 1.0 / double(word_rank + 1);
+        zipf_words[word_rank] = "w" + spell_number_in_letters(word_rank);
+    }
+    discrete_distribution<size_t> rank_distribution(rank_weights.begin(), rank_weights.end());
+    HeavyHitterSketch heavy_hitter_sketch;
+    vector<uint64_t> true_counts(ZIPF_VOCABULARY_SIZE, 0);
+    for (size_t word_index = 0; word_index < ZIPF_STREAM_WORDS; word_index++) {
+        size_t word_rank = rank_distribution(random_generator);
+        true_counts[word_rank]++;
+        const string& zipf_word = zipf_words[word_rank];
+        heavy_hitter_sketch.record_word(zipf_word, hash<string>()(zipf_word), zipf_word.size());
+    }
+
+    uint64_t count_error_bound = heavy_hitter_sketch.recorded_word_count() / HeavyHitterSketch::COUNTER_CAPACITY;
+    expect_check(heavy_hitter_sketch.recorded_word_count() == ZIPF_STREAM_WORDS, "every Zipf word is recorded");
+    expect_check(heavy_hitter_sketch.counters().size() <= HeavyHitterSketch::COUNTER_CAPACITY, "counters stay within capacity");
+    vector<bool> word_tracked(ZIPF_VOCABULARY_SIZE, false);
+    for (const HeavyHitterSketch::WordCounter& word_counter : heavy_hitter_sketch.counters()) {
+        size_t word_rank = find(zipf_words.begin(), zipf_words.end(), word_counter.word) - zipf_words.begin();
+        if (word_rank == ZIPF_VOCABULARY_SIZE) {
+            expect_check(false, "counter holds a word from the stream: " + word_counter.word);
+            continue;
+        }
+        word_tracked[word_rank] = true;
+        uint64_t true_count = true_counts[word_rank];
+        expect_check(word_counter.estimated_count >= true_count, "estimate of " + word_counter.word + " is never below its count");
+        expect_check(word_counter.estimated_count - word_counter.overestimate <= true_count,
+                     "guaranteed count of " + word_counter.word + " is never above its count");
+        expect_check(word_counter.estimated_count - true_count <= count_error_bound,
+                     "estimate of " + word_counter.word + " is within the error bound");
+    }
+    size_t heavy_word_count = 0;
+    for (size_t word_rank = 0; word_rank < ZIPF_VOCABULARY_SIZE; word_rank++) {
+        if (true_counts[word_rank] > count_error_bound) {
+            heavy_word_count++;
+            expect_check(word_tracked[word_rank], "word " + zipf_words[word_rank] + " above the error bound is tracked");
+        }
+    }
+    expect_check(heavy_word_count > 50, "the Zipf stream has words above the error bound");
+
+    // Advanced words (over eight letters) drawn uniformly, plus one word frequent enough to report
+    const size_t FLAT_VOCABULARY_SIZE = 20000;
+    const size_t FLAT_STREAM_WORDS = 300000;
+    const size_t FREQUENT_WORD_INTERVAL = 20;
+    vector<string> flat_words(FLAT_VOCABULARY_SIZE);
+    for (size_t word_index = 0; word_index < FLAT_VOCABULARY_SIZE; word_index++) {
+        flat_words[word_index] = "zanthoxyl" + spell_number_in_letters(word_index);
+    }
+    for (bool include_frequent_word : {false, true}) {
+        StreamingPassageAnalyzer streaming_analyzer;
+        string text_piece;
+        uint64_t frequent_word_count = 0;
+        for (size_t word_index = 0; word_index < FLAT_STREAM_WORDS; word_index++) {
+            if (include_frequent_word && word_index % FREQUENT_WORD_INTERVAL == 0) {
+                text_piece += "quintessential";
+                frequent_word_count++;
+            } else {
+                text_piece += flat_words[random_generator() % FLAT_VOCABULARY_SIZE];
+            }
+            text_piece += word_index % 17 == 16 ? ". " : " ";
+            if (text_piece.size() >= 4096) {
+                streaming_analyzer.append_text(text_piece);
+                text_piece.clear();
+            }
+        }
+        streaming_analyzer.append_text(text_piece);
+        PassageAnalysisAccumulator streamed_metrics = streaming_analyzer.finish();
+
+        expect_check(streamed_metrics.vocabulary_estimated, "streamed vocabulary is marked estimated");
+        expect_check(streamed_metrics.total_word_count == FLAT_STREAM_WORDS, "every flat word is counted");
+        if (!include_frequent_word) {
+            expect_check(streamed_metrics.frequent_advanced_words.empty(),
+                         "a flat stream reports no frequent advanced words, got " +
+                             to_string(streamed_metrics.frequent_advanced_words.size()));
+        } else {
+            bool frequent_word_reported = !streamed_metrics.frequent_advanced_words.empty() &&
+                                          streamed_metrics.frequent_advanced_words[0].word == "quintessential" &&
+                                          streamed_metrics.frequent_advanced_words[0].occurrence_count <= frequent_word_count;
+            expect_check(frequent_word_reported, "a word above the error bound is reported first with a count no higher than " +
+                                                     to_string(frequent_word_count));
+            expect_check(streamed_metrics.frequent_advanced_words.size() == 1,
+                         "only the frequent word stands out of the flat stream");
+        }
+    }
+}
+
+/*
+ * Readability indices (user-021)
+ * The syllable estimate matches a hand-checked word list except on the
+ * listed misses, which stay within one syllable. The five indices of a
+ * fixed passage match values worked out by hand from its counts, on
+ * every engine, and passages without words are marked so reports can
+ * leave the indices out
+ */
+static void test_readability_indices() {
+    const vector<pair<string, size_t>> syllable_cases = {
+        {"the", 1}, {"make", 1}, {"makes", 1}, {"table", 2}, {"jumped", 1}, {"wanted", 2}, {"boxes", 2}, {"people", 2},
+        {"implementation", 5}, {"artificial", 4}, {"intelligence", 4}, {"technologies", 5}, {"comprehensive", 4},
+        {"understanding", 4}, {"algorithmic", 4}, {"processes", 3}, {"computational", 5}, {"modern", 2}, {"systems", 2},
+        {"utilize", 3}, {"sophisticated", 5}, {"machine", 2}, {"learning", 2}, {"frameworks", 2}, {"analyze", 3},
+        {"complex", 2}, {"data", 2}, {"patterns", 2}, {"generate", 3}, {"predictive", 3}, {"models", 2},
+        {"organizations", 5}, {"must", 1}, {"consider", 3}, {"ethical", 3}, {"implications", 4}, {"while", 1},
+        {"developing", 4}, {"these", 1}, {"advanced", 2}, {"technological", 5}, {"solutions", 3}, {"for", 1},
+        {"applications", 4}, {"and", 1}, {"user", 2}, {"interactions", 4}, {"caf\xC3\xA9", 2}, {"na\xC3\xAFve", 2},
+        {"r\xC3\xA9sum\xC3\xA9", 3}, {"rhythm", 2}, {"every", 3}, {"hello", 2}, {"world", 1}, {"beautiful", 3},
+        {"queue", 1}, {"you", 1}, {"area", 3}, {"create", 2}, {"little", 2}, {"whale", 1}, {"fire", 1}, {"going", 2},
+        {"readability", 5}};
+    // Vowel groups miss the split "ie", "ea" and "oi", the silent "e" inside a compound and a syllable without vowels
+    const vector<string> syllable_misses = {"technologies", "frameworks", "area", "create", "going", "rhythm"};
+    for (const auto& [listed_word, listed_syllables] : syllable_cases) {
+        size_t estimated_syllables = estimate_syllable_count(listed_word);
+        bool listed_miss = find(syllable_misses.begin(), syllable_misses.end(), listed_word) != syllable_misses.end();
+        expect_check(listed_miss ? estimated_syllables != listed_syllables &&
+                                       estimated_syllables + 1 >= listed_syllables && estimated_syllables <= listed_syllables + 1
+                                 : estimated_syllables == listed_syllables,
+                     "'" + listed_word + "' estimated at " + to_string(estimated_syllables) + " syllables, listed " +
+                         to_string(listed_syllables) + (listed_miss ? " as a known miss" : ""));
+    }
+
+    // 12 words of 48 letters and 17 syllables in 2 sentences; "beautiful" and "afternoon" have three syllables
+    string fixed_passage = "The cat sat on the mat. It was one beautiful, sunny afternoon.";
+    StreamingPassageAnalyzer streaming_analyzer;
+    streaming_analyzer.append_text(fixed_passage);
+    for (const PassageAnalysisAccumulator& passage_metrics :
+         {analyze_passage_in_single_pass(fixed_passage), analyze_text_passage(fixed_passage).passage_metrics,
+          streaming_analyzer.finish()}) {
+        expect_check(passage_metrics.total_word_count == 12 && passage_metrics.total_character_count == 48 &&
+                         passage_metrics.syllable_count == 17 && passage_metrics.polysyllabic_word_count == 2 &&
+                         passage_metrics.sentence_count == 2,
+                     "fixed passage counts");
+        // Flesch: 206.835 - 1.015 * 6 - 84.6 * 17 / 12, and 0.39 * 6 + 11.8 * 17 / 12 - 15.59
+        expect_check(fabs(passage_metrics.flesch_reading_ease() - 80.895) < 1e-6, "Flesch Reading Ease of the fixed passage");
+        expect_check(fabs(passage_metrics.flesch_kincaid_grade() - 3.4666666667) < 1e-6,
+                     "Flesch-Kincaid Grade of the fixed passage");
+        // Gunning Fog: 0.4 * (6 + 100 * 2 / 12); SMOG: 1.043 * sqrt(2 * 30 / 2) + 3.1291
+        expect_check(fabs(passage_metrics.gunning_fog_index() - 9.0666666667) < 1e-6, "Gunning Fog of the fixed passage");
+        expect_check(fabs(passage_metrics.smog_index() - 8.8418462748) < 1e-6, "SMOG of the fixed passage");
+        // Coleman-Liau: 0.0588 * 400 - 0.296 * 100 * 2 / 12 - 15.8
+        expect_check(fabs(passage_metrics.coleman_liau_index() - 2.7866666667) < 1e-6, "Coleman-Liau of the fixed passage");
+    }
+
+    for (const char* wordless_passage : {"", " \n\t", "... !? 42, 1999.", "a b c. x"}) {
+        AnalysisResult analysis_result = analyze_text_passage(wordless_passage);
+        expect_check(!analysis_result.contains_words && analysis_result.complexity_band[0] == '\0' &&
+                         analysis_result.passage_metrics.syllable_count == 0,
+                     "passage \"" + string(wordless_passage) + "\" is marked as having no words");
+    }
+    expect_check(analyze_text_passage("Go.").contains_words, "a one-word passage has words");
+}
+
+/*
+ * Sentence segmentation (user-022)
+ * Abbreviations, initialisms and decimals must not end a sentence, while
+ * an ellipsis does; the fused engine must count the same sentences
+ */
+static void test_sentence_segmentation() {
+    const pair<string, vector<string>> segmentation_cases[] = {
+        {"Dr. Smith went home. He slept.", {"Dr. Smith went home.", "He slept."}},
+        {"See e.g. the report. Done.", {"See e.g. the report.", "Done."}},
+        {"Pi is 3.14 today. Yes.", {"Pi is 3.14 today.", "Yes."}},
+        {"Wait... what? Fine.", {"Wait...", "what?", "Fine."}},
+        {"It ended\xE2\x80\xA6 Then more.", {"It ended\xE2\x80\xA6", "Then more."}},
+        {"He moved to the U.S.A. last year. Then he left.", {"He moved to the U.S.A. last year.", "Then he left."}},
+        {"He said \"stop.\" Then left.", {"He said \"stop.\"", "Then left."}},
+        {"Hello world", {"Hello world"}},
+        {"... ...", {}},
+    };
+    for (const auto& [text_passage, expected_sentences] : segmentation_cases) {
+        vector<SentenceSpan> sentence_spans = segment_sentences(text_passage);
+        bool sentences_match = sentence_spans.size() == expected_sentences.size();
+        for (size_t sentence_index = 0; sentences_match && sentence_index < sentence_spans.size(); sentence_index++) {
+            const SentenceSpan& sentence_span = sentence_spans[sentence_index];
+            sentences_match = text_passage.compare(sentence_span.start_offset, sentence_span.byte_length,
+                                                   expected_sentences[sentence_index]) == 0;
+        }
+        expect_check(sentences_match, "segmentation of \"" + text_passage + "\"");
+        expect_check(analyze_passage_in_single_pass(text_passage).sentence_count == expected_sentences.size(),
+                     "single-pass sentence count of \"" + text_passage + "\"");
+    }
+}
+
+/*
+ * Thesaurus perfect hash (user-023)
+ * Every headword of a generated dictionary must find exactly its own
+ * synonyms through the file's minimal perfect hash, other words none;
+ * a truncated file must be refused when opened
+ */
+static void test_synonym_thesaurus() {
+    filesystem::path thesaurus_directory = filesystem::temp_directory_path() /
+                                           ("text_analysis_tests_thesaurus_" + to_string(random_device()()));
+    filesystem::create_directories(thesaurus_directory);
+    string source_path = (thesaurus_directory / "synonyms.txt").string();
+    string thesaurus_path = (thesaurus_directory / "synonyms.bin").string();
+
+    const size_t HEADWORD_COUNT = 20000;
+    mt19937_64 random_generator(TEST_RANDOM_SEED);
+    vector<string> headwords;
+    vector<vector<string>> headword_synonyms;
+    {
+        ofstream source_file(source_path);
+        for (size_t headword_index = 0; headword_index < HEADWORD_COUNT; headword_index++) {
+            // The number before the first 'z' keeps headwords distinct; random letters vary their hashes
+            string headword = "w" + spell_number_in_letters(headword_index) + "z";
+            for (size_t letter_count = random_generator() % 8; letter_count > 0; letter_count--) {
+                headword.push_back(static_cast<char>('a' + random_generator() % 26));
+            }
+            vector<string> synonyms;
+            source_file << headword;
+            for (size_t synonym_count = 1 + random_generator() % 6; synonym_count > 0; synonym_count--) {
+                synonyms.push_back("s" + spell_number_in_letters(random_generator() % 100000) + headword);
+                source_file << ',' << synonyms.back();
+            }
+            source_file << '\n';
+            headwords.push_back(headword);
+            headword_synonyms.push_back(synonyms);
+        }
+    }
+
+    string error_description;
+    SynonymThesaurus synonym_thesaurus;
+    expect_check(build_thesaurus_file({source_path}, thesaurus_path, error_description),
+                 "thesaurus builds: " + error_description);
+    expect_check(synonym_thesaurus.open_thesaurus(thesaurus_path) && synonym_thesaurus.headword_count() == HEADWORD_COUNT,
+                 "thesaurus opens with every headword");
+
+    string_view synonym_views[8];
+    size_t mismatched_headword_count = 0;
+    for (size_t headword_index = 0; headword_index < HEADWORD_COUNT; headword_index++) {
+        const vector<string>& expected_synonyms = headword_synonyms[headword_index];
+        size_t synonym_count = synonym_thesaurus.lookup_synonyms(headwords[headword_index], synonym_views, 8);
+        mismatched_headword_count += synonym_count != expected_synonyms.size() ||
+                                     !equal(expected_synonyms.begin(), expected_synonyms.end(), synonym_views);
+    }
+    expect_check(mismatched_headword_count == 0, to_string(mismatched_headword_count) + " headwords returned wrong synonyms");
+
+    size_t false_hit_count = 0;
+    for (size_t probe_index = 0; probe_index < HEADWORD_COUNT; probe_index++) {
+        false_hit_count += synonym_thesaurus.lookup_synonyms("x" + spell_number_in_letters(probe_index), synonym_views, 8) != 0;
+    }
+    false_hit_count += synonym_thesaurus.lookup_synonyms("", synonym_views, 8) != 0;
+    expect_check(false_hit_count == 0, to_string(false_hit_count) + " absent words returned synonyms");
+
+    filesystem::resize_file(thesaurus_path, filesystem::file_size(thesaurus_path) / 2);
+    SynonymThesaurus truncated_thesaurus;
+    expect_check(!truncated_thesaurus.open_thesaurus(thesaurus_path), "a truncated thesaurus file is refused");
+    filesystem::remove_all(thesaurus_directory);
+}
+
+/*
+ * Symbol of a byte as the style linter sees it: ASCII letters fold case,
+ * digits, apostrophes and hyphens stay part of a word, and every other
+ * byte separates words, whitespace apart from punctuation
+ */
+static int reference_style_symbol(unsigned char text_byte) {
+    if (isalpha(text_byte)) {
+        return tolower(text_byte);
+    }
+    if (isdigit(text_byte) || text_byte == '\'' || text_byte == '-') {
+        return text_byte;
+    }
+    return isspace(text_byte) ? ' ' : 0;
+}
+
+/*
+ * Every match of every phrase, found by comparing symbols at each offset
+ * Runs of whitespace collapse to one symbol, and a match must start and
+ * end at a separator or at the ends of the passage
+ */
+static vector<tuple<string, uint64_t, uint64_t>> reference_style_matches(string_view text_passage,
+                                                                         const vector<string>& style_phrases) {
+    vector<int> passage_symbols = {' '};
+    vector<uint64_t> symbol_offsets = {0};
+    for (size_t byte_index = 0; byte_index < text_passage.size(); byte_index++) {
+        int text_symbol = reference_style_symbol(static_cast<unsigned char>(text_passage[byte_index]));
+        if (text_symbol != ' ' || passage_symbols.back() != ' ') {
+            passage_symbols.push_back(text_symbol);
+            symbol_offsets.push_back(byte_index);
+        }
+    }
+    passage_symbols.push_back(' ');
+    symbol_offsets.push_back(text_passage.size());
+
+    auto is_separator = [](int text_symbol) { return text_symbol == ' ' || text_symbol == 0; };
+    vector<tuple<string, uint64_t, uint64_t>> phrase_matches;
+    for (const string& style_phrase : style_phrases) {
+        for (size_t symbol_index = 1; symbol_index + style_phrase.size() < passage_symbols.size(); symbol_index++) {
+            if (!is_separator(passage_symbols[symbol_index - 1]) ||
+                !is_separator(passage_symbols[symbol_index + style_phrase.size()])) {
+                continue;
+            }
+            bool phrase_found = true;
+            for (size_t phrase_index = 0; phrase_found && phrase_index < style_phrase.size(); phrase_index++) {
+                phrase_found = passage_symbols[symbol_index + phrase_index] == style_phrase[phrase_index];
+            }
+            if (phrase_found) {
+                uint64_t start_offset = symbol_offsets[symbol_index];
+                phrase_matches.emplace_back(style_phrase, start_offset,
+                                            symbol_offsets[symbol_index + style_phrase.size()] - start_offset);
+            }
+        }
+    }
+    sort(phrase_matches.begin(), phrase_matches.end());
+    return phrase_matches;
+}
+
+/*
+ * Aho-Corasick style linter (user-024)
+ * Overlapping and nested phrases must match exactly where the reference
+ * matcher finds them, and a scan fed in random pieces must report what
+ * lint_passage() reports for the whole passage
+ */
+static void test_style_linter() {
+    const vector<string> style_phrases = {"in order to", "order", "the fact that", "due to the fact that", "fact",
+                                          "very", "very very", "low-hanging fruit", "at the end of the day",
+                                          "end of the day", "it could be argued that", "kind of", "3d"};
+    const vector<string> linted_fragments = {"in", "order", "to", "the", "fact", "that", "due", "very", "low-hanging",
+                                             "fruit", "at", "end", "of", "day", "it", "could", "be", "argued", "kind",
+                                             "IN", "Order", "VERY", "3D", "don't", "x", "caf\xC3\xA9", "\xE2\x80\x9C"};
+    const vector<string> fragment_separators = {" ", "  ", "\n", "\t ", ", ", ". ", "-", "'", "", "\xE2\x80\x94"};
+
+    StyleLinter phrase_linter(false);
+    string error_description;
+    for (const string& style_phrase : style_phrases) {
+        expect_check(phrase_linter.add_rule({StyleIssueCategory::Wordy, style_phrase, ""}, error_description),
+                     "rule '" + style_phrase + "' is accepted: " + error_description);
+    }
+    StyleLinter builtin_linter;
+
+    mt19937_64 random_generator(TEST_RANDOM_SEED);
+    for (size_t passage_index = 0; passage_index < RANDOM_PASSAGE_COUNT; passage_index++) {
+        string text_passage;
+        for (size_t fragment_count = random_generator() % 40; fragment_count > 0; fragment_count--) {
+            text_passage += linted_fragments[random_generator() % linted_fragments.size()];
+            text_passage += fragment_separators[random_generator() % fragment_separators.size()];
+        }
+        string passage_label = " on passage " + to_string(passage_index);
+
+        StyleLintReport style_report = phrase_linter.lint_passage(text_passage);
+        vector<tuple<string, uint64_t, uint64_t>> reported_matches;
+        for (const StyleMatch& style_match : style_report.matches) {
+            reported_matches.emplace_back(style_report.findings[style_match.finding_index].style_rule.phrase,
+                                          style_match.start_offset, style_match.byte_length);
+        }
+        sort(reported_matches.begin(), reported_matches.end());
+        uint64_t finding_match_total = 0;
+        for (const StyleFinding& style_finding : style_report.findings) {
+            finding_match_total += style_finding.match_count;
+        }
+        expect_check(reported_matches == reference_style_matches(text_passage, style_phrases) &&
+                         finding_match_total == style_report.total_match_count &&
+                         style_report.matches.size() == style_report.total_match_count,
+                     "linter matches the reference matcher" + passage_label);
+
+        for (const StyleLinter* style_linter : {&phrase_linter, &builtin_linter}) {
+            StyleLintScan style_scan(*style_linter);
+            for (size_t piece_offset = 0; piece_offset < text_passage.size();) {
+                size_t piece_length = min<size_t>(random_generator() % 6, text_passage.size() - piece_offset);
+                style_scan.scan_text_piece(string_view(text_passage).substr(piece_offset, piece_length));
+                piece_offset += piece_length;
+            }
+            expect_check(style_reports_identical(style_scan.finish(), style_linter->lint_passage(text_passage)),
+                         "piecewise scan matches the whole passage" + passage_label);
+        }
+    }
+}
+
+/*
+ * Vocabulary word tables (user-025)
+ * Every function word and Dolch word longer than five letters must be
+ * found in the library's perfect-hash tables and classed basic. Words on
+ * neither list, random ones of every length and near misses of listed
+ * ones, must miss and be classed by length alone: basic up to five
+ * letters, intermediate up to eight and advanced beyond
+ */
+static void test_vocabulary_word_tables() {
+    // The entries of the library's lists that length alone would not class as basic
+    const vector<string> long_function_words = {
+        "across", "afterwards", "against", "almost", "already", "although", "always", "amongst", "another", "anybody", "anyone",
+        "anything", "anyway", "anywhere", "around", "because", "before", "beforehand", "behind", "beside", "besides", "between",
+        "beyond", "cannot", "couldnt", "doesnt", "during", "either", "elsewhere", "enough", "everybody", "everyone",
+        "everything", "everywhere", "except", "further", "furthermore", "havent", "having", "herself", "himself", "however",
+        "inside", "instead", "itself", "meanwhile", "moreover", "mustnt", "myself", "neither", "nevertheless", "nobody",
+        "nonetheless", "nothing", "nowhere", "others", "otherwise", "ourselves", "outside", "perhaps", "rather", "several",
+        "should", "shouldnt", "somebody", "someone", "something", "sometimes", "somewhere", "theirs", "themselves", "thence",
+        "thereafter", "thereby", "therefore", "though", "through", "throughout", "together", "toward", "towards", "unless",
+        "werent", "whatever", "whenever", "whereas", "wherever", "whether", "whichever", "whoever", "within", "without",
+        "wouldnt", "yourself", "yourselves"};
+    const vector<string> long_dolch_words = {
+        "better", "birthday", "brother", "chicken", "children", "christmas", "farmer", "father", "flower", "garden", "goodbye",
+        "ground", "letter", "morning", "mother", "picture", "please", "pretty", "rabbit", "school", "sister", "squirrel",
+        "street", "window", "yellow"};
+    vector<string> listed_words = long_function_words;
+    listed_words.insert(listed_words.end(), long_dolch_words.begin(), long_dolch_words.end());
+    for (const string& listed_word : listed_words) {
+        expect_check(classify_vocabulary_word(listed_word, listed_word.size()) == VocabularyWordClass::Basic,
+                     "listed word '" + listed_word + "' is basic");
+    }
+
+    auto length_class = [](size_t character_count) {
+        return character_count <= 5   ? VocabularyWordClass::Basic
+               : character_count <= 8 ? VocabularyWordClass::Intermediate
+                                      : VocabularyWordClass::Advanced;
+    };
+    vector<string> unlisted_words = {"birthdays", "mothers", "yellows", "somethings", "windo", "chickenx", "xchicken",
+                                     "throughs", "garden-", "squirrels", "schools", "picturesque", "bettor", "fathom"};
+    for (const string& listed_word : listed_words) {
+        // One letter changed at every position, so only a full comparison can reject them
+        for (size_t letter_index = 0; letter_index < listed_word.size(); letter_index++) {
+            string changed_word = listed_word;
+            changed_word[letter_index] = changed_word[letter_index] == 'z' ? 'y' : 'z';
+            unlisted_words.push_back(changed_word);
+        }
+        unlisted_words.push_back(listed_word.substr(0, listed_word.size() - 1));
+    }
+    mt19937_64 random_generator(TEST_RANDOM_SEED);
+    for (size_t word_length = 1; word_length <= 40; word_length++) {
+        for (size_t word_index = 0; word_index < 500; word_index++) {
+            string random_word;
+            for (size_t letter_index = 0; letter_index < word_length; letter_index++) {
+                random_word.push_back(static_cast<char>('a' + random_generator() % 26));
+            }
+            unlisted_words.push_back(random_word);
+        }
+    }
+    for (const string& unlisted_word : unlisted_words) {
+        if (find(listed_words.begin(), listed_words.end(), unlisted_word) != listed_words.end()) {
+            continue;
+        }
+        // Short words are basic whatever they are, so only longer ones show a table miss
+        expect_check(unlisted_word.size() <= 5 || classify_vocabulary_word(unlisted_word, unlisted_word.size()) ==
+                                                       length_class(unlisted_word.size()),
+                     "unlisted word '" + unlisted_word + "' is classed by its length");
+    }
+
+    // The cutoffs themselves, on words of no list
+    const vector<pair<string, VocabularyWordClass>> cutoff_cases = {
+        {"cat", VocabularyWordClass::Basic},           {"house", VocabularyWordClass::Basic},
+        {"planet", VocabularyWordClass::Intermediate}, {"elephant", VocabularyWordClass::Intermediate},
+        {"beautiful", VocabularyWordClass::Advanced},  {"implementation", VocabularyWordClass::Advanced}};
+    for (const auto& [cutoff_word, expected_class] : cutoff_cases) {
+        expect_check(classify_vocabulary_word(cutoff_word, cutoff_word.size()) == expected_class,
+                     "'" + cutoff_word + "' is classed at the length cutoff");
+    }
+    expect_check(classify_vocabulary_word("caf\xC3\xA9s", 5) == VocabularyWordClass::Basic,
+                 "the cutoff counts characters, not bytes");
+}
+
+int main() {
+    const pair<const char*, void (*)()> test_sections[] = {
+        {"tokenizer kernels", test_tokenizer_kernels},
+        {"single-pass engine", test_single_pass_engine},
+        {"document corpus", test_document_corpus},
+        {"structured reports", test_structured_reports},
+        {"result cache", test_result_cache},
+        {"incremental analysis", test_incremental_analysis},
+        {"streaming sketches", test_streaming_sketches},
+        {"readability indices", test_readability_indices},
+        {"sentence segmentation", test_sentence_segmentation},
+        {"synonym thesaurus", test_synonym_thesaurus},
+        {"style linter", test_style_linter},
+        {"vocabulary word tables", test_vocabulary_word_tables},
+    };
+    for (const auto& [section_name, run_section] : test_sections) {
+        uint64_t failures_before_section = failed_check_count;
+        run_section();
+        cout << (failed_check_count == failures_before_section ? "ok   " : "FAIL ") << section_name << '\n';
+    }
+    cout << (failed_check_count == 0 ? "All tests passed" : to_string(failed_check_count) + " checks failed") << endl;
+    return failed_check_count == 0 ? 0 : 1;
+}
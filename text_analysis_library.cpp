@@ -0,0 +1,6011 @@
+/*
+ * Text analysis library
+ * Code hints and optimizations by artlest
+ *
+ * Implementation of the interface in text_analysis_library.h. Nothing in
+ * this file writes to the console; progress and reports are handed back
+ * to the calling program.
+ */
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <string_view>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <cstdlib>
+#include <cstdio>
+#include <filesystem>
+#include <charconv>
+#include <limits>
+
+#include "text_analysis_library.h"
+
+using namespace std;
+
+// Vectorized tokenizer kernels are compiled per instruction set and chosen at runtime
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define TEXT_ANALYSER_X86_SIMD 1
+#define TEXT_ANALYSER_TARGET(instruction_set) __attribute__((target(instruction_set)))
+#include <immintrin.h>
+#else
+#define TEXT_ANALYSER_X86_SIMD 0
+#endif
+
+#if TEXT_ANALYSER_POSIX_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#endif
+
+// Bytes scanned between progress updates; a multiple of the 64-byte block size
+const size_t PROGRESS_SLICE_BYTES = 1024 * 1024;
+
+// Passages are only split across threads into chunks of at least this size
+const size_t MINIMUM_PARALLEL_CHUNK_BYTES = 1024 * 1024;
+
+// Incremental sentence segments are cut at the next whitespace once they reach this size
+const size_t INCREMENTAL_SEGMENT_MAXIMUM_BYTES = 4096;
+
+// Streamed documents are read and analyzed in pieces of this size
+const size_t STREAMING_READ_BUFFER_BYTES = 1024 * 1024;
+
+// Heap allocations are only counted while a benchmark or --stats is measuring
+atomic<bool> allocation_counting_enabled{false};
+atomic<uint64_t> counted_allocation_count{0};
+atomic<uint64_t> counted_allocation_bytes{0};
+thread_local uint64_t thread_allocation_count = 0;
+thread_local uint64_t thread_allocated_bytes = 0;
+
+#if TEXT_ANALYSER_INSTRUMENTATION
+// Stage totals, recorded only once --stats switches instrumentation on
+atomic<bool> pipeline_instrumentation_enabled{false};
+PipelineStageCounters pipeline_stage_counters[PIPELINE_STAGE_COUNT];
+#endif
+
+ProgressReporter::ProgressReporter(uint64_t total_bytes, uint64_t total_work_units, const char* work_unit_label,
+                                   ProgressRenderFunction render_function)
+    : render_function(render_function), total_bytes(total_bytes), total_work_units(total_work_units),
+      work_unit_label(work_unit_label), start_time(chrono::steady_clock::now()) {}
+
+void ProgressReporter::add_processed_bytes(uint64_t processed_byte_count) {
+    processed_bytes.fetch_add(processed_byte_count, memory_order_relaxed);
+    render_if_due(false);
+}
+
+void ProgressReporter::complete_work_unit() {
+    completed_work_units.fetch_add(1, memory_order_relaxed);
+    render_if_due(false);
+}
+
+void ProgressReporter::finish() {
+    render_if_due(true);
+}
+
+void ProgressReporter::render_if_due(bool force_render) {
+    if (render_function == nullptr) {
+        return;
+    }
+
+    // Claim the next render slot without blocking the calling worker
+    int64_t elapsed_nanoseconds = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start_time).count();
+    int64_t scheduled_render = next_render_nanoseconds.load(memory_order_relaxed);
+    if (!force_render && (elapsed_nanoseconds < scheduled_render ||
+                          !next_render_nanoseconds.compare_exchange_strong(
+                              scheduled_render, elapsed_nanoseconds + chrono::nanoseconds(RENDER_INTERVAL).count()))) {
+        return;
+    }
+
+    lock_guard<mutex> render_lock(render_mutex);
+    render_function(processed_bytes.load(memory_order_relaxed), total_bytes, completed_work_units.load(memory_order_relaxed),
+                    total_work_units, work_unit_label, elapsed_nanoseconds / 1e9, force_render);
+}
+
+#if TEXT_ANALYSER_INSTRUMENTATION
+PipelineStageScope::PipelineStageScope(PipelineStage pipeline_stage)
+    : pipeline_stage(pipeline_stage), recording(pipeline_instrumentation_enabled.load(memory_order_relaxed)) {
+    if (recording) {
+        allocation_count_at_start = thread_allocation_count;
+        allocated_bytes_at_start = thread_allocated_bytes;
+        stage_start = chrono::steady_clock::now();
+    }
+}
+
+PipelineStageScope::~PipelineStageScope() {
+    if (!recording) {
+        return;
+    }
+    uint64_t elapsed_nanoseconds =
+        static_cast<uint64_t>(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - stage_start).count());
+    PipelineStageCounters& stage_counters = pipeline_stage_counters[static_cast<size_t>(pipeline_stage)];
+    stage_counters.invocation_count.fetch_add(1, memory_order_relaxed);
+    stage_counters.elapsed_nanoseconds.fetch_add(elapsed_nanoseconds, memory_order_relaxed);
+    stage_counters.processed_bytes.fetch_add(processed_bytes, memory_order_relaxed);
+    stage_counters.processed_tokens.fetch_add(processed_tokens, memory_order_relaxed);
+    stage_counters.allocation_count.fetch_add(thread_allocation_count - allocation_count_at_start, memory_order_relaxed);
+    stage_counters.allocated_bytes.fetch_add(thread_allocated_bytes - allocated_bytes_at_start, memory_order_relaxed);
+}
+
+/*
+ * Start recording pipeline stages, including the allocations they make
+ */
+void enable_pipeline_instrumentation() {
+    allocation_counting_enabled.store(true, memory_order_relaxed);
+    pipeline_instrumentation_enabled.store(true, memory_order_relaxed);
+}
+
+const char* pipeline_stage_name(PipelineStage pipeline_stage) {
+    switch (pipeline_stage) {
+        case PipelineStage::Input: return "input";
+        case PipelineStage::Analysis: return "analysis";
+        case PipelineStage::Rendering: return "rendering";
+        case PipelineStage::Output: return "output";
+    }
+    return "unknown";
+}
+
+/*
+ * Append the stage totals as a JSON array of stage records
+ */
+void serialize_pipeline_statistics(string& output_buffer) {
+    StructuredRecordSerializer record_serializer(output_buffer, ReportOutputFormat::JSON);
+    output_buffer.push_back('[');
+    for (size_t stage_index = 0; stage_index < PIPELINE_STAGE_COUNT; stage_index++) {
+        const PipelineStageCounters& stage_counters = pipeline_stage_counters[stage_index];
+        if (stage_index > 0) {
+            output_buffer.push_back(',');
+        }
+        record_serializer.begin_record();
+        record_serializer.field_text("stage", pipeline_stage_name(static_cast<PipelineStage>(stage_index)));
+        record_serializer.field_unsigned("calls", stage_counters.invocation_count.load(memory_order_relaxed));
+        record_serializer.field_decimal("seconds", stage_counters.elapsed_nanoseconds.load(memory_order_relaxed) / 1e9);
+        record_serializer.field_unsigned("bytes", stage_counters.processed_bytes.load(memory_order_relaxed));
+        record_serializer.field_unsigned("tokens", stage_counters.processed_tokens.load(memory_order_relaxed));
+        record_serializer.field_unsigned("allocations", stage_counters.allocation_count.load(memory_order_relaxed));
+        record_serializer.field_unsigned("allocated_bytes", stage_counters.allocated_bytes.load(memory_order_relaxed));
+        record_serializer.end_record();
+    }
+    output_buffer.push_back(']');
+}
+
+#endif
+
+/*
+ * This function maps a document file into memory for in-place analysis
+ * Sequential access is advised to the kernel so read-ahead stays ahead of
+ * the tokenizer; very large files may additionally request huge pages
+ */
+bool MappedTextFile::open_document(const string& document_path, bool request_huge_pages) {
+    TEXT_ANALYSER_STAGE_SCOPE(input_stage, PipelineStage::Input);
+    release_mapping();
+
+#if TEXT_ANALYSER_POSIX_MMAP
+    int file_descriptor = open(document_path.c_str(), O_RDONLY);
+    if (file_descriptor < 0) {
+        error_description = "cannot open '" + document_path + "': " + strerror(errno);
+        return false;
+    }
+
+    struct stat file_status;
+    if (fstat(file_descriptor, &file_status) != 0 || !S_ISREG(file_status.st_mode)) {
+        error_description = "'" + document_path + "' is not a regular file";
+        close(file_descriptor);
+        return false;
+    }
+
+    // Empty documents are valid and need no mapping
+    if (file_status.st_size == 0) {
+        close(file_descriptor);
+        return true;
+    }
+
+    size_t document_length = static_cast<size_t>(file_status.st_size);
+    void* mapping_address = mmap(nullptr, document_length, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+    close(file_descriptor);  // The mapping keeps its own reference to the file
+    if (mapping_address == MAP_FAILED) {
+        error_description = "cannot map '" + document_path + "': " + strerror(errno);
+        return false;
+    }
+
+    // Advisory hints only; failures leave a perfectly usable mapping
+    madvise(mapping_address, document_length, MADV_SEQUENTIAL);
+#ifdef MADV_HUGEPAGE
+    if (request_huge_pages && document_length >= HUGE_PAGE_THRESHOLD_BYTES) {
+        madvise(mapping_address, document_length, MADV_HUGEPAGE);
+    }
+#else
+    (void)request_huge_pages;
+#endif
+
+    mapped_bytes = static_cast<const char*>(mapping_address);
+    mapped_length = document_length;
+    TEXT_ANALYSER_STAGE_BYTES(input_stage, mapped_length);
+    return true;
+#else
+    // Platforms without mmap read the document once into an owned buffer
+    (void)request_huge_pages;
+    ifstream document_stream(document_path, ios::binary | ios::ate);
+    if (!document_stream) {
+        error_description = "cannot open '" + document_path + "'";
+        return false;
+    }
+    fallback_buffer.resize(static_cast<size_t>(document_stream.tellg()));
+    document_stream.seekg(0);
+    document_stream.read(fallback_buffer.data(), static_cast<streamsize>(fallback_buffer.size()));
+    mapped_bytes = fallback_buffer.data();
+    mapped_length = fallback_buffer.size();
+    TEXT_ANALYSER_STAGE_BYTES(input_stage, mapped_length);
+    return true;
+#endif
+}
+
+void MappedTextFile::release_mapping() {
+#if TEXT_ANALYSER_POSIX_MMAP
+    if (mapped_bytes != nullptr) {
+        munmap(const_cast<char*>(mapped_bytes), mapped_length);
+    }
+#else
+    fallback_buffer.clear();
+#endif
+    mapped_bytes = nullptr;
+    mapped_length = 0;
+}
+
+/*
+ * Unicode word characters above U+007F: general categories L (letters)
+ * and M (combining marks), as sorted inclusive code point ranges.
+ * Generated from the Unicode 14.0 character database
+ */
+const uint32_t UNICODE_WORD_CHARACTER_RANGES[][2] = {
+    {0xAA, 0xAA}, {0xB5, 0xB5}, {0xBA, 0xBA}, {0xC0, 0xD6}, {0xD8, 0xF6}, {0xF8, 0x2C1}, {0x2C6, 0x2D1}, {0x2E0, 0x2E4},
+    {0x2EC, 0x2EC}, {0x2EE, 0x2EE}, {0x300, 0x374}, {0x376, 0x377}, {0x37A, 0x37D}, {0x37F, 0x37F}, {0x386, 0x386},
+    {0x388, 0x38A}, {0x38C, 0x38C}, {0x38E, 0x3A1}, {0x3A3, 0x3F5}, {0x3F7, 0x481}, {0x483, 0x52F}, {0x531, 0x556},
+    {0x559, 0x559}, {0x560, 0x588}, {0x591, 0x5BD}, {0x5BF, 0x5BF}, {0x5C1, 0x5C2}, {0x5C4, 0x5C5}, {0x5C7, 0x5C7},
+    {0x5D0, 0x5EA}, {0x5EF, 0x5F2}, {0x610, 0x61A}, {0x620, 0x65F}, {0x66E, 0x6D3}, {0x6D5, 0x6DC}, {0x6DF, 0x6E8},
+    {0x6EA, 0x6EF}, {0x6FA, 0x6FC}, {0x6FF, 0x6FF}, {0x710, 0x74A}, {0x74D, 0x7B1}, {0x7CA, 0x7F5}, {0x7FA, 0x7FA},
+    {0x7FD, 0x7FD}, {0x800, 0x82D}, {0x840, 0x85B}, {0x860, 0x86A}, {0x870, 0x887}, {0x889, 0x88E}, {0x898, 0x8E1},
+    {0x8E3, 0x963}, {0x971, 0x983}, {0x985, 0x98C}, {0x98F, 0x990}, {0x993, 0x9A8}, {0x9AA, 0x9B0}, {0x9B2, 0x9B2},
+    {0x9B6, 0x9B9}, {0x9BC, 0x9C4}, {0x9C7, 0x9C8}, {0x9CB, 0x9CE}, {0x9D7, 0x9D7}, {0x9DC, 0x9DD}, {0x9DF, 0x9E3},
+    {0x9F0, 0x9F1}, {0x9FC, 0x9FC}, {0x9FE, 0x9FE}, {0xA01, 0xA03}, {0xA05, 0xA0A}, {0xA0F, 0xA10}, {0xA13, 0xA28},
+    {0xA2A, 0xA30}, {0xA32, 0xA33}, {0xA35, 0xA36}, {0xA38, 0xA39}, {0xA3C, 0xA3C}, {0xA3E, 0xA42}, {0xA47, 0xA48},
+    {0xA4B, 0xA4D}, {0xA51, 0xA51}, {0xA59, 0xA5C}, {0xA5E, 0xA5E}, {0xA70, 0xA75}, {0xA81, 0xA83}, {0xA85, 0xA8D},
+    {0xA8F, 0xA91}, {0xA93, 0xAA8}, {0xAAA, 0xAB0}, {0xAB2, 0xAB3}, {0xAB5, 0xAB9}, {0xABC, 0xAC5}, {0xAC7, 0xAC9},
+    {0xACB, 0xACD}, {0xAD0, 0xAD0}, {0xAE0, 0xAE3}, {0xAF9, 0xAFF}, {0xB01, 0xB03}, {0xB05, 0xB0C}, {0xB0F, 0xB10},
+    {0xB13, 0xB28}, {0xB2A, 0xB30}, {0xB32, 0xB33}, {0xB35, 0xB39}, {0xB3C, 0xB44}, {0xB47, 0xB48}, {0xB4B, 0xB4D},
+    {0xB55, 0xB57}, {0xB5C, 0xB5D}, {0xB5F, 0xB63}, {0xB71, 0xB71}, {0xB82, 0xB83}, {0xB85, 0xB8A}, {0xB8E, 0xB90},
+    {0xB92, 0xB95}, {0xB99, 0xB9A}, {0xB9C, 0xB9C}, {0xB9E, 0xB9F}, {0xBA3, 0xBA4}, {0xBA8, 0xBAA}, {0xBAE, 0xBB9},
+    {0xBBE, 0xBC2}, {0xBC6, 0xBC8}, {0xBCA, 0xBCD}, {0xBD0, 0xBD0}, {0xBD7, 0xBD7}, {0xC00, 0xC0C}, {0xC0E, 0xC10},
+    {0xC12, 0xC28}, {0xC2A, 0xC39}, {0xC3C, 0xC44}, {0xC46, 0xC48}, {0xC4A, 0xC4D}, {0xC55, 0xC56}, {0xC58, 0xC5A},
+    {0xC5D, 0xC5D}, {0xC60, 0xC63}, {0xC80, 0xC83}, {0xC85, 0xC8C}, {0xC8E, 0xC90}, {0xC92, 0xCA8}, {0xCAA, 0xCB3},
+    {0xCB5, 0xCB9}, {0xCBC, 0xCC4}, {0xCC6, 0xCC8}, {0xCCA, 0xCCD}, {0xCD5, 0xCD6}, {0xCDD, 0xCDE}, {0xCE0, 0xCE3},
+    {0xCF1, 0xCF2}, {0xD00, 0xD0C}, {0xD0E, 0xD10}, {0xD12, 0xD44}, {0xD46, 0xD48}, {0xD4A, 0xD4E}, {0xD54, 0xD57},
+    {0xD5F, 0xD63}, {0xD7A, 0xD7F}, {0xD81, 0xD83}, {0xD85, 0xD96}, {0xD9A, 0xDB1}, {0xDB3, 0xDBB}, {0xDBD, 0xDBD},
+    {0xDC0, 0xDC6}, {0xDCA, 0xDCA}, {0xDCF, 0xDD4}, {0xDD6, 0xDD6}, {0xDD8, 0xDDF}, {0xDF2, 0xDF3}, {0xE01, 0xE3A},
+    {0xE40, 0xE4E}, {0xE81, 0xE82}, {0xE84, 0xE84}, {0xE86, 0xE8A}, {0xE8C, 0xEA3}, {0xEA5, 0xEA5}, {0xEA7, 0xEBD},
+    {0xEC0, 0xEC4}, {0xEC6, 0xEC6}, {0xEC8, 0xECD}, {0xEDC, 0xEDF}, {0xF00, 0xF00}, {0xF18, 0xF19}, {0xF35, 0xF35},
+    {0xF37, 0xF37}, {0xF39, 0xF39}, {0xF3E, 0xF47}, {0xF49, 0xF6C}, {0xF71, 0xF84}, {0xF86, 0xF97}, {0xF99, 0xFBC},
+    {0xFC6, 0xFC6}, {0x1000, 0x103F}, {0x1050, 0x108F}, {0x109A, 0x109D}, {0x10A0, 0x10C5}, {0x10C7, 0x10C7},
+    {0x10CD, 0x10CD}, {0x10D0, 0x10FA}, {0x10FC, 0x1248}, {0x124A, 0x124D}, {0x1250, 0x1256}, {0x1258, 0x1258},
+    {0x125A, 0x125D}, {0x1260, 0x1288}, {0x128A, 0x128D}, {0x1290, 0x12B0}, {0x12B2, 0x12B5}, {0x12B8, 0x12BE},
+    {0x12C0, 0x12C0}, {0x12C2, 0x12C5}, {0x12C8, 0x12D6}, {0x12D8, 0x1310}, {0x1312, 0x1315}, {0x1318, 0x135A},
+    {0x135D, 0x135F}, {0x1380, 0x138F}, {0x13A0, 0x13F5}, {0x13F8, 0x13FD}, {0x1401, 0x166C}, {0x166F, 0x167F},
+    {0x1681, 0x169A}, {0x16A0, 0x16EA}, {0x16F1, 0x16F8}, {0x1700, 0x1715}, {0x171F, 0x1734}, {0x1740, 0x1753},
+    {0x1760, 0x176C}, {0x176E, 0x1770}, {0x1772, 0x1773}, {0x1780, 0x17D3}, {0x17D7, 0x17D7}, {0x17DC, 0x17DD},
+    {0x180B, 0x180D}, {0x180F, 0x180F}, {0x1820, 0x1878}, {0x1880, 0x18AA}, {0x18B0, 0x18F5}, {0x1900, 0x191E},
+    {0x1920, 0x192B}, {0x1930, 0x193B}, {0x1950, 0x196D}, {0x1970, 0x1974}, {0x1980, 0x19AB}, {0x19B0, 0x19C9},
+    {0x1A00, 0x1A1B}, {0x1A20, 0x1A5E}, {0x1A60, 0x1A7C}, {0x1A7F, 0x1A7F}, {0x1AA7, 0x1AA7}, {0x1AB0, 0x1ACE},
+    {0x1B00, 0x1B4C}, {0x1B6B, 0x1B73}, {0x1B80, 0x1BAF}, {0x1BBA, 0x1BF3}, {0x1C00, 0x1C37}, {0x1C4D, 0x1C4F},
+    {0x1C5A, 0x1C7D}, {0x1C80, 0x1C88}, {0x1C90, 0x1CBA}, {0x1CBD, 0x1CBF}, {0x1CD0, 0x1CD2}, {0x1CD4, 0x1CFA},
+    {0x1D00, 0x1F15}, {0x1F18, 0x1F1D}, {0x1F20, 0x1F45}, {0x1F48, 0x1F4D}, {0x1F50, 0x1F57}, {0x1F59, 0x1F59},
+    {0x1F5B, 0x1F5B}, {0x1F5D, 0x1F5D}, {0x1F5F, 0x1F7D}, {0x1F80, 0x1FB4}, {0x1FB6, 0x1FBC}, {0x1FBE, 0x1FBE},
+    {0x1FC2, 0x1FC4}, {0x1FC6, 0x1FCC}, {0x1FD0, 0x1FD3}, {0x1FD6, 0x1FDB}, {0x1FE0, 0x1FEC}, {0x1FF2, 0x1FF4},
+    {0x1FF6, 0x1FFC}, {0x2071, 0x2071}, {0x207F, 0x207F}, {0x2090, 0x209C}, {0x20D0, 0x20F0}, {0x2102, 0x2102},
+    {0x2107, 0x2107}, {0x210A, 0x2113}, {0x2115, 0x2115}, {0x2119, 0x211D}, {0x2124, 0x2124}, {0x2126, 0x2126},
+    {0x2128, 0x2128}, {0x212A, 0x212D}, {0x212F, 0x2139}, {0x213C, 0x213F}, {0x2145, 0x2149}, {0x214E, 0x214E},
+    {0x2183, 0x2184}, {0x2C00, 0x2CE4}, {0x2CEB, 0x2CF3}, {0x2D00, 0x2D25}, {0x2D27, 0x2D27}, {0x2D2D, 0x2D2D},
+    {0x2D30, 0x2D67}, {0x2D6F, 0x2D6F}, {0x2D7F, 0x2D96}, {0x2DA0, 0x2DA6}, {0x2DA8, 0x2DAE}, {0x2DB0, 0x2DB6},
+    {0x2DB8, 0x2DBE}, {0x2DC0, 0x2DC6}, {0x2DC8, 0x2DCE}, {0x2DD0, 0x2DD6}, {0x2DD8, 0x2DDE}, {0x2DE0, 0x2DFF},
+    {0x2E2F, 0x2E2F}, {0x3005, 0x3006}, {0x302A, 0x302F}, {0x3031, 0x3035}, {0x303B, 0x303C}, {0x3041, 0x3096},
+    {0x3099, 0x309A}, {0x309D, 0x309F}, {0x30A1, 0x30FA}, {0x30FC, 0x30FF}, {0x3105, 0x312F}, {0x3131, 0x318E},
+    {0x31A0, 0x31BF}, {0x31F0, 0x31FF}, {0x3400, 0x4DBF}, {0x4E00, 0xA48C}, {0xA4D0, 0xA4FD}, {0xA500, 0xA60C},
+    {0xA610, 0xA61F}, {0xA62A, 0xA62B}, {0xA640, 0xA672}, {0xA674, 0xA67D}, {0xA67F, 0xA6E5}, {0xA6F0, 0xA6F1},
+    {0xA717, 0xA71F}, {0xA722, 0xA788}, {0xA78B, 0xA7CA}, {0xA7D0, 0xA7D1}, {0xA7D3, 0xA7D3}, {0xA7D5, 0xA7D9},
+    {0xA7F2, 0xA827}, {0xA82C, 0xA82C}, {0xA840, 0xA873}, {0xA880, 0xA8C5}, {0xA8E0, 0xA8F7}, {0xA8FB, 0xA8FB},
+    {0xA8FD, 0xA8FF}, {0xA90A, 0xA92D}, {0xA930, 0xA953}, {0xA960, 0xA97C}, {0xA980, 0xA9C0}, {0xA9CF, 0xA9CF},
+    {0xA9E0, 0xA9EF}, {0xA9FA, 0xA9FE}, {0xAA00, 0xAA36}, {0xAA40, 0xAA4D}, {0xAA60, 0xAA76}, {0xAA7A, 0xAAC2},
+    {0xAADB, 0xAADD}, {0xAAE0, 0xAAEF}, {0xAAF2, 0xAAF6}, {0xAB01, 0xAB06}, {0xAB09, 0xAB0E}, {0xAB11, 0xAB16},
+    {0xAB20, 0xAB26}, {0xAB28, 0xAB2E}, {0xAB30, 0xAB5A}, {0xAB5C, 0xAB69}, {0xAB70, 0xABEA}, {0xABEC, 0xABED},
+    {0xAC00, 0xD7A3}, {0xD7B0, 0xD7C6}, {0xD7CB, 0xD7FB}, {0xF900, 0xFA6D}, {0xFA70, 0xFAD9}, {0xFB00, 0xFB06},
+    {0xFB13, 0xFB17}, {0xFB1D, 0xFB28}, {0xFB2A, 0xFB36}, {0xFB38, 0xFB3C}, {0xFB3E, 0xFB3E}, {0xFB40, 0xFB41},
+    {0xFB43, 0xFB44}, {0xFB46, 0xFBB1}, {0xFBD3, 0xFD3D}, {0xFD50, 0xFD8F}, {0xFD92, 0xFDC7}, {0xFDF0, 0xFDFB},
+    {0xFE00, 0xFE0F}, {0xFE20, 0xFE2F}, {0xFE70, 0xFE74}, {0xFE76, 0xFEFC}, {0xFF21, 0xFF3A}, {0xFF41, 0xFF5A},
+    {0xFF66, 0xFFBE}, {0xFFC2, 0xFFC7}, {0xFFCA, 0xFFCF}, {0xFFD2, 0xFFD7}, {0xFFDA, 0xFFDC}, {0x10000, 0x1000B},
+    {0x1000D, 0x10026}, {0x10028, 0x1003A}, {0x1003C, 0x1003D}, {0x1003F, 0x1004D}, {0x10050, 0x1005D},
+    {0x10080, 0x100FA}, {0x101FD, 0x101FD}, {0x10280, 0x1029C}, {0x102A0, 0x102D0}, {0x102E0, 0x102E0},
+    {0x10300, 0x1031F}, {0x1032D, 0x10340}, {0x10342, 0x10349}, {0x10350, 0x1037A}, {0x10380, 0x1039D},
+    {0x103A0, 0x103C3}, {0x103C8, 0x103CF}, {0x10400, 0x1049D}, {0x104B0, 0x104D3}, {0x104D8, 0x104FB},
+    {0x10500, 0x10527}, {0x10530, 0x10563}, {0x10570, 0x1057A}, {0x1057C, 0x1058A}, {0x1058C, 0x10592},
+    {0x10594, 0x10595}, {0x10597, 0x105A1}, {0x105A3, 0x105B1}, {0x105B3, 0x105B9}, {0x105BB, 0x105BC},
+    {0x10600, 0x10736}, {0x10740, 0x10755}, {0x10760, 0x10767}, {0x10780, 0x10785}, {0x10787, 0x107B0},
+    {0x107B2, 0x107BA}, {0x10800, 0x10805}, {0x10808, 0x10808}, {0x1080A, 0x10835}, {0x10837, 0x10838},
+    {0x1083C, 0x1083C}, {0x1083F, 0x10855}, {0x10860, 0x10876}, {0x10880, 0x1089E}, {0x108E0, 0x108F2},
+    {0x108F4, 0x108F5}, {0x10900, 0x10915}, {0x10920, 0x10939}, {0x10980, 0x109B7}, {0x109BE, 0x109BF},
+    {0x10A00, 0x10A03}, {0x10A05, 0x10A06}, {0x10A0C, 0x10A13}, {0x10A15, 0x10A17}, {0x10A19, 0x10A35},
+    {0x10A38, 0x10A3A}, {0x10A3F, 0x10A3F}, {0x10A60, 0x10A7C}, {0x10A80, 0x10A9C}, {0x10AC0, 0x10AC7},
+    {0x10AC9, 0x10AE6}, {0x10B00, 0x10B35}, {0x10B40, 0x10B55}, {0x10B60, 0x10B72}, {0x10B80, 0x10B91},
+    {0x10C00, 0x10C48}, {0x10C80, 0x10CB2}, {0x10CC0, 0x10CF2}, {0x10D00, 0x10D27}, {0x10E80, 0x10EA9},
+    {0x10EAB, 0x10EAC}, {0x10EB0, 0x10EB1}, {0x10F00, 0x10F1C}, {0x10F27, 0x10F27}, {0x10F30, 0x10F50},
+    {0x10F70, 0x10F85}, {0x10FB0, 0x10FC4}, {0x10FE0, 0x10FF6}, {0x11000, 0x11046}, {0x11070, 0x11075},
+    {0x1107F, 0x110BA}, {0x110C2, 0x110C2}, {0x110D0, 0x110E8}, {0x11100, 0x11134}, {0x11144, 0x11147},
+    {0x11150, 0x11173}, {0x11176, 0x11176}, {0x11180, 0x111C4}, {0x111C9, 0x111CC}, {0x111CE, 0x111CF},
+    {0x111DA, 0x111DA}, {0x111DC, 0x111DC}, {0x11200, 0x11211}, {0x11213, 0x11237}, {0x1123E, 0x1123E},
+    {0x11280, 0x11286}, {0x11288, 0x11288}, {0x1128A, 0x1128D}, {0x1128F, 0x1129D}, {0x1129F, 0x112A8},
+    {0x112B0, 0x112EA}, {0x11300, 0x11303}, {0x11305, 0x1130C}, {0x1130F, 0x11310}, {0x11313, 0x11328},
+    {0x1132A, 0x11330}, {0x11332, 0x11333}, {0x11335, 0x11339}, {0x1133B, 0x11344}, {0x11347, 0x11348},
+    {0x1134B, 0x1134D}, {0x11350, 0x11350}, {0x11357, 0x11357}, {0x1135D, 0x11363}, {0x11366, 0x1136C},
+    {0x11370, 0x11374}, {0x11400, 0x1144A}, {0x1145E, 0x11461}, {0x11480, 0x114C5}, {0x114C7, 0x114C7},
+    {0x11580, 0x115B5}, {0x115B8, 0x115C0}, {0x115D8, 0x115DD}, {0x11600, 0x11640}, {0x11644, 0x11644},
+    {0x11680, 0x116B8}, {0x11700, 0x1171A}, {0x1171D, 0x1172B}, {0x11740, 0x11746}, {0x11800, 0x1183A},
+    {0x118A0, 0x118DF}, {0x118FF, 0x11906}, {0x11909, 0x11909}, {0x1190C, 0x11913}, {0x11915, 0x11916},
+    {0x11918, 0x11935}, {0x11937, 0x11938}, {0x1193B, 0x11943}, {0x119A0, 0x119A7}, {0x119AA, 0x119D7},
+    {0x119DA, 0x119E1}, {0x119E3, 0x119E4}, {0x11A00, 0x11A3E}, {0x11A47, 0x11A47}, {0x11A50, 0x11A99},
+    {0x11A9D, 0x11A9D}, {0x11AB0, 0x11AF8}, {0x11C00, 0x11C08}, {0x11C0A, 0x11C36}, {0x11C38, 0x11C40},
+    {0x11C72, 0x11C8F}, {0x11C92, 0x11CA7}, {0x11CA9, 0x11CB6}, {0x11D00, 0x11D06}, {0x11D08, 0x11D09},
+    {0x11D0B, 0x11D36}, {0x11D3A, 0x11D3A}, {0x11D3C, 0x11D3D}, {0x11D3F, 0x11D47}, {0x11D60, 0x11D65},
+    {0x11D67, 0x11D68}, {0x11D6A, 0x11D8E}, {0x11D90, 0x11D91}, {0x11D93, 0x11D98}, {0x11EE0, 0x11EF6},
+    {0x11FB0, 0x11FB0}, {0x12000, 0x12399}, {0x12480, 0x12543}, {0x12F90, 0x12FF0}, {0x13000, 0x1342E},
+    {0x14400, 0x14646}, {0x16800, 0x16A38}, {0x16A40, 0x16A5E}, {0x16A70, 0x16ABE}, {0x16AD0, 0x16AED},
+    {0x16AF0, 0x16AF4}, {0x16B00, 0x16B36}, {0x16B40, 0x16B43}, {0x16B63, 0x16B77}, {0x16B7D, 0x16B8F},
+    {0x16E40, 0x16E7F}, {0x16F00, 0x16F4A}, {0x16F4F, 0x16F87}, {0x16F8F, 0x16F9F}, {0x16FE0, 0x16FE1},
+    {0x16FE3, 0x16FE4}, {0x16FF0, 0x16FF1}, {0x17000, 0x187F7}, {0x18800, 0x18CD5}, {0x18D00, 0x18D08},
+    {0x1AFF0, 0x1AFF3}, {0x1AFF5, 0x1AFFB}, {0x1AFFD, 0x1AFFE}, {0x1B000, 0x1B122}, {0x1B150, 0x1B152},
+    {0x1B164, 0x1B167}, {0x1B170, 0x1B2FB}, {0x1BC00, 0x1BC6A}, {0x1BC70, 0x1BC7C}, {0x1BC80, 0x1BC88},
+    {0x1BC90, 0x1BC99}, {0x1BC9D, 0x1BC9E}, {0x1CF00, 0x1CF2D}, {0x1CF30, 0x1CF46}, {0x1D165, 0x1D169},
+    {0x1D16D, 0x1D172}, {0x1D17B, 0x1D182}, {0x1D185, 0x1D18B}, {0x1D1AA, 0x1D1AD}, {0x1D242, 0x1D244},
+    {0x1D400, 0x1D454}, {0x1D456, 0x1D49C}, {0x1D49E, 0x1D49F}, {0x1D4A2, 0x1D4A2}, {0x1D4A5, 0x1D4A6},
+    {0x1D4A9, 0x1D4AC}, {0x1D4AE, 0x1D4B9}, {0x1D4BB, 0x1D4BB}, {0x1D4BD, 0x1D4C3}, {0x1D4C5, 0x1D505},
+    {0x1D507, 0x1D50A}, {0x1D50D, 0x1D514}, {0x1D516, 0x1D51C}, {0x1D51E, 0x1D539}, {0x1D53B, 0x1D53E},
+    {0x1D540, 0x1D544}, {0x1D546, 0x1D546}, {0x1D54A, 0x1D550}, {0x1D552, 0x1D6A5}, {0x1D6A8, 0x1D6C0},
+    {0x1D6C2, 0x1D6DA}, {0x1D6DC, 0x1D6FA}, {0x1D6FC, 0x1D714}, {0x1D716, 0x1D734}, {0x1D736, 0x1D74E},
+    {0x1D750, 0x1D76E}, {0x1D770, 0x1D788}, {0x1D78A, 0x1D7A8}, {0x1D7AA, 0x1D7C2}, {0x1D7C4, 0x1D7CB},
+    {0x1DA00, 0x1DA36}, {0x1DA3B, 0x1DA6C}, {0x1DA75, 0x1DA75}, {0x1DA84, 0x1DA84}, {0x1DA9B, 0x1DA9F},
+    {0x1DAA1, 0x1DAAF}, {0x1DF00, 0x1DF1E}, {0x1E000, 0x1E006}, {0x1E008, 0x1E018}, {0x1E01B, 0x1E021},
+    {0x1E023, 0x1E024}, {0x1E026, 0x1E02A}, {0x1E100, 0x1E12C}, {0x1E130, 0x1E13D}, {0x1E14E, 0x1E14E},
+    {0x1E290, 0x1E2AE}, {0x1E2C0, 0x1E2EF}, {0x1E7E0, 0x1E7E6}, {0x1E7E8, 0x1E7EB}, {0x1E7ED, 0x1E7EE},
+    {0x1E7F0, 0x1E7FE}, {0x1E800, 0x1E8C4}, {0x1E8D0, 0x1E8D6}, {0x1E900, 0x1E94B}, {0x1EE00, 0x1EE03},
+    {0x1EE05, 0x1EE1F}, {0x1EE21, 0x1EE22}, {0x1EE24, 0x1EE24}, {0x1EE27, 0x1EE27}, {0x1EE29, 0x1EE32},
+    {0x1EE34, 0x1EE37}, {0x1EE39, 0x1EE39}, {0x1EE3B, 0x1EE3B}, {0x1EE42, 0x1EE42}, {0x1EE47, 0x1EE47},
+    {0x1EE49, 0x1EE49}, {0x1EE4B, 0x1EE4B}, {0x1EE4D, 0x1EE4F}, {0x1EE51, 0x1EE52}, {0x1EE54, 0x1EE54},
+    {0x1EE57, 0x1EE57}, {0x1EE59, 0x1EE59}, {0x1EE5B, 0x1EE5B}, {0x1EE5D, 0x1EE5D}, {0x1EE5F, 0x1EE5F},
+    {0x1EE61, 0x1EE62}, {0x1EE64, 0x1EE64}, {0x1EE67, 0x1EE6A}, {0x1EE6C, 0x1EE72}, {0x1EE74, 0x1EE77},
+    {0x1EE79, 0x1EE7C}, {0x1EE7E, 0x1EE7E}, {0x1EE80, 0x1EE89}, {0x1EE8B, 0x1EE9B}, {0x1EEA1, 0x1EEA3},
+    {0x1EEA5, 0x1EEA9}, {0x1EEAB, 0x1EEBB}, {0x20000, 0x2A6DF}, {0x2A700, 0x2B738}, {0x2B740, 0x2B81D},
+    {0x2B820, 0x2CEA1}, {0x2CEB0, 0x2EBE0}, {0x2F800, 0x2FA1D}, {0x30000, 0x3134A}, {0xE0100, 0xE01EF}
+};
+
+namespace {
+
+/*
+ * Simple lowercase mappings above U+007F, generated from the same
+ * database. Each entry maps first..last by adding the delta; a stride of 2
+ * maps only every other code point, as in the alternating Latin and
+ * Cyrillic blocks. Mappings whose lowercase form would need more UTF-8
+ * bytes are left out, so lowercasing never lengthens a word
+ */
+struct UnicodeLowercaseRange {
+    uint32_t first_code_point;
+    uint32_t last_code_point;
+    int32_t lowercase_delta;
+    uint32_t code_point_stride;
+};
+
+}  // namespace
+
+const UnicodeLowercaseRange UNICODE_LOWERCASE_RANGES[] = {
+    {0xC0, 0xD6, 32, 1}, {0xD8, 0xDE, 32, 1}, {0x100, 0x12E, 1, 2}, {0x132, 0x136, 1, 2}, {0x139, 0x147, 1, 2},
+    {0x14A, 0x176, 1, 2}, {0x178, 0x178, -121, 1}, {0x179, 0x17D, 1, 2}, {0x181, 0x181, 210, 1}, {0x182, 0x184, 1, 2},
+    {0x186, 0x186, 206, 1}, {0x187, 0x187, 1, 1}, {0x189, 0x18A, 205, 1}, {0x18B, 0x18B, 1, 1}, {0x18E, 0x18E, 79, 1},
+    {0x18F, 0x18F, 202, 1}, {0x190, 0x190, 203, 1}, {0x191, 0x191, 1, 1}, {0x193, 0x193, 205, 1},
+    {0x194, 0x194, 207, 1}, {0x196, 0x196, 211, 1}, {0x197, 0x197, 209, 1}, {0x198, 0x198, 1, 1},
+    {0x19C, 0x19C, 211, 1}, {0x19D, 0x19D, 213, 1}, {0x19F, 0x19F, 214, 1}, {0x1A0, 0x1A4, 1, 2},
+    {0x1A6, 0x1A6, 218, 1}, {0x1A7, 0x1A7, 1, 1}, {0x1A9, 0x1A9, 218, 1}, {0x1AC, 0x1AC, 1, 1}, {0x1AE, 0x1AE, 218, 1},
+    {0x1AF, 0x1AF, 1, 1}, {0x1B1, 0x1B2, 217, 1}, {0x1B3, 0x1B5, 1, 2}, {0x1B7, 0x1B7, 219, 1}, {0x1B8, 0x1B8, 1, 1},
+    {0x1BC, 0x1BC, 1, 1}, {0x1C4, 0x1C4, 2, 1}, {0x1C5, 0x1C5, 1, 1}, {0x1C7, 0x1C7, 2, 1}, {0x1C8, 0x1C8, 1, 1},
+    {0x1CA, 0x1CA, 2, 1}, {0x1CB, 0x1DB, 1, 2}, {0x1DE, 0x1EE, 1, 2}, {0x1F1, 0x1F1, 2, 1}, {0x1F2, 0x1F4, 1, 2},
+    {0x1F6, 0x1F6, -97, 1}, {0x1F7, 0x1F7, -56, 1}, {0x1F8, 0x21E, 1, 2}, {0x220, 0x220, -130, 1}, {0x222, 0x232, 1, 2},
+    {0x23B, 0x23B, 1, 1}, {0x23D, 0x23D, -163, 1}, {0x241, 0x241, 1, 1}, {0x243, 0x243, -195, 1}, {0x244, 0x244, 69, 1},
+    {0x245, 0x245, 71, 1}, {0x246, 0x24E, 1, 2}, {0x370, 0x372, 1, 2}, {0x376, 0x376, 1, 1}, {0x37F, 0x37F, 116, 1},
+    {0x386, 0x386, 38, 1}, {0x388, 0x38A, 37, 1}, {0x38C, 0x38C, 64, 1}, {0x38E, 0x38F, 63, 1}, {0x391, 0x3A1, 32, 1},
+    {0x3A3, 0x3AB, 32, 1}, {0x3CF, 0x3CF, 8, 1}, {0x3D8, 0x3EE, 1, 2}, {0x3F4, 0x3F4, -60, 1}, {0x3F7, 0x3F7, 1, 1},
+    {0x3F9, 0x3F9, -7, 1}, {0x3FA, 0x3FA, 1, 1}, {0x3FD, 0x3FF, -130, 1}, {0x400, 0x40F, 80, 1}, {0x410, 0x42F, 32, 1},
+    {0x460, 0x480, 1, 2}, {0x48A, 0x4BE, 1, 2}, {0x4C0, 0x4C0, 15, 1}, {0x4C1, 0x4CD, 1, 2}, {0x4D0, 0x52E, 1, 2},
+    {0x531, 0x556, 48, 1}, {0x10A0, 0x10C5, 7264, 1}, {0x10C7, 0x10C7, 7264, 1}, {0x10CD, 0x10CD, 7264, 1},
+    {0x13A0, 0x13EF, 38864, 1}, {0x13F0, 0x13F5, 8, 1}, {0x1C90, 0x1CBA, -3008, 1}, {0x1CBD, 0x1CBF, -3008, 1},
+    {0x1E00, 0x1E94, 1, 2}, {0x1E9E, 0x1E9E, -7615, 1}, {0x1EA0, 0x1EFE, 1, 2}, {0x1F08, 0x1F0F, -8, 1},
+    {0x1F18, 0x1F1D, -8, 1}, {0x1F28, 0x1F2F, -8, 1}, {0x1F38, 0x1F3F, -8, 1}, {0x1F48, 0x1F4D, -8, 1},
+    {0x1F59, 0x1F5F, -8, 2}, {0x1F68, 0x1F6F, -8, 1}, {0x1F88, 0x1F8F, -8, 1}, {0x1F98, 0x1F9F, -8, 1},
+    {0x1FA8, 0x1FAF, -8, 1}, {0x1FB8, 0x1FB9, -8, 1}, {0x1FBA, 0x1FBB, -74, 1}, {0x1FBC, 0x1FBC, -9, 1},
+    {0x1FC8, 0x1FCB, -86, 1}, {0x1FCC, 0x1FCC, -9, 1}, {0x1FD8, 0x1FD9, -8, 1}, {0x1FDA, 0x1FDB, -100, 1},
+    {0x1FE8, 0x1FE9, -8, 1}, {0x1FEA, 0x1FEB, -112, 1}, {0x1FEC, 0x1FEC, -7, 1}, {0x1FF8, 0x1FF9, -128, 1},
+    {0x1FFA, 0x1FFB, -126, 1}, {0x1FFC, 0x1FFC, -9, 1}, {0x2126, 0x2126, -7517, 1}, {0x212A, 0x212A, -8383, 1},
+    {0x212B, 0x212B, -8262, 1}, {0x2132, 0x2132, 28, 1}, {0x2160, 0x216F, 16, 1}, {0x2183, 0x2183, 1, 1},
+    {0x24B6, 0x24CF, 26, 1}, {0x2C00, 0x2C2F, 48, 1}, {0x2C60, 0x2C60, 1, 1}, {0x2C62, 0x2C62, -10743, 1},
+    {0x2C63, 0x2C63, -3814, 1}, {0x2C64, 0x2C64, -10727, 1}, {0x2C67, 0x2C6B, 1, 2}, {0x2C6D, 0x2C6D, -10780, 1},
+    {0x2C6E, 0x2C6E, -10749, 1}, {0x2C6F, 0x2C6F, -10783, 1}, {0x2C70, 0x2C70, -10782, 1}, {0x2C72, 0x2C72, 1, 1},
+    {0x2C75, 0x2C75, 1, 1}, {0x2C7E, 0x2C7F, -10815, 1}, {0x2C80, 0x2CE2, 1, 2}, {0x2CEB, 0x2CED, 1, 2},
+    {0x2CF2, 0x2CF2, 1, 1}, {0xA640, 0xA66C, 1, 2}, {0xA680, 0xA69A, 1, 2}, {0xA722, 0xA72E, 1, 2},
+    {0xA732, 0xA76E, 1, 2}, {0xA779, 0xA77B, 1, 2}, {0xA77D, 0xA77D, -35332, 1}, {0xA77E, 0xA786, 1, 2},
+    {0xA78B, 0xA78B, 1, 1}, {0xA78D, 0xA78D, -42280, 1}, {0xA790, 0xA792, 1, 2}, {0xA796, 0xA7A8, 1, 2},
+    {0xA7AA, 0xA7AA, -42308, 1}, {0xA7AB, 0xA7AB, -42319, 1}, {0xA7AC, 0xA7AC, -42315, 1}, {0xA7AD, 0xA7AD, -42305, 1},
+    {0xA7AE, 0xA7AE, -42308, 1}, {0xA7B0, 0xA7B0, -42258, 1}, {0xA7B1, 0xA7B1, -42282, 1}, {0xA7B2, 0xA7B2, -42261, 1},
+    {0xA7B3, 0xA7B3, 928, 1}, {0xA7B4, 0xA7C2, 1, 2}, {0xA7C4, 0xA7C4, -48, 1}, {0xA7C5, 0xA7C5, -42307, 1},
+    {0xA7C6, 0xA7C6, -35384, 1}, {0xA7C7, 0xA7C9, 1, 2}, {0xA7D0, 0xA7D0, 1, 1}, {0xA7D6, 0xA7D8, 1, 2},
+    {0xA7F5, 0xA7F5, 1, 1}, {0xFF21, 0xFF3A, 32, 1}, {0x10400, 0x10427, 40, 1}, {0x104B0, 0x104D3, 40, 1},
+    {0x10570, 0x1057A, 39, 1}, {0x1057C, 0x1058A, 39, 1}, {0x1058C, 0x10592, 39, 1}, {0x10594, 0x10595, 39, 1},
+    {0x10C80, 0x10CB2, 64, 1}, {0x118A0, 0x118BF, 32, 1}, {0x16E40, 0x16E5F, 32, 1}, {0x1E900, 0x1E921, 34, 1}
+};
+
+/*
+ * Report whether a code point above U+007F belongs inside a word
+ */
+static bool is_unicode_word_character(uint32_t code_point) {
+    // Latin-1 and Latin Extended letters, the most common case, skip the search
+    if (code_point >= 0xC0 && code_point < 0x250) {
+        return code_point != 0xD7 && code_point != 0xF7;
+    }
+    const size_t range_count = sizeof(UNICODE_WORD_CHARACTER_RANGES) / sizeof(UNICODE_WORD_CHARACTER_RANGES[0]);
+    auto following_range = upper_bound(UNICODE_WORD_CHARACTER_RANGES, UNICODE_WORD_CHARACTER_RANGES + range_count, code_point,
+                                       [](uint32_t searched_code_point, const uint32_t (&character_range)[2]) {
+                                           return searched_code_point < character_range[0];
+                                       });
+    return following_range != UNICODE_WORD_CHARACTER_RANGES && code_point <= (*(following_range - 1))[1];
+}
+
+/*
+ * Report whether a code point above U+007F separates words like ASCII whitespace
+ */
+static inline bool is_unicode_whitespace(uint32_t code_point) {
+    return code_point == 0x85 || code_point == 0xA0 || code_point == 0x1680 || (code_point >= 0x2000 && code_point <= 0x200A) ||
+           code_point == 0x2028 || code_point == 0x2029 || code_point == 0x202F || code_point == 0x205F || code_point == 0x3000;
+}
+
+/*
+ * Map a code point above U+007F to its simple lowercase form
+ */
+static uint32_t lowercase_unicode_code_point(uint32_t code_point) {
+    if (code_point < 0x100) {
+        return code_point >= 0xC0 && code_point <= 0xDE && code_point != 0xD7 ? code_point + 0x20 : code_point;
+    }
+    const size_t range_count = sizeof(UNICODE_LOWERCASE_RANGES) / sizeof(UNICODE_LOWERCASE_RANGES[0]);
+    auto following_range = upper_bound(UNICODE_LOWERCASE_RANGES, UNICODE_LOWERCASE_RANGES + range_count, code_point,
+                                       [](uint32_t searched_code_point, const UnicodeLowercaseRange& lowercase_range) {
+                                           return searched_code_point < lowercase_range.first_code_point;
+                                       });
+    if (following_range == UNICODE_LOWERCASE_RANGES) {
+        return code_point;
+    }
+    const UnicodeLowercaseRange& lowercase_range = *(following_range - 1);
+    if (code_point > lowercase_range.last_code_point ||
+        (code_point - lowercase_range.first_code_point) % lowercase_range.code_point_stride != 0) {
+        return code_point;
+    }
+    return static_cast<uint32_t>(static_cast<int32_t>(code_point) + lowercase_range.lowercase_delta);
+}
+
+/*
+ * Decode one UTF-8 sequence whose lead byte is 0x80 or above
+ * Returns the sequence length, or 0 when the bytes are not well-formed
+ * UTF-8: a stray continuation byte, an overlong form, a surrogate, a
+ * code point past U+10FFFF or a sequence cut off by the end of the text
+ */
+static inline size_t decode_utf8_sequence(const unsigned char* sequence_bytes, size_t available_bytes, uint32_t& code_point) {
+    unsigned char lead_byte = sequence_bytes[0];
+    size_t sequence_length;
+    unsigned char second_byte_minimum = 0x80;
+    unsigned char second_byte_maximum = 0xBF;
+    if (lead_byte >= 0xC2 && lead_byte <= 0xDF) {
+        sequence_length = 2;
+        code_point = lead_byte & 0x1F;
+    } else if (lead_byte >= 0xE0 && lead_byte <= 0xEF) {
+        sequence_length = 3;
+        code_point = lead_byte & 0x0F;
+        second_byte_minimum = lead_byte == 0xE0 ? 0xA0 : 0x80;
+        second_byte_maximum = lead_byte == 0xED ? 0x9F : 0xBF;
+    } else if (lead_byte >= 0xF0 && lead_byte <= 0xF4) {
+        sequence_length = 4;
+        code_point = lead_byte & 0x07;
+        second_byte_minimum = lead_byte == 0xF0 ? 0x90 : 0x80;
+        second_byte_maximum = lead_byte == 0xF4 ? 0x8F : 0xBF;
+    } else {
+        return 0;
+    }
+    if (available_bytes < sequence_length || sequence_bytes[1] < second_byte_minimum || sequence_bytes[1] > second_byte_maximum) {
+        return 0;
+    }
+    code_point = (code_point << 6) | (sequence_bytes[1] & 0x3F);
+    for (size_t continuation_index = 2; continuation_index < sequence_length; continuation_index++) {
+        if ((sequence_bytes[continuation_index] & 0xC0) != 0x80) {
+            return 0;
+        }
+        code_point = (code_point << 6) | (sequence_bytes[continuation_index] & 0x3F);
+    }
+    return sequence_length;
+}
+
+/*
+ * Encode a code point above U+007F as UTF-8; returns the byte count
+ */
+static inline size_t encode_utf8_sequence(uint32_t code_point, unsigned char* encoded_bytes) {
+    if (code_point < 0x800) {
+        encoded_bytes[0] = static_cast<unsigned char>(0xC0 | (code_point >> 6));
+        encoded_bytes[1] = static_cast<unsigned char>(0x80 | (code_point & 0x3F));
+        return 2;
+    }
+    if (code_point < 0x10000) {
+        encoded_bytes[0] = static_cast<unsigned char>(0xE0 | (code_point >> 12));
+        encoded_bytes[1] = static_cast<unsigned char>(0x80 | ((code_point >> 6) & 0x3F));
+        encoded_bytes[2] = static_cast<unsigned char>(0x80 | (code_point & 0x3F));
+        return 3;
+    }
+    encoded_bytes[0] = static_cast<unsigned char>(0xF0 | (code_point >> 18));
+    encoded_bytes[1] = static_cast<unsigned char>(0x80 | ((code_point >> 12) & 0x3F));
+    encoded_bytes[2] = static_cast<unsigned char>(0x80 | ((code_point >> 6) & 0x3F));
+    encoded_bytes[3] = static_cast<unsigned char>(0x80 | (code_point & 0x3F));
+    return 4;
+}
+
+/*
+ * Number of characters in a normalized word
+ * Normalized words hold only well-formed UTF-8, so every byte that is not
+ * a continuation byte starts one character
+ */
+static size_t count_utf8_characters(string_view normalized_word) {
+    size_t character_count = 0;
+    for (char character : normalized_word) {
+        character_count += (static_cast<unsigned char>(character) & 0xC0) != 0x80;
+    }
+    return character_count;
+}
+
+/*
+ * Move a split position back to the start of the UTF-8 sequence it falls in
+ * so a sequence is never divided between two scans
+ */
+static size_t align_to_utf8_sequence_start(string_view text_passage, size_t split_position) {
+    for (int step = 0; step < 3 && split_position > 0 && split_position < text_passage.size() &&
+                       (static_cast<unsigned char>(text_passage[split_position]) & 0xC0) == 0x80;
+         step++) {
+        split_position--;
+    }
+    return split_position;
+}
+
+/*
+ * Scalar character classes shared by every tokenizer kernel
+ * These match isalpha/isspace in the "C" locale without the lookup call
+ */
+static inline bool is_ascii_letter_byte(unsigned char byte_value) {
+    return static_cast<unsigned char>((byte_value | 0x20) - 'a') < 26;
+}
+
+static inline bool is_ascii_whitespace_byte(unsigned char byte_value) {
+    return byte_value == ' ' || static_cast<unsigned char>(byte_value - '\t') < 5;
+}
+
+// Bytes a token sink may write or read past the last letter it appends
+const size_t TOKEN_COPY_SLACK_BYTES = 16;
+
+namespace {
+
+/*
+ * Token sink that writes normalized words into a TokenizedPassage buffer
+ * Every kernel feeds letters and word boundaries through this interface
+ */
+class TokenBufferSink {
+public:
+    static constexpr bool tracks_punctuation = false;
+    static constexpr bool tracks_sentences = false;
+
+    TokenBufferSink(char* normalized_output, vector<WordTokenSpan>& word_spans)
+        : normalized_output(normalized_output), word_spans(word_spans) {}
+
+    void append_letter(unsigned char lowercase_letter) {
+        normalized_output[output_position++] = static_cast<char>(lowercase_letter);
+        current_word_length++;
+    }
+
+    // Short runs are copied as one fixed 16-byte move; the output buffer and
+    // the classified block both carry slack so the over-copy stays in bounds
+    void append_letters(const unsigned char* lowercase_letters, size_t letter_count) {
+        if (letter_count <= 16) {
+            memcpy(normalized_output + output_position, lowercase_letters, 16);
+        } else {
+            memcpy(normalized_output + output_position, lowercase_letters, letter_count);
+        }
+        output_position += static_cast<uint32_t>(letter_count);
+        current_word_length += letter_count;
+    }
+
+    // Lowercasing never lengthens an encoded letter, so the buffer bound still holds
+    void append_encoded_letter(const unsigned char* encoded_letter, size_t encoded_byte_count) {
+        memcpy(normalized_output + output_position, encoded_letter, encoded_byte_count);
+        output_position += static_cast<uint32_t>(encoded_byte_count);
+        current_word_length++;
+    }
+
+    void close_word() {
+        // Keep words longer than one letter, otherwise reuse their buffer space
+        if (current_word_length > 1) {
+            word_spans.push_back({current_word_start, output_position - current_word_start});
+        } else {
+            output_position = current_word_start;
+        }
+        current_word_start = output_position;
+        current_word_length = 0;
+    }
+
+    uint32_t written_character_count() const { return output_position; }
+
+private:
+    char* normalized_output;
+    vector<WordTokenSpan>& word_spans;
+    uint32_t output_position = 0;
+    uint32_t current_word_start = 0;
+    size_t current_word_length = 0;
+};
+
+}  // namespace
+
+/*
+ * Feed one non-ASCII UTF-8 sequence to the token sink; returns its length
+ * Letters and marks are lowercased into the current word, Unicode spaces
+ * close it, and other characters are skipped like ASCII punctuation.
+ * A malformed byte is skipped on its own so decoding resynchronizes
+ */
+template <typename TokenSink>
+static inline size_t scan_utf8_sequence(const unsigned char* sequence_bytes, size_t available_bytes, TokenSink& token_sink) {
+    uint32_t code_point;
+    size_t sequence_length = decode_utf8_sequence(sequence_bytes, available_bytes, code_point);
+    if (sequence_length == 0) {
+        return 1;
+    }
+    if (is_unicode_word_character(code_point)) {
+        unsigned char lowercase_bytes[4];
+        token_sink.append_encoded_letter(lowercase_bytes, encode_utf8_sequence(lowercase_unicode_code_point(code_point), lowercase_bytes));
+    } else if (is_unicode_whitespace(code_point)) {
+        token_sink.close_word();
+    }
+    return sequence_length;
+}
+
+/*
+ * Hashing for the compile-time word tables
+ * Words are mixed eight bytes per multiply like hash_word_bytes. The
+ * compiler assembles each chunk byte by byte; at run time a little-endian
+ * host reads the same value with at most two overlapping loads, so
+ * lookups cost about what a frequency table probe does
+ */
+const uint16_t STATIC_WORD_DIRECT_SLOT_FLAG = 0x8000;
+const size_t STATIC_WORD_BUCKET_LIMIT = 16;
+
+// Little-endian value of chunk_length (1 to 8) word bytes from chunk_offset, zero-extended
+static constexpr uint64_t load_static_word_chunk(string_view word_characters, size_t chunk_offset, size_t chunk_length) {
+#if (defined(__GNUC__) || defined(__clang__)) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    if (!__builtin_is_constant_evaluated()) {
+        const char* chunk_bytes = word_characters.data() + chunk_offset;
+        if (word_characters.size() >= 8) {
+            uint64_t trailing_bytes = 0;
+            memcpy(&trailing_bytes, chunk_bytes + chunk_length - 8, 8);
+            return trailing_bytes >> (8 * (8 - chunk_length));
+        }
+        if (chunk_length >= 4) {
+            uint32_t leading_bytes = 0;
+            uint32_t trailing_bytes = 0;
+            memcpy(&leading_bytes, chunk_bytes, 4);
+            memcpy(&trailing_bytes, chunk_bytes + chunk_length - 4, 4);
+            return leading_bytes | (static_cast<uint64_t>(trailing_bytes) << (8 * (chunk_length - 4)));
+        }
+        const unsigned char* short_bytes = reinterpret_cast<const unsigned char*>(chunk_bytes);
+        return short_bytes[0] | (static_cast<uint64_t>(short_bytes[chunk_length / 2]) << (8 * (chunk_length / 2))) |
+               (static_cast<uint64_t>(short_bytes[chunk_length - 1]) << (8 * (chunk_length - 1)));
+    }
+#endif
+    uint64_t word_chunk = 0;
+    for (size_t byte_index = 0; byte_index < chunk_length; byte_index++) {
+        unsigned char word_byte = static_cast<unsigned char>(word_characters[chunk_offset + byte_index]);
+        word_chunk |= static_cast<uint64_t>(word_byte) << (8 * byte_index);
+    }
+    return word_chunk;
+}
+
+static constexpr uint64_t hash_static_word(string_view word_characters, uint64_t hash_seed) {
+    const uint64_t multiplier = 0x9E3779B97F4A7C15ULL;
+    uint64_t hash_state = hash_seed ^ (word_characters.size() * multiplier);
+    for (size_t chunk_offset = 0; chunk_offset < word_characters.size(); chunk_offset += 8) {
+        size_t chunk_length = min<size_t>(8, word_characters.size() - chunk_offset);
+        uint64_t word_chunk = load_static_word_chunk(word_characters, chunk_offset, chunk_length);
+        hash_state = (hash_state ^ word_chunk) * multiplier;
+        hash_state ^= hash_state >> 29;
+    }
+    hash_state *= 0xD6E8FEB86659FD93ULL;
+    return hash_state ^ (hash_state >> 32);
+}
+
+static constexpr size_t static_word_bucket(uint64_t word_hash, size_t bucket_count) {
+    return static_cast<size_t>(((word_hash & 0xFFFFFFFFu) * bucket_count) >> 32);
+}
+
+static constexpr size_t static_word_displaced_slot(uint64_t word_hash, uint16_t displacement, size_t slot_count) {
+    uint64_t mixed_hash = (word_hash ^ (displacement * 0xC2B2AE3D27D4EB4FULL)) * 0x9E3779B97F4A7C15ULL;
+    return static_cast<size_t>(((mixed_hash >> 32) * slot_count) >> 32);
+}
+
+namespace {
+
+/*
+ * Minimal perfect hash of a fixed word list, built by the compiler
+ * Hash and displace, as for thesaurus files: words fall into buckets of
+ * about two, and from the largest bucket down each bucket takes the first
+ * displacement that sends all its words to free slots, while a bucket of
+ * one word points straight at a free slot. The table has exactly one slot
+ * per word, so a lookup is one hash, two loads and one comparison, and
+ * nothing is built at startup. find() returns the word's position in its
+ * list, or NOT_FOUND
+ */
+template <size_t WORD_COUNT>
+struct StaticWordTable {
+    static_assert(WORD_COUNT > 0 && WORD_COUNT < STATIC_WORD_DIRECT_SLOT_FLAG, "word list too large for 16-bit slots");
+    static constexpr size_t BUCKET_COUNT = WORD_COUNT / 2 + 1;
+    static constexpr size_t NOT_FOUND = WORD_COUNT;
+
+    uint64_t hash_seed = 0;
+    array<uint16_t, BUCKET_COUNT> bucket_displacements{};
+    array<string_view, WORD_COUNT> slot_words{};
+    array<uint16_t, WORD_COUNT> slot_word_indices{};
+
+    constexpr size_t find(string_view word_characters) const {
+        uint64_t word_hash = hash_static_word(word_characters, hash_seed);
+        uint16_t displacement = bucket_displacements[static_word_bucket(word_hash, BUCKET_COUNT)];
+        size_t word_slot = (displacement & STATIC_WORD_DIRECT_SLOT_FLAG) != 0
+                               ? displacement & ~STATIC_WORD_DIRECT_SLOT_FLAG
+                               : static_word_displaced_slot(word_hash, displacement, WORD_COUNT);
+        return slot_words[word_slot] == word_characters ? slot_word_indices[word_slot] : NOT_FOUND;
+    }
+
+    constexpr bool contains(string_view word_characters) const { return find(word_characters) != NOT_FOUND; }
+};
+
+}  // namespace
+
+/*
+ * Build the StaticWordTable of a word list during compilation
+ * A seed whose hashes crowd one bucket past STATIC_WORD_BUCKET_LIMIT, or
+ * leave a bucket without a workable displacement, is replaced by the
+ * next. A word listed twice stops compilation, since no table could hold it
+ */
+template <size_t WORD_COUNT>
+static constexpr StaticWordTable<WORD_COUNT> build_static_word_table(const string_view (&table_words)[WORD_COUNT]) {
+    using WordTable = StaticWordTable<WORD_COUNT>;
+    for (uint64_t hash_seed = 1;; hash_seed++) {
+        WordTable word_table;
+        word_table.hash_seed = hash_seed;
+        array<uint64_t, WORD_COUNT> word_hashes{};
+        array<size_t, WordTable::BUCKET_COUNT> bucket_sizes{};
+        size_t largest_bucket_size = 0;
+        for (size_t word_index = 0; word_index < WORD_COUNT; word_index++) {
+            word_hashes[word_index] = hash_static_word(table_words[word_index], hash_seed);
+            size_t& bucket_size = bucket_sizes[static_word_bucket(word_hashes[word_index], WordTable::BUCKET_COUNT)];
+            largest_bucket_size = max(largest_bucket_size, ++bucket_size);
+        }
+        if (largest_bucket_size > STATIC_WORD_BUCKET_LIMIT) {
+            continue;
+        }
+
+        array<bool, WORD_COUNT> slot_taken{};
+        bool buckets_placed = true;
+        for (size_t bucket_size = largest_bucket_size; bucket_size >= 1 && buckets_placed; bucket_size--) {
+            for (size_t bucket_index = 0; bucket_index < WordTable::BUCKET_COUNT && buckets_placed; bucket_index++) {
+                if (bucket_sizes[bucket_index] != bucket_size) {
+                    continue;
+                }
+                array<size_t, STATIC_WORD_BUCKET_LIMIT> bucket_words{};
+                size_t gathered_count = 0;
+                for (size_t word_index = 0; word_index < WORD_COUNT; word_index++) {
+                    if (static_word_bucket(word_hashes[word_index], WordTable::BUCKET_COUNT) == bucket_index) {
+                        for (size_t gathered_index = 0; gathered_index < gathered_count; gathered_index++) {
+                            if (table_words[bucket_words[gathered_index]] == table_words[word_index]) {
+                                throw invalid_argument("build_static_word_table: a word is listed twice");
+                            }
+                        }
+                        bucket_words[gathered_count++] = word_index;
+                    }
+                }
+
+                if (bucket_size == 1) {
+                    // Buckets of one come last, so any free slot will do
+                    size_t free_slot = 0;
+                    while (slot_taken[free_slot]) {
+                        free_slot++;
+                    }
+                    slot_taken[free_slot] = true;
+                    word_table.bucket_displacements[bucket_index] =
+                        static_cast<uint16_t>(free_slot | STATIC_WORD_DIRECT_SLOT_FLAG);
+                    word_table.slot_words[free_slot] = table_words[bucket_words[0]];
+                    word_table.slot_word_indices[free_slot] = static_cast<uint16_t>(bucket_words[0]);
+                    continue;
+                }
+
+                buckets_placed = false;
+                for (uint16_t displacement = 0; displacement < STATIC_WORD_DIRECT_SLOT_FLAG && !buckets_placed; displacement++) {
+                    array<size_t, STATIC_WORD_BUCKET_LIMIT> word_slots{};
+                    bool slots_free = true;
+                    for (size_t member_index = 0; member_index < bucket_size && slots_free; member_index++) {
+                        uint64_t member_hash = word_hashes[bucket_words[member_index]];
+                        word_slots[member_index] = static_word_displaced_slot(member_hash, displacement, WORD_COUNT);
+                        slots_free = !slot_taken[word_slots[member_index]];
+                        for (size_t earlier_index = 0; earlier_index < member_index && slots_free; earlier_index++) {
+                            slots_free = word_slots[earlier_index] != word_slots[member_index];
+                        }
+                    }
+                    if (slots_free) {
+                        for (size_t member_index = 0; member_index < bucket_size; member_index++) {
+                            size_t word_slot = word_slots[member_index];
+                            slot_taken[word_slot] = true;
+                            word_table.slot_words[word_slot] = table_words[bucket_words[member_index]];
+                            word_table.slot_word_indices[word_slot] = static_cast<uint16_t>(bucket_words[member_index]);
+                        }
+                        word_table.bucket_displacements[bucket_index] = displacement;
+                        buckets_placed = true;
+                    }
+                }
+            }
+        }
+        if (buckets_placed) {
+            return word_table;
+        }
+    }
+}
+
+/*
+ * Function words: articles, pronouns, prepositions, conjunctions,
+ * auxiliaries and the like, normalized as passage words are, so
+ * apostrophes are dropped ("dont"). They carry grammar rather than
+ * meaning, and count as basic vocabulary at any length
+ */
+constexpr string_view FUNCTION_WORDS[] = {
+    "a",           "about",       "above",       "across",      "after",       "afterwards",  "again",       "against",
+    "all",         "almost",      "along",       "already",     "also",        "although",    "always",      "am",
+    "among",       "amongst",     "an",          "and",         "another",     "any",         "anybody",     "anyone",
+    "anything",    "anyway",      "anywhere",    "are",         "arent",       "around",      "as",          "at",
+    "be",          "because",     "been",        "before",      "beforehand",  "behind",      "being",       "below",
+    "beside",      "besides",     "between",     "beyond",      "both",        "but",         "by",          "can",
+    "cannot",      "cant",        "could",       "couldnt",     "did",         "didnt",       "do",          "does",
+    "doesnt",      "doing",       "done",        "dont",        "down",        "during",      "each",        "either",
+    "else",        "elsewhere",   "enough",      "even",        "ever",        "every",       "everybody",   "everyone",
+    "everything",  "everywhere",  "except",      "few",         "for",         "from",        "further",     "furthermore",
+    "had",         "hadnt",       "has",         "hasnt",       "have",        "havent",      "having",      "he",
+    "hence",       "her",         "here",        "hers",        "herself",     "him",         "himself",     "his",
+    "how",         "however",     "i",           "if",          "in",          "inside",      "instead",     "into",
+    "is",          "isnt",        "it",          "its",         "itself",      "just",        "least",       "less",
+    "like",        "many",        "may",         "me",          "meanwhile",   "might",       "mine",        "more",
+    "moreover",    "most",        "much",        "must",        "mustnt",      "my",          "myself",      "near",
+    "neither",     "never",       "nevertheless","no",          "nobody",      "none",        "nonetheless", "nor",
+    "not",         "nothing",     "now",         "nowhere",     "of",          "off",         "often",       "on",
+    "once",        "one",         "only",        "onto",        "or",          "other",       "others",      "otherwise",
+    "our",         "ours",        "ourselves",   "out",         "outside",     "over",        "own",         "per",
+    "perhaps",     "quite",       "rather",      "same",        "several",     "shall",       "she",         "should",
+    "shouldnt",    "since",       "so",          "some",        "somebody",    "someone",     "something",   "sometimes",
+    "somewhere",   "still",       "such",        "than",        "that",        "the",         "their",       "theirs",
+    "them",        "themselves",  "then",        "thence",      "there",       "thereafter",  "thereby",     "therefore",
+    "these",       "they",        "this",        "those",       "though",      "through",     "throughout",  "thus",
+    "to",          "together",    "too",         "toward",      "towards",     "under",       "unless",      "until",
+    "up",          "upon",        "us",          "very",        "was",         "wasnt",       "we",          "were",
+    "werent",      "what",        "whatever",    "when",        "whenever",    "where",       "whereas",     "wherever",
+    "whether",     "which",       "whichever",   "while",       "who",         "whoever",     "whole",       "whom",
+    "whose",       "why",         "will",        "with",        "within",      "without",     "wont",        "would",
+    "wouldnt",     "yet",         "you",         "your",        "yours",       "yourself",    "yourselves"};
+
+/*
+ * Dolch sight words (the 220 service words and 95 nouns taught to early
+ * readers) longer than five letters, leaving out those already listed as
+ * function words. Length alone would count them as intermediate words
+ */
+constexpr string_view BASIC_VOCABULARY_WORDS[] = {
+    "better",      "birthday",    "brother",     "chicken",     "children",    "christmas",   "farmer",      "father",
+    "flower",      "garden",      "goodbye",     "ground",      "letter",      "morning",     "mother",      "picture",
+    "please",      "pretty",      "rabbit",      "school",      "sister",      "squirrel",    "street",      "window",
+    "yellow"};
+
+constexpr auto FUNCTION_WORD_TABLE = build_static_word_table(FUNCTION_WORDS);
+constexpr auto BASIC_VOCABULARY_TABLE = build_static_word_table(BASIC_VOCABULARY_WORDS);
+
+static bool is_function_word(string_view normalized_word) {
+    return FUNCTION_WORD_TABLE.contains(normalized_word);
+}
+
+/*
+ * Vocabulary class of a normalized word
+ * Words of at most five letters, function words and Dolch sight
+ * words are basic; other words over eight letters are advanced, and the
+ * rest intermediate. Only words longer than five letters are looked up
+ */
+VocabularyWordClass classify_vocabulary_word(string_view normalized_word, size_t character_count) {
+    if (character_count <= 5 || is_function_word(normalized_word) ||
+        BASIC_VOCABULARY_TABLE.contains(normalized_word)) {
+        return VocabularyWordClass::Basic;
+    }
+    return character_count > 8 ? VocabularyWordClass::Advanced : VocabularyWordClass::Intermediate;
+}
+
+/*
+ * Bit scans of a nonzero mask
+ * GCC and Clang compile these to one instruction; other compilers get a
+ * plain loop
+ */
+static inline unsigned lowest_set_bit_index(uint32_t bit_mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctz(bit_mask));
+#else
+    unsigned bit_index = 0;
+    while ((bit_mask & 1u) == 0) {
+        bit_mask >>= 1;
+        bit_index++;
+    }
+    return bit_index;
+#endif
+}
+
+static inline unsigned lowest_set_bit_index(uint64_t bit_mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(bit_mask));
+#else
+    unsigned bit_index = 0;
+    while ((bit_mask & 1u) == 0) {
+        bit_mask >>= 1;
+        bit_index++;
+    }
+    return bit_index;
+#endif
+}
+
+static inline unsigned leading_zero_bit_count(uint64_t bit_pattern) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_clzll(bit_pattern));
+#else
+    unsigned zero_count = 0;
+    while ((bit_pattern & (1ULL << 63)) == 0) {
+        bit_pattern <<= 1;
+        zero_count++;
+    }
+    return zero_count;
+#endif
+}
+
+// Exponent of a power of two, usable in constant expressions
+static constexpr unsigned power_of_two_exponent(uint64_t power_of_two) {
+    unsigned exponent = 0;
+    while (power_of_two > 1) {
+        power_of_two >>= 1;
+        exponent++;
+    }
+    return exponent;
+}
+
+namespace {
+
+/*
+ * Byte classes and states of the sentence boundary state machine
+ * The UTF-8 classes recognize U+2026 (E2 80 A6) as a terminal and the
+ * closing quotes U+2019, U+201D (E2 80 99, E2 80 9D) and U+00BB (C2 BB);
+ * any other byte of a multi-byte sequence behaves like a letter
+ */
+enum SentenceByteClass : uint8_t {
+    SENTENCE_BYTE_OTHER,
+    SENTENCE_BYTE_WHITESPACE,
+    SENTENCE_BYTE_PERIOD,
+    SENTENCE_BYTE_STRONG_TERMINAL,  // '!' and '?'
+    SENTENCE_BYTE_CLOSER,           // Closing quotes and brackets
+    SENTENCE_BYTE_LEAD_E2,
+    SENTENCE_BYTE_LEAD_C2,
+    SENTENCE_BYTE_CONTINUATION_80,
+    SENTENCE_BYTE_CONTINUATION_ELLIPSIS,
+    SENTENCE_BYTE_CONTINUATION_QUOTE,
+    SENTENCE_BYTE_CONTINUATION_GUILLEMET,
+    SENTENCE_BYTE_CLASS_COUNT
+};
+
+enum SentenceScannerState : uint8_t {
+    SENTENCE_SCAN,      // No terminal run open; only candidate bytes are examined
+    SENTENCE_TERMINAL,  // Inside a terminal run or the closers after it
+    SENTENCE_SCAN_E2,
+    SENTENCE_SCAN_E2_80,
+    SENTENCE_TERMINAL_E2,
+    SENTENCE_TERMINAL_E2_80,
+    SENTENCE_TERMINAL_C2,
+    SENTENCE_STATE_COUNT,
+    // Actions taken by the driver rather than states
+    SENTENCE_ABBREVIATION_CHECK = SENTENCE_STATE_COUNT,
+    SENTENCE_BOUNDARY
+};
+
+}  // namespace
+
+constexpr array<uint8_t, 256> SENTENCE_BYTE_CLASSES = [] {
+    array<uint8_t, 256> byte_classes{};
+    for (unsigned char whitespace_byte : {' ', '\t', '\n', '\v', '\f', '\r'}) {
+        byte_classes[whitespace_byte] = SENTENCE_BYTE_WHITESPACE;
+    }
+    byte_classes['.'] = SENTENCE_BYTE_PERIOD;
+    byte_classes['!'] = SENTENCE_BYTE_STRONG_TERMINAL;
+    byte_classes['?'] = SENTENCE_BYTE_STRONG_TERMINAL;
+    for (unsigned char closer_byte : {'"', '\'', ')', ']', '}'}) {
+        byte_classes[closer_byte] = SENTENCE_BYTE_CLOSER;
+    }
+    byte_classes[0xE2] = SENTENCE_BYTE_LEAD_E2;
+    byte_classes[0xC2] = SENTENCE_BYTE_LEAD_C2;
+    byte_classes[0x80] = SENTENCE_BYTE_CONTINUATION_80;
+    byte_classes[0xA6] = SENTENCE_BYTE_CONTINUATION_ELLIPSIS;
+    byte_classes[0x99] = SENTENCE_BYTE_CONTINUATION_QUOTE;
+    byte_classes[0x9D] = SENTENCE_BYTE_CONTINUATION_QUOTE;
+    byte_classes[0xBB] = SENTENCE_BYTE_CONTINUATION_GUILLEMET;
+    return byte_classes;
+}();
+
+/*
+ * Transition table, one row per state and one column per byte class
+ * Every row starts from the SCAN row, so a byte that breaks a partial
+ * UTF-8 match is still classified on its own
+ */
+constexpr array<array<uint8_t, SENTENCE_BYTE_CLASS_COUNT>, SENTENCE_STATE_COUNT> SENTENCE_STATE_TRANSITIONS = [] {
+    array<uint8_t, SENTENCE_BYTE_CLASS_COUNT> scan_row{};
+    for (uint8_t& next_state : scan_row) {
+        next_state = SENTENCE_SCAN;
+    }
+    scan_row[SENTENCE_BYTE_PERIOD] = SENTENCE_ABBREVIATION_CHECK;
+    scan_row[SENTENCE_BYTE_STRONG_TERMINAL] = SENTENCE_TERMINAL;
+    scan_row[SENTENCE_BYTE_LEAD_E2] = SENTENCE_SCAN_E2;
+
+    array<array<uint8_t, SENTENCE_BYTE_CLASS_COUNT>, SENTENCE_STATE_COUNT> state_transitions{};
+    for (auto& transition_row : state_transitions) {
+        transition_row = scan_row;
+    }
+    state_transitions[SENTENCE_SCAN_E2][SENTENCE_BYTE_CONTINUATION_80] = SENTENCE_SCAN_E2_80;
+    state_transitions[SENTENCE_SCAN_E2_80][SENTENCE_BYTE_CONTINUATION_ELLIPSIS] = SENTENCE_TERMINAL;
+
+    auto& terminal_row = state_transitions[SENTENCE_TERMINAL];
+    terminal_row[SENTENCE_BYTE_WHITESPACE] = SENTENCE_BOUNDARY;
+    terminal_row[SENTENCE_BYTE_PERIOD] = SENTENCE_TERMINAL;  // Runs such as "..." or "?!" end one sentence
+    terminal_row[SENTENCE_BYTE_CLOSER] = SENTENCE_TERMINAL;
+    terminal_row[SENTENCE_BYTE_LEAD_E2] = SENTENCE_TERMINAL_E2;
+    terminal_row[SENTENCE_BYTE_LEAD_C2] = SENTENCE_TERMINAL_C2;
+    state_transitions[SENTENCE_TERMINAL_E2][SENTENCE_BYTE_CONTINUATION_80] = SENTENCE_TERMINAL_E2_80;
+    state_transitions[SENTENCE_TERMINAL_E2_80][SENTENCE_BYTE_CONTINUATION_ELLIPSIS] = SENTENCE_TERMINAL;
+    state_transitions[SENTENCE_TERMINAL_E2_80][SENTENCE_BYTE_CONTINUATION_QUOTE] = SENTENCE_TERMINAL;
+    state_transitions[SENTENCE_TERMINAL_C2][SENTENCE_BYTE_CONTINUATION_GUILLEMET] = SENTENCE_TERMINAL;
+    return state_transitions;
+}();
+
+/*
+ * Abbreviations that are followed by a period inside a sentence
+ * Lowercase and without the final period; single letters and dotted
+ * initialisms such as "e.g" are recognized by shape instead. Words that
+ * often end a sentence ("no", "sun", "us") are deliberately left out
+ */
+constexpr string_view SENTENCE_ABBREVIATIONS[] = {
+    "mr",   "mrs",  "ms",   "dr",   "prof", "sr",   "jr",   "st",   "mt",   "vs",   "etc",  "inc",
+    "ltd",  "co",   "corp", "dept", "univ", "bros", "fig",  "figs", "eq",   "approx", "est", "vol",
+    "vols", "ch",   "pp",   "jan",  "feb",  "apr",  "aug",  "sept", "oct",  "nov",  "dec",  "gen",
+    "gov",  "sen",  "rev",  "capt", "col",  "lt",   "sgt",  "cmdr", "adm",  "al",   "cf",   "viz",
+    "ca",   "ph.d"};
+
+// Longest listed abbreviation; longer tokens are ruled out before any lookup
+const size_t ABBREVIATION_MAXIMUM_BYTES = 8;
+
+constexpr auto SENTENCE_ABBREVIATION_TABLE = build_static_word_table(SENTENCE_ABBREVIATIONS);
+
+/*
+ * Decide whether the period at period_position closes an abbreviation
+ * The token before it is read backwards, from the block and then from the
+ * bytes kept from earlier blocks, up to whitespace or an opening quote or
+ * bracket; any other byte, or a token too long to be listed, rules it out
+ */
+bool SentenceBoundaryScanner::ends_abbreviation(const unsigned char* block_bytes, size_t period_position) const {
+    unsigned char reversed_token[ABBREVIATION_MAXIMUM_BYTES];
+    size_t token_length = 0;
+    for (size_t lookback_distance = 1;; lookback_distance++) {
+        unsigned char byte_value = lookback_distance <= period_position
+                                       ? block_bytes[period_position - lookback_distance]
+                                       : preceding_bytes[sizeof(preceding_bytes) - (lookback_distance - period_position)];
+        if (is_ascii_letter_byte(byte_value) || byte_value == '.') {
+            if (token_length == ABBREVIATION_MAXIMUM_BYTES) {
+                return false;
+            }
+            reversed_token[token_length++] = byte_value | 0x20;  // Lowercases letters and keeps '.'
+            continue;
+        }
+        if (!is_ascii_whitespace_byte(byte_value) && byte_value != '"' && byte_value != '\'' && byte_value != '(' &&
+            byte_value != '[' && byte_value != '{') {
+            return false;
+        }
+        break;
+    }
+
+    // Initials and dotted initialisms: letters alternating with periods
+    bool alternates_letters = token_length % 2 == 1;
+    for (size_t token_index = 0; token_index < token_length && alternates_letters; token_index++) {
+        alternates_letters = (reversed_token[token_index] == '.') == (token_index % 2 == 1);
+    }
+    if (alternates_letters) {
+        return true;
+    }
+
+    char abbreviation_characters[ABBREVIATION_MAXIMUM_BYTES];
+    for (size_t token_index = 0; token_index < token_length; token_index++) {
+        abbreviation_characters[token_index] = static_cast<char>(reversed_token[token_length - 1 - token_index]);
+    }
+    return token_length > 0 && SENTENCE_ABBREVIATION_TABLE.contains(string_view(abbreviation_characters, token_length));
+}
+
+/*
+ * Run the state machine over one block of at most 64 bytes
+ * While no terminal run is open the scan jumps from one candidate byte to
+ * the next, so candidate_mask must flag every '.', '!', '?' and 0xE2 byte
+ * of the block; passing every bit is always correct, just slower
+ */
+uint64_t SentenceBoundaryScanner::scan_block(const unsigned char* block_bytes, size_t block_length, uint64_t candidate_mask) {
+    uint64_t boundary_mask = 0;
+    size_t byte_position = 0;
+    while (byte_position < block_length) {
+        if (scanner_state == SENTENCE_SCAN) {
+            uint64_t remaining_candidates = candidate_mask & (~0ULL << byte_position);
+            if (remaining_candidates == 0) {
+                break;
+            }
+            byte_position = lowest_set_bit_index(remaining_candidates);
+            if (byte_position >= block_length) {
+                break;
+            }
+        }
+
+        uint8_t next_state = SENTENCE_STATE_TRANSITIONS[scanner_state][SENTENCE_BYTE_CLASSES[block_bytes[byte_position]]];
+        if (next_state == SENTENCE_ABBREVIATION_CHECK) {
+            next_state = ends_abbreviation(block_bytes, byte_position) ? SENTENCE_SCAN : SENTENCE_TERMINAL;
+        } else if (next_state == SENTENCE_BOUNDARY) {
+            boundary_mask |= 1ULL << byte_position;
+            next_state = SENTENCE_SCAN;
+        }
+        scanner_state = next_state;
+        byte_position++;
+    }
+
+    // Keep the last bytes for the lookback of the next block
+    if (block_length >= sizeof(preceding_bytes)) {
+        memcpy(preceding_bytes, block_bytes + block_length - sizeof(preceding_bytes), sizeof(preceding_bytes));
+    } else {
+        memmove(preceding_bytes, preceding_bytes + block_length, sizeof(preceding_bytes) - block_length);
+        memcpy(preceding_bytes + sizeof(preceding_bytes) - block_length, block_bytes, block_length);
+    }
+    return boundary_mask;
+}
+
+/*
+ * End the text; an open terminal run ends the last sentence there
+ * The scanner is reset, so the next block starts a new text
+ */
+bool SentenceBoundaryScanner::finish() {
+    bool ends_sentence = scanner_state == SENTENCE_TERMINAL;
+    scanner_state = SENTENCE_SCAN;
+    memset(preceding_bytes, ' ', sizeof(preceding_bytes));
+    return ends_sentence;
+}
+
+/*
+ * Portable scalar tokenizer loop
+ * This is the reference behaviour every vectorized kernel must reproduce;
+ * the word still open at the end of the text is left to the caller.
+ * Sentence boundaries are found one 64-byte window ahead of the tokenizer
+ */
+template <typename TokenSink>
+static void scan_passage_bytes_scalar(string_view text_passage, TokenSink& token_sink) {
+    const unsigned char* passage_bytes = reinterpret_cast<const unsigned char*>(text_passage.data());
+    size_t passage_length = text_passage.size();
+    size_t byte_offset = 0;
+    size_t sentence_window_start = 0;
+    size_t sentence_window_end = 0;
+    uint64_t sentence_boundary_mask = 0;
+    while (byte_offset < passage_length) {
+        if constexpr (TokenSink::tracks_sentences) {
+            while (byte_offset >= sentence_window_end) {
+                sentence_window_start = sentence_window_end;
+                sentence_window_end = min(passage_length, sentence_window_start + 64);
+                sentence_boundary_mask = token_sink.scan_sentence_boundaries(
+                    passage_bytes + sentence_window_start, sentence_window_end - sentence_window_start, ~0ULL);
+            }
+        }
+        unsigned char byte_value = passage_bytes[byte_offset];
+        if (byte_value >= 0x80) {
+            byte_offset += scan_utf8_sequence(passage_bytes + byte_offset, passage_length - byte_offset, token_sink);
+            continue;
+        }
+        if (is_ascii_letter_byte(byte_value)) {
+            token_sink.append_letter(byte_value | 0x20);  // Normalize to lowercase
+        } else if (is_ascii_whitespace_byte(byte_value)) {
+            token_sink.close_word();
+            if constexpr (TokenSink::tracks_sentences) {
+                if ((sentence_boundary_mask >> (byte_offset - sentence_window_start)) & 1) {
+                    token_sink.close_sentence();
+                }
+            }
+        } else if constexpr (TokenSink::tracks_punctuation) {
+            token_sink.record_punctuation_byte(byte_value);
+        }
+        byte_offset++;
+    }
+}
+
+#if TEXT_ANALYSER_X86_SIMD
+
+namespace {
+
+/*
+ * Classification result for one 64-byte block of passage text
+ * Bit i of each mask describes byte i; the punctuation masks feed the
+ * sentence statistics of the fused engine, and the letter, whitespace and
+ * punctuation masks are only meaningful for ASCII bytes; lowercase_bytes holds every byte
+ * with the ASCII case bit set, which is only meaningful for letters
+ */
+struct ClassifiedTextBlock {
+    uint64_t alphabetic_mask;
+    uint64_t whitespace_mask;
+    uint64_t sentence_terminal_mask;  // '.', '!' and '?'
+    uint64_t comma_mask;
+    uint64_t semicolon_mask;
+    uint64_t non_ascii_mask;  // Bytes of multi-byte UTF-8 sequences, handled by the scalar decoder
+    alignas(64) unsigned char lowercase_bytes[64 + TOKEN_COPY_SLACK_BYTES];
+};
+
+}  // namespace
+
+/*
+ * Vector classification kernels, one per instruction set
+ * Letters are detected as (byte | 0x20) - 'a' < 26 and whitespace as
+ * ' ' or '\t'..'\r', using a signed-compare bias because SSE2 and AVX2
+ * have no unsigned byte comparison
+ */
+TEXT_ANALYSER_TARGET("sse2")
+static void classify_text_block_sse2(const unsigned char* block_bytes, ClassifiedTextBlock& classified_block) {
+    const __m128i case_bit = _mm_set1_epi8(0x20);
+    const __m128i letter_bias = _mm_set1_epi8(static_cast<char>(0x80 - 'a'));
+    const __m128i letter_limit = _mm_set1_epi8(static_cast<char>(-128 + 26));
+    const __m128i control_bias = _mm_set1_epi8(static_cast<char>(0x80 - '\t'));
+    const __m128i control_limit = _mm_set1_epi8(static_cast<char>(-128 + 5));
+    const __m128i space_character = _mm_set1_epi8(' ');
+    const __m128i period_character = _mm_set1_epi8('.');
+    const __m128i exclamation_character = _mm_set1_epi8('!');
+    const __m128i question_character = _mm_set1_epi8('?');
+    const __m128i comma_character = _mm_set1_epi8(',');
+    const __m128i semicolon_character = _mm_set1_epi8(';');
+
+    uint64_t alphabetic_mask = 0;
+    uint64_t whitespace_mask = 0;
+    uint64_t sentence_terminal_mask = 0;
+    uint64_t comma_mask = 0;
+    uint64_t semicolon_mask = 0;
+    uint64_t non_ascii_mask = 0;
+    for (int lane_offset = 0; lane_offset < 64; lane_offset += 16) {
+        __m128i raw_bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block_bytes + lane_offset));
+        __m128i lowered_bytes = _mm_or_si128(raw_bytes, case_bit);
+        __m128i letter_lanes = _mm_cmplt_epi8(_mm_add_epi8(lowered_bytes, letter_bias), letter_limit);
+        __m128i space_lanes = _mm_or_si128(_mm_cmpeq_epi8(raw_bytes, space_character),
+                                           _mm_cmplt_epi8(_mm_add_epi8(raw_bytes, control_bias), control_limit));
+        _mm_store_si128(reinterpret_cast<__m128i*>(classified_block.lowercase_bytes + lane_offset), lowered_bytes);
+        alphabetic_mask |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(letter_lanes))) << lane_offset;
+        whitespace_mask |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(space_lanes))) << lane_offset;
+
+        __m128i terminal_lanes = _mm_or_si128(_mm_cmpeq_epi8(raw_bytes, period_character),
+                                              _mm_or_si128(_mm_cmpeq_epi8(raw_bytes, exclamation_character),
+                                                           _mm_cmpeq_epi8(raw_bytes, question_character)));
+        sentence_terminal_mask |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(terminal_lanes))) << lane_offset;
+        comma_mask |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(raw_bytes, comma_character)))) << lane_offset;
+        semicolon_mask |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(raw_bytes, semicolon_character)))) << lane_offset;
+        non_ascii_mask |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(raw_bytes))) << lane_offset;
+    }
+    classified_block.alphabetic_mask = alphabetic_mask;
+    classified_block.whitespace_mask = whitespace_mask;
+    classified_block.sentence_terminal_mask = sentence_terminal_mask;
+    classified_block.comma_mask = comma_mask;
+    classified_block.semicolon_mask = semicolon_mask;
+    classified_block.non_ascii_mask = non_ascii_mask;
+}
+
+TEXT_ANALYSER_TARGET("avx2")
+static void classify_text_block_avx2(const unsigned char* block_bytes, ClassifiedTextBlock& classified_block) {
+    const __m256i case_bit = _mm256_set1_epi8(0x20);
+    const __m256i letter_bias = _mm256_set1_epi8(static_cast<char>(0x80 - 'a'));
+    const __m256i letter_limit = _mm256_set1_epi8(static_cast<char>(-128 + 26));
+    const __m256i control_bias = _mm256_set1_epi8(static_cast<char>(0x80 - '\t'));
+    const __m256i control_limit = _mm256_set1_epi8(static_cast<char>(-128 + 5));
+    const __m256i space_character = _mm256_set1_epi8(' ');
+    const __m256i period_character = _mm256_set1_epi8('.');
+    const __m256i exclamation_character = _mm256_set1_epi8('!');
+    const __m256i question_character = _mm256_set1_epi8('?');
+    const __m256i comma_character = _mm256_set1_epi8(',');
+    const __m256i semicolon_character = _mm256_set1_epi8(';');
+
+    uint64_t alphabetic_mask = 0;
+    uint64_t whitespace_mask = 0;
+    uint64_t sentence_terminal_mask = 0;
+    uint64_t comma_mask = 0;
+    uint64_t semicolon_mask = 0;
+    uint64_t non_ascii_mask = 0;
+    for (int lane_offset = 0; lane_offset < 64; lane_offset += 32) {
+        __m256i raw_bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block_bytes + lane_offset));
+        __m256i lowered_bytes = _mm256_or_si256(raw_bytes, case_bit);
+        __m256i letter_lanes = _mm256_cmpgt_epi8(letter_limit, _mm256_add_epi8(lowered_bytes, letter_bias));
+        __m256i space_lanes = _mm256_or_si256(_mm256_cmpeq_epi8(raw_bytes, space_character),
+                                              _mm256_cmpgt_epi8(control_limit, _mm256_add_epi8(raw_bytes, control_bias)));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(classified_block.lowercase_bytes + lane_offset), lowered_bytes);
+        alphabetic_mask |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(letter_lanes))) << lane_offset;
+        whitespace_mask |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(space_lanes))) << lane_offset;
+
+        __m256i terminal_lanes = _mm256_or_si256(_mm256_cmpeq_epi8(raw_bytes, period_character),
+                                                 _mm256_or_si256(_mm256_cmpeq_epi8(raw_bytes, exclamation_character),
+                                                                 _mm256_cmpeq_epi8(raw_bytes, question_character)));
+        sentence_terminal_mask |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(terminal_lanes))) << lane_offset;
+        comma_mask |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(raw_bytes, comma_character)))) << lane_offset;
+        semicolon_mask |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(raw_bytes, semicolon_character)))) << lane_offset;
+        non_ascii_mask |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(raw_bytes))) << lane_offset;
+    }
+    classified_block.alphabetic_mask = alphabetic_mask;
+    classified_block.whitespace_mask = whitespace_mask;
+    classified_block.sentence_terminal_mask = sentence_terminal_mask;
+    classified_block.comma_mask = comma_mask;
+    classified_block.semicolon_mask = semicolon_mask;
+    classified_block.non_ascii_mask = non_ascii_mask;
+}
+
+TEXT_ANALYSER_TARGET("avx512f,avx512bw")
+static void classify_text_block_avx512(const unsigned char* block_bytes, ClassifiedTextBlock& classified_block) {
+    const __m512i case_bit = _mm512_set1_epi8(0x20);
+    const __m512i letter_bias = _mm512_set1_epi8(static_cast<char>(0x80 - 'a'));
+    const __m512i letter_limit = _mm512_set1_epi8(static_cast<char>(-128 + 26));
+    const __m512i control_bias = _mm512_set1_epi8(static_cast<char>(0x80 - '\t'));
+    const __m512i control_limit = _mm512_set1_epi8(static_cast<char>(-128 + 5));
+    const __m512i space_character = _mm512_set1_epi8(' ');
+
+    __m512i raw_bytes = _mm512_loadu_si512(block_bytes);
+    __m512i lowered_bytes = _mm512_or_si512(raw_bytes, case_bit);
+    _mm512_store_si512(classified_block.lowercase_bytes, lowered_bytes);
+    classified_block.alphabetic_mask = _mm512_cmplt_epi8_mask(_mm512_add_epi8(lowered_bytes, letter_bias), letter_limit);
+    classified_block.whitespace_mask = _mm512_cmpeq_epi8_mask(raw_bytes, space_character) |
+                                       _mm512_cmplt_epi8_mask(_mm512_add_epi8(raw_bytes, control_bias), control_limit);
+    classified_block.sentence_terminal_mask = _mm512_cmpeq_epi8_mask(raw_bytes, _mm512_set1_epi8('.')) |
+                                              _mm512_cmpeq_epi8_mask(raw_bytes, _mm512_set1_epi8('!')) |
+                                              _mm512_cmpeq_epi8_mask(raw_bytes, _mm512_set1_epi8('?'));
+    classified_block.comma_mask = _mm512_cmpeq_epi8_mask(raw_bytes, _mm512_set1_epi8(','));
+    classified_block.semicolon_mask = _mm512_cmpeq_epi8_mask(raw_bytes, _mm512_set1_epi8(';'));
+    classified_block.non_ascii_mask = _mm512_movepi8_mask(raw_bytes);
+}
+
+/*
+ * Feed every run of consecutive letters in a mask to the token sink
+ * The lowest run is cleared with x & (x + lowest_bit) on each iteration
+ */
+template <typename TokenSink>
+static inline void emit_letter_runs(uint64_t letter_mask, const unsigned char* lowercase_bytes, TokenSink& token_sink) {
+    while (letter_mask != 0) {
+        unsigned run_start = static_cast<unsigned>(__builtin_ctzll(letter_mask));
+        uint64_t remaining_after_run = ~(letter_mask >> run_start);
+        unsigned run_length = remaining_after_run != 0 ? static_cast<unsigned>(__builtin_ctzll(remaining_after_run)) : 64 - run_start;
+        token_sink.append_letters(lowercase_bytes + run_start, run_length);
+        letter_mask &= letter_mask + (letter_mask & (~letter_mask + 1));
+    }
+}
+
+/*
+ * Turn the selected bytes of a classified block into letter runs and word
+ * boundaries. Bytes that are neither letters nor whitespace are skipped
+ * without closing the word, exactly like the scalar loop; whitespace
+ * bytes flagged in sentence_boundary_mask also close the sentence
+ */
+template <typename TokenSink>
+static inline void emit_classified_block(const ClassifiedTextBlock& classified_block, uint64_t selected_bytes,
+                                         uint64_t sentence_boundary_mask, TokenSink& token_sink) {
+    uint64_t letter_mask = classified_block.alphabetic_mask & selected_bytes;
+    uint64_t boundary_mask = classified_block.whitespace_mask & selected_bytes;
+
+    if constexpr (TokenSink::tracks_punctuation) {
+        token_sink.record_punctuation_counts(
+            static_cast<unsigned>(__builtin_popcountll(classified_block.comma_mask & selected_bytes)),
+            static_cast<unsigned>(__builtin_popcountll(classified_block.semicolon_mask & selected_bytes)));
+    }
+
+    // Fast path for a block made entirely of letters
+    if (boundary_mask == 0 && letter_mask == ~0ULL) {
+        token_sink.append_letters(classified_block.lowercase_bytes, 64);
+        return;
+    }
+
+    while (boundary_mask != 0) {
+        unsigned boundary_position = static_cast<unsigned>(__builtin_ctzll(boundary_mask));
+        uint64_t bytes_before_boundary = (1ULL << boundary_position) - 1;
+        emit_letter_runs(letter_mask & bytes_before_boundary, classified_block.lowercase_bytes, token_sink);
+        letter_mask &= ~bytes_before_boundary;
+        token_sink.close_word();
+        if constexpr (TokenSink::tracks_sentences) {
+            if ((sentence_boundary_mask >> boundary_position) & 1) {
+                token_sink.close_sentence();
+            }
+        }
+        boundary_mask &= boundary_mask - 1;
+    }
+    emit_letter_runs(letter_mask, classified_block.lowercase_bytes, token_sink);
+}
+
+/*
+ * Block-at-a-time tokenizer driver shared by the vector kernels
+ * Pure-ASCII blocks go straight through the masks. In a block holding
+ * UTF-8 sequences the ASCII bytes before the first sequence use the
+ * masks, the run of sequences goes through the scalar decoder, and the
+ * next block starts right after it, so sequences never straddle blocks.
+ * The final partial block is zero-padded; zero bytes are neither letters
+ * nor whitespace, so padding never changes token boundaries. Sinks that
+ * track sentences see every byte through the sentence scanner first,
+ * with the terminal mask as its candidates and every byte of a UTF-8 run
+ */
+template <typename TokenSink>
+static void scan_passage_blocks(string_view text_passage, TokenSink& token_sink,
+                                void (*classify_text_block)(const unsigned char*, ClassifiedTextBlock&)) {
+    const unsigned char* passage_bytes = reinterpret_cast<const unsigned char*>(text_passage.data());
+    size_t passage_length = text_passage.size();
+    ClassifiedTextBlock classified_block;
+    alignas(64) unsigned char padded_tail[64] = {};
+
+    size_t block_offset = 0;
+    while (block_offset < passage_length) {
+        size_t block_length = min<size_t>(64, passage_length - block_offset);
+        const unsigned char* block_bytes = passage_bytes + block_offset;
+        if (block_length < 64) {
+            memset(padded_tail, 0, sizeof(padded_tail));
+            memcpy(padded_tail, block_bytes, block_length);
+            block_bytes = padded_tail;
+        }
+        classify_text_block(block_bytes, classified_block);
+
+        uint64_t sentence_boundary_mask = 0;
+        if (classified_block.non_ascii_mask == 0) {
+            if constexpr (TokenSink::tracks_sentences) {
+                sentence_boundary_mask =
+                    token_sink.scan_sentence_boundaries(block_bytes, block_length, classified_block.sentence_terminal_mask);
+            }
+            emit_classified_block(classified_block, ~0ULL, sentence_boundary_mask, token_sink);
+            block_offset += block_length;
+            continue;
+        }
+
+        unsigned ascii_prefix_length = static_cast<unsigned>(__builtin_ctzll(classified_block.non_ascii_mask));
+        uint64_t ascii_prefix_bytes = (1ULL << ascii_prefix_length) - 1;
+        if constexpr (TokenSink::tracks_sentences) {
+            sentence_boundary_mask = token_sink.scan_sentence_boundaries(
+                block_bytes, ascii_prefix_length, classified_block.sentence_terminal_mask & ascii_prefix_bytes);
+        }
+        emit_classified_block(classified_block, ascii_prefix_bytes, sentence_boundary_mask, token_sink);
+        block_offset += ascii_prefix_length;
+        size_t utf8_run_start = block_offset;
+        while (block_offset < passage_length && passage_bytes[block_offset] >= 0x80) {
+            block_offset += scan_utf8_sequence(passage_bytes + block_offset, passage_length - block_offset, token_sink);
+        }
+        // A run without ASCII bytes holds no whitespace, so it ends no sentence
+        if constexpr (TokenSink::tracks_sentences) {
+            for (size_t window_start = utf8_run_start; window_start < block_offset; window_start += 64) {
+                token_sink.scan_sentence_boundaries(passage_bytes + window_start, min<size_t>(64, block_offset - window_start), ~0ULL);
+            }
+        }
+    }
+}
+
+#endif  // TEXT_ANALYSER_X86_SIMD
+
+/*
+ * Report whether the running CPU can execute a tokenizer kernel
+ */
+bool tokenizer_kernel_supported(TokenizerKernel tokenizer_kernel) {
+    switch (tokenizer_kernel) {
+        case TokenizerKernel::Scalar:
+            return true;
+#if TEXT_ANALYSER_X86_SIMD
+        case TokenizerKernel::SSE2:
+            return __builtin_cpu_supports("sse2");
+        case TokenizerKernel::AVX2:
+            return __builtin_cpu_supports("avx2");
+        case TokenizerKernel::AVX512:
+            return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+#endif
+        default:
+            return false;
+    }
+}
+
+/*
+ * Select the widest tokenizer kernel the CPU supports, once per process
+ */
+TokenizerKernel active_tokenizer_kernel() {
+    static const TokenizerKernel selected_kernel = [] {
+        for (TokenizerKernel candidate_kernel : {TokenizerKernel::AVX512, TokenizerKernel::AVX2, TokenizerKernel::SSE2}) {
+            if (tokenizer_kernel_supported(candidate_kernel)) {
+                return candidate_kernel;
+            }
+        }
+        return TokenizerKernel::Scalar;
+    }();
+    return selected_kernel;
+}
+
+const char* tokenizer_kernel_name(TokenizerKernel tokenizer_kernel) {
+    switch (tokenizer_kernel) {
+        case TokenizerKernel::SSE2:
+            return "SSE2";
+        case TokenizerKernel::AVX2:
+            return "AVX2";
+        case TokenizerKernel::AVX512:
+            return "AVX-512";
+        default:
+            return "Scalar";
+    }
+}
+
+/*
+ * Run a token sink over one slice of a passage without closing its last word
+ */
+template <typename TokenSink>
+static void scan_passage_slice(string_view passage_slice, TokenizerKernel tokenizer_kernel, TokenSink& token_sink) {
+#if TEXT_ANALYSER_X86_SIMD
+    if (tokenizer_kernel_supported(tokenizer_kernel)) {
+        switch (tokenizer_kernel) {
+            case TokenizerKernel::SSE2:
+                scan_passage_blocks(passage_slice, token_sink, classify_text_block_sse2);
+                return;
+            case TokenizerKernel::AVX2:
+                scan_passage_blocks(passage_slice, token_sink, classify_text_block_avx2);
+                return;
+            case TokenizerKernel::AVX512:
+                scan_passage_blocks(passage_slice, token_sink, classify_text_block_avx512);
+                return;
+            default:
+                break;
+        }
+    }
+#endif
+    scan_passage_bytes_scalar(passage_slice, token_sink);
+}
+
+/*
+ * Run a token sink over a passage with the requested kernel
+ * Unsupported kernels fall back to the scalar loop; when a progress
+ * reporter is given the passage is scanned in slices so progress can be
+ * reported; slices end on UTF-8 sequence boundaries and the sink state
+ * simply carries over between slices
+ */
+template <typename TokenSink>
+static void scan_passage_with_kernel(string_view text_passage, TokenizerKernel tokenizer_kernel, TokenSink& token_sink,
+                                     ProgressReporter* progress_reporter = nullptr) {
+    if (progress_reporter == nullptr) {
+        scan_passage_slice(text_passage, tokenizer_kernel, token_sink);
+    } else {
+        size_t slice_start = 0;
+        while (slice_start < text_passage.size()) {
+            size_t slice_end = align_to_utf8_sequence_start(text_passage, slice_start + PROGRESS_SLICE_BYTES);
+            string_view passage_slice = text_passage.substr(slice_start, slice_end - slice_start);
+            scan_passage_slice(passage_slice, tokenizer_kernel, token_sink);
+            progress_reporter->add_processed_bytes(passage_slice.size());
+            slice_start += passage_slice.size();
+        }
+    }
+    token_sink.close_word();
+}
+
+/*
+ * This function extracts individual words from text passages for analysis
+ * Words are whitespace-delimited chunks reduced to their lowercase letters,
+ * which include every Unicode letter and combining mark in UTF-8 text;
+ * chunks shorter than two letters are discarded
+ * Normalized characters are written into one preallocated buffer so the
+ * returned view costs no allocation per word
+ */
+TokenizedPassage extract_words_from_passage(string_view text_passage) {
+    return extract_words_with_kernel(text_passage, active_tokenizer_kernel());
+}
+
+/*
+ * Tokenize with an explicit kernel; used directly by the benchmark
+ */
+TokenizedPassage extract_words_with_kernel(string_view text_passage, TokenizerKernel tokenizer_kernel) {
+    if (text_passage.size() > UINT32_MAX) {
+        throw length_error("extract_words_from_passage: passage exceeds 4 GiB span limit");
+    }
+
+    TokenizedPassage word_collection;
+    // Size both buffers for the worst case up front; the character buffer is
+    // left uninitialized and untouched capacity is never faulted in
+    word_collection.normalized_character_capacity = text_passage.size() + TOKEN_COPY_SLACK_BYTES;
+    word_collection.normalized_word_characters.reset(new char[word_collection.normalized_character_capacity]);
+    word_collection.word_spans.reserve(text_passage.size() / 3 + 1);
+    TokenBufferSink token_sink(word_collection.normalized_word_characters.get(), word_collection.word_spans);
+
+    scan_passage_with_kernel(text_passage, tokenizer_kernel, token_sink);
+    return word_collection;
+}
+
+/*
+ * Fast 64-bit hash of a word's bytes
+ * Eight bytes are mixed per multiply, which keeps hashing cheap for the
+ * short words that dominate natural text. The final partial chunk is read
+ * with fixed-size loads that may overlap, so no byte-by-byte copy is needed
+ */
+static inline uint64_t hash_word_bytes(string_view word_characters) {
+    const uint64_t multiplier = 0x9E3779B97F4A7C15ULL;
+    uint64_t hash_state = word_characters.size() * multiplier;
+    size_t byte_offset = 0;
+    for (; byte_offset + 8 <= word_characters.size(); byte_offset += 8) {
+        uint64_t word_chunk;
+        memcpy(&word_chunk, word_characters.data() + byte_offset, 8);
+        hash_state = (hash_state ^ word_chunk) * multiplier;
+        hash_state ^= hash_state >> 29;
+    }
+    size_t remaining_bytes = word_characters.size() - byte_offset;
+    if (remaining_bytes > 0) {
+        const unsigned char* word_bytes = reinterpret_cast<const unsigned char*>(word_characters.data());
+        uint64_t word_chunk;
+        if (word_characters.size() >= 8) {
+            memcpy(&word_chunk, word_bytes + word_characters.size() - 8, 8);
+        } else if (remaining_bytes >= 4) {
+            uint32_t leading_bytes = 0;
+            uint32_t trailing_bytes = 0;
+            memcpy(&leading_bytes, word_bytes, 4);
+            memcpy(&trailing_bytes, word_bytes + remaining_bytes - 4, 4);
+            word_chunk = (static_cast<uint64_t>(trailing_bytes) << 32) | leading_bytes;
+        } else {
+            word_chunk = word_bytes[0] | (static_cast<uint64_t>(word_bytes[remaining_bytes / 2]) << 8) |
+                         (static_cast<uint64_t>(word_bytes[remaining_bytes - 1]) << 16);
+        }
+        hash_state = (hash_state ^ word_chunk) * multiplier;
+        hash_state ^= hash_state >> 29;
+    }
+    return hash_state * multiplier;
+}
+
+const char* VocabularyArena::store_characters(string_view word_characters) {
+    // Unusually long words get a block of their own
+    if (word_characters.size() > ARENA_BLOCK_BYTES / 4) {
+        oversized_words.emplace_back(new char[word_characters.size()]);
+        oversized_word_bytes += word_characters.size();
+        memcpy(oversized_words.back().get(), word_characters.data(), word_characters.size());
+        return oversized_words.back().get();
+    }
+
+    if (block_used_bytes + word_characters.size() > ARENA_BLOCK_BYTES) {
+        arena_blocks.emplace_back(new char[ARENA_BLOCK_BYTES]);
+        current_block = arena_blocks.back().get();
+        block_used_bytes = 0;
+    }
+    char* stored_characters = current_block + block_used_bytes;
+    memcpy(stored_characters, word_characters.data(), word_characters.size());
+    block_used_bytes += word_characters.size();
+    return stored_characters;
+}
+
+uint32_t InternedVocabulary::intern(string_view normalized_word) {
+    if ((words_by_id.size() + 1) * 2 > slot_ids.size()) {
+        grow_slot_table();
+    }
+
+    uint64_t word_hash = hash_word_bytes(normalized_word);
+    size_t slot_mask = slot_ids.size() - 1;
+    for (size_t slot_index = word_hash & slot_mask;; slot_index = (slot_index + 1) & slot_mask) {
+        uint32_t slot_id = slot_ids[slot_index];
+        if (slot_id == EMPTY_SLOT) {
+            uint32_t new_word_id = static_cast<uint32_t>(words_by_id.size());
+            words_by_id.emplace_back(character_arena.store_characters(normalized_word), normalized_word.size());
+            character_counts_by_id.push_back(static_cast<uint32_t>(count_utf8_characters(normalized_word)));
+            hashes_by_id.push_back(word_hash);
+            slot_ids[slot_index] = new_word_id;
+            return new_word_id;
+        }
+        if (hashes_by_id[slot_id] == word_hash && words_by_id[slot_id] == normalized_word) {
+            return slot_id;
+        }
+    }
+}
+
+void InternedVocabulary::grow_slot_table() {
+    // Keep the table at most half full; stored hashes make rehashing cheap
+    vector<uint32_t> grown_slots(max<size_t>(64, slot_ids.size() * 2), EMPTY_SLOT);
+    size_t slot_mask = grown_slots.size() - 1;
+    for (uint32_t word_id = 0; word_id < words_by_id.size(); word_id++) {
+        size_t slot_index = hashes_by_id[word_id] & slot_mask;
+        while (grown_slots[slot_index] != EMPTY_SLOT) {
+            slot_index = (slot_index + 1) & slot_mask;
+        }
+        grown_slots[slot_index] = word_id;
+    }
+    slot_ids.swap(grown_slots);
+}
+
+size_t InternedVocabulary::memory_footprint_bytes() const {
+    return character_arena.reserved_bytes() + words_by_id.capacity() * sizeof(string_view) +
+           character_counts_by_id.capacity() * sizeof(uint32_t) + hashes_by_id.capacity() * sizeof(uint64_t) +
+           slot_ids.capacity() * sizeof(uint32_t);
+}
+
+vector<uint64_t> InternedTokenStream::word_frequencies() const {
+    vector<uint64_t> frequency_by_id(vocabulary.size(), 0);
+    for (uint32_t word_id : word_ids) {
+        frequency_by_id[word_id]++;
+    }
+    return frequency_by_id;
+}
+
+/*
+ * Bit mask of the slots in a probe group whose control byte matches
+ * SSE2 compares all sixteen control bytes in one instruction
+ */
+static inline uint32_t match_probe_group(const uint8_t* group_control_bytes, uint8_t control_byte) {
+#if TEXT_ANALYSER_X86_SIMD && defined(__SSE2__)
+    __m128i group_bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group_control_bytes));
+    __m128i matching_bytes = _mm_cmpeq_epi8(group_bytes, _mm_set1_epi8(static_cast<char>(control_byte)));
+    return static_cast<uint32_t>(_mm_movemask_epi8(matching_bytes));
+#else
+    uint32_t match_mask = 0;
+    for (size_t slot_offset = 0; slot_offset < WordFrequencyTable::PROBE_GROUP_SLOTS; slot_offset++) {
+        if (group_control_bytes[slot_offset] == control_byte) {
+            match_mask |= 1u << slot_offset;
+        }
+    }
+    return match_mask;
+#endif
+}
+
+// Seven hash bits not used to choose the probe group; the top bit stays clear
+static inline uint8_t word_hash_control_byte(uint64_t word_hash) {
+    return static_cast<uint8_t>(word_hash >> 57);
+}
+
+const WordFrequencyTable::WordEntry& WordFrequencyTable::record_word(string_view normalized_word, size_t character_count,
+                                                                     uint64_t occurrence_count) {
+    WordEntry& word_entry = find_or_insert_entry(normalized_word, hash_word_bytes(normalized_word), character_count);
+    if (word_entry.occurrence_count == 0) {
+        present_word_count++;
+    }
+    word_entry.occurrence_count += occurrence_count;
+    return word_entry;
+}
+
+void WordFrequencyTable::remove_word(string_view normalized_word, size_t character_count) {
+    WordEntry& word_entry = find_or_insert_entry(normalized_word, hash_word_bytes(normalized_word), character_count);
+    if (word_entry.occurrence_count > 0 && --word_entry.occurrence_count == 0) {
+        present_word_count--;
+    }
+}
+
+/*
+ * Add the counts of the table built for the chunk that follows this one
+ * Stored hashes are reused, so no word is hashed twice
+ */
+void WordFrequencyTable::merge_following_table(const WordFrequencyTable& following_table) {
+    for (const WordEntry& following_entry : following_table.slot_entries) {
+        if (following_entry.occurrence_count == 0) {
+            continue;
+        }
+        WordEntry& word_entry = find_or_insert_entry(following_entry.word, following_entry.word_hash,
+                                                     following_entry.character_count);
+        if (word_entry.occurrence_count == 0) {
+            present_word_count++;
+        }
+        word_entry.occurrence_count += following_entry.occurrence_count;
+    }
+}
+
+/*
+ * Probe groups in turn from the one chosen by the low hash bits
+ * Entries are never deleted, so the first group with an empty slot ends
+ * the search and a missing word is inserted there
+ */
+WordFrequencyTable::WordEntry& WordFrequencyTable::find_or_insert_entry(string_view normalized_word, uint64_t word_hash,
+                                                                        size_t character_count) {
+    // Keep the table at most seven-eighths full
+    if ((occupied_slot_count + 1) * 8 > slot_entries.size() * 7) {
+        grow_slot_table();
+    }
+
+    uint8_t control_byte = word_hash_control_byte(word_hash);
+    size_t group_mask = slot_entries.size() / PROBE_GROUP_SLOTS - 1;
+    for (size_t group_index = word_hash & group_mask;; group_index = (group_index + 1) & group_mask) {
+        size_t group_start = group_index * PROBE_GROUP_SLOTS;
+        const uint8_t* group_control_bytes = control_bytes.data() + group_start;
+        for (uint32_t match_mask = match_probe_group(group_control_bytes, control_byte); match_mask != 0;
+             match_mask &= match_mask - 1) {
+            WordEntry& candidate_entry = slot_entries[group_start + lowest_set_bit_index(match_mask)];
+            if (candidate_entry.word_hash == word_hash && candidate_entry.word == normalized_word) {
+                return candidate_entry;
+            }
+        }
+
+        if (match_probe_group(group_control_bytes, EMPTY_CONTROL_BYTE) != 0) {
+            WordEntry& inserted_entry = slot_entries[claim_empty_slot(word_hash)];
+            const char* stored_characters = character_arena.store_characters(normalized_word);
+            inserted_entry = {string_view(stored_characters, normalized_word.size()), word_hash, 0, character_count,
+                              static_cast<uint32_t>(estimate_syllable_count(normalized_word)),
+                              classify_vocabulary_word(normalized_word, character_count)};
+            occupied_slot_count++;
+            return inserted_entry;
+        }
+    }
+}
+
+/*
+ * Mark the first empty slot on a hash's probe sequence as taken
+ */
+size_t WordFrequencyTable::claim_empty_slot(uint64_t word_hash) {
+    size_t group_mask = slot_entries.size() / PROBE_GROUP_SLOTS - 1;
+    for (size_t group_index = word_hash & group_mask;; group_index = (group_index + 1) & group_mask) {
+        size_t group_start = group_index * PROBE_GROUP_SLOTS;
+        uint32_t empty_mask = match_probe_group(control_bytes.data() + group_start, EMPTY_CONTROL_BYTE);
+        if (empty_mask != 0) {
+            size_t slot_index = group_start + lowest_set_bit_index(empty_mask);
+            control_bytes[slot_index] = word_hash_control_byte(word_hash);
+            return slot_index;
+        }
+    }
+}
+
+void WordFrequencyTable::grow_slot_table() {
+    size_t grown_slot_count = max<size_t>(4 * PROBE_GROUP_SLOTS, slot_entries.size() * 2);
+    vector<WordEntry> previous_entries(grown_slot_count);
+    vector<uint8_t> previous_control_bytes(grown_slot_count, EMPTY_CONTROL_BYTE);
+    previous_entries.swap(slot_entries);
+    previous_control_bytes.swap(control_bytes);
+    for (size_t slot_index = 0; slot_index < previous_entries.size(); slot_index++) {
+        if (previous_control_bytes[slot_index] != EMPTY_CONTROL_BYTE) {
+            slot_entries[claim_empty_slot(previous_entries[slot_index].word_hash)] = previous_entries[slot_index];
+        }
+    }
+}
+
+HeavyHitterSketch::HeavyHitterSketch() : index_slots(INDEX_SLOTS, EMPTY_INDEX_SLOT) {
+    word_counters.reserve(COUNTER_CAPACITY);
+    ranked_counts.reserve(COUNTER_CAPACITY);
+    ranked_counters.reserve(COUNTER_CAPACITY);
+    counter_ranks.reserve(COUNTER_CAPACITY);
+}
+
+/*
+ * Count one occurrence of a word
+ * A tracked word is incremented in place; otherwise the word takes a free
+ * counter or replaces the word with the smallest count, inheriting that
+ * count as its possible overestimate
+ */
+void HeavyHitterSketch::record_word(string_view normalized_word, uint64_t word_hash, size_t character_count) {
+    total_recorded_words++;
+    size_t slot_index = find_index_slot(normalized_word, word_hash);
+    uint32_t counter_index = index_slots[slot_index];
+    if (counter_index != EMPTY_INDEX_SLOT) {
+        increment_counter(counter_index);
+        return;
+    }
+
+    if (word_counters.size() < COUNTER_CAPACITY) {
+        // Every tracked count is at least one, so a new counter ranks last
+        counter_index = static_cast<uint32_t>(word_counters.size());
+        word_counters.push_back({string(normalized_word), word_hash, character_count, 1, 0});
+        counter_ranks.push_back(static_cast<uint32_t>(ranked_counts.size()));
+        ranked_counts.push_back(1);
+        ranked_counters.push_back(counter_index);
+        index_slots[slot_index] = counter_index;
+        return;
+    }
+
+    counter_index = ranked_counters.back();
+    WordCounter& replaced_counter = word_counters[counter_index];
+    remove_index_slot(find_index_slot(replaced_counter.word, replaced_counter.word_hash));
+    replaced_counter.word.assign(normalized_word.data(), normalized_word.size());
+    replaced_counter.word_hash = word_hash;
+    replaced_counter.character_count = character_count;
+    replaced_counter.overestimate = replaced_counter.estimated_count;
+    // The removal may have shifted entries, so the free slot is looked up again
+    index_slots[find_index_slot(normalized_word, word_hash)] = counter_index;
+    increment_counter(counter_index);
+}
+
+/*
+ * Add one to a counter while keeping the ranking sorted
+ * The counter trades places with the first counter of equal count, found
+ * by binary search over the contiguous counts, and then moves ahead of it
+ */
+void HeavyHitterSketch::increment_counter(uint32_t counter_index) {
+    size_t counter_rank = counter_ranks[counter_index];
+    uint64_t current_count = ranked_counts[counter_rank];
+    size_t run_start = counter_rank;
+    // Frequent words usually lead their run already and skip the search
+    if (counter_rank > 0 && ranked_counts[counter_rank - 1] == current_count) {
+        // Branch-free binary search; runs of equal low counts make branches unpredictable
+        const uint64_t* search_base = ranked_counts.data();
+        size_t search_length = counter_rank;
+        while (search_length > 1) {
+            size_t half_length = search_length / 2;
+            search_base = search_base[half_length] > current_count ? search_base + half_length : search_base;
+            search_length -= half_length;
+        }
+        run_start = static_cast<size_t>(search_base - ranked_counts.data()) + (*search_base > current_count);
+    }
+    uint32_t displaced_counter = ranked_counters[run_start];
+    ranked_counters[counter_rank] = displaced_counter;
+    counter_ranks[displaced_counter] = static_cast<uint32_t>(counter_rank);
+    ranked_counters[run_start] = counter_index;
+    counter_ranks[counter_index] = static_cast<uint32_t>(run_start);
+    ranked_counts[run_start] = current_count + 1;
+    word_counters[counter_index].estimated_count = current_count + 1;
+}
+
+/*
+ * Slot holding the word, or the empty slot where it would be inserted
+ */
+size_t HeavyHitterSketch::find_index_slot(string_view normalized_word, uint64_t word_hash) const {
+    size_t slot_mask = INDEX_SLOTS - 1;
+    for (size_t slot_index = word_hash & slot_mask;; slot_index = (slot_index + 1) & slot_mask) {
+        uint32_t counter_index = index_slots[slot_index];
+        if (counter_index == EMPTY_INDEX_SLOT ||
+            (word_counters[counter_index].word_hash == word_hash && word_counters[counter_index].word == normalized_word)) {
+            return slot_index;
+        }
+    }
+}
+
+/*
+ * Empty a slot by shifting later entries of its probe run back into it,
+ * so lookups never need tombstones
+ */
+void HeavyHitterSketch::remove_index_slot(size_t slot_index) {
+    size_t slot_mask = INDEX_SLOTS - 1;
+    size_t following_slot = slot_index;
+    while (true) {
+        following_slot = (following_slot + 1) & slot_mask;
+        uint32_t counter_index = index_slots[following_slot];
+        if (counter_index == EMPTY_INDEX_SLOT) {
+            index_slots[slot_index] = EMPTY_INDEX_SLOT;
+            return;
+        }
+        size_t home_slot = word_counters[counter_index].word_hash & slot_mask;
+        // The entry may move back only if the emptied slot lies on its probe path
+        if (((following_slot - home_slot) & slot_mask) >= ((following_slot - slot_index) & slot_mask)) {
+            index_slots[slot_index] = counter_index;
+            slot_index = following_slot;
+        }
+    }
+}
+
+
+/*
+ * Record one word hash
+ * hash_word_bytes is tuned for table lookups, not for uniform high bits,
+ * so the hash is remixed before its leading bits pick a register and the
+ * rest give the rank
+ */
+void DistinctCountSketch::record_hash(uint64_t word_hash) {
+    word_hash ^= word_hash >> 33;
+    word_hash *= 0xFF51AFD7ED558CCDULL;
+    word_hash ^= word_hash >> 33;
+    word_hash *= 0xC4CEB9FE1A85EC53ULL;
+    word_hash ^= word_hash >> 33;
+
+    size_t register_index = static_cast<size_t>(word_hash >> (64 - PRECISION_BITS));
+    uint64_t rank_bits = word_hash << PRECISION_BITS;
+    uint8_t hash_rank = static_cast<uint8_t>(rank_bits == 0 ? 64 - PRECISION_BITS + 1 : leading_zero_bit_count(rank_bits) + 1);
+    registers[register_index] = max(registers[register_index], hash_rank);
+}
+
+/*
+ * Estimate the number of distinct hashes recorded
+ * Uses Ertl's improved estimator on the register histogram, which stays
+ * unbiased from a handful of words up to billions without the separate
+ * small-range correction of the original HyperLogLog
+ */
+uint64_t DistinctCountSketch::estimate() const {
+    const unsigned maximum_rank = 64 - PRECISION_BITS;
+    const double register_count = static_cast<double>(registers.size());
+    uint64_t rank_histogram[64 - PRECISION_BITS + 2] = {};
+    for (uint8_t register_value : registers) {
+        rank_histogram[register_value]++;
+    }
+
+    auto sigma = [](double empty_fraction) {
+        if (empty_fraction == 1.0) {
+            return numeric_limits<double>::infinity();
+        }
+        double power_of_two = 1.0;
+        double series_sum = empty_fraction;
+        double previous_sum;
+        do {
+            empty_fraction *= empty_fraction;
+            previous_sum = series_sum;
+            series_sum += empty_fraction * power_of_two;
+            power_of_two += power_of_two;
+        } while (series_sum != previous_sum);
+        return series_sum;
+    };
+    auto tau = [](double saturated_fraction) {
+        if (saturated_fraction == 0.0 || saturated_fraction == 1.0) {
+            return 0.0;
+        }
+        double power_of_half = 1.0;
+        double series_sum = 1.0 - saturated_fraction;
+        double previous_sum;
+        do {
+            saturated_fraction = sqrt(saturated_fraction);
+            previous_sum = series_sum;
+            power_of_half *= 0.5;
+            series_sum -= (1.0 - saturated_fraction) * (1.0 - saturated_fraction) * power_of_half;
+        } while (series_sum != previous_sum);
+        return series_sum / 3.0;
+    };
+
+    double harmonic_sum = register_count * tau(1.0 - rank_histogram[maximum_rank + 1] / register_count);
+    for (unsigned hash_rank = maximum_rank; hash_rank >= 1; hash_rank--) {
+        harmonic_sum = 0.5 * (harmonic_sum + rank_histogram[hash_rank]);
+    }
+    harmonic_sum += register_count * sigma(rank_histogram[0] / register_count);
+    return static_cast<uint64_t>(llround(register_count * register_count / (2.0 * log(2.0) * harmonic_sum)));
+}
+
+void StreamingVocabularySketch::record_word(string_view normalized_word, size_t character_count, VocabularyWordClass word_class) {
+    uint64_t word_hash = hash_word_bytes(normalized_word);
+    distinct_words.record_hash(word_hash);
+    if (word_class == VocabularyWordClass::Basic) {
+        basic_word_counters.record_word(normalized_word, word_hash, character_count);
+    } else if (word_class == VocabularyWordClass::Advanced) {
+        advanced_word_counters.record_word(normalized_word, word_hash, character_count);
+    }
+}
+
+namespace {
+
+/*
+ * Token sink that interns every word as soon as it is closed
+ * Letters gather in one reused scratch string, so steady-state
+ * tokenization allocates only when a new distinct word appears
+ */
+class InterningTokenSink {
+public:
+    static constexpr bool tracks_punctuation = false;
+    static constexpr bool tracks_sentences = false;
+
+    explicit InterningTokenSink(InternedTokenStream& token_stream) : token_stream(token_stream) {}
+
+    void append_letter(unsigned char lowercase_letter) {
+        current_word_characters.push_back(static_cast<char>(lowercase_letter));
+        current_word_length++;
+    }
+
+    void append_letters(const unsigned char* lowercase_letters, size_t letter_count) {
+        current_word_characters.append(reinterpret_cast<const char*>(lowercase_letters), letter_count);
+        current_word_length += letter_count;
+    }
+
+    void append_encoded_letter(const unsigned char* encoded_letter, size_t encoded_byte_count) {
+        current_word_characters.append(reinterpret_cast<const char*>(encoded_letter), encoded_byte_count);
+        current_word_length++;
+    }
+
+    void close_word() {
+        if (current_word_length > 1) {
+            token_stream.word_ids.push_back(token_stream.vocabulary.intern(current_word_characters));
+        }
+        current_word_characters.clear();
+        current_word_length = 0;
+    }
+
+private:
+    InternedTokenStream& token_stream;
+    string current_word_characters;
+    size_t current_word_length = 0;
+};
+
+}  // namespace
+
+/*
+ * This function tokenizes a passage straight into interned word IDs
+ * Token boundaries are those of extract_words_from_passage
+ */
+InternedTokenStream intern_words_from_passage(string_view text_passage) {
+    InternedTokenStream token_stream;
+    InterningTokenSink interning_sink(token_stream);
+    scan_passage_with_kernel(text_passage, active_tokenizer_kernel(), interning_sink);
+    return token_stream;
+}
+
+/*
+ * Byte classes for syllable estimation
+ * Bit 0 marks the vowel letters a, e, i, o, u and y; bit 1 marks the
+ * second byte of an accented Latin-1 vowel (lead byte 0xC3, as in é or ü);
+ * bit 2 marks the letters after which "-es" is pronounced ("boxes")
+ */
+constexpr array<uint8_t, 256> SYLLABLE_BYTE_CLASSES = [] {
+    array<uint8_t, 256> byte_classes{};
+    for (unsigned char vowel_letter : {'a', 'e', 'i', 'o', 'u', 'y'}) {
+        byte_classes[vowel_letter] |= 1;
+    }
+    for (unsigned accented_byte = 0xA0; accented_byte <= 0xBF; accented_byte++) {
+        // Skips ç, ñ, the multiplication and division signs and þ
+        bool accented_vowel = accented_byte != 0xA7 && accented_byte != 0xB0 && accented_byte != 0xB1 &&
+                              accented_byte != 0xB7 && accented_byte != 0xBE;
+        byte_classes[accented_byte] |= accented_vowel ? 2 : 0;
+    }
+    for (unsigned char sibilant_letter : {'s', 'x', 'z', 'c', 'g', 'h'}) {
+        byte_classes[sibilant_letter] |= 4;
+    }
+    return byte_classes;
+}();
+
+/*
+ * Estimate the syllables of one normalized word
+ * Counts groups of consecutive vowels with one table lookup per byte and
+ * no data-dependent branches, then drops one for a silent ending: a final
+ * e ("make", but not "table"), or -es / -ed after a consonant that leaves
+ * them unvoiced ("makes", "jumped", but not "boxes" or "wanted").
+ * Every word has at least one syllable. Letters outside English count as
+ * consonants, as the readability formulas are calibrated for English
+ */
+size_t estimate_syllable_count(string_view normalized_word) {
+    const unsigned char* word_bytes = reinterpret_cast<const unsigned char*>(normalized_word.data());
+    size_t word_size = normalized_word.size();
+    unsigned previous_vowel = 0;
+    unsigned follows_latin1_lead = 0;
+    size_t vowel_group_count = 0;
+    for (size_t byte_index = 0; byte_index < word_size; byte_index++) {
+        unsigned byte_class = SYLLABLE_BYTE_CLASSES[word_bytes[byte_index]];
+        unsigned current_vowel = (byte_class & 1) | ((byte_class >> 1) & follows_latin1_lead);
+        vowel_group_count += current_vowel & (previous_vowel ^ 1);
+        previous_vowel = current_vowel;
+        follows_latin1_lead = word_bytes[byte_index] == 0xC3;
+    }
+
+    if (word_size >= 3 && vowel_group_count > 1) {
+        unsigned char final_byte = word_bytes[word_size - 1];
+        unsigned char second_last_byte = word_bytes[word_size - 2];
+        unsigned third_last_class = SYLLABLE_BYTE_CLASSES[word_bytes[word_size - 3]];
+        bool second_last_vowel = (SYLLABLE_BYTE_CLASSES[second_last_byte] & 1) != 0;
+        bool third_last_vowel = (third_last_class & 1) != 0;
+        bool silent_final_e = final_byte == 'e' && !second_last_vowel && !(second_last_byte == 'l' && !third_last_vowel);
+        bool silent_es = final_byte == 's' && second_last_byte == 'e' && !third_last_vowel && (third_last_class & 4) == 0;
+        bool silent_ed = final_byte == 'd' && second_last_byte == 'e' && !third_last_vowel &&
+                         word_bytes[word_size - 3] != 't' && word_bytes[word_size - 3] != 'd';
+        vowel_group_count -= silent_final_e || silent_es || silent_ed;
+    }
+    return max<size_t>(vowel_group_count, 1);
+}
+
+/*
+ * Complexity contribution of one word, as in calculate_readability_complexity_score
+ */
+static inline double word_complexity_factor(size_t word_length) {
+    double complexity_factor = word_length * 1.2;
+    if (word_length > 8) {
+        complexity_factor *= 1.5;  // Advanced vocabulary bonus
+    }
+    if (word_length > 12) {
+        complexity_factor *= 1.3;  // Technical complexity bonus
+    }
+    return complexity_factor;
+}
+
+/*
+ * Fold one normalized word into every word-level metric
+ * The complexity factor is computed exactly as in
+ * calculate_readability_complexity_score and summed in passage order, so
+ * the fused score is bit-identical to the staged one
+ */
+void PassageAnalysisAccumulator::record_word(string_view normalized_word) {
+    size_t word_length = count_utf8_characters(normalized_word);
+    VocabularyWordClass word_class = classify_vocabulary_word(normalized_word, word_length);
+    record_word_length(word_length, word_class);
+    record_word_syllables(estimate_syllable_count(normalized_word));
+    record_vocabulary_example(normalized_word, word_class);
+}
+
+void PassageAnalysisAccumulator::record_word_length(size_t word_length, VocabularyWordClass word_class) {
+    int current_word_length = static_cast<int>(word_length);
+    total_word_count++;
+    total_character_count += word_length;
+    minimum_word_length = min(minimum_word_length, current_word_length);
+    maximum_word_length = max(maximum_word_length, current_word_length);
+
+    if (word_length > 7) {
+        long_word_count++;
+    }
+    complexity_accumulator += word_complexity_factor(word_length);
+
+    advanced_vocabulary_count += word_class == VocabularyWordClass::Advanced;
+    basic_vocabulary_count += word_class == VocabularyWordClass::Basic;
+}
+
+void PassageAnalysisAccumulator::record_vocabulary_example(string_view normalized_word, VocabularyWordClass word_class) {
+    if (word_class == VocabularyWordClass::Basic) {
+        if (basic_vocabulary_examples.size() < VOCABULARY_EXAMPLE_LIMIT) {
+            basic_vocabulary_examples.emplace_back(normalized_word);
+        }
+    } else if (word_class == VocabularyWordClass::Advanced) {
+        if (advanced_vocabulary_examples.size() < VOCABULARY_EXAMPLE_LIMIT) {
+            advanced_vocabulary_examples.emplace_back(normalized_word);
+        }
+    }
+}
+
+/*
+ * Count one finished sentence; a sentence without words is not counted
+ */
+void PassageAnalysisAccumulator::record_sentence(uint64_t sentence_words, uint64_t sentence_characters) {
+    if (sentence_words == 0) {
+        return;
+    }
+    sentence_count++;
+    sentence_word_lengths.record_length(sentence_words);
+    sentence_character_lengths.record_length(sentence_characters);
+}
+
+/*
+ * End the open sentence at the words counted so far
+ * The first sentence of a chunk may have begun in an earlier chunk, so it
+ * is held back as the leading sentence until the chunks are merged
+ */
+void PassageAnalysisAccumulator::close_sentence() {
+    uint64_t sentence_words = total_word_count - sentence_start_word_count;
+    uint64_t sentence_characters = total_character_count - sentence_start_character_count;
+    if (sentence_boundary_seen) {
+        record_sentence(sentence_words, sentence_characters);
+    } else {
+        sentence_boundary_seen = true;
+        leading_sentence_words = sentence_words;
+        leading_sentence_characters = sentence_characters;
+    }
+    sentence_start_word_count = total_word_count;
+    sentence_start_character_count = total_character_count;
+}
+
+/*
+ * Count the sentences still open at either end once the passage is complete
+ * The text after the last boundary is a sentence even without a terminal
+ */
+void PassageAnalysisAccumulator::finish_sentences() {
+    if (sentence_boundary_seen) {
+        record_sentence(leading_sentence_words, leading_sentence_characters);
+    }
+    record_sentence(total_word_count - sentence_start_word_count, total_character_count - sentence_start_character_count);
+    sentence_boundary_seen = false;
+    leading_sentence_words = 0;
+    leading_sentence_characters = 0;
+    sentence_start_word_count = total_word_count;
+    sentence_start_character_count = total_character_count;
+}
+
+/*
+ * Bucket layout of SentenceLengthDistribution
+ * Past the exact range, bucket i of an octave [2^k, 2^(k+1)) starts at
+ * (BUCKETS_PER_OCTAVE + i) << (k - log2(BUCKETS_PER_OCTAVE))
+ */
+constexpr unsigned EXACT_LENGTH_OCTAVE = power_of_two_exponent(SentenceLengthDistribution::EXACT_LENGTH_LIMIT);
+constexpr unsigned BUCKETS_PER_OCTAVE_BITS = power_of_two_exponent(SentenceLengthDistribution::BUCKETS_PER_OCTAVE);
+
+static inline size_t sentence_length_bucket(uint64_t sentence_length) {
+    if (sentence_length < SentenceLengthDistribution::EXACT_LENGTH_LIMIT) {
+        return static_cast<size_t>(sentence_length);
+    }
+    unsigned length_octave = 63 - leading_zero_bit_count(sentence_length);
+    uint64_t octave_bucket =
+        (sentence_length >> (length_octave - BUCKETS_PER_OCTAVE_BITS)) - SentenceLengthDistribution::BUCKETS_PER_OCTAVE;
+    return static_cast<size_t>(SentenceLengthDistribution::EXACT_LENGTH_LIMIT +
+                               (length_octave - EXACT_LENGTH_OCTAVE) * SentenceLengthDistribution::BUCKETS_PER_OCTAVE + octave_bucket);
+}
+
+// Middle of a bucket's length range, which is the length itself in the exact range
+static inline uint64_t sentence_length_bucket_midpoint(size_t bucket_index) {
+    if (bucket_index < SentenceLengthDistribution::EXACT_LENGTH_LIMIT) {
+        return bucket_index;
+    }
+    size_t octave_offset = bucket_index - SentenceLengthDistribution::EXACT_LENGTH_LIMIT;
+    size_t octave_index = octave_offset / SentenceLengthDistribution::BUCKETS_PER_OCTAVE;
+    size_t octave_bucket = octave_offset % SentenceLengthDistribution::BUCKETS_PER_OCTAVE;
+    unsigned bucket_width_bits = static_cast<unsigned>(EXACT_LENGTH_OCTAVE + octave_index - BUCKETS_PER_OCTAVE_BITS);
+    return ((SentenceLengthDistribution::BUCKETS_PER_OCTAVE + octave_bucket) << bucket_width_bits) +
+           ((uint64_t(1) << bucket_width_bits) - 1) / 2;
+}
+
+void SentenceLengthDistribution::record_length(uint64_t sentence_length) {
+    sentence_count++;
+    length_sum += sentence_length;
+    squared_length_sum += sentence_length * sentence_length;
+    longest_length = max(longest_length, sentence_length);
+    size_t bucket_index = sentence_length_bucket(sentence_length);
+    if (bucket_index >= bucket_counts.size()) {
+        bucket_counts.resize(bucket_index + 1);
+    }
+    bucket_counts[bucket_index]++;
+}
+
+void SentenceLengthDistribution::merge(const SentenceLengthDistribution& other_distribution) {
+    sentence_count += other_distribution.sentence_count;
+    length_sum += other_distribution.length_sum;
+    squared_length_sum += other_distribution.squared_length_sum;
+    longest_length = max(longest_length, other_distribution.longest_length);
+    if (other_distribution.bucket_counts.size() > bucket_counts.size()) {
+        bucket_counts.resize(other_distribution.bucket_counts.size());
+    }
+    for (size_t bucket_index = 0; bucket_index < other_distribution.bucket_counts.size(); bucket_index++) {
+        bucket_counts[bucket_index] += other_distribution.bucket_counts[bucket_index];
+    }
+}
+
+// Population standard deviation; NaN without sentences, like mean()
+double SentenceLengthDistribution::standard_deviation() const {
+    double mean_length = mean();
+    double length_variance = static_cast<double>(squared_length_sum) / sentence_count - mean_length * mean_length;
+    return sqrt(max(length_variance, 0.0));
+}
+
+/*
+ * Nearest-rank percentile, percentile_rank in (0, 1]
+ * Exact below EXACT_LENGTH_LIMIT; above it the middle of the bucket
+ * holding the rank, never more than the longest sentence
+ */
+uint64_t SentenceLengthDistribution::percentile(double percentile_rank) const {
+    if (sentence_count == 0) {
+        return 0;
+    }
+    uint64_t target_rank = max<uint64_t>(1, static_cast<uint64_t>(ceil(percentile_rank * static_cast<double>(sentence_count))));
+    uint64_t cumulative_count = 0;
+    for (size_t bucket_index = 0; bucket_index < bucket_counts.size(); bucket_index++) {
+        cumulative_count += bucket_counts[bucket_index];
+        if (cumulative_count >= target_rank) {
+            return min(sentence_length_bucket_midpoint(bucket_index), longest_length);
+        }
+    }
+    return longest_length;
+}
+
+namespace {
+
+/*
+ * Word and count considered for a most-frequent list
+ */
+struct FrequentWordCandidate {
+    string_view word;
+    uint64_t occurrence_count;
+};
+
+}  // namespace
+
+/*
+ * Keep the FREQUENT_WORD_LIMIT most frequent candidates, most frequent first
+ * partial_sort only orders the words that are kept, so the cost grows with
+ * the vocabulary size times the log of the limit. Ties are broken
+ * alphabetically so every engine reports the same list
+ */
+static void select_most_frequent_words(vector<FrequentWordCandidate>& frequent_word_candidates,
+                                       vector<FrequentWord>& frequent_words) {
+    size_t selected_count = min(PassageAnalysisAccumulator::FREQUENT_WORD_LIMIT, frequent_word_candidates.size());
+    partial_sort(frequent_word_candidates.begin(), frequent_word_candidates.begin() + selected_count,
+                 frequent_word_candidates.end(),
+                 [](const FrequentWordCandidate& first, const FrequentWordCandidate& second) {
+                     if (first.occurrence_count != second.occurrence_count) {
+                         return first.occurrence_count > second.occurrence_count;
+                     }
+                     return first.word < second.word;
+                 });
+    frequent_words.clear();
+    for (size_t candidate_index = 0; candidate_index < selected_count; candidate_index++) {
+        frequent_words.push_back({string(frequent_word_candidates[candidate_index].word),
+                                  frequent_word_candidates[candidate_index].occurrence_count});
+    }
+}
+
+/*
+ * Fill the frequency summary from the word counts of the whole passage
+ * Basic and advanced words follow the same classes as the counts
+ */
+void PassageAnalysisAccumulator::summarize_word_frequencies(const WordFrequencyTable& word_frequencies) {
+    vector<FrequentWordCandidate> basic_word_candidates;
+    vector<FrequentWordCandidate> advanced_word_candidates;
+    for (const WordFrequencyTable::WordEntry& word_entry : word_frequencies.entries()) {
+        if (word_entry.occurrence_count == 0) {
+            continue;
+        }
+        if (word_entry.word_class == VocabularyWordClass::Basic) {
+            basic_word_candidates.push_back({word_entry.word, word_entry.occurrence_count});
+        } else if (word_entry.word_class == VocabularyWordClass::Advanced) {
+            advanced_word_candidates.push_back({word_entry.word, word_entry.occurrence_count});
+        }
+    }
+    distinct_word_count = word_frequencies.distinct_word_count();
+    select_most_frequent_words(basic_word_candidates, frequent_basic_words);
+    select_most_frequent_words(advanced_word_candidates, frequent_advanced_words);
+    vocabulary_estimated = false;
+}
+
+/*
+ * Fill the frequency summary from a streaming sketch instead of exact counts
+ * A Space-Saving counter may exceed the true count by its inherited
+ * overestimate, so each word is ranked and reported by its guaranteed count,
+ * the estimate minus that overestimate. Only words counted exactly (never
+ * inherited an overestimate) or guaranteed more often than the sketch error
+ * bound are kept; on a flat distribution the counters keep changing hands
+ * and the lists stay empty rather than ranking noise. The distinct count is
+ * a HyperLogLog estimate, clamped so it never exceeds the number of words seen
+ */
+void PassageAnalysisAccumulator::summarize_vocabulary_sketch(const StreamingVocabularySketch& vocabulary_sketch) {
+    for (auto [word_counters, frequent_words] :
+         {make_pair(&vocabulary_sketch.basic_words(), &frequent_basic_words),
+          make_pair(&vocabulary_sketch.advanced_words(), &frequent_advanced_words)}) {
+        vector<FrequentWordCandidate> word_candidates;
+        word_candidates.reserve(word_counters->counters().size());
+        uint64_t count_error_bound = word_counters->recorded_word_count() / HeavyHitterSketch::COUNTER_CAPACITY;
+        for (const HeavyHitterSketch::WordCounter& word_counter : word_counters->counters()) {
+            uint64_t guaranteed_count = word_counter.estimated_count - word_counter.overestimate;
+            if (word_counter.overestimate == 0 || guaranteed_count > count_error_bound) {
+                word_candidates.push_back({word_counter.word, guaranteed_count});
+            }
+        }
+        select_most_frequent_words(word_candidates, *frequent_words);
+    }
+    distinct_word_count = min(vocabulary_sketch.estimated_distinct_words(), total_word_count);
+    vocabulary_estimated = true;
+}
+
+namespace {
+
+/*
+ * Ordered log of word lengths recorded by one parallel chunk
+ * The complexity score is a sequential floating-point sum, so chunks log
+ * their word lengths (one byte each, longer words escaped to a side list)
+ * and the merge replays them in passage order to stay bit-identical
+ */
+struct WordLengthLog {
+    static constexpr uint8_t LONG_WORD_ESCAPE = 255;
+
+    vector<uint8_t> word_lengths;
+    vector<size_t> long_word_lengths;
+
+    void record(size_t word_length) {
+        if (word_length < LONG_WORD_ESCAPE) {
+            word_lengths.push_back(static_cast<uint8_t>(word_length));
+        } else {
+            word_lengths.push_back(LONG_WORD_ESCAPE);
+            long_word_lengths.push_back(word_length);
+        }
+    }
+};
+
+/*
+ * Growable scratch copy of the word a token sink is currently reading
+ * Letter runs are copied like TokenBufferSink does, as one fixed 16-byte
+ * move when short, so the buffer always keeps TOKEN_COPY_SLACK_BYTES spare
+ */
+class WordScratchBuffer {
+public:
+    void append_letter(unsigned char lowercase_letter) {
+        reserve_for(1);
+        word_characters[word_length++] = static_cast<char>(lowercase_letter);
+    }
+
+    void append_letters(const unsigned char* lowercase_letters, size_t letter_count) {
+        reserve_for(letter_count);
+        if (letter_count <= 16) {
+            memcpy(word_characters.get() + word_length, lowercase_letters, 16);
+        } else {
+            memcpy(word_characters.get() + word_length, lowercase_letters, letter_count);
+        }
+        word_length += letter_count;
+    }
+
+    void append_encoded_letter(const unsigned char* encoded_letter, size_t encoded_byte_count) {
+        reserve_for(encoded_byte_count);
+        for (size_t byte_index = 0; byte_index < encoded_byte_count; byte_index++) {
+            word_characters[word_length++] = static_cast<char>(encoded_letter[byte_index]);
+        }
+    }
+
+    string_view word() const { return string_view(word_characters.get(), word_length); }
+    void clear() { word_length = 0; }
+
+private:
+    void reserve_for(size_t byte_count) {
+        if (word_length + byte_count + TOKEN_COPY_SLACK_BYTES > buffer_capacity) {
+            size_t grown_capacity = max<size_t>(128, 2 * (word_length + byte_count + TOKEN_COPY_SLACK_BYTES));
+            unique_ptr<char[]> grown_characters(new char[grown_capacity]);
+            if (word_length > 0) {
+                memcpy(grown_characters.get(), word_characters.get(), word_length);
+            }
+            word_characters = move(grown_characters);
+            buffer_capacity = grown_capacity;
+        }
+    }
+
+    unique_ptr<char[]> word_characters;
+    size_t word_length = 0;
+    size_t buffer_capacity = 0;
+};
+
+/*
+ * Token sink that folds words straight into a PassageAnalysisAccumulator
+ * Letters gather in the scratch word; when a word closes its syllables are
+ * estimated from it while it is still in cache, and it is counted in the
+ * optional frequency table or vocabulary sketch. Its sentence scanner sees
+ * the bytes ahead of the tokenizer, and a sentence is closed right after
+ * the word closed by the boundary whitespace
+ */
+class PassageMetricsSink {
+public:
+    static constexpr bool tracks_punctuation = true;
+    static constexpr bool tracks_sentences = true;
+
+    explicit PassageMetricsSink(PassageAnalysisAccumulator& passage_metrics, WordLengthLog* word_length_log = nullptr,
+                                WordFrequencyTable* word_frequencies = nullptr,
+                                StreamingVocabularySketch* vocabulary_sketch = nullptr)
+        : passage_metrics(passage_metrics), word_length_log(word_length_log), word_frequencies(word_frequencies),
+          vocabulary_sketch(vocabulary_sketch) {}
+
+    void append_letter(unsigned char lowercase_letter) {
+        current_word_length++;
+        current_word_characters.append_letter(lowercase_letter);
+    }
+
+    void append_letters(const unsigned char* lowercase_letters, size_t letter_count) {
+        current_word_length += letter_count;
+        current_word_characters.append_letters(lowercase_letters, letter_count);
+    }
+
+    void append_encoded_letter(const unsigned char* encoded_letter, size_t encoded_byte_count) {
+        current_word_length++;
+        current_word_characters.append_encoded_letter(encoded_letter, encoded_byte_count);
+    }
+
+    void close_word() {
+        if (current_word_length > 1) {
+            if (word_length_log != nullptr) {
+                word_length_log->record(current_word_length);
+            }
+            // The frequency table estimates syllables and classifies once per distinct word
+            VocabularyWordClass word_class;
+            if (word_frequencies != nullptr) {
+                const WordFrequencyTable::WordEntry& word_entry =
+                    word_frequencies->record_word(current_word_characters.word(), current_word_length);
+                passage_metrics.record_word_syllables(word_entry.syllable_count);
+                word_class = word_entry.word_class;
+            } else {
+                passage_metrics.record_word_syllables(estimate_syllable_count(current_word_characters.word()));
+                word_class = classify_vocabulary_word(current_word_characters.word(), current_word_length);
+            }
+            passage_metrics.record_word_length(current_word_length, word_class);
+            if (vocabulary_sketch != nullptr) {
+                vocabulary_sketch->record_word(current_word_characters.word(), current_word_length, word_class);
+            }
+            if (capturing_examples) {
+                passage_metrics.record_vocabulary_example(current_word_characters.word(), word_class);
+                capturing_examples = passage_metrics.needs_vocabulary_examples();
+            }
+        }
+        current_word_length = 0;
+        current_word_characters.clear();
+    }
+
+    void record_punctuation_byte(unsigned char byte_value) {
+        if (byte_value == ',') {
+            passage_metrics.comma_count++;
+        } else if (byte_value == ';') {
+            passage_metrics.semicolon_count++;
+        }
+    }
+
+    void record_punctuation_counts(unsigned commas, unsigned semicolons) {
+        passage_metrics.comma_count += commas;
+        passage_metrics.semicolon_count += semicolons;
+    }
+
+    uint64_t scan_sentence_boundaries(const unsigned char* block_bytes, size_t block_length, uint64_t candidate_mask) {
+        return sentence_scanner.scan_block(block_bytes, block_length, candidate_mask);
+    }
+
+    void close_sentence() { passage_metrics.close_sentence(); }
+
+    // Called once the last word is closed; the end of the text may end a sentence
+    void finish_sentences() {
+        if (sentence_scanner.finish()) {
+            passage_metrics.close_sentence();
+        }
+    }
+
+private:
+    PassageAnalysisAccumulator& passage_metrics;
+    WordLengthLog* word_length_log;
+    WordFrequencyTable* word_frequencies;
+    StreamingVocabularySketch* vocabulary_sketch;
+    SentenceBoundaryScanner sentence_scanner;
+    size_t current_word_length = 0;
+    WordScratchBuffer current_word_characters;
+    bool capturing_examples = true;
+};
+
+/*
+ * Token sink that takes every word back out of a frequency table
+ * The incremental analyzer runs it over a region before re-analyzing it
+ */
+class WordFrequencyRemovalSink {
+public:
+    static constexpr bool tracks_punctuation = false;
+    static constexpr bool tracks_sentences = false;
+
+    explicit WordFrequencyRemovalSink(WordFrequencyTable& word_frequencies) : word_frequencies(word_frequencies) {}
+
+    void append_letter(unsigned char lowercase_letter) {
+        current_word_characters.push_back(static_cast<char>(lowercase_letter));
+        current_word_length++;
+    }
+
+    void append_letters(const unsigned char* lowercase_letters, size_t letter_count) {
+        current_word_characters.append(reinterpret_cast<const char*>(lowercase_letters), letter_count);
+        current_word_length += letter_count;
+    }
+
+    void append_encoded_letter(const unsigned char* encoded_letter, size_t encoded_byte_count) {
+        current_word_characters.append(reinterpret_cast<const char*>(encoded_letter), encoded_byte_count);
+        current_word_length++;
+    }
+
+    void close_word() {
+        if (current_word_length > 1) {
+            word_frequencies.remove_word(current_word_characters, current_word_length);
+        }
+        current_word_characters.clear();
+        current_word_length = 0;
+    }
+
+private:
+    WordFrequencyTable& word_frequencies;
+    string current_word_characters;
+    size_t current_word_length = 0;
+};
+
+}  // namespace
+
+/*
+ * Analyze one passage, or one chunk of a split passage, into a partial result
+ * Words are counted into the given frequency table; the optional log
+ * receives the word lengths for replay_complexity_accumulator
+ */
+static void analyze_passage_chunk(string_view chunk_text, PassageAnalysisAccumulator& chunk_metrics,
+                                  WordLengthLog* chunk_length_log, WordFrequencyTable& chunk_word_frequencies,
+                                  ProgressReporter* progress_reporter) {
+    TEXT_ANALYSER_STAGE_SCOPE(analysis_stage, PipelineStage::Analysis);
+    if (chunk_length_log != nullptr) {
+        chunk_length_log->word_lengths.reserve(chunk_text.size() / 3 + 1);
+    }
+    PassageMetricsSink metrics_sink(chunk_metrics, chunk_length_log, &chunk_word_frequencies);
+    scan_passage_with_kernel(chunk_text, active_tokenizer_kernel(), metrics_sink, progress_reporter);
+    // Chunks end before whitespace or at the end of the passage
+    metrics_sink.finish_sentences();
+    chunk_metrics.passage_length = chunk_text.size();
+    TEXT_ANALYSER_STAGE_BYTES(analysis_stage, chunk_text.size());
+    TEXT_ANALYSER_STAGE_TOKENS(analysis_stage, chunk_metrics.total_word_count);
+}
+
+/*
+ * This function computes every reported metric in one pass over the bytes
+ * Tokenization, word statistics, complexity scoring, punctuation counts,
+ * vocabulary classification and word frequency counting all share the
+ * vectorized scan, replacing
+ * the five separate passes of the staged functions with identical results
+ */
+PassageAnalysisAccumulator analyze_passage_in_single_pass(string_view text_passage, ProgressReporter* progress_reporter) {
+    PassageAnalysisAccumulator passage_metrics;
+    WordFrequencyTable word_frequencies;
+    analyze_passage_chunk(text_passage, passage_metrics, nullptr, word_frequencies, progress_reporter);
+    passage_metrics.finish_sentences();
+    passage_metrics.summarize_word_frequencies(word_frequencies);
+    return passage_metrics;
+}
+
+/*
+ * Start of an unfinished UTF-8 sequence at the end of a piece, or its size
+ * Only a lead byte followed solely by too few continuation bytes is held
+ * back; anything else scans the same whatever bytes come next
+ */
+static size_t find_unfinished_sequence_start(string_view text_piece) {
+    for (size_t trailing_bytes = 1; trailing_bytes <= min<size_t>(3, text_piece.size()); trailing_bytes++) {
+        unsigned char byte_value = static_cast<unsigned char>(text_piece[text_piece.size() - trailing_bytes]);
+        if ((byte_value & 0xC0) == 0x80) {
+            continue;
+        }
+        size_t sequence_length = byte_value >= 0xF0 ? 4 : byte_value >= 0xE0 ? 3 : 2;
+        if (byte_value >= 0xC0 && sequence_length > trailing_bytes) {
+            return text_piece.size() - trailing_bytes;
+        }
+        break;
+    }
+    return text_piece.size();
+}
+
+struct StreamingPassageAnalyzer::StreamingSinkState {
+    StreamingSinkState(PassageAnalysisAccumulator& passage_metrics, StreamingVocabularySketch& vocabulary_sketch)
+        : metrics_sink(passage_metrics, nullptr, nullptr, &vocabulary_sketch) {}
+
+    PassageMetricsSink metrics_sink;
+};
+
+StreamingPassageAnalyzer::StreamingPassageAnalyzer()
+    : sink_state(make_unique<StreamingSinkState>(passage_metrics, vocabulary_sketch)) {}
+
+StreamingPassageAnalyzer::~StreamingPassageAnalyzer() = default;
+
+void StreamingPassageAnalyzer::scan_text_piece(string_view text_piece) {
+    scan_passage_slice(text_piece, active_tokenizer_kernel(), sink_state->metrics_sink);
+}
+
+/*
+ * Analyze the next piece of the stream
+ * A sequence held back from the previous piece is completed with this
+ * piece's leading continuation bytes (at most three can belong to it) and
+ * scanned on its own, so no piece is ever copied
+ */
+void StreamingPassageAnalyzer::append_text(string_view text_piece) {
+    TEXT_ANALYSER_STAGE_SCOPE(analysis_stage, PipelineStage::Analysis);
+    TEXT_ANALYSER_STAGE_BYTES(analysis_stage, text_piece.size());
+    streamed_byte_count += text_piece.size();
+
+    if (carried_byte_count > 0) {
+        size_t continuation_count = 0;
+        while (continuation_count < 3 && continuation_count < text_piece.size() &&
+               (static_cast<unsigned char>(text_piece[continuation_count]) & 0xC0) == 0x80) {
+            carried_bytes[carried_byte_count++] = static_cast<unsigned char>(text_piece[continuation_count++]);
+        }
+        text_piece.remove_prefix(continuation_count);
+        string_view carried_text(reinterpret_cast<const char*>(carried_bytes), carried_byte_count);
+        // A piece made only of continuation bytes may still leave the sequence unfinished
+        size_t scanned_byte_count = text_piece.empty() ? find_unfinished_sequence_start(carried_text) : carried_byte_count;
+        scan_text_piece(carried_text.substr(0, scanned_byte_count));
+        carried_byte_count -= scanned_byte_count;
+        memmove(carried_bytes, carried_bytes + scanned_byte_count, carried_byte_count);
+        if (text_piece.empty()) {
+            return;
+        }
+    }
+
+    size_t scanned_byte_count = find_unfinished_sequence_start(text_piece);
+    scan_text_piece(text_piece.substr(0, scanned_byte_count));
+    carried_byte_count = text_piece.size() - scanned_byte_count;
+    memcpy(carried_bytes, text_piece.data() + scanned_byte_count, carried_byte_count);
+}
+
+/*
+ * Close the stream and return its metrics
+ */
+PassageAnalysisAccumulator StreamingPassageAnalyzer::finish() {
+    TEXT_ANALYSER_STAGE_SCOPE(analysis_stage, PipelineStage::Analysis);
+    scan_text_piece(string_view(reinterpret_cast<const char*>(carried_bytes), carried_byte_count));
+    carried_byte_count = 0;
+    sink_state->metrics_sink.close_word();
+    sink_state->metrics_sink.finish_sentences();
+    passage_metrics.finish_sentences();
+    passage_metrics.passage_length = streamed_byte_count;
+    passage_metrics.summarize_vocabulary_sketch(vocabulary_sketch);
+    TEXT_ANALYSER_STAGE_TOKENS(analysis_stage, passage_metrics.total_word_count);
+    return passage_metrics;
+}
+
+/*
+ * Merge the counts of the chunk that directly follows this one
+ * Example words keep passage order because chunks are merged in order;
+ * complexity_accumulator is not merged here, see replay_complexity_accumulator,
+ * and the frequency summary is rebuilt from the merged frequency tables
+ */
+void PassageAnalysisAccumulator::merge_following_chunk(const PassageAnalysisAccumulator& following_chunk) {
+    // The sentence open at the end of this chunk runs into the following one
+    if (following_chunk.sentence_boundary_seen) {
+        uint64_t joined_sentence_words = total_word_count - sentence_start_word_count + following_chunk.leading_sentence_words;
+        uint64_t joined_sentence_characters =
+            total_character_count - sentence_start_character_count + following_chunk.leading_sentence_characters;
+        if (sentence_boundary_seen) {
+            record_sentence(joined_sentence_words, joined_sentence_characters);
+        } else {
+            sentence_boundary_seen = true;
+            leading_sentence_words = joined_sentence_words;
+            leading_sentence_characters = joined_sentence_characters;
+        }
+        sentence_start_word_count = total_word_count + following_chunk.sentence_start_word_count;
+        sentence_start_character_count = total_character_count + following_chunk.sentence_start_character_count;
+    }
+    sentence_count += following_chunk.sentence_count;
+    sentence_word_lengths.merge(following_chunk.sentence_word_lengths);
+    sentence_character_lengths.merge(following_chunk.sentence_character_lengths);
+
+    total_word_count += following_chunk.total_word_count;
+    total_character_count += following_chunk.total_character_count;
+    minimum_word_length = min(minimum_word_length, following_chunk.minimum_word_length);
+    maximum_word_length = max(maximum_word_length, following_chunk.maximum_word_length);
+    long_word_count += following_chunk.long_word_count;
+    advanced_vocabulary_count += following_chunk.advanced_vocabulary_count;
+    basic_vocabulary_count += following_chunk.basic_vocabulary_count;
+    syllable_count += following_chunk.syllable_count;
+    polysyllabic_word_count += following_chunk.polysyllabic_word_count;
+
+    passage_length += following_chunk.passage_length;
+    comma_count += following_chunk.comma_count;
+    semicolon_count += following_chunk.semicolon_count;
+
+    for (const string& example_word : following_chunk.basic_vocabulary_examples) {
+        if (basic_vocabulary_examples.size() < VOCABULARY_EXAMPLE_LIMIT) {
+            basic_vocabulary_examples.push_back(example_word);
+        }
+    }
+    for (const string& example_word : following_chunk.advanced_vocabulary_examples) {
+        if (advanced_vocabulary_examples.size() < VOCABULARY_EXAMPLE_LIMIT) {
+            advanced_vocabulary_examples.push_back(example_word);
+        }
+    }
+}
+
+/*
+ * Recompute the sequential complexity sum from the chunk logs in order
+ * Factors for short words come from a table built with the same
+ * expression as word_complexity_factor, so every addition is the same
+ * one the single-threaded engine performs
+ */
+static double replay_complexity_accumulator(const vector<WordLengthLog>& chunk_length_logs) {
+    double factor_by_length[WordLengthLog::LONG_WORD_ESCAPE];
+    for (size_t word_length = 0; word_length < WordLengthLog::LONG_WORD_ESCAPE; word_length++) {
+        factor_by_length[word_length] = word_complexity_factor(word_length);
+    }
+
+    double complexity_accumulator = 0.0;
+    for (const WordLengthLog& length_log : chunk_length_logs) {
+        size_t long_word_index = 0;
+        for (uint8_t logged_length : length_log.word_lengths) {
+            if (logged_length != WordLengthLog::LONG_WORD_ESCAPE) {
+                complexity_accumulator += factor_by_length[logged_length];
+            } else {
+                complexity_accumulator += word_complexity_factor(length_log.long_word_lengths[long_word_index++]);
+            }
+        }
+    }
+    return complexity_accumulator;
+}
+
+/*
+ * Split a passage into roughly equal chunks that never cut a word
+ * Each nominal split point moves forward to the end of a sentence when
+ * one is close, and otherwise to the next whitespace byte; a chunk that
+ * starts with whitespace closes no word, so counts are unaffected
+ */
+static vector<string_view> split_passage_into_chunks(string_view text_passage, size_t chunk_count) {
+    const size_t sentence_search_window = 4096;
+    vector<string_view> passage_chunks;
+    size_t chunk_start = 0;
+
+    for (size_t chunk_index = 1; chunk_index < chunk_count && chunk_start < text_passage.size(); chunk_index++) {
+        size_t nominal_split = max(chunk_start, text_passage.size() / chunk_count * chunk_index);
+        size_t window_end = min(text_passage.size(), nominal_split + sentence_search_window);
+
+        // Prefer a split right after a sentence terminal followed by whitespace
+        size_t split_position = string_view::npos;
+        for (size_t position = nominal_split; position + 1 < window_end; position++) {
+            char character = text_passage[position];
+            if ((character == '.' || character == '!' || character == '?') &&
+                is_ascii_whitespace_byte(static_cast<unsigned char>(text_passage[position + 1]))) {
+                split_position = position + 1;
+                break;
+            }
+        }
+
+        // Otherwise split at the next whitespace byte
+        if (split_position == string_view::npos) {
+            split_position = nominal_split;
+            while (split_position < text_passage.size() &&
+                   !is_ascii_whitespace_byte(static_cast<unsigned char>(text_passage[split_position]))) {
+                split_position++;
+            }
+        }
+
+        passage_chunks.push_back(text_passage.substr(chunk_start, split_position - chunk_start));
+        chunk_start = split_position;
+    }
+
+    passage_chunks.push_back(text_passage.substr(chunk_start));
+    return passage_chunks;
+}
+
+/*
+ * Merge the partial results of consecutive chunks in passage order
+ */
+static PassageAnalysisAccumulator merge_passage_chunks(vector<PassageAnalysisAccumulator>& chunk_metrics,
+                                                       const vector<WordLengthLog>& chunk_length_logs,
+                                                       vector<WordFrequencyTable>& chunk_word_frequencies) {
+    PassageAnalysisAccumulator passage_metrics = move(chunk_metrics[0]);
+    for (size_t chunk_index = 1; chunk_index < chunk_metrics.size(); chunk_index++) {
+        passage_metrics.merge_following_chunk(chunk_metrics[chunk_index]);
+        chunk_word_frequencies[0].merge_following_table(chunk_word_frequencies[chunk_index]);
+    }
+    passage_metrics.complexity_accumulator = replay_complexity_accumulator(chunk_length_logs);
+    passage_metrics.finish_sentences();
+    passage_metrics.summarize_word_frequencies(chunk_word_frequencies[0]);
+    return passage_metrics;
+}
+
+/*
+ * Map a requested thread count to a real one; zero means every hardware thread
+ */
+unsigned resolve_analysis_thread_count(unsigned analysis_thread_count) {
+    return analysis_thread_count != 0 ? analysis_thread_count : max(1u, thread::hardware_concurrency());
+}
+
+/*
+ * Number of chunks worth splitting a passage into for a given thread budget
+ */
+size_t parallel_chunk_count(size_t passage_length, unsigned analysis_thread_count) {
+    return min<size_t>(analysis_thread_count, max<size_t>(1, passage_length / MINIMUM_PARALLEL_CHUNK_BYTES));
+}
+
+/*
+ * This function analyzes one large passage on several threads
+ * The passage is split at word-safe boundaries, every chunk runs the
+ * fused engine into its own accumulator, and the partials are merged in
+ * order; all metrics, including the complexity score, match the
+ * single-threaded engine exactly for any thread count
+ * A thread count of zero uses every hardware thread; the optional progress
+ * reporter counts bytes and one work unit per finished chunk
+ */
+PassageAnalysisAccumulator analyze_passage_in_parallel(string_view text_passage, unsigned analysis_thread_count,
+                                                       ProgressReporter* progress_reporter) {
+    analysis_thread_count = resolve_analysis_thread_count(analysis_thread_count);
+
+    // Small passages are not worth the thread start-up cost
+    size_t chunk_count = parallel_chunk_count(text_passage.size(), analysis_thread_count);
+    if (chunk_count <= 1) {
+        PassageAnalysisAccumulator passage_metrics = analyze_passage_in_single_pass(text_passage, progress_reporter);
+        if (progress_reporter != nullptr) {
+            progress_reporter->complete_work_unit();
+        }
+        return passage_metrics;
+    }
+
+    vector<string_view> passage_chunks = split_passage_into_chunks(text_passage, chunk_count);
+    vector<PassageAnalysisAccumulator> chunk_metrics(passage_chunks.size());
+    vector<WordLengthLog> chunk_length_logs(passage_chunks.size());
+    vector<WordFrequencyTable> chunk_word_frequencies(passage_chunks.size());
+
+    auto analyze_chunk = [&](size_t chunk_index) {
+        analyze_passage_chunk(passage_chunks[chunk_index], chunk_metrics[chunk_index], &chunk_length_logs[chunk_index],
+                              chunk_word_frequencies[chunk_index], progress_reporter);
+        if (progress_reporter != nullptr) {
+            progress_reporter->complete_work_unit();
+        }
+    };
+
+    // Analyze every chunk except the first on its own worker thread
+    vector<thread> chunk_workers;
+    for (size_t chunk_index = 1; chunk_index < passage_chunks.size(); chunk_index++) {
+        chunk_workers.emplace_back(analyze_chunk, chunk_index);
+    }
+    analyze_chunk(0);
+    for (thread& chunk_worker : chunk_workers) {
+        chunk_worker.join();
+    }
+
+    return merge_passage_chunks(chunk_metrics, chunk_length_logs, chunk_word_frequencies);
+}
+
+PieceTableDocument::PieceTableDocument(string original_text)
+    : original_buffer(move(original_text)), document_length(original_buffer.size()) {
+    if (document_length > 0) {
+        document_pieces.push_back({false, 0, document_length});
+    }
+}
+
+/*
+ * Make a piece boundary at document_offset and return the index of the
+ * piece starting there (the piece count when the offset is the end)
+ */
+size_t PieceTableDocument::split_piece_at(size_t document_offset) {
+    size_t piece_start = 0;
+    for (size_t piece_index = 0; piece_index < document_pieces.size(); piece_index++) {
+        DocumentPiece& document_piece = document_pieces[piece_index];
+        if (document_offset == piece_start) {
+            return piece_index;
+        }
+        if (document_offset < piece_start + document_piece.piece_length) {
+            size_t leading_length = document_offset - piece_start;
+            DocumentPiece trailing_piece = {document_piece.from_add_buffer, document_piece.buffer_offset + leading_length,
+                                            document_piece.piece_length - leading_length};
+            document_piece.piece_length = leading_length;
+            document_pieces.insert(document_pieces.begin() + piece_index + 1, trailing_piece);
+            return piece_index + 1;
+        }
+        piece_start += document_piece.piece_length;
+    }
+    return document_pieces.size();
+}
+
+void PieceTableDocument::insert_text(size_t insertion_offset, string_view inserted_text) {
+    if (inserted_text.empty()) {
+        return;
+    }
+    insertion_offset = min(insertion_offset, document_length);
+    size_t piece_index = split_piece_at(insertion_offset);
+
+    // Typing at the end of the previous insertion just extends its piece
+    if (piece_index > 0) {
+        DocumentPiece& previous_piece = document_pieces[piece_index - 1];
+        if (previous_piece.from_add_buffer && previous_piece.buffer_offset + previous_piece.piece_length == add_buffer.size()) {
+            add_buffer.append(inserted_text);
+            previous_piece.piece_length += inserted_text.size();
+            document_length += inserted_text.size();
+            return;
+        }
+    }
+
+    document_pieces.insert(document_pieces.begin() + piece_index, DocumentPiece{true, add_buffer.size(), inserted_text.size()});
+    add_buffer.append(inserted_text);
+    document_length += inserted_text.size();
+}
+
+void PieceTableDocument::erase_text(size_t erase_offset, size_t erase_length) {
+    erase_offset = min(erase_offset, document_length);
+    erase_length = min(erase_length, document_length - erase_offset);
+    if (erase_length == 0) {
+        return;
+    }
+    size_t first_piece = split_piece_at(erase_offset);
+    size_t end_piece = split_piece_at(erase_offset + erase_length);
+    document_pieces.erase(document_pieces.begin() + first_piece, document_pieces.begin() + end_piece);
+    document_length -= erase_length;
+}
+
+string PieceTableDocument::extract_text(size_t range_offset, size_t range_length) const {
+    range_offset = min(range_offset, document_length);
+    range_length = min(range_length, document_length - range_offset);
+
+    string range_text;
+    range_text.reserve(range_length);
+    size_t piece_start = 0;
+    for (const DocumentPiece& document_piece : document_pieces) {
+        if (range_text.size() == range_length) {
+            break;
+        }
+        size_t piece_end = piece_start + document_piece.piece_length;
+        if (piece_end > range_offset) {
+            size_t copy_start = max(range_offset, piece_start) - piece_start;
+            size_t copy_length = min(document_piece.piece_length - copy_start, range_length - range_text.size());
+            range_text.append(piece_characters(document_piece) + copy_start, copy_length);
+        }
+        piece_start = piece_end;
+    }
+    return range_text;
+}
+
+/*
+ * Cut a region into sentence segments for the incremental engine
+ * A segment ends after a whitespace byte that follows '.', '!' or '?',
+ * or after the first whitespace byte once it reaches the size cap. Every
+ * cut follows whitespace, so no word spans two segments and the segment
+ * partials merge exactly like the parallel engine's chunks
+ */
+static vector<string_view> split_region_into_sentence_segments(string_view region_text) {
+    vector<string_view> sentence_segments;
+    size_t segment_start = 0;
+    for (size_t byte_index = 0; byte_index < region_text.size(); byte_index++) {
+        if (!is_ascii_whitespace_byte(static_cast<unsigned char>(region_text[byte_index]))) {
+            continue;
+        }
+        char preceding_character = byte_index > segment_start ? region_text[byte_index - 1] : ' ';
+        bool ends_sentence = preceding_character == '.' || preceding_character == '!' || preceding_character == '?';
+        if (ends_sentence || byte_index + 1 - segment_start >= INCREMENTAL_SEGMENT_MAXIMUM_BYTES) {
+            sentence_segments.push_back(region_text.substr(segment_start, byte_index + 1 - segment_start));
+            segment_start = byte_index + 1;
+        }
+    }
+    if (segment_start < region_text.size()) {
+        sentence_segments.push_back(region_text.substr(segment_start));
+    }
+    return sentence_segments;
+}
+
+/*
+ * One sentence segment and the merged metrics of its treap subtree
+ */
+struct IncrementalPassageAnalyzer::SegmentNode {
+    PassageAnalysisAccumulator segment_metrics;
+    PassageAnalysisAccumulator subtree_metrics;
+    uint64_t segment_bytes = 0;
+    uint64_t subtree_bytes = 0;
+    size_t subtree_segments = 1;
+    uint32_t priority = 0;
+    unique_ptr<SegmentNode> left_child;
+    unique_ptr<SegmentNode> right_child;
+};
+
+/*
+ * Recompute a node's subtree totals from its children, in document order
+ */
+void IncrementalPassageAnalyzer::refresh_segment_node(SegmentNode& segment_node) {
+    const SegmentNode* left_child = segment_node.left_child.get();
+    const SegmentNode* right_child = segment_node.right_child.get();
+
+    segment_node.subtree_bytes = segment_node.segment_bytes;
+    segment_node.subtree_segments = 1;
+    segment_node.subtree_metrics = left_child != nullptr ? left_child->subtree_metrics : PassageAnalysisAccumulator();
+    segment_node.subtree_metrics.merge_following_chunk(segment_node.segment_metrics);
+    segment_node.subtree_metrics.complexity_accumulator += segment_node.segment_metrics.complexity_accumulator;
+    if (left_child != nullptr) {
+        segment_node.subtree_bytes += left_child->subtree_bytes;
+        segment_node.subtree_segments += left_child->subtree_segments;
+    }
+    if (right_child != nullptr) {
+        segment_node.subtree_metrics.merge_following_chunk(right_child->subtree_metrics);
+        segment_node.subtree_metrics.complexity_accumulator += right_child->subtree_metrics.complexity_accumulator;
+        segment_node.subtree_bytes += right_child->subtree_bytes;
+        segment_node.subtree_segments += right_child->subtree_segments;
+    }
+}
+
+/*
+ * Concatenate two segment treaps, every segment of leading_tree first
+ */
+unique_ptr<IncrementalPassageAnalyzer::SegmentNode> IncrementalPassageAnalyzer::merge_segment_trees(
+    unique_ptr<SegmentNode> leading_tree, unique_ptr<SegmentNode> following_tree) {
+    if (leading_tree == nullptr) {
+        return following_tree;
+    }
+    if (following_tree == nullptr) {
+        return leading_tree;
+    }
+    if (leading_tree->priority > following_tree->priority) {
+        leading_tree->right_child = merge_segment_trees(move(leading_tree->right_child), move(following_tree));
+        refresh_segment_node(*leading_tree);
+        return leading_tree;
+    }
+    following_tree->left_child = merge_segment_trees(move(leading_tree), move(following_tree->left_child));
+    refresh_segment_node(*following_tree);
+    return following_tree;
+}
+
+/*
+ * Split a segment treap after its first leading_segment_count segments
+ */
+void IncrementalPassageAnalyzer::split_segment_tree(unique_ptr<SegmentNode> segment_tree, size_t leading_segment_count,
+                                                    unique_ptr<SegmentNode>& leading_tree,
+                                                    unique_ptr<SegmentNode>& following_tree) {
+    if (segment_tree == nullptr) {
+        leading_tree.reset();
+        following_tree.reset();
+        return;
+    }
+    size_t left_segments = segment_tree->left_child != nullptr ? segment_tree->left_child->subtree_segments : 0;
+    if (leading_segment_count <= left_segments) {
+        split_segment_tree(move(segment_tree->left_child), leading_segment_count, leading_tree, segment_tree->left_child);
+        refresh_segment_node(*segment_tree);
+        following_tree = move(segment_tree);
+    } else {
+        split_segment_tree(move(segment_tree->right_child), leading_segment_count - left_segments - 1,
+                           segment_tree->right_child, following_tree);
+        refresh_segment_node(*segment_tree);
+        leading_tree = move(segment_tree);
+    }
+}
+
+IncrementalPassageAnalyzer::IncrementalPassageAnalyzer(string initial_text) : document(move(initial_text)) {
+    string full_text = document.text();
+    segment_tree = build_segment_tree(full_text);
+    last_reanalyzed_byte_count = full_text.size();
+}
+
+// Defined here, where SegmentNode is complete
+IncrementalPassageAnalyzer::~IncrementalPassageAnalyzer() = default;
+
+/*
+ * Analyze each sentence segment of a region and join them into one treap
+ * The region's words are added to the document frequency table
+ */
+unique_ptr<IncrementalPassageAnalyzer::SegmentNode> IncrementalPassageAnalyzer::build_segment_tree(string_view region_text) {
+    unique_ptr<SegmentNode> region_tree;
+    for (string_view sentence_segment : split_region_into_sentence_segments(region_text)) {
+        auto segment_node = make_unique<SegmentNode>();
+        analyze_passage_chunk(sentence_segment, segment_node->segment_metrics, nullptr, document_word_frequencies, nullptr);
+        segment_node->segment_bytes = sentence_segment.size();
+        priority_state ^= priority_state << 13;
+        priority_state ^= priority_state >> 17;
+        priority_state ^= priority_state << 5;
+        segment_node->priority = priority_state;
+        refresh_segment_node(*segment_node);
+        region_tree = merge_segment_trees(move(region_tree), move(segment_node));
+    }
+    return region_tree;
+}
+
+/*
+ * Find the segment containing a byte offset
+ * Returns its index and reports where it starts and how long it is
+ */
+size_t IncrementalPassageAnalyzer::locate_segment(size_t document_offset, size_t& segment_start, size_t& segment_length) const {
+    const SegmentNode* current_node = segment_tree.get();
+    size_t segment_index = 0;
+    segment_start = 0;
+    while (current_node != nullptr) {
+        uint64_t left_bytes = current_node->left_child != nullptr ? current_node->left_child->subtree_bytes : 0;
+        size_t left_segments = current_node->left_child != nullptr ? current_node->left_child->subtree_segments : 0;
+        if (document_offset < segment_start + left_bytes) {
+            current_node = current_node->left_child.get();
+        } else if (document_offset < segment_start + left_bytes + current_node->segment_bytes) {
+            segment_start += left_bytes;
+            segment_length = current_node->segment_bytes;
+            return segment_index + left_segments;
+        } else {
+            segment_start += left_bytes + current_node->segment_bytes;
+            segment_index += left_segments + 1;
+            current_node = current_node->right_child.get();
+        }
+    }
+    segment_length = 0;
+    return segment_index;
+}
+
+/*
+ * This function applies one edit and refreshes the metrics around it
+ * The re-analyzed region runs from the segment holding the byte before the
+ * edit to the segment holding the byte after it. Both ends of that region
+ * follow unchanged whitespace, so the segments outside it stay valid
+ */
+void IncrementalPassageAnalyzer::replace_text(size_t edit_offset, size_t erased_length, string_view inserted_text) {
+    size_t original_size = document.size();
+    edit_offset = min(edit_offset, original_size);
+    erased_length = min(erased_length, original_size - edit_offset);
+    if (erased_length == 0 && inserted_text.empty()) {
+        last_reanalyzed_byte_count = 0;
+        return;
+    }
+
+    size_t first_segment = 0;
+    size_t region_start = 0;
+    size_t segment_length = 0;
+    if (edit_offset > 0) {
+        first_segment = locate_segment(edit_offset - 1, region_start, segment_length);
+    }
+
+    size_t end_segment = segment_count();
+    size_t region_end = original_size;
+    if (edit_offset + erased_length < original_size) {
+        size_t following_segment_start = 0;
+        end_segment = locate_segment(edit_offset + erased_length, following_segment_start, segment_length) + 1;
+        region_end = following_segment_start + segment_length;
+    }
+
+    // Take the words of the region as it was out of the document counts
+    string replaced_region_text = document.extract_text(region_start, region_end - region_start);
+    WordFrequencyRemovalSink removal_sink(document_word_frequencies);
+    scan_passage_with_kernel(replaced_region_text, active_tokenizer_kernel(), removal_sink, nullptr);
+    document_summary_current = false;
+
+    document.erase_text(edit_offset, erased_length);
+    document.insert_text(edit_offset, inserted_text);
+    region_end = region_end - erased_length + inserted_text.size();
+
+    string region_text = document.extract_text(region_start, region_end - region_start);
+    last_reanalyzed_byte_count = region_text.size();
+
+    unique_ptr<SegmentNode> leading_tree;
+    unique_ptr<SegmentNode> remaining_tree;
+    unique_ptr<SegmentNode> replaced_tree;
+    unique_ptr<SegmentNode> following_tree;
+    split_segment_tree(move(segment_tree), first_segment, leading_tree, remaining_tree);
+    split_segment_tree(move(remaining_tree), end_segment - first_segment, replaced_tree, following_tree);
+    segment_tree = merge_segment_trees(merge_segment_trees(move(leading_tree), build_segment_tree(region_text)),
+                                       move(following_tree));
+}
+
+const PassageAnalysisAccumulator& IncrementalPassageAnalyzer::passage_metrics() const {
+    if (!document_summary_current) {
+        summarized_document_metrics = segment_tree != nullptr ? segment_tree->subtree_metrics : PassageAnalysisAccumulator();
+        summarized_document_metrics.finish_sentences();
+        summarized_document_metrics.summarize_word_frequencies(document_word_frequencies);
+        document_summary_current = true;
+    }
+    return summarized_document_metrics;
+}
+
+size_t IncrementalPassageAnalyzer::segment_count() const {
+    return segment_tree != nullptr ? segment_tree->subtree_segments : 0;
+}
+
+/*
+ * Mixing steps of the 128-bit content hash
+ */
+static inline uint64_t rotate_left_64(uint64_t value, int rotation) {
+    return (value << rotation) | (value >> (64 - rotation));
+}
+
+static inline uint64_t finalize_hash_lane(uint64_t lane_value) {
+    lane_value ^= lane_value >> 33;
+    lane_value *= 0xff51afd7ed558ccdULL;
+    lane_value ^= lane_value >> 33;
+    lane_value *= 0xc4ceb9fe1a85ec53ULL;
+    lane_value ^= lane_value >> 33;
+    return lane_value;
+}
+
+/*
+ * 128-bit content hash of a passage (MurmurHash3 x64_128, seed 0)
+ * The raw bytes are hashed because every metric depends on them, including
+ * punctuation and passage length; 16 bytes are mixed per step
+ */
+PassageContentHash hash_passage_content(string_view text_passage) {
+    const uint64_t FIRST_MIX_CONSTANT = 0x87c37b91114253d5ULL;
+    const uint64_t SECOND_MIX_CONSTANT = 0x4cf5ad432745937fULL;
+    const unsigned char* passage_bytes = reinterpret_cast<const unsigned char*>(text_passage.data());
+    size_t passage_length = text_passage.size();
+    size_t block_count = passage_length / 16;
+    uint64_t first_lane = 0;
+    uint64_t second_lane = 0;
+
+    for (size_t block_index = 0; block_index < block_count; block_index++) {
+        uint64_t first_word;
+        uint64_t second_word;
+        memcpy(&first_word, passage_bytes + block_index * 16, sizeof(first_word));
+        memcpy(&second_word, passage_bytes + block_index * 16 + 8, sizeof(second_word));
+
+        first_word *= FIRST_MIX_CONSTANT;
+        first_word = rotate_left_64(first_word, 31);
+        first_word *= SECOND_MIX_CONSTANT;
+        first_lane ^= first_word;
+        first_lane = rotate_left_64(first_lane, 27) + second_lane;
+        first_lane = first_lane * 5 + 0x52dce729;
+
+        second_word *= SECOND_MIX_CONSTANT;
+        second_word = rotate_left_64(second_word, 33);
+        second_word *= FIRST_MIX_CONSTANT;
+        second_lane ^= second_word;
+        second_lane = rotate_left_64(second_lane, 31) + first_lane;
+        second_lane = second_lane * 5 + 0x38495ab5;
+    }
+
+    // Fold the trailing bytes in little-endian order
+    const unsigned char* tail_bytes = passage_bytes + block_count * 16;
+    size_t tail_length = passage_length & 15;
+    uint64_t first_word = 0;
+    uint64_t second_word = 0;
+    for (size_t tail_index = 0; tail_index < tail_length; tail_index++) {
+        if (tail_index < 8) {
+            first_word |= static_cast<uint64_t>(tail_bytes[tail_index]) << (8 * tail_index);
+        } else {
+            second_word |= static_cast<uint64_t>(tail_bytes[tail_index]) << (8 * (tail_index - 8));
+        }
+    }
+    if (tail_length > 8) {
+        second_word *= SECOND_MIX_CONSTANT;
+        second_word = rotate_left_64(second_word, 33);
+        second_word *= FIRST_MIX_CONSTANT;
+        second_lane ^= second_word;
+    }
+    if (tail_length > 0) {
+        first_word *= FIRST_MIX_CONSTANT;
+        first_word = rotate_left_64(first_word, 31);
+        first_word *= SECOND_MIX_CONSTANT;
+        first_lane ^= first_word;
+    }
+
+    first_lane ^= passage_length;
+    second_lane ^= passage_length;
+    first_lane += second_lane;
+    second_lane += first_lane;
+    first_lane = finalize_hash_lane(first_lane);
+    second_lane = finalize_hash_lane(second_lane);
+    first_lane += second_lane;
+    second_lane += first_lane;
+
+    PassageContentHash content_hash;
+    content_hash.low_bits = first_lane;
+    content_hash.high_bits = second_lane;
+    return content_hash;
+}
+
+// Fixed-width little-endian fields of an on-disk cache entry
+static void append_cache_integer(string& entry_bytes, uint64_t field_value) {
+    for (int byte_index = 0; byte_index < 8; byte_index++) {
+        entry_bytes.push_back(static_cast<char>(field_value >> (8 * byte_index)));
+    }
+}
+
+static bool read_cache_integer(string_view& entry_bytes, uint64_t& field_value) {
+    if (entry_bytes.size() < 8) {
+        return false;
+    }
+    field_value = 0;
+    for (int byte_index = 0; byte_index < 8; byte_index++) {
+        field_value |= static_cast<uint64_t>(static_cast<unsigned char>(entry_bytes[byte_index])) << (8 * byte_index);
+    }
+    entry_bytes.remove_prefix(8);
+    return true;
+}
+
+static void append_cache_text(string& entry_bytes, string_view field_text) {
+    append_cache_integer(entry_bytes, field_text.size());
+    entry_bytes.append(field_text);
+}
+
+static bool read_cache_text(string_view& entry_bytes, string& field_text) {
+    uint64_t text_length = 0;
+    if (!read_cache_integer(entry_bytes, text_length) || text_length > entry_bytes.size()) {
+        return false;
+    }
+    field_text.assign(entry_bytes.substr(0, text_length));
+    entry_bytes.remove_prefix(text_length);
+    return true;
+}
+
+/*
+ * Encode a style report, rules included, after the accumulator fields
+ */
+static void append_cached_style_report(string& entry_bytes, const StyleLintReport& style_report) {
+    append_cache_integer(entry_bytes, style_report.checked_rule_count);
+    append_cache_integer(entry_bytes, style_report.rule_set_fingerprint);
+    append_cache_integer(entry_bytes, style_report.total_match_count);
+    for (uint64_t category_match_count : style_report.category_match_counts) {
+        append_cache_integer(entry_bytes, category_match_count);
+    }
+    append_cache_integer(entry_bytes, style_report.findings.size());
+    for (const StyleFinding& style_finding : style_report.findings) {
+        append_cache_integer(entry_bytes, static_cast<uint64_t>(style_finding.style_rule.category));
+        append_cache_text(entry_bytes, style_finding.style_rule.phrase);
+        append_cache_text(entry_bytes, style_finding.style_rule.suggestion);
+        append_cache_integer(entry_bytes, style_finding.match_count);
+    }
+    append_cache_integer(entry_bytes, style_report.matches.size());
+    for (const StyleMatch& style_match : style_report.matches) {
+        append_cache_integer(entry_bytes, style_match.finding_index);
+        append_cache_integer(entry_bytes, style_match.start_offset);
+        append_cache_integer(entry_bytes, style_match.byte_length);
+    }
+}
+
+static bool read_cached_style_report(string_view& entry_bytes, StyleLintReport& style_report) {
+    bool counts_read = read_cache_integer(entry_bytes, style_report.checked_rule_count) &&
+                       read_cache_integer(entry_bytes, style_report.rule_set_fingerprint) &&
+                       read_cache_integer(entry_bytes, style_report.total_match_count);
+    for (uint64_t& category_match_count : style_report.category_match_counts) {
+        counts_read = counts_read && read_cache_integer(entry_bytes, category_match_count);
+    }
+    uint64_t finding_count = 0;
+    if (!counts_read || !read_cache_integer(entry_bytes, finding_count) || finding_count > style_report.checked_rule_count) {
+        return false;
+    }
+    style_report.findings.assign(finding_count, StyleFinding());
+    for (StyleFinding& style_finding : style_report.findings) {
+        uint64_t category_index = 0;
+        if (!read_cache_integer(entry_bytes, category_index) || category_index >= STYLE_ISSUE_CATEGORY_COUNT ||
+            !read_cache_text(entry_bytes, style_finding.style_rule.phrase) ||
+            !read_cache_text(entry_bytes, style_finding.style_rule.suggestion) ||
+            !read_cache_integer(entry_bytes, style_finding.match_count)) {
+            return false;
+        }
+        style_finding.style_rule.category = static_cast<StyleIssueCategory>(category_index);
+    }
+
+    uint64_t match_count = 0;
+    if (!read_cache_integer(entry_bytes, match_count) || match_count > StyleLintReport::MATCH_RECORD_LIMIT) {
+        return false;
+    }
+    style_report.matches.assign(match_count, StyleMatch());
+    for (StyleMatch& style_match : style_report.matches) {
+        uint64_t finding_index = 0;
+        if (!read_cache_integer(entry_bytes, finding_index) || finding_index >= finding_count ||
+            !read_cache_integer(entry_bytes, style_match.start_offset) ||
+            !read_cache_integer(entry_bytes, style_match.byte_length)) {
+            return false;
+        }
+        style_match.finding_index = static_cast<uint32_t>(finding_index);
+    }
+    return true;
+}
+
+/*
+ * Encode an accumulator and its style report for the disk tier
+ * Every field that affects a report is written; DISK_FORMAT_VERSION must be
+ * raised whenever fields are added or their meaning changes
+ */
+static string encode_cached_passage_analysis(const PassageAnalysisAccumulator& passage_metrics,
+                                             const StyleLintReport& style_report) {
+    string entry_bytes = "TXAC";
+    append_cache_integer(entry_bytes, AnalysisResultCache::DISK_FORMAT_VERSION);
+    append_cache_integer(entry_bytes, passage_metrics.total_word_count);
+    append_cache_integer(entry_bytes, passage_metrics.total_character_count);
+    append_cache_integer(entry_bytes, static_cast<uint64_t>(static_cast<int64_t>(passage_metrics.minimum_word_length)));
+    append_cache_integer(entry_bytes, static_cast<uint64_t>(static_cast<int64_t>(passage_metrics.maximum_word_length)));
+    append_cache_integer(entry_bytes, passage_metrics.long_word_count);
+    append_cache_integer(entry_bytes, passage_metrics.advanced_vocabulary_count);
+    append_cache_integer(entry_bytes, passage_metrics.basic_vocabulary_count);
+    uint64_t complexity_bits;
+    memcpy(&complexity_bits, &passage_metrics.complexity_accumulator, sizeof(complexity_bits));
+    append_cache_integer(entry_bytes, complexity_bits);
+    append_cache_integer(entry_bytes, passage_metrics.syllable_count);
+    append_cache_integer(entry_bytes, passage_metrics.polysyllabic_word_count);
+    append_cache_integer(entry_bytes, passage_metrics.passage_length);
+    append_cache_integer(entry_bytes, passage_metrics.sentence_count);
+    append_cache_integer(entry_bytes, passage_metrics.comma_count);
+    append_cache_integer(entry_bytes, passage_metrics.semicolon_count);
+    for (const SentenceLengthDistribution* sentence_lengths :
+         {&passage_metrics.sentence_word_lengths, &passage_metrics.sentence_character_lengths}) {
+        append_cache_integer(entry_bytes, sentence_lengths->sentence_count);
+        append_cache_integer(entry_bytes, sentence_lengths->length_sum);
+        append_cache_integer(entry_bytes, sentence_lengths->squared_length_sum);
+        append_cache_integer(entry_bytes, sentence_lengths->longest_length);
+        append_cache_integer(entry_bytes, sentence_lengths->bucket_counts.size());
+        for (uint64_t bucket_count : sentence_lengths->bucket_counts) {
+            append_cache_integer(entry_bytes, bucket_count);
+        }
+    }
+    for (const vector<string>* vocabulary_examples :
+         {&passage_metrics.basic_vocabulary_examples, &passage_metrics.advanced_vocabulary_examples}) {
+        append_cache_integer(entry_bytes, vocabulary_examples->size());
+        for (const string& vocabulary_example : *vocabulary_examples) {
+            append_cache_integer(entry_bytes, vocabulary_example.size());
+            entry_bytes.append(vocabulary_example);
+        }
+    }
+    append_cache_integer(entry_bytes, passage_metrics.distinct_word_count);
+    append_cache_integer(entry_bytes, passage_metrics.vocabulary_estimated);
+    for (const vector<FrequentWord>* frequent_words :
+         {&passage_metrics.frequent_basic_words, &passage_metrics.frequent_advanced_words}) {
+        append_cache_integer(entry_bytes, frequent_words->size());
+        for (const FrequentWord& frequent_word : *frequent_words) {
+            append_cache_integer(entry_bytes, frequent_word.word.size());
+            entry_bytes.append(frequent_word.word);
+            append_cache_integer(entry_bytes, frequent_word.occurrence_count);
+        }
+    }
+    append_cached_style_report(entry_bytes, style_report);
+    return entry_bytes;
+}
+
+/*
+ * Decode a disk tier entry, rejecting foreign, stale or truncated files
+ */
+static bool decode_cached_passage_analysis(string_view entry_bytes, PassageAnalysisAccumulator& passage_metrics,
+                                           StyleLintReport& style_report) {
+    uint64_t format_version = 0;
+    if (entry_bytes.substr(0, 4) != "TXAC") {
+        return false;
+    }
+    entry_bytes.remove_prefix(4);
+    if (!read_cache_integer(entry_bytes, format_version) || format_version != AnalysisResultCache::DISK_FORMAT_VERSION) {
+        return false;
+    }
+
+    uint64_t minimum_word_length = 0;
+    uint64_t maximum_word_length = 0;
+    uint64_t complexity_bits = 0;
+    bool fields_read = read_cache_integer(entry_bytes, passage_metrics.total_word_count) &&
+                       read_cache_integer(entry_bytes, passage_metrics.total_character_count) &&
+                       read_cache_integer(entry_bytes, minimum_word_length) &&
+                       read_cache_integer(entry_bytes, maximum_word_length) &&
+                       read_cache_integer(entry_bytes, passage_metrics.long_word_count) &&
+                       read_cache_integer(entry_bytes, passage_metrics.advanced_vocabulary_count) &&
+                       read_cache_integer(entry_bytes, passage_metrics.basic_vocabulary_count) &&
+                       read_cache_integer(entry_bytes, complexity_bits) &&
+                       read_cache_integer(entry_bytes, passage_metrics.syllable_count) &&
+                       read_cache_integer(entry_bytes, passage_metrics.polysyllabic_word_count) &&
+                       read_cache_integer(entry_bytes, passage_metrics.passage_length) &&
+                       read_cache_integer(entry_bytes, passage_metrics.sentence_count) &&
+                       read_cache_integer(entry_bytes, passage_metrics.comma_count) &&
+                       read_cache_integer(entry_bytes, passage_metrics.semicolon_count);
+    if (!fields_read) {
+        return false;
+    }
+    passage_metrics.minimum_word_length = static_cast<int>(static_cast<int64_t>(minimum_word_length));
+    passage_metrics.maximum_word_length = static_cast<int>(static_cast<int64_t>(maximum_word_length));
+    memcpy(&passage_metrics.complexity_accumulator, &complexity_bits, sizeof(complexity_bits));
+
+    for (SentenceLengthDistribution* sentence_lengths :
+         {&passage_metrics.sentence_word_lengths, &passage_metrics.sentence_character_lengths}) {
+        uint64_t bucket_count = 0;
+        bool distribution_read = read_cache_integer(entry_bytes, sentence_lengths->sentence_count) &&
+                                 read_cache_integer(entry_bytes, sentence_lengths->length_sum) &&
+                                 read_cache_integer(entry_bytes, sentence_lengths->squared_length_sum) &&
+                                 read_cache_integer(entry_bytes, sentence_lengths->longest_length) &&
+                                 read_cache_integer(entry_bytes, bucket_count);
+        if (!distribution_read || bucket_count > sentence_length_bucket(UINT64_MAX) + 1) {
+            return false;
+        }
+        sentence_lengths->bucket_counts.assign(bucket_count, 0);
+        for (uint64_t& stored_count : sentence_lengths->bucket_counts) {
+            if (!read_cache_integer(entry_bytes, stored_count)) {
+                return false;
+            }
+        }
+    }
+
+    for (vector<string>* vocabulary_examples :
+         {&passage_metrics.basic_vocabulary_examples, &passage_metrics.advanced_vocabulary_examples}) {
+        uint64_t example_count = 0;
+        if (!read_cache_integer(entry_bytes, example_count) || example_count > PassageAnalysisAccumulator::VOCABULARY_EXAMPLE_LIMIT) {
+            return false;
+        }
+        vocabulary_examples->clear();
+        for (uint64_t example_index = 0; example_index < example_count; example_index++) {
+            uint64_t example_length = 0;
+            if (!read_cache_integer(entry_bytes, example_length) || example_length > entry_bytes.size()) {
+                return false;
+            }
+            vocabulary_examples->emplace_back(entry_bytes.substr(0, example_length));
+            entry_bytes.remove_prefix(example_length);
+        }
+    }
+
+    uint64_t vocabulary_estimated = 0;
+    if (!read_cache_integer(entry_bytes, passage_metrics.distinct_word_count) ||
+        !read_cache_integer(entry_bytes, vocabulary_estimated) || vocabulary_estimated > 1) {
+        return false;
+    }
+    passage_metrics.vocabulary_estimated = vocabulary_estimated != 0;
+    for (vector<FrequentWord>* frequent_words :
+         {&passage_metrics.frequent_basic_words, &passage_metrics.frequent_advanced_words}) {
+        uint64_t frequent_word_count = 0;
+        if (!read_cache_integer(entry_bytes, frequent_word_count) ||
+            frequent_word_count > PassageAnalysisAccumulator::FREQUENT_WORD_LIMIT) {
+            return false;
+        }
+        frequent_words->clear();
+        for (uint64_t frequent_word_index = 0; frequent_word_index < frequent_word_count; frequent_word_index++) {
+            uint64_t word_length = 0;
+            FrequentWord frequent_word;
+            if (!read_cache_integer(entry_bytes, word_length) || word_length > entry_bytes.size()) {
+                return false;
+            }
+            frequent_word.word = string(entry_bytes.substr(0, word_length));
+            entry_bytes.remove_prefix(word_length);
+            if (!read_cache_integer(entry_bytes, frequent_word.occurrence_count)) {
+                return false;
+            }
+            frequent_words->push_back(move(frequent_word));
+        }
+    }
+    return read_cached_style_report(entry_bytes, style_report) && entry_bytes.empty();
+}
+
+AnalysisResultCache::AnalysisResultCache(size_t maximum_entry_count, const string& disk_directory, uint64_t maximum_disk_bytes)
+    : maximum_entry_count(maximum_entry_count), disk_directory(disk_directory), maximum_disk_bytes(maximum_disk_bytes) {
+    if (!disk_directory.empty()) {
+        error_code directory_error;
+        filesystem::create_directories(disk_directory, directory_error);
+        index_disk_directory();
+    }
+}
+
+/*
+ * Look a passage up in memory, then on disk
+ * Disk hits are promoted into the memory tier
+ */
+bool AnalysisResultCache::lookup(const PassageContentHash& content_hash, PassageAnalysisAccumulator& cached_metrics,
+                                 const StyleLinter* style_linter, StyleLintReport* cached_style_report) {
+    // With a linter, only an entry linted under the same rules will do
+    auto entry_usable = [style_linter](const CachedPassageAnalysis& cached_analysis) {
+        return style_linter == nullptr ||
+               cached_analysis.style_report.rule_set_fingerprint == style_linter->rule_set_fingerprint();
+    };
+    auto copy_cached_analysis = [&](const CachedPassageAnalysis& cached_analysis) {
+        cached_metrics = cached_analysis.passage_metrics;
+        if (cached_style_report != nullptr) {
+            *cached_style_report = cached_analysis.style_report;
+        }
+    };
+
+    {
+        lock_guard<mutex> cache_lock(cache_mutex);
+        auto resident_entry = resident_entries.find(content_hash);
+        if (resident_entry != resident_entries.end() && entry_usable(resident_entry->second->second)) {
+            recency_list.splice(recency_list.begin(), recency_list, resident_entry->second);
+            copy_cached_analysis(resident_entry->second->second);
+            cache_statistics.memory_hits++;
+            return true;
+        }
+    }
+
+    // Disk reads happen outside the lock so other workers keep hitting memory
+    CachedPassageAnalysis loaded_analysis;
+    if (!disk_directory.empty() && load_disk_entry(content_hash, loaded_analysis) && entry_usable(loaded_analysis)) {
+        copy_cached_analysis(loaded_analysis);
+        lock_guard<mutex> cache_lock(cache_mutex);
+        cache_statistics.disk_hits++;
+        insert_resident_entry(content_hash, move(loaded_analysis));
+        auto disk_entry = disk_entries.find(content_hash);
+        if (disk_entry != disk_entries.end()) {
+            disk_recency_list.splice(disk_recency_list.begin(), disk_recency_list, disk_entry->second);
+        }
+        return true;
+    }
+
+    lock_guard<mutex> cache_lock(cache_mutex);
+    cache_statistics.misses++;
+    return false;
+}
+
+/*
+ * Remember the metrics and style report of a freshly analyzed passage in
+ * every enabled tier
+ */
+void AnalysisResultCache::store(const PassageContentHash& content_hash, const PassageAnalysisAccumulator& passage_metrics,
+                                const StyleLintReport& style_report) {
+    CachedPassageAnalysis cached_analysis{passage_metrics, style_report};
+    if (!disk_directory.empty()) {
+        save_disk_entry(content_hash, cached_analysis);
+    }
+    lock_guard<mutex> cache_lock(cache_mutex);
+    cache_statistics.stores++;
+    insert_resident_entry(content_hash, move(cached_analysis));
+}
+
+AnalysisCacheStatistics AnalysisResultCache::statistics() const {
+    lock_guard<mutex> cache_lock(cache_mutex);
+    AnalysisCacheStatistics current_statistics = cache_statistics;
+    current_statistics.resident_entries = resident_entries.size();
+    current_statistics.disk_entries = disk_entries.size();
+    current_statistics.disk_bytes = disk_entry_bytes;
+    return current_statistics;
+}
+
+/*
+ * Insert or refresh a memory tier entry, evicting the least recently used
+ * entries beyond the bound; the caller holds cache_mutex
+ */
+void AnalysisResultCache::insert_resident_entry(const PassageContentHash& content_hash, CachedPassageAnalysis cached_analysis) {
+    if (maximum_entry_count == 0) {
+        return;
+    }
+
+    auto resident_entry = resident_entries.find(content_hash);
+    if (resident_entry != resident_entries.end()) {
+        resident_entry->second->second = move(cached_analysis);
+        recency_list.splice(recency_list.begin(), recency_list, resident_entry->second);
+        return;
+    }
+
+    recency_list.emplace_front(content_hash, move(cached_analysis));
+    resident_entries.emplace(content_hash, recency_list.begin());
+    while (resident_entries.size() > maximum_entry_count) {
+        resident_entries.erase(recency_list.back().first);
+        recency_list.pop_back();
+        cache_statistics.evictions++;
+    }
+}
+
+string AnalysisResultCache::disk_entry_path(const PassageContentHash& content_hash) const {
+    char hash_digits[33];
+    snprintf(hash_digits, sizeof(hash_digits), "%016llx%016llx", static_cast<unsigned long long>(content_hash.high_bits),
+             static_cast<unsigned long long>(content_hash.low_bits));
+    return (filesystem::path(disk_directory) / (string(hash_digits) + ".txac")).string();
+}
+
+/*
+ * Recover the passage hash from a disk entry file name
+ * Returns false for anything else, such as an interrupted write's temporary file
+ */
+static bool parse_disk_entry_name(const string& file_name, PassageContentHash& content_hash) {
+    const size_t HASH_DIGIT_COUNT = 32;
+    if (file_name.size() != HASH_DIGIT_COUNT + 5 || file_name.compare(HASH_DIGIT_COUNT, 5, ".txac") != 0) {
+        return false;
+    }
+    const char* hash_digits = file_name.data();
+    from_chars_result high_result = from_chars(hash_digits, hash_digits + 16, content_hash.high_bits, 16);
+    from_chars_result low_result = from_chars(hash_digits + 16, hash_digits + HASH_DIGIT_COUNT, content_hash.low_bits, 16);
+    return high_result.ec == errc() && high_result.ptr == hash_digits + 16 && low_result.ec == errc() &&
+           low_result.ptr == hash_digits + HASH_DIGIT_COUNT;
+}
+
+/*
+ * Index the entry files already in the disk directory from the oldest to
+ * the newest modification time, then trim them to the byte bound
+ */
+void AnalysisResultCache::index_disk_directory() {
+    vector<pair<filesystem::file_time_type, DiskEntry>> found_entries;
+    error_code scan_error;
+    for (filesystem::directory_iterator entry_iterator(disk_directory, scan_error), directory_end;
+         !scan_error && entry_iterator != directory_end; entry_iterator.increment(scan_error)) {
+        PassageContentHash content_hash;
+        if (!parse_disk_entry_name(entry_iterator->path().filename().string(), content_hash)) {
+            continue;
+        }
+        error_code status_error;
+        uint64_t entry_byte_count = entry_iterator->file_size(status_error);
+        filesystem::file_time_type modification_time = entry_iterator->last_write_time(status_error);
+        if (!status_error) {
+            found_entries.push_back({modification_time, {content_hash, entry_byte_count}});
+        }
+    }
+    sort(found_entries.begin(), found_entries.end(),
+         [](const auto& first_entry, const auto& second_entry) { return first_entry.first < second_entry.first; });
+
+    {
+        lock_guard<mutex> cache_lock(cache_mutex);
+        for (const auto& found_entry : found_entries) {
+            record_disk_entry(found_entry.second.first, found_entry.second.second);
+        }
+    }
+    trim_disk_entries();
+}
+
+/*
+ * Read and decode a disk tier entry, refreshing its modification time so
+ * the next index of the directory still sees it as recently used. An
+ * entry that fails to decode is stale or damaged and is deleted
+ */
+bool AnalysisResultCache::load_disk_entry(const PassageContentHash& content_hash, CachedPassageAnalysis& cached_analysis) {
+    string entry_path = disk_entry_path(content_hash);
+    FILE* entry_file = fopen(entry_path.c_str(), "rb");
+    if (entry_file == nullptr) {
+        return false;
+    }
+    string entry_bytes;
+    char read_buffer[4096];
+    size_t read_byte_count;
+    while ((read_byte_count = fread(read_buffer, 1, sizeof(read_buffer), entry_file)) > 0) {
+        entry_bytes.append(read_buffer, read_byte_count);
+    }
+    fclose(entry_file);
+
+    error_code file_error;
+    CachedPassageAnalysis decoded_analysis;
+    if (!decode_cached_passage_analysis(entry_bytes, decoded_analysis.passage_metrics, decoded_analysis.style_report)) {
+        filesystem::remove(entry_path, file_error);
+        lock_guard<mutex> cache_lock(cache_mutex);
+        forget_disk_entry(content_hash);
+        return false;
+    }
+    filesystem::last_write_time(entry_path, filesystem::file_time_type::clock::now(), file_error);
+    cached_analysis = move(decoded_analysis);
+
+    // Another process may have written the entry after this cache indexed the directory
+    lock_guard<mutex> cache_lock(cache_mutex);
+    if (disk_entries.find(content_hash) == disk_entries.end()) {
+        record_disk_entry(content_hash, entry_bytes.size());
+    }
+    return true;
+}
+
+/*
+ * Write a disk tier entry through a temporary file and a rename, so a
+ * concurrent reader or a crash never observes a partial entry
+ */
+void AnalysisResultCache::save_disk_entry(const PassageContentHash& content_hash, const CachedPassageAnalysis& cached_analysis) {
+    string entry_path = disk_entry_path(content_hash);
+    string temporary_path = entry_path + ".tmp" + to_string(hash<thread::id>()(this_thread::get_id()));
+    string entry_bytes = encode_cached_passage_analysis(cached_analysis.passage_metrics, cached_analysis.style_report);
+
+    FILE* entry_file = fopen(temporary_path.c_str(), "wb");
+    if (entry_file == nullptr) {
+        return;
+    }
+    bool entry_written = fwrite(entry_bytes.data(), 1, entry_bytes.size(), entry_file) == entry_bytes.size();
+    entry_written = fclose(entry_file) == 0 && entry_written;
+
+    error_code rename_error;
+    if (entry_written) {
+        filesystem::rename(temporary_path, entry_path, rename_error);
+    }
+    if (!entry_written || rename_error) {
+        filesystem::remove(temporary_path, rename_error);
+        return;
+    }
+
+    {
+        lock_guard<mutex> cache_lock(cache_mutex);
+        record_disk_entry(content_hash, entry_bytes.size());
+    }
+    trim_disk_entries();
+}
+
+/*
+ * Make an entry the most recently used one of the disk index, replacing
+ * any earlier size recorded for it; the caller holds cache_mutex
+ */
+void AnalysisResultCache::record_disk_entry(const PassageContentHash& content_hash, uint64_t entry_byte_count) {
+    forget_disk_entry(content_hash);
+    disk_recency_list.emplace_front(content_hash, entry_byte_count);
+    disk_entries.emplace(content_hash, disk_recency_list.begin());
+    disk_entry_bytes += entry_byte_count;
+}
+
+// Drop an entry from the disk index; the caller holds cache_mutex
+void AnalysisResultCache::forget_disk_entry(const PassageContentHash& content_hash) {
+    auto disk_entry = disk_entries.find(content_hash);
+    if (disk_entry == disk_entries.end()) {
+        return;
+    }
+    disk_entry_bytes -= disk_entry->second->second;
+    disk_recency_list.erase(disk_entry->second);
+    disk_entries.erase(disk_entry);
+}
+
+/*
+ * Delete the least recently used disk entries until the tier fits in
+ * maximum_disk_bytes; the newest entry is always kept
+ */
+void AnalysisResultCache::trim_disk_entries() {
+    vector<string> evicted_paths;
+    {
+        lock_guard<mutex> cache_lock(cache_mutex);
+        while (disk_entry_bytes > maximum_disk_bytes && disk_recency_list.size() > 1) {
+            PassageContentHash evicted_hash = disk_recency_list.back().first;
+            evicted_paths.push_back(disk_entry_path(evicted_hash));
+            forget_disk_entry(evicted_hash);
+            cache_statistics.disk_evictions++;
+        }
+    }
+
+    // Files are deleted outside the lock, like every other disk access
+    error_code remove_error;
+    for (const string& evicted_path : evicted_paths) {
+        filesystem::remove(evicted_path, remove_error);
+    }
+}
+
+/*
+ * Analyze a passage unless the cache already holds its results
+ * With a style linter the passage is also linted into style_report, and
+ * a cache hit answers both. A null cache simply runs the parallel engine
+ */
+PassageAnalysisAccumulator analyze_passage_through_cache(string_view text_passage, AnalysisResultCache* result_cache,
+                                                         unsigned analysis_thread_count, const StyleLinter* style_linter,
+                                                         StyleLintReport* style_report) {
+    StyleLintReport passage_style_report;
+    PassageContentHash content_hash;
+    PassageAnalysisAccumulator passage_metrics;
+    if (result_cache != nullptr) {
+        content_hash = hash_passage_content(text_passage);
+        StyleLintReport* cached_style_report = style_linter != nullptr ? &passage_style_report : nullptr;
+        if (result_cache->lookup(content_hash, passage_metrics, style_linter, cached_style_report)) {
+            if (style_report != nullptr) {
+                *style_report = move(passage_style_report);
+            }
+            return passage_metrics;
+        }
+    }
+
+    passage_metrics = analyze_passage_in_parallel(text_passage, analysis_thread_count);
+    if (style_linter != nullptr) {
+        passage_style_report = style_linter->lint_passage(text_passage);
+    }
+    if (result_cache != nullptr) {
+        result_cache->store(content_hash, passage_metrics, passage_style_report);
+    }
+    if (style_report != nullptr) {
+        *style_report = move(passage_style_report);
+    }
+    return passage_metrics;
+}
+
+thread_local WorkStealingThreadPool* WorkStealingThreadPool::current_pool = nullptr;
+thread_local unsigned WorkStealingThreadPool::current_worker_index = 0;
+
+WorkStealingThreadPool::WorkStealingThreadPool(unsigned worker_count) {
+    worker_count = max(1u, worker_count);
+    for (unsigned worker_index = 0; worker_index < worker_count; worker_index++) {
+        worker_queues.push_back(make_unique<WorkerQueue>());
+    }
+    for (unsigned worker_index = 0; worker_index < worker_count; worker_index++) {
+        worker_threads.emplace_back(&WorkStealingThreadPool::worker_loop, this, worker_index);
+    }
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool() {
+    {
+        lock_guard<mutex> idle_lock(idle_mutex);
+        shutting_down = true;
+    }
+    work_available.notify_all();
+    for (thread& worker_thread : worker_threads) {
+        worker_thread.join();
+    }
+}
+
+void WorkStealingThreadPool::submit(function<void()> task) {
+    unsigned target_queue = current_pool == this
+        ? current_worker_index
+        : next_submission_queue.fetch_add(1, memory_order_relaxed) % worker_count();
+
+    unfinished_task_count.fetch_add(1);
+    {
+        lock_guard<mutex> queue_lock(worker_queues[target_queue]->queue_mutex);
+        worker_queues[target_queue]->queued_tasks.push_back(move(task));
+    }
+    queued_task_count.fetch_add(1);
+
+    // Taking the idle mutex orders this wake-up after any worker's final check
+    { lock_guard<mutex> idle_lock(idle_mutex); }
+    work_available.notify_one();
+}
+
+void WorkStealingThreadPool::wait_until_idle() {
+    unique_lock<mutex> idle_lock(idle_mutex);
+    all_tasks_finished.wait(idle_lock, [this] { return unfinished_task_count.load() == 0; });
+}
+
+bool WorkStealingThreadPool::try_acquire_task(unsigned worker_index, function<void()>& acquired_task) {
+    // Newest local task first; it is the one most likely to be cache-warm
+    {
+        WorkerQueue& own_queue = *worker_queues[worker_index];
+        lock_guard<mutex> queue_lock(own_queue.queue_mutex);
+        if (!own_queue.queued_tasks.empty()) {
+            acquired_task = move(own_queue.queued_tasks.back());
+            own_queue.queued_tasks.pop_back();
+            queued_task_count.fetch_sub(1);
+            return true;
+        }
+    }
+
+    // Otherwise steal the oldest task from the next non-empty peer
+    for (unsigned offset = 1; offset < worker_count(); offset++) {
+        WorkerQueue& victim_queue = *worker_queues[(worker_index + offset) % worker_count()];
+        lock_guard<mutex> queue_lock(victim_queue.queue_mutex);
+        if (!victim_queue.queued_tasks.empty()) {
+            acquired_task = move(victim_queue.queued_tasks.front());
+            victim_queue.queued_tasks.pop_front();
+            queued_task_count.fetch_sub(1);
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingThreadPool::worker_loop(unsigned worker_index) {
+    current_pool = this;
+    current_worker_index = worker_index;
+
+    function<void()> acquired_task;
+    while (true) {
+        if (try_acquire_task(worker_index, acquired_task)) {
+            acquired_task();
+            acquired_task = nullptr;
+            if (unfinished_task_count.fetch_sub(1) == 1) {
+                { lock_guard<mutex> idle_lock(idle_mutex); }
+                all_tasks_finished.notify_all();
+            }
+            continue;
+        }
+
+        unique_lock<mutex> idle_lock(idle_mutex);
+        work_available.wait(idle_lock, [this] { return shutting_down || queued_task_count.load() > 0; });
+        if (shutting_down && queued_task_count.load() == 0) {
+            return;
+        }
+    }
+}
+
+/*
+ * Collect the documents of a batch corpus
+ * A directory contributes every regular file below it, in sorted order;
+ * any other path is read as a file list with one document path per line
+ */
+bool collect_corpus_document_paths(const string& corpus_source, vector<string>& document_paths, string& error_description) {
+    error_code filesystem_error;
+    if (filesystem::is_directory(corpus_source, filesystem_error)) {
+        for (const auto& directory_entry : filesystem::recursive_directory_iterator(corpus_source, filesystem_error)) {
+            if (directory_entry.is_regular_file()) {
+                document_paths.push_back(directory_entry.path().string());
+            }
+        }
+        sort(document_paths.begin(), document_paths.end());
+    } else {
+        MappedTextFile file_list;
+        if (!file_list.open_document(corpus_source, false)) {
+            error_description = file_list.last_error();
+            return false;
+        }
+        string_view listed_paths = file_list.contents();
+        while (!listed_paths.empty()) {
+            size_t line_end = min(listed_paths.find('\n'), listed_paths.size());
+            string_view listed_path = listed_paths.substr(0, line_end);
+            if (!listed_path.empty() && listed_path.back() == '\r') {
+                listed_path.remove_suffix(1);
+            }
+            if (!listed_path.empty()) {
+                document_paths.emplace_back(listed_path);
+            }
+            listed_paths.remove_prefix(min(line_end + 1, listed_paths.size()));
+        }
+    }
+
+    if (filesystem_error) {
+        error_description = "cannot read '" + corpus_source + "': " + filesystem_error.message();
+        return false;
+    }
+    return true;
+}
+
+namespace {
+
+/*
+ * State shared by every task of one batch corpus run
+ * The first task to hash a document's bytes claims them; identical
+ * documents hashed later are recorded as duplicates and never analyzed
+ */
+struct BatchCorpusRun {
+    WorkStealingThreadPool* analysis_pool = nullptr;
+    ProgressReporter* progress_reporter = nullptr;
+    AnalysisResultCache* result_cache = nullptr;
+    const StyleLinter* style_linter = nullptr;
+    mutex claimed_content_mutex;
+    unordered_map<PassageContentHash, size_t, PassageContentHashHasher> claimed_content;
+};
+
+/*
+ * Shared state of one large batch document analyzed as several chunk tasks
+ * With a style linter, one more task lints the whole document alongside
+ * them. The task that finishes last merges the partial results
+ */
+struct SplitDocumentJob {
+    unique_ptr<MappedTextFile> document_file;
+    vector<string_view> document_chunks;
+    vector<PassageAnalysisAccumulator> chunk_metrics;
+    vector<WordLengthLog> chunk_length_logs;
+    vector<WordFrequencyTable> chunk_word_frequencies;
+    atomic<size_t> remaining_task_count{0};
+    DocumentAnalysisResult* destination_result = nullptr;
+    ProgressReporter* progress_reporter = nullptr;
+    AnalysisResultCache* result_cache = nullptr;
+};
+
+}  // namespace
+
+/*
+ * Merge a split document's chunks into its result once its last task ends
+ */
+static void finish_split_document(SplitDocumentJob& split_job) {
+    DocumentAnalysisResult& destination_result = *split_job.destination_result;
+    destination_result.passage_metrics =
+        merge_passage_chunks(split_job.chunk_metrics, split_job.chunk_length_logs, split_job.chunk_word_frequencies);
+    destination_result.analysis_succeeded = true;
+    if (split_job.result_cache != nullptr) {
+        split_job.result_cache->store(destination_result.content_hash, destination_result.passage_metrics,
+                                      destination_result.style_report);
+    }
+    split_job.progress_reporter->complete_work_unit();
+}
+
+/*
+ * Analyze one batch document inside the pool
+ * Duplicates of a document already claimed in this batch and documents
+ * found in the result cache finish without analysis. Documents large
+ * enough to split are fanned out as chunk tasks on the current worker's
+ * deque, where idle workers can steal them
+ */
+static void analyze_batch_document(BatchCorpusRun& batch_run, DocumentAnalysisResult& document_result, size_t document_index) {
+    WorkStealingThreadPool& analysis_pool = *batch_run.analysis_pool;
+    ProgressReporter& progress_reporter = *batch_run.progress_reporter;
+    auto document_file = make_unique<MappedTextFile>();
+    if (!document_file->open_document(document_result.document_path, true)) {
+        document_result.error_description = document_file->last_error();
+        progress_reporter.complete_work_unit();
+        return;
+    }
+
+    string_view document_text = document_file->contents();
+    document_result.document_bytes = document_text.size();
+    if (document_text.empty()) {
+        document_result.error_description = "empty document";
+        progress_reporter.complete_work_unit();
+        return;
+    }
+
+    document_result.content_hash = hash_passage_content(document_text);
+    {
+        lock_guard<mutex> claim_lock(batch_run.claimed_content_mutex);
+        auto content_claim = batch_run.claimed_content.emplace(document_result.content_hash, document_index);
+        if (!content_claim.second) {
+            document_result.duplicate_of_document = content_claim.first->second;
+            progress_reporter.add_processed_bytes(document_text.size());
+            progress_reporter.complete_work_unit();
+            return;
+        }
+    }
+    const StyleLinter* style_linter = batch_run.style_linter;
+    if (batch_run.result_cache != nullptr &&
+        batch_run.result_cache->lookup(document_result.content_hash, document_result.passage_metrics, style_linter,
+                                       style_linter != nullptr ? &document_result.style_report : nullptr)) {
+        document_result.served_from_cache = true;
+        document_result.analysis_succeeded = true;
+        progress_reporter.add_processed_bytes(document_text.size());
+        progress_reporter.complete_work_unit();
+        return;
+    }
+
+    size_t chunk_count = parallel_chunk_count(document_text.size(), analysis_pool.worker_count());
+    if (chunk_count <= 1) {
+        document_result.passage_metrics = analyze_passage_in_single_pass(document_text, &progress_reporter);
+        if (style_linter != nullptr) {
+            document_result.style_report = style_linter->lint_passage(document_text);
+        }
+        document_result.analysis_succeeded = true;
+        if (batch_run.result_cache != nullptr) {
+            batch_run.result_cache->store(document_result.content_hash, document_result.passage_metrics,
+                                          document_result.style_report);
+        }
+        progress_reporter.complete_work_unit();
+        return;
+    }
+
+    auto split_job = make_shared<SplitDocumentJob>();
+    split_job->document_chunks = split_passage_into_chunks(document_text, chunk_count);
+    split_job->document_file = move(document_file);
+    split_job->chunk_metrics.resize(split_job->document_chunks.size());
+    split_job->chunk_length_logs.resize(split_job->document_chunks.size());
+    split_job->chunk_word_frequencies.resize(split_job->document_chunks.size());
+    split_job->remaining_task_count = split_job->document_chunks.size() + (style_linter != nullptr ? 1 : 0);
+    split_job->destination_result = &document_result;
+    split_job->progress_reporter = &progress_reporter;
+    split_job->result_cache = batch_run.result_cache;
+
+    for (size_t chunk_index = 0; chunk_index < split_job->document_chunks.size(); chunk_index++) {
+        analysis_pool.submit([split_job, chunk_index] {
+            analyze_passage_chunk(split_job->document_chunks[chunk_index], split_job->chunk_metrics[chunk_index],
+                                  &split_job->chunk_length_logs[chunk_index], split_job->chunk_word_frequencies[chunk_index],
+                                  split_job->progress_reporter);
+            if (split_job->remaining_task_count.fetch_sub(1) == 1) {
+                finish_split_document(*split_job);
+            }
+        });
+    }
+    if (style_linter != nullptr) {
+        analysis_pool.submit([split_job, style_linter, document_text] {
+            split_job->destination_result->style_report = style_linter->lint_passage(document_text);
+            if (split_job->remaining_task_count.fetch_sub(1) == 1) {
+                finish_split_document(*split_job);
+            }
+        });
+    }
+}
+
+/*
+ * This function analyzes every document of a corpus on a work-stealing pool
+ * Documents are submitted largest first so huge files start early and
+ * tiny files fill the gaps; results keep the order of the input list.
+ * Byte-identical documents are analyzed once and the others point at the
+ * earliest copy in the list. A style linter, when given, lints every
+ * document that is not served from the cache. Progress goes to the
+ * optional render function
+ */
+vector<DocumentAnalysisResult> analyze_document_corpus(const vector<string>& document_paths, unsigned analysis_thread_count,
+                                                       AnalysisResultCache* result_cache,
+                                                       ProgressRenderFunction progress_render_function,
+                                                       const StyleLinter* style_linter) {
+    analysis_thread_count = resolve_analysis_thread_count(analysis_thread_count);
+
+    vector<DocumentAnalysisResult> document_results(document_paths.size());
+    vector<pair<uintmax_t, size_t>> submission_order;
+    uint64_t corpus_bytes = 0;
+    for (size_t document_index = 0; document_index < document_paths.size(); document_index++) {
+        document_results[document_index].document_path = document_paths[document_index];
+        error_code size_error;
+        uintmax_t document_size = filesystem::file_size(document_paths[document_index], size_error);
+        submission_order.emplace_back(size_error ? 0 : document_size, document_index);
+        corpus_bytes += size_error ? 0 : document_size;
+    }
+    stable_sort(submission_order.begin(), submission_order.end(),
+                [](const pair<uintmax_t, size_t>& first, const pair<uintmax_t, size_t>& second) {
+                    return first.first > second.first;
+                });
+
+    ProgressReporter progress_reporter(corpus_bytes, document_paths.size(), "documents", progress_render_function);
+    WorkStealingThreadPool analysis_pool(analysis_thread_count);
+    BatchCorpusRun batch_run;
+    batch_run.analysis_pool = &analysis_pool;
+    batch_run.progress_reporter = &progress_reporter;
+    batch_run.result_cache = result_cache;
+    batch_run.style_linter = style_linter;
+    for (const auto& submission : submission_order) {
+        size_t document_index = submission.second;
+        analysis_pool.submit([&batch_run, &document_results, document_index] {
+            analyze_batch_document(batch_run, document_results[document_index], document_index);
+        });
+    }
+    analysis_pool.wait_until_idle();
+    progress_reporter.finish();
+
+    // Copy results to duplicates, then relabel so the earliest copy in list order is the original
+    unordered_map<PassageContentHash, size_t, PassageContentHashHasher> earliest_document_by_content;
+    for (size_t document_index = 0; document_index < document_results.size(); document_index++) {
+        DocumentAnalysisResult& document_result = document_results[document_index];
+        if (document_result.duplicate_of_document != DocumentAnalysisResult::NO_DUPLICATE_DOCUMENT) {
+            document_result.passage_metrics = document_results[document_result.duplicate_of_document].passage_metrics;
+            document_result.style_report = document_results[document_result.duplicate_of_document].style_report;
+            document_result.analysis_succeeded = true;
+        }
+        if (document_result.analysis_succeeded) {
+            earliest_document_by_content.emplace(document_result.content_hash, document_index);
+        }
+    }
+    for (size_t document_index = 0; document_index < document_results.size(); document_index++) {
+        DocumentAnalysisResult& document_result = document_results[document_index];
+        if (document_result.analysis_succeeded) {
+            size_t earliest_document = earliest_document_by_content[document_result.content_hash];
+            document_result.duplicate_of_document =
+                earliest_document == document_index ? DocumentAnalysisResult::NO_DUPLICATE_DOCUMENT : earliest_document;
+        }
+    }
+    return document_results;
+}
+
+/*
+ * This function analyzes one document of any length in fixed memory
+ * The document is read in pieces through a StreamingPassageAnalyzer, so
+ * pipes and files larger than memory work; "-" reads standard input.
+ * The vocabulary summary is estimated; the cache is not consulted
+ * because the content hash would need the whole document first. A style
+ * linter, when given, scans the same pieces as they are read
+ */
+DocumentAnalysisResult analyze_document_stream(const string& document_path, const StyleLinter* style_linter) {
+    DocumentAnalysisResult document_result;
+    document_result.document_path = document_path;
+    bool reads_standard_input = document_path == "-";
+    FILE* document_stream = reads_standard_input ? stdin : fopen(document_path.c_str(), "rb");
+    if (document_stream == nullptr) {
+        document_result.error_description = "cannot open '" + document_path + "': " + strerror(errno);
+        return document_result;
+    }
+
+    StreamingPassageAnalyzer streaming_analyzer;
+    unique_ptr<StyleLintScan> style_scan;
+    if (style_linter != nullptr) {
+        style_scan = make_unique<StyleLintScan>(*style_linter);
+    }
+    vector<char> read_buffer(STREAMING_READ_BUFFER_BYTES);
+    size_t read_byte_count;
+    while (true) {
+        {
+            TEXT_ANALYSER_STAGE_SCOPE(input_stage, PipelineStage::Input);
+            read_byte_count = fread(read_buffer.data(), 1, read_buffer.size(), document_stream);
+            TEXT_ANALYSER_STAGE_BYTES(input_stage, read_byte_count);
+        }
+        if (read_byte_count == 0) {
+            break;
+        }
+        streaming_analyzer.append_text(string_view(read_buffer.data(), read_byte_count));
+        if (style_scan != nullptr) {
+            style_scan->scan_text_piece(string_view(read_buffer.data(), read_byte_count));
+        }
+        document_result.document_bytes += read_byte_count;
+    }
+    bool read_failed = ferror(document_stream) != 0;
+    int read_error = errno;
+    if (!reads_standard_input) {
+        fclose(document_stream);
+    }
+
+    if (read_failed) {
+        document_result.error_description = "cannot read '" + document_path + "': " + strerror(read_error);
+    } else if (document_result.document_bytes == 0 && !reads_standard_input) {
+        document_result.error_description = "empty document";
+    } else {
+        document_result.passage_metrics = streaming_analyzer.finish();
+        if (style_scan != nullptr) {
+            document_result.style_report = style_scan->finish();
+        }
+        document_result.analysis_succeeded = true;
+    }
+    return document_result;
+}
+
+/*
+ * This function implements readability complexity scoring algorithms
+ * The calculation uses statistical methods for objective text assessment
+ * Professional scoring systems require mathematical precision and validation
+ */
+double calculate_readability_complexity_score(const InternedTokenStream& word_collection) {
+    double complexity_accumulator = 0.0;
+    int total_character_count = 0;
+    int advanced_vocabulary_count = 0;
+    
+    // Iterate through the complete word collection for comprehensive analysis
+    for (uint32_t word_id : word_collection.word_ids) {
+        size_t vocabulary_item_length = word_collection.vocabulary.character_count(word_id);
+        // Calculate individual word complexity based on length and structure
+        double word_complexity_factor = vocabulary_item_length * 1.2;
+        
+        // Apply bonus multipliers for advanced vocabulary characteristics
+        if (vocabulary_item_length > 8) {
+            word_complexity_factor *= 1.5;  // Advanced vocabulary bonus
+            advanced_vocabulary_count++;
+        }
+        
+        // Additional complexity for technical terminology patterns
+        if (vocabulary_item_length > 12) {
+            word_complexity_factor *= 1.3;  // Technical complexity bonus
+        }
+        
+        // Accumulate the complexity metrics for statistical processing
+        complexity_accumulator += word_complexity_factor;
+        total_character_count += vocabulary_item_length;
+    }
+    
+    // Calculate the normalized complexity score using professional algorithms
+    double normalized_complexity_score = complexity_accumulator / word_collection.size();
+    
+    // Apply statistical normalization for standardized scoring methodology
+    return min(normalized_complexity_score / 8.0, 10.0);
+}
+
+/*
+ * This function performs comprehensive statistical analysis on text data
+ * The implementation generates professional metrics for educational assessment
+ * Statistical processing follows academic standards for language evaluation
+ */
+PassageAnalysisAccumulator perform_comprehensive_text_analysis(const InternedTokenStream& word_collection, string_view original_passage) {
+    // Perform sentence structure analysis for comprehensive assessment
+    PassageAnalysisAccumulator passage_metrics = analyze_sentence_structure(original_passage);
+    
+    // Calculate fundamental text metrics for professional reporting
+    passage_metrics.total_word_count = word_collection.size();
+    
+    // Syllables are estimated once per distinct word
+    vector<uint32_t> syllable_counts_by_id(word_collection.vocabulary.size());
+    for (uint32_t word_id = 0; word_id < word_collection.vocabulary.size(); word_id++) {
+        syllable_counts_by_id[word_id] = static_cast<uint32_t>(estimate_syllable_count(word_collection.vocabulary.word(word_id)));
+    }
+    
+    // Process each vocabulary item for comprehensive statistical evaluation
+    for (uint32_t word_id : word_collection.word_ids) {
+        int current_word_length = static_cast<int>(word_collection.vocabulary.character_count(word_id));
+        passage_metrics.total_character_count += current_word_length;
+        passage_metrics.record_word_syllables(syllable_counts_by_id[word_id]);
+        
+        // Update statistical boundaries for range analysis
+        passage_metrics.minimum_word_length = min(passage_metrics.minimum_word_length, current_word_length);
+        passage_metrics.maximum_word_length = max(passage_metrics.maximum_word_length, current_word_length);
+        
+        // Count advanced vocabulary elements for sophistication metrics
+        if (current_word_length > 7) {
+            passage_metrics.long_word_count++;
+        }
+    }
+    
+    return passage_metrics;
+}
+
+/*
+ * This function analyzes sentence structure patterns in text passages
+ * The implementation evaluates syntactic complexity for writing assessment
+ * Structural analysis follows linguistic principles for educational feedback
+ */
+PassageAnalysisAccumulator analyze_sentence_structure(string_view text_passage) {
+    // Segment the passage into sentences for structural metrics
+    PassageAnalysisAccumulator passage_metrics;
+    passage_metrics.passage_length = text_passage.length();
+    for (const SentenceSpan& sentence_span : segment_sentences(text_passage)) {
+        passage_metrics.record_sentence(sentence_span.word_count, sentence_span.character_count);
+    }
+    
+    // Analyze punctuation patterns for complexity assessment
+    for (char character : text_passage) {
+        if (character == ',') {
+            passage_metrics.comma_count++;
+        } else if (character == ';') {
+            passage_metrics.semicolon_count++;
+        }
+    }
+    
+    return passage_metrics;
+}
+
+namespace {
+
+/*
+ * Token sink that only counts words and their letters, as the accumulator does
+ */
+struct SentenceWordCountSink {
+    static constexpr bool tracks_punctuation = false;
+    static constexpr bool tracks_sentences = false;
+
+    void append_letter(unsigned char) { current_word_length++; }
+    void append_letters(const unsigned char*, size_t letter_count) { current_word_length += letter_count; }
+    void append_encoded_letter(const unsigned char*, size_t) { current_word_length++; }
+    void close_word() {
+        if (current_word_length > 1) {
+            word_count++;
+            character_count += current_word_length;
+        }
+        current_word_length = 0;
+    }
+
+    uint64_t word_count = 0;
+    uint64_t character_count = 0;
+    size_t current_word_length = 0;
+};
+
+}  // namespace
+
+/*
+ * This function splits a passage into sentences with their byte offsets
+ * Boundaries come from one SentenceBoundaryScanner pass over the whole
+ * passage, then each sentence's words are counted with the scalar
+ * tokenizer, so the spans are the reference for the fused engines.
+ * The text after the last boundary is a sentence too; stretches without
+ * words, such as a stray "..." between sentences, are not
+ */
+vector<SentenceSpan> segment_sentences(string_view text_passage) {
+    const unsigned char* passage_bytes = reinterpret_cast<const unsigned char*>(text_passage.data());
+    vector<SentenceSpan> sentence_spans;
+    uint64_t sentence_start = 0;
+    auto close_sentence_at = [&](uint64_t sentence_end) {
+        SentenceWordCountSink word_counter;
+        scan_passage_bytes_scalar(text_passage.substr(sentence_start, sentence_end - sentence_start), word_counter);
+        word_counter.close_word();
+        if (word_counter.word_count > 0) {
+            // Trim the whitespace around the sentence
+            uint64_t span_start = sentence_start;
+            uint64_t span_end = sentence_end;
+            while (is_ascii_whitespace_byte(passage_bytes[span_start])) {
+                span_start++;
+            }
+            while (is_ascii_whitespace_byte(passage_bytes[span_end - 1])) {
+                span_end--;
+            }
+            sentence_spans.push_back({span_start, span_end - span_start, word_counter.word_count, word_counter.character_count});
+        }
+        sentence_start = sentence_end;
+    };
+
+    SentenceBoundaryScanner boundary_scanner;
+    for (size_t block_offset = 0; block_offset < text_passage.size(); block_offset += 64) {
+        uint64_t boundary_mask =
+            boundary_scanner.scan_block(passage_bytes + block_offset, min<size_t>(64, text_passage.size() - block_offset), ~0ULL);
+        for (; boundary_mask != 0; boundary_mask &= boundary_mask - 1) {
+            close_sentence_at(block_offset + lowest_set_bit_index(boundary_mask));
+        }
+    }
+    boundary_scanner.finish();
+    close_sentence_at(text_passage.size());
+    return sentence_spans;
+}
+
+/*
+ * Thesaurus file layout, integers in host byte order (the version check
+ * rejects a file built on a host of the other order):
+ *   header   "TXTH", format version, headword count and bucket count as
+ *            32-bit integers, then the byte size of the records (64-bit)
+ *   buckets  one 32-bit displacement per hash bucket
+ *   offsets  one 32-bit record offset per headword slot
+ *   records  per headword a length byte and the headword, a synonym count
+ *            byte, then a length byte and the text of every synonym
+ * A displacement with THESAURUS_DIRECT_SLOT_FLAG set is the slot of the
+ * bucket's only headword; any other is the seed that spreads the bucket's
+ * headwords over their slots
+ */
+const size_t THESAURUS_HEADER_BYTES = 24;
+const uint32_t THESAURUS_DIRECT_SLOT_FLAG = 0x80000000u;
+const size_t THESAURUS_HEADWORDS_PER_BUCKET = 4;
+const uint32_t THESAURUS_DISPLACEMENT_SEARCH_LIMIT = 1u << 24;
+const size_t THESAURUS_FIELD_LIMIT = 255;  // Lengths and synonym counts are single bytes
+
+static inline uint32_t load_thesaurus_integer(const unsigned char* integer_bytes) {
+    uint32_t integer_value;
+    memcpy(&integer_value, integer_bytes, sizeof(integer_value));
+    return integer_value;
+}
+
+static inline void append_thesaurus_integer(string& file_bytes, uint32_t integer_value) {
+    file_bytes.append(reinterpret_cast<const char*>(&integer_value), sizeof(integer_value));
+}
+
+static inline uint32_t thesaurus_bucket_index(uint64_t headword_hash, uint32_t bucket_count) {
+    return static_cast<uint32_t>(((headword_hash >> 32) * bucket_count) >> 32);
+}
+
+static inline uint32_t thesaurus_displaced_slot(uint64_t headword_hash, uint32_t displacement, uint32_t slot_count) {
+    uint64_t mixed_hash = headword_hash ^ (displacement * 0x9E3779B97F4A7C15ULL);
+    mixed_hash ^= mixed_hash >> 32;
+    mixed_hash *= 0xD6E8FEB86659FD93ULL;
+    mixed_hash ^= mixed_hash >> 32;
+    return static_cast<uint32_t>(((mixed_hash & 0xFFFFFFFFu) * slot_count) >> 32);
+}
+
+/*
+ * Map a thesaurus file and check that its tables fill it exactly
+ * Records are bounds-checked when they are looked up, so a damaged file
+ * yields missing synonyms rather than reads outside the mapping
+ */
+bool SynonymThesaurus::open_thesaurus(const string& thesaurus_path) {
+    headword_total = 0;
+    if (!thesaurus_file.open_document(thesaurus_path, false)) {
+        error_description = thesaurus_file.last_error();
+        return false;
+    }
+
+    string_view file_bytes = thesaurus_file.contents();
+    const unsigned char* file_start = reinterpret_cast<const unsigned char*>(file_bytes.data());
+    if (file_bytes.size() < THESAURUS_HEADER_BYTES || file_bytes.substr(0, 4) != "TXTH" ||
+        load_thesaurus_integer(file_start + 4) != FILE_FORMAT_VERSION) {
+        error_description = "'" + thesaurus_path + "' is not a thesaurus file of format version " + to_string(FILE_FORMAT_VERSION);
+        return false;
+    }
+    uint32_t stored_headword_count = load_thesaurus_integer(file_start + 8);
+    uint32_t stored_bucket_count = load_thesaurus_integer(file_start + 12);
+    uint64_t stored_record_bytes;
+    memcpy(&stored_record_bytes, file_start + 16, sizeof(stored_record_bytes));
+    if (stored_headword_count == 0 || stored_bucket_count == 0 || stored_record_bytes > file_bytes.size() ||
+        THESAURUS_HEADER_BYTES + 4 * (uint64_t(stored_bucket_count) + stored_headword_count) + stored_record_bytes !=
+            file_bytes.size()) {
+        error_description = "'" + thesaurus_path + "' is truncated or damaged";
+        return false;
+    }
+#if TEXT_ANALYSER_POSIX_MMAP
+    // Lookups land on scattered pages, where read-ahead only wastes I/O
+    madvise(const_cast<char*>(file_bytes.data()), file_bytes.size(), MADV_RANDOM);
+#endif
+
+    bucket_displacements = file_start + THESAURUS_HEADER_BYTES;
+    entry_offsets = bucket_displacements + 4 * size_t(stored_bucket_count);
+    entry_records = entry_offsets + 4 * size_t(stored_headword_count);
+    entry_record_bytes = stored_record_bytes;
+    bucket_count = stored_bucket_count;
+    headword_total = stored_headword_count;
+    return true;
+}
+
+size_t SynonymThesaurus::lookup_synonyms(string_view normalized_word, string_view* synonym_views,
+                                         size_t synonym_capacity) const {
+    if (headword_total == 0 || normalized_word.size() > THESAURUS_FIELD_LIMIT) {
+        return 0;
+    }
+    uint64_t word_hash = hash_word_bytes(normalized_word);
+    uint32_t bucket_index = thesaurus_bucket_index(word_hash, bucket_count);
+    uint32_t displacement = load_thesaurus_integer(bucket_displacements + 4 * size_t(bucket_index));
+    uint32_t headword_slot = (displacement & THESAURUS_DIRECT_SLOT_FLAG) != 0
+                                 ? displacement & ~THESAURUS_DIRECT_SLOT_FLAG
+                                 : thesaurus_displaced_slot(word_hash, displacement, headword_total);
+    if (headword_slot >= headword_total) {
+        return 0;
+    }
+
+    // Every word hashes to some slot, so the headword stored there must match
+    uint64_t record_offset = load_thesaurus_integer(entry_offsets + 4 * size_t(headword_slot));
+    if (record_offset + 2 + normalized_word.size() > entry_record_bytes) {
+        return 0;
+    }
+    const unsigned char* record_cursor = entry_records + record_offset;
+    const unsigned char* records_end = entry_records + entry_record_bytes;
+    if (record_cursor[0] != normalized_word.size() ||
+        memcmp(record_cursor + 1, normalized_word.data(), normalized_word.size()) != 0) {
+        return 0;
+    }
+    record_cursor += 1 + normalized_word.size();
+
+    size_t synonym_count = min<size_t>(*record_cursor++, synonym_capacity);
+    size_t stored_count = 0;
+    while (stored_count < synonym_count && record_cursor < records_end) {
+        size_t synonym_length = *record_cursor++;
+        if (synonym_length > static_cast<size_t>(records_end - record_cursor)) {
+            break;
+        }
+        synonym_views[stored_count++] = string_view(reinterpret_cast<const char*>(record_cursor), synonym_length);
+        record_cursor += synonym_length;
+    }
+    return stored_count;
+}
+
+namespace {
+
+/*
+ * One headword of the thesaurus sources with its synonyms in source order
+ */
+struct ThesaurusSourceEntry {
+    string headword;
+    vector<string> synonyms;
+};
+
+}  // namespace
+
+// Strip ASCII whitespace, including a CRLF line's carriage return, from both ends
+static inline string_view trim_ascii_whitespace(string_view source_field) {
+    while (!source_field.empty() && is_ascii_whitespace_byte(static_cast<unsigned char>(source_field.front()))) {
+        source_field.remove_prefix(1);
+    }
+    while (!source_field.empty() && is_ascii_whitespace_byte(static_cast<unsigned char>(source_field.back()))) {
+        source_field.remove_suffix(1);
+    }
+    return source_field;
+}
+
+/*
+ * Compile plain text synonym lists into a thesaurus file
+ * Each source line is a headword and its synonyms separated by commas, as
+ * in the Moby thesaurus; blank lines and lines starting with '#' are
+ * skipped. Headwords are normalized like passage words, and a headword
+ * that is not a single word is dropped since no passage word can match it;
+ * repeated headwords have their synonyms combined.
+ * The perfect hash is hash and displace: headwords are grouped into
+ * buckets of about four, and from the largest bucket down each bucket
+ * searches for a displacement that sends all its headwords to free slots.
+ * Buckets of one headword simply take the next free slot. The file is
+ * written through a temporary file and a rename, so a running program
+ * never maps a partial dictionary
+ */
+bool build_thesaurus_file(const vector<string>& source_paths, const string& thesaurus_path, string& error_description) {
+    vector<ThesaurusSourceEntry> source_entries;
+    unordered_map<string, size_t> entry_index_by_headword;
+    for (const string& source_path : source_paths) {
+        MappedTextFile source_file;
+        if (!source_file.open_document(source_path, false)) {
+            error_description = source_file.last_error();
+            return false;
+        }
+        string_view source_text = source_file.contents();
+        while (!source_text.empty()) {
+            size_t line_end = min(source_text.find('\n'), source_text.size());
+            string_view source_line = source_text.substr(0, line_end);
+            source_text.remove_prefix(min(line_end + 1, source_text.size()));
+
+            size_t field_end = min(source_line.find(','), source_line.size());
+            string_view headword_field = trim_ascii_whitespace(source_line.substr(0, field_end));
+            if (headword_field.empty() || headword_field[0] == '#') {
+                continue;
+            }
+            TokenizedPassage headword_words = extract_words_from_passage(headword_field);
+            if (headword_words.size() != 1 || headword_words[0].size() > THESAURUS_FIELD_LIMIT) {
+                continue;
+            }
+            auto [index_position, inserted] = entry_index_by_headword.try_emplace(string(headword_words[0]), source_entries.size());
+            if (inserted) {
+                source_entries.push_back({string(headword_words[0]), {}});
+            }
+
+            vector<string>& entry_synonyms = source_entries[index_position->second].synonyms;
+            while (field_end < source_line.size()) {
+                size_t next_field_end = min(source_line.find(',', field_end + 1), source_line.size());
+                string_view synonym = trim_ascii_whitespace(source_line.substr(field_end + 1, next_field_end - field_end - 1));
+                field_end = next_field_end;
+                if (!synonym.empty() && synonym.size() <= THESAURUS_FIELD_LIMIT &&
+                    entry_synonyms.size() < THESAURUS_FIELD_LIMIT) {
+                    entry_synonyms.emplace_back(synonym);
+                }
+            }
+        }
+    }
+    source_entries.erase(remove_if(source_entries.begin(), source_entries.end(),
+                                   [](const ThesaurusSourceEntry& source_entry) { return source_entry.synonyms.empty(); }),
+                         source_entries.end());
+    if (source_entries.empty()) {
+        error_description = "the thesaurus sources contain no headword with synonyms";
+        return false;
+    }
+    if (source_entries.size() >= THESAURUS_DIRECT_SLOT_FLAG) {
+        error_description = "the thesaurus sources contain too many headwords";
+        return false;
+    }
+
+    // Group the headwords into buckets by hash; equal hashes could never be told apart
+    uint32_t headword_count = static_cast<uint32_t>(source_entries.size());
+    uint32_t bucket_count =
+        static_cast<uint32_t>((headword_count + THESAURUS_HEADWORDS_PER_BUCKET - 1) / THESAURUS_HEADWORDS_PER_BUCKET);
+    vector<uint64_t> headword_hashes(headword_count);
+    vector<vector<uint32_t>> bucket_members(bucket_count);
+    for (uint32_t entry_index = 0; entry_index < headword_count; entry_index++) {
+        headword_hashes[entry_index] = hash_word_bytes(source_entries[entry_index].headword);
+        bucket_members[thesaurus_bucket_index(headword_hashes[entry_index], bucket_count)].push_back(entry_index);
+    }
+    vector<uint64_t> sorted_hashes = headword_hashes;
+    sort(sorted_hashes.begin(), sorted_hashes.end());
+    if (adjacent_find(sorted_hashes.begin(), sorted_hashes.end()) != sorted_hashes.end()) {
+        error_description = "two thesaurus headwords share a hash value";
+        return false;
+    }
+
+    // Place the largest buckets first, while free slots are plentiful
+    vector<uint32_t> bucket_order(bucket_count);
+    for (uint32_t bucket_index = 0; bucket_index < bucket_count; bucket_index++) {
+        bucket_order[bucket_index] = bucket_index;
+    }
+    stable_sort(bucket_order.begin(), bucket_order.end(), [&](uint32_t first_bucket, uint32_t second_bucket) {
+        return bucket_members[first_bucket].size() > bucket_members[second_bucket].size();
+    });
+    const uint32_t FREE_SLOT = UINT32_MAX;
+    vector<uint32_t> bucket_displacements(bucket_count, 0);
+    vector<uint32_t> entry_by_slot(headword_count, FREE_SLOT);
+    vector<uint32_t> candidate_slots;
+    uint32_t next_free_slot = 0;
+    for (uint32_t bucket_index : bucket_order) {
+        const vector<uint32_t>& members = bucket_members[bucket_index];
+        if (members.empty()) {
+            break;
+        }
+        if (members.size() == 1) {
+            while (entry_by_slot[next_free_slot] != FREE_SLOT) {
+                next_free_slot++;
+            }
+            entry_by_slot[next_free_slot] = members[0];
+            bucket_displacements[bucket_index] = THESAURUS_DIRECT_SLOT_FLAG | next_free_slot;
+            continue;
+        }
+
+        bool bucket_placed = false;
+        for (uint32_t displacement = 0; displacement < THESAURUS_DISPLACEMENT_SEARCH_LIMIT && !bucket_placed; displacement++) {
+            candidate_slots.clear();
+            bucket_placed = true;
+            for (uint32_t member_index : members) {
+                uint32_t candidate_slot = thesaurus_displaced_slot(headword_hashes[member_index], displacement, headword_count);
+                if (entry_by_slot[candidate_slot] != FREE_SLOT ||
+                    find(candidate_slots.begin(), candidate_slots.end(), candidate_slot) != candidate_slots.end()) {
+                    bucket_placed = false;
+                    break;
+                }
+                candidate_slots.push_back(candidate_slot);
+            }
+            if (bucket_placed) {
+                for (size_t member_position = 0; member_position < members.size(); member_position++) {
+                    entry_by_slot[candidate_slots[member_position]] = members[member_position];
+                }
+                bucket_displacements[bucket_index] = displacement;
+            }
+        }
+        if (!bucket_placed) {
+            error_description = "no perfect hash was found for the thesaurus headwords";
+            return false;
+        }
+    }
+
+    // Records are laid out in slot order
+    string entry_records;
+    vector<uint32_t> record_offsets(headword_count);
+    for (uint32_t headword_slot = 0; headword_slot < headword_count; headword_slot++) {
+        const ThesaurusSourceEntry& source_entry = source_entries[entry_by_slot[headword_slot]];
+        if (entry_records.size() > UINT32_MAX) {
+            error_description = "the thesaurus records exceed 4 GB";
+            return false;
+        }
+        record_offsets[headword_slot] = static_cast<uint32_t>(entry_records.size());
+        entry_records.push_back(static_cast<char>(source_entry.headword.size()));
+        entry_records.append(source_entry.headword);
+        entry_records.push_back(static_cast<char>(source_entry.synonyms.size()));
+        for (const string& synonym : source_entry.synonyms) {
+            entry_records.push_back(static_cast<char>(synonym.size()));
+            entry_records.append(synonym);
+        }
+    }
+
+    string file_bytes = "TXTH";
+    append_thesaurus_integer(file_bytes, SynonymThesaurus::FILE_FORMAT_VERSION);
+    append_thesaurus_integer(file_bytes, headword_count);
+    append_thesaurus_integer(file_bytes, bucket_count);
+    uint64_t record_byte_count = entry_records.size();
+    file_bytes.append(reinterpret_cast<const char*>(&record_byte_count), sizeof(record_byte_count));
+    for (uint32_t displacement : bucket_displacements) {
+        append_thesaurus_integer(file_bytes, displacement);
+    }
+    for (uint32_t record_offset : record_offsets) {
+        append_thesaurus_integer(file_bytes, record_offset);
+    }
+    file_bytes.append(entry_records);
+
+    string temporary_path = thesaurus_path + ".tmp";
+    FILE* thesaurus_output = fopen(temporary_path.c_str(), "wb");
+    if (thesaurus_output == nullptr) {
+        error_description = "cannot write '" + temporary_path + "': " + strerror(errno);
+        return false;
+    }
+    bool file_written = fwrite(file_bytes.data(), 1, file_bytes.size(), thesaurus_output) == file_bytes.size();
+    file_written = fclose(thesaurus_output) == 0 && file_written;
+    error_code rename_error;
+    if (file_written) {
+        filesystem::rename(temporary_path, thesaurus_path, rename_error);
+    }
+    if (!file_written || rename_error) {
+        error_description = "cannot write '" + thesaurus_path + "'";
+        filesystem::remove(temporary_path, rename_error);
+        return false;
+    }
+    return true;
+}
+
+/*
+ * Look up thesaurus alternatives for a passage's most frequent words
+ * Only single-word synonyms longer than the word are kept, since longer
+ * words are what the complexity score counts as more advanced; words the
+ * thesaurus offers nothing for are left out
+ */
+vector<VocabularySuggestion> suggest_word_alternatives(const vector<FrequentWord>& frequent_words,
+                                                       const SynonymThesaurus& synonym_thesaurus) {
+    vector<VocabularySuggestion> vocabulary_suggestions;
+    string_view synonym_views[THESAURUS_FIELD_LIMIT];
+    for (const FrequentWord& frequent_word : frequent_words) {
+        size_t synonym_count = synonym_thesaurus.lookup_synonyms(frequent_word.word, synonym_views, THESAURUS_FIELD_LIMIT);
+        VocabularySuggestion vocabulary_suggestion;
+        for (size_t synonym_index = 0;
+             synonym_index < synonym_count && vocabulary_suggestion.alternatives.size() < VocabularySuggestion::ALTERNATIVE_LIMIT;
+             synonym_index++) {
+            string_view synonym = synonym_views[synonym_index];
+            if (synonym.size() > frequent_word.word.size() && synonym.find(' ') == string_view::npos) {
+                vocabulary_suggestion.alternatives.emplace_back(synonym);
+            }
+        }
+        if (!vocabulary_suggestion.alternatives.empty()) {
+            vocabulary_suggestion.word = frequent_word.word;
+            vocabulary_suggestion.occurrence_count = frequent_word.occurrence_count;
+            vocabulary_suggestions.push_back(move(vocabulary_suggestion));
+        }
+    }
+    return vocabulary_suggestions;
+}
+
+/*
+ * Name of a style issue category as written in rule files and reports
+ */
+const char* style_issue_category_name(StyleIssueCategory style_issue_category) {
+    switch (style_issue_category) {
+    case StyleIssueCategory::Wordy:
+        return "wordy";
+    case StyleIssueCategory::Cliche:
+        return "cliche";
+    case StyleIssueCategory::Filler:
+        return "filler";
+    case StyleIssueCategory::Hedging:
+        return "hedging";
+    }
+    return "unknown";
+}
+
+namespace {
+
+/*
+ * Symbols the style automaton reads, one per passage byte
+ * Letters fold to lowercase. Digits, apostrophes and hyphens are word
+ * bytes, so "well-known" holds no match for "known"; bytes of multi-byte
+ * UTF-8 characters count as punctuation, so curly quotes and dashes
+ * separate words the way ASCII punctuation does
+ */
+enum StyleLintSymbol : uint8_t {
+    STYLE_SYMBOL_DIGIT = 26,
+    STYLE_SYMBOL_APOSTROPHE,
+    STYLE_SYMBOL_HYPHEN,
+    STYLE_SYMBOL_SPACE,
+    STYLE_SYMBOL_PUNCTUATION
+};
+
+}  // namespace
+
+constexpr array<uint8_t, 256> STYLE_LINT_BYTE_SYMBOLS = [] {
+    array<uint8_t, 256> byte_symbols{};
+    for (uint8_t& byte_symbol : byte_symbols) {
+        byte_symbol = STYLE_SYMBOL_PUNCTUATION;
+    }
+    for (unsigned letter_index = 0; letter_index < 26; letter_index++) {
+        byte_symbols['a' + letter_index] = static_cast<uint8_t>(letter_index);
+        byte_symbols['A' + letter_index] = static_cast<uint8_t>(letter_index);
+    }
+    for (unsigned char digit_byte = '0'; digit_byte <= '9'; digit_byte++) {
+        byte_symbols[digit_byte] = STYLE_SYMBOL_DIGIT;
+    }
+    byte_symbols['\''] = STYLE_SYMBOL_APOSTROPHE;
+    byte_symbols['-'] = STYLE_SYMBOL_HYPHEN;
+    for (unsigned char whitespace_byte : {' ', '\t', '\n', '\v', '\f', '\r'}) {
+        byte_symbols[whitespace_byte] = STYLE_SYMBOL_SPACE;
+    }
+    return byte_symbols;
+}();
+
+// Transitions into a state that ends a phrase carry this flag, so the scan tests one bit per byte
+const uint32_t STYLE_MATCH_TRANSITION_FLAG = 0x80000000u;
+const uint32_t STYLE_NO_RULE = 0xFFFFFFFFu;
+const size_t STYLE_RECOMMENDATION_LIMIT = 3;
+
+namespace {
+
+/*
+ * Built-in style rules
+ * Phrases are lowercase and match regardless of case; an empty
+ * suggestion means the phrase is better cut or reworded than replaced
+ */
+struct BuiltinStyleRule {
+    StyleIssueCategory category;
+    const char* phrase;
+    const char* suggestion;
+};
+
+}  // namespace
+
+constexpr BuiltinStyleRule BUILTIN_STYLE_RULES[] = {
+    {StyleIssueCategory::Wordy, "in order to", "to"},
+    {StyleIssueCategory::Wordy, "due to the fact that", "because"},
+    {StyleIssueCategory::Wordy, "owing to the fact that", "because"},
+    {StyleIssueCategory::Wordy, "in spite of the fact that", "although"},
+    {StyleIssueCategory::Wordy, "despite the fact that", "although"},
+    {StyleIssueCategory::Wordy, "at this point in time", "now"},
+    {StyleIssueCategory::Wordy, "at the present time", "now"},
+    {StyleIssueCategory::Wordy, "in the event that", "if"},
+    {StyleIssueCategory::Wordy, "for the purpose of", "for"},
+    {StyleIssueCategory::Wordy, "with regard to", "about"},
+    {StyleIssueCategory::Wordy, "with respect to", "about"},
+    {StyleIssueCategory::Wordy, "in relation to", "about"},
+    {StyleIssueCategory::Wordy, "a large number of", "many"},
+    {StyleIssueCategory::Wordy, "the majority of", "most"},
+    {StyleIssueCategory::Wordy, "in the near future", "soon"},
+    {StyleIssueCategory::Wordy, "on a daily basis", "daily"},
+    {StyleIssueCategory::Wordy, "on a regular basis", "regularly"},
+    {StyleIssueCategory::Wordy, "prior to", "before"},
+    {StyleIssueCategory::Wordy, "subsequent to", "after"},
+    {StyleIssueCategory::Wordy, "in close proximity to", "near"},
+    {StyleIssueCategory::Wordy, "has the ability to", "can"},
+    {StyleIssueCategory::Wordy, "is able to", "can"},
+    {StyleIssueCategory::Wordy, "make a decision", "decide"},
+    {StyleIssueCategory::Wordy, "come to a conclusion", "conclude"},
+    {StyleIssueCategory::Wordy, "take into consideration", "consider"},
+    {StyleIssueCategory::Wordy, "conduct an investigation", "investigate"},
+    {StyleIssueCategory::Wordy, "each and every", "each"},
+    {StyleIssueCategory::Wordy, "first and foremost", "first"},
+    {StyleIssueCategory::Wordy, "until such time as", "until"},
+    {StyleIssueCategory::Wordy, "in a timely manner", "promptly"},
+    {StyleIssueCategory::Wordy, "by means of", "by"},
+    {StyleIssueCategory::Wordy, "in the absence of", "without"},
+    {StyleIssueCategory::Wordy, "a sufficient number of", "enough"},
+    {StyleIssueCategory::Wordy, "at all times", "always"},
+    {StyleIssueCategory::Wordy, "it is important to note that", ""},
+    {StyleIssueCategory::Wordy, "in the process of", ""},
+    {StyleIssueCategory::Wordy, "the fact that", ""},
+    {StyleIssueCategory::Cliche, "at the end of the day", ""},
+    {StyleIssueCategory::Cliche, "think outside the box", ""},
+    {StyleIssueCategory::Cliche, "low-hanging fruit", ""},
+    {StyleIssueCategory::Cliche, "in this day and age", ""},
+    {StyleIssueCategory::Cliche, "last but not least", ""},
+    {StyleIssueCategory::Cliche, "only time will tell", ""},
+    {StyleIssueCategory::Cliche, "avoid it like the plague", ""},
+    {StyleIssueCategory::Cliche, "better late than never", ""},
+    {StyleIssueCategory::Cliche, "a blessing in disguise", ""},
+    {StyleIssueCategory::Cliche, "easier said than done", ""},
+    {StyleIssueCategory::Cliche, "needle in a haystack", ""},
+    {StyleIssueCategory::Cliche, "tip of the iceberg", ""},
+    {StyleIssueCategory::Cliche, "when all is said and done", ""},
+    {StyleIssueCategory::Cliche, "par for the course", ""},
+    {StyleIssueCategory::Cliche, "at the drop of a hat", ""},
+    {StyleIssueCategory::Cliche, "by leaps and bounds", ""},
+    {StyleIssueCategory::Cliche, "game changer", ""},
+    {StyleIssueCategory::Cliche, "paradigm shift", ""},
+    {StyleIssueCategory::Cliche, "win-win situation", ""},
+    {StyleIssueCategory::Filler, "basically", ""},
+    {StyleIssueCategory::Filler, "actually", ""},
+    {StyleIssueCategory::Filler, "literally", ""},
+    {StyleIssueCategory::Filler, "really", ""},
+    {StyleIssueCategory::Filler, "very", ""},
+    {StyleIssueCategory::Filler, "totally", ""},
+    {StyleIssueCategory::Filler, "essentially", ""},
+    {StyleIssueCategory::Filler, "needless to say", ""},
+    {StyleIssueCategory::Filler, "it goes without saying that", ""},
+    {StyleIssueCategory::Filler, "in terms of", ""},
+    {StyleIssueCategory::Filler, "kind of", ""},
+    {StyleIssueCategory::Filler, "sort of", ""},
+    {StyleIssueCategory::Filler, "for all intents and purposes", ""},
+    {StyleIssueCategory::Hedging, "i think", ""},
+    {StyleIssueCategory::Hedging, "i believe", ""},
+    {StyleIssueCategory::Hedging, "i feel that", ""},
+    {StyleIssueCategory::Hedging, "it seems that", ""},
+    {StyleIssueCategory::Hedging, "it appears that", ""},
+    {StyleIssueCategory::Hedging, "perhaps", ""},
+    {StyleIssueCategory::Hedging, "somewhat", ""},
+    {StyleIssueCategory::Hedging, "arguably", ""},
+    {StyleIssueCategory::Hedging, "to some extent", ""},
+    {StyleIssueCategory::Hedging, "in my opinion", ""},
+    {StyleIssueCategory::Hedging, "may or may not", ""},
+    {StyleIssueCategory::Hedging, "more or less", ""},
+    {StyleIssueCategory::Hedging, "it could be argued that", ""}};
+
+/*
+ * Parse a style issue category name as written in rule files
+ */
+static bool parse_style_issue_category(string_view category_name, StyleIssueCategory& style_issue_category) {
+    for (size_t category_index = 0; category_index < STYLE_ISSUE_CATEGORY_COUNT; category_index++) {
+        if (category_name == style_issue_category_name(static_cast<StyleIssueCategory>(category_index))) {
+            style_issue_category = static_cast<StyleIssueCategory>(category_index);
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * Turn a phrase into automaton symbols, lowercased with single spaces
+ * between its words; normalized_phrase receives the same text as bytes
+ */
+static bool convert_style_phrase(string_view phrase, string& normalized_phrase, string& phrase_symbols,
+                                 string& error_description) {
+    normalized_phrase.clear();
+    phrase_symbols.clear();
+    for (unsigned char phrase_byte : trim_ascii_whitespace(phrase)) {
+        uint8_t phrase_symbol = STYLE_LINT_BYTE_SYMBOLS[phrase_byte];
+        if (phrase_symbol == STYLE_SYMBOL_PUNCTUATION) {
+            error_description =
+                "style phrase '" + string(phrase) + "' may only hold ASCII letters, digits, apostrophes and hyphens";
+            return false;
+        }
+        if (phrase_symbol == STYLE_SYMBOL_SPACE && !phrase_symbols.empty() &&
+            phrase_symbols.back() == static_cast<char>(STYLE_SYMBOL_SPACE)) {
+            continue;
+        }
+        phrase_symbols.push_back(static_cast<char>(phrase_symbol));
+        normalized_phrase.push_back(phrase_symbol == STYLE_SYMBOL_SPACE ? ' '
+                                    : phrase_symbol < 26              ? static_cast<char>('a' + phrase_symbol)
+                                                                      : static_cast<char>(phrase_byte));
+    }
+    if (phrase_symbols.empty() || phrase_symbols.size() > StyleLinter::PHRASE_SYMBOL_LIMIT) {
+        error_description = "style phrase '" + string(phrase) + "' must hold between 1 and " +
+                            to_string(StyleLinter::PHRASE_SYMBOL_LIMIT) + " characters";
+        return false;
+    }
+    return true;
+}
+
+StyleLinter::StyleLinter(bool include_builtin_rules) {
+    if (include_builtin_rules) {
+        string error_description;
+        for (const BuiltinStyleRule& builtin_rule : BUILTIN_STYLE_RULES) {
+            insert_rule({builtin_rule.category, builtin_rule.phrase, builtin_rule.suggestion}, error_description);
+        }
+    }
+    build_automaton();
+}
+
+/*
+ * Add one rule, replacing the rule for the same phrase if there is one
+ * The automaton is not rebuilt; callers rebuild once after their last rule
+ */
+bool StyleLinter::insert_rule(const StyleRule& style_rule, string& error_description) {
+    string normalized_phrase;
+    string phrase_symbols;
+    if (!convert_style_phrase(style_rule.phrase, normalized_phrase, phrase_symbols, error_description)) {
+        return false;
+    }
+    auto [index_position, inserted] =
+        rule_index_by_phrase.try_emplace(normalized_phrase, static_cast<uint32_t>(style_rules.size()));
+    if (inserted) {
+        style_rules.push_back({style_rule.category, normalized_phrase, string(trim_ascii_whitespace(style_rule.suggestion))});
+        rule_phrase_symbols.push_back(move(phrase_symbols));
+    } else {
+        StyleRule& replaced_rule = style_rules[index_position->second];
+        replaced_rule.category = style_rule.category;
+        replaced_rule.suggestion = string(trim_ascii_whitespace(style_rule.suggestion));
+    }
+    return true;
+}
+
+bool StyleLinter::add_rule(const StyleRule& style_rule, string& error_description) {
+    if (!insert_rule(style_rule, error_description)) {
+        return false;
+    }
+    build_automaton();
+    return true;
+}
+
+/*
+ * Add the rules of a rule file
+ * Each line is "category|phrase|suggestion", the suggestion optional;
+ * blank lines and lines starting with '#' are skipped. A file with any
+ * malformed line adds none of its rules
+ */
+bool StyleLinter::load_rule_file(const string& rule_path, string& error_description) {
+    MappedTextFile rule_file;
+    if (!rule_file.open_document(rule_path, false)) {
+        error_description = rule_file.last_error();
+        return false;
+    }
+    vector<StyleRule> file_rules;
+    string_view rule_text = rule_file.contents();
+    for (size_t line_number = 1; !rule_text.empty(); line_number++) {
+        size_t line_end = min(rule_text.find('\n'), rule_text.size());
+        string_view rule_line = trim_ascii_whitespace(rule_text.substr(0, line_end));
+        rule_text.remove_prefix(min(line_end + 1, rule_text.size()));
+        if (rule_line.empty() || rule_line[0] == '#') {
+            continue;
+        }
+
+        size_t category_end = rule_line.find('|');
+        size_t phrase_end = category_end == string_view::npos ? string_view::npos : rule_line.find('|', category_end + 1);
+        StyleRule file_rule;
+        string_view category_field = trim_ascii_whitespace(rule_line.substr(0, category_end));
+        if (category_end == string_view::npos || !parse_style_issue_category(category_field, file_rule.category)) {
+            error_description = "'" + rule_path + "' line " + to_string(line_number) +
+                                ": expected wordy, cliche, filler or hedging before the first '|'";
+            return false;
+        }
+        file_rule.phrase = string(rule_line.substr(category_end + 1, phrase_end - category_end - 1));
+        if (phrase_end != string_view::npos) {
+            file_rule.suggestion = string(rule_line.substr(phrase_end + 1));
+        }
+        string normalized_phrase;
+        string phrase_symbols;
+        if (!convert_style_phrase(file_rule.phrase, normalized_phrase, phrase_symbols, error_description)) {
+            error_description = "'" + rule_path + "' line " + to_string(line_number) + ": " + error_description;
+            return false;
+        }
+        file_rules.push_back(move(file_rule));
+    }
+    for (const StyleRule& file_rule : file_rules) {
+        insert_rule(file_rule, error_description);
+    }
+    build_automaton();
+    return true;
+}
+
+/*
+ * Build the flattened automaton from the rules
+ * Every phrase is entered followed by each of the two boundary symbols,
+ * so a match ends on a word boundary; the boundary before it is checked
+ * when the match is found, which keeps one copy of each phrase in the
+ * table. Breadth-first order then fills in each missing transition from
+ * the state's failure link, turning the trie into a complete DFA, and
+ * links each state to the nearest state on its failure chain that ends a
+ * phrase, so overlapping phrases all report
+ */
+void StyleLinter::build_automaton() {
+    // Cached reports are reused only by a linter whose rules hash the same
+    string rule_set_text;
+    for (const StyleRule& style_rule : style_rules) {
+        rule_set_text.push_back(static_cast<char>(style_rule.category));
+        rule_set_text.append(style_rule.phrase).push_back('\0');
+        rule_set_text.append(style_rule.suggestion).push_back('\0');
+    }
+    PassageContentHash rule_set_hash = hash_passage_content(rule_set_text);
+    rule_fingerprint = rule_set_hash.low_bits ^ rule_set_hash.high_bits;
+
+    state_transitions.assign(SYMBOL_COUNT, 0);
+    state_rule_indices.assign(1, STYLE_NO_RULE);
+    for (uint32_t rule_index = 0; rule_index < style_rules.size(); rule_index++) {
+        auto follow_symbol = [&](uint32_t trie_state, uint8_t pattern_symbol) {
+            if (state_transitions[trie_state * SYMBOL_COUNT + pattern_symbol] == 0) {
+                state_transitions[trie_state * SYMBOL_COUNT + pattern_symbol] = static_cast<uint32_t>(state_rule_indices.size());
+                state_rule_indices.push_back(STYLE_NO_RULE);
+                state_transitions.resize(state_transitions.size() + SYMBOL_COUNT, 0);
+            }
+            return state_transitions[trie_state * SYMBOL_COUNT + pattern_symbol];
+        };
+        uint32_t phrase_state = 0;
+        for (char phrase_symbol : rule_phrase_symbols[rule_index]) {
+            phrase_state = follow_symbol(phrase_state, static_cast<uint8_t>(phrase_symbol));
+        }
+        for (uint8_t trailing_boundary : {STYLE_SYMBOL_SPACE, STYLE_SYMBOL_PUNCTUATION}) {
+            state_rule_indices[follow_symbol(phrase_state, trailing_boundary)] = rule_index;
+        }
+    }
+
+    // The root keeps its zero transitions; no trie edge ever leads back to it
+    vector<uint32_t> failure_links(state_rule_indices.size(), 0);
+    state_output_links.assign(state_rule_indices.size(), 0);
+    vector<uint32_t> breadth_first_states;
+    for (size_t symbol = 0; symbol < SYMBOL_COUNT; symbol++) {
+        if (state_transitions[symbol] != 0) {
+            breadth_first_states.push_back(state_transitions[symbol]);
+        }
+    }
+    for (size_t queue_index = 0; queue_index < breadth_first_states.size(); queue_index++) {
+        uint32_t parent_state = breadth_first_states[queue_index];
+        for (size_t symbol = 0; symbol < SYMBOL_COUNT; symbol++) {
+            uint32_t& next_state = state_transitions[parent_state * SYMBOL_COUNT + symbol];
+            uint32_t failure_target = state_transitions[failure_links[parent_state] * SYMBOL_COUNT + symbol];
+            if (next_state == 0) {
+                next_state = failure_target;
+                continue;
+            }
+            failure_links[next_state] = failure_target;
+            state_output_links[next_state] =
+                state_rule_indices[failure_target] != STYLE_NO_RULE ? failure_target : state_output_links[failure_target];
+            breadth_first_states.push_back(next_state);
+        }
+    }
+    for (uint32_t& transition : state_transitions) {
+        if (state_rule_indices[transition] != STYLE_NO_RULE || state_output_links[transition] != 0) {
+            transition |= STYLE_MATCH_TRANSITION_FLAG;
+        }
+    }
+}
+
+/*
+ * Find every rule phrase in a passage in one pass over its bytes
+ */
+StyleLintReport StyleLinter::lint_passage(string_view text_passage) const {
+    StyleLintScan passage_scan(*this);
+    passage_scan.scan_text_piece(text_passage);
+    return passage_scan.finish();
+}
+
+/*
+ * Start a scan as if a space preceded the passage
+ */
+StyleLintScan::StyleLintScan(const StyleLinter& style_linter)
+    : style_linter(style_linter), rule_match_counts(style_linter.style_rules.size(), 0) {
+    match_offset_ring[0] = 0;
+    match_symbol_ring[0] = STYLE_SYMBOL_SPACE;
+    automaton_state = style_linter.state_transitions[STYLE_SYMBOL_SPACE] & ~STYLE_MATCH_TRANSITION_FLAG;
+    previous_symbol = STYLE_SYMBOL_SPACE;
+}
+
+/*
+ * Advance the scan over the next piece of the passage
+ * A whitespace byte after another is skipped, so any run of whitespace
+ * reads as one space, even across pieces. A ring of the last symbols and
+ * their byte offsets gives each match's start and the symbol before it,
+ * since a phrase and its boundaries never exceed the ring
+ */
+void StyleLintScan::scan_text_piece(string_view text_piece) {
+    const uint32_t* state_rule_indices = style_linter.state_rule_indices.data();
+    const uint32_t* state_output_links = style_linter.state_output_links.data();
+    auto record_matches_ending_at = [&](uint32_t match_state, uint64_t symbol_index, uint64_t end_offset) {
+        if (state_rule_indices[match_state] == STYLE_NO_RULE) {
+            match_state = state_output_links[match_state];
+        }
+        for (; match_state != 0; match_state = state_output_links[match_state]) {
+            uint32_t rule_index = state_rule_indices[match_state];
+            uint64_t first_symbol_index = symbol_index - style_linter.rule_phrase_symbols[rule_index].size();
+            if (match_symbol_ring[(first_symbol_index - 1) % SYMBOL_RING_SIZE] < STYLE_SYMBOL_SPACE) {
+                continue;  // The phrase ends a longer word, as "very" ends "every"
+            }
+            rule_match_counts[rule_index]++;
+            if (rule_matches.size() < StyleLintReport::MATCH_RECORD_LIMIT) {
+                uint64_t start_offset = match_offset_ring[first_symbol_index % SYMBOL_RING_SIZE];
+                rule_matches.push_back({rule_index, start_offset, end_offset - start_offset});
+            }
+        }
+    };
+    // The scan state is passed by value, so the compiler keeps it in registers
+    const uint32_t* transition_table = style_linter.state_transitions.data();
+    auto advance_automaton = [&](uint32_t current_state, uint64_t symbol_index, uint8_t passage_symbol, uint64_t byte_offset) {
+        match_offset_ring[symbol_index % SYMBOL_RING_SIZE] = byte_offset;
+        match_symbol_ring[symbol_index % SYMBOL_RING_SIZE] = passage_symbol;
+        uint32_t transition = transition_table[current_state * StyleLinter::SYMBOL_COUNT + passage_symbol];
+        if ((transition & STYLE_MATCH_TRANSITION_FLAG) != 0) {
+            record_matches_ending_at(transition & ~STYLE_MATCH_TRANSITION_FLAG, symbol_index, byte_offset);
+        }
+        return transition & ~STYLE_MATCH_TRANSITION_FLAG;
+    };
+
+    uint32_t current_state = automaton_state;
+    uint64_t current_symbol_index = symbol_index;
+    uint8_t last_symbol = previous_symbol;
+    const unsigned char* piece_bytes = reinterpret_cast<const unsigned char*>(text_piece.data());
+    for (size_t byte_offset = 0; byte_offset < text_piece.size(); byte_offset++) {
+        uint8_t passage_symbol = STYLE_LINT_BYTE_SYMBOLS[piece_bytes[byte_offset]];
+        if (passage_symbol == STYLE_SYMBOL_SPACE && last_symbol == STYLE_SYMBOL_SPACE) {
+            continue;
+        }
+        last_symbol = passage_symbol;
+        current_state = advance_automaton(current_state, ++current_symbol_index, passage_symbol, scanned_byte_count + byte_offset);
+    }
+    automaton_state = current_state;
+    symbol_index = current_symbol_index;
+    previous_symbol = last_symbol;
+    scanned_byte_count += text_piece.size();
+}
+
+/*
+ * End the passage with a virtual space and number the findings most
+ * frequent first, pointing the recorded matches at them
+ */
+StyleLintReport StyleLintScan::finish() {
+    if (previous_symbol != STYLE_SYMBOL_SPACE) {
+        scan_text_piece(" ");
+        scanned_byte_count--;
+    }
+
+    const vector<StyleRule>& style_rules = style_linter.style_rules;
+    StyleLintReport style_report;
+    style_report.checked_rule_count = style_rules.size();
+    style_report.rule_set_fingerprint = style_linter.rule_set_fingerprint();
+    vector<uint32_t> matched_rule_indices;
+    for (uint32_t rule_index = 0; rule_index < style_rules.size(); rule_index++) {
+        if (rule_match_counts[rule_index] > 0) {
+            matched_rule_indices.push_back(rule_index);
+        }
+    }
+    stable_sort(matched_rule_indices.begin(), matched_rule_indices.end(), [&](uint32_t left_rule, uint32_t right_rule) {
+        return rule_match_counts[left_rule] > rule_match_counts[right_rule];
+    });
+    vector<uint32_t> finding_index_by_rule(style_rules.size(), 0);
+    for (uint32_t rule_index : matched_rule_indices) {
+        finding_index_by_rule[rule_index] = static_cast<uint32_t>(style_report.findings.size());
+        style_report.findings.push_back({style_rules[rule_index], rule_match_counts[rule_index]});
+        style_report.total_match_count += rule_match_counts[rule_index];
+        style_report.category_match_counts[static_cast<size_t>(style_rules[rule_index].category)] += rule_match_counts[rule_index];
+    }
+    for (StyleMatch& rule_match : rule_matches) {
+        rule_match.finding_index = finding_index_by_rule[rule_match.finding_index];
+    }
+    style_report.matches = move(rule_matches);
+    return style_report;
+}
+
+/*
+ * One recommendation line for a style finding
+ */
+static string describe_style_finding(const StyleFinding& style_finding) {
+    const StyleRule& style_rule = style_finding.style_rule;
+    string finding_description;
+    if (!style_rule.suggestion.empty()) {
+        finding_description = "Replace '" + style_rule.phrase + "' with '" + style_rule.suggestion + "'";
+    } else if (style_rule.category == StyleIssueCategory::Wordy) {
+        finding_description = "Cut or shorten '" + style_rule.phrase + "'";
+    } else if (style_rule.category == StyleIssueCategory::Cliche) {
+        finding_description = "Say plainly what the cliché '" + style_rule.phrase + "' stands for";
+    } else if (style_rule.category == StyleIssueCategory::Filler) {
+        finding_description = "Cut the filler '" + style_rule.phrase + "'";
+    } else {
+        finding_description = "Drop the hedge '" + style_rule.phrase + "' and state the point directly";
+    }
+    finding_description += " (" + to_string(style_finding.match_count) +
+                           (style_finding.match_count == 1 ? " occurrence)" : " occurrences)");
+    return finding_description;
+}
+
+/*
+ * This function generates specific vocabulary enhancement suggestions
+ * The implementation provides actionable recommendations for word choice improvement
+ * Enhancement strategies follow professional writing development principles
+ */
+PassageAnalysisAccumulator suggest_vocabulary_enhancements(const InternedTokenStream& word_collection) {
+    // Classify each distinct word once, by word-class membership and length
+    const InternedVocabulary& vocabulary = word_collection.vocabulary;
+    vector<VocabularyWordClass> word_classes_by_id(vocabulary.size());
+    for (uint32_t word_id = 0; word_id < vocabulary.size(); word_id++) {
+        word_classes_by_id[word_id] = classify_vocabulary_word(vocabulary.word(word_id), vocabulary.character_count(word_id));
+    }
+
+    // Categorize vocabulary elements by complexity level
+    PassageAnalysisAccumulator passage_metrics;
+    for (uint32_t word_id : word_collection.word_ids) {
+        VocabularyWordClass word_class = word_classes_by_id[word_id];
+        passage_metrics.basic_vocabulary_count += word_class == VocabularyWordClass::Basic;
+        passage_metrics.advanced_vocabulary_count += word_class == VocabularyWordClass::Advanced;
+        passage_metrics.record_vocabulary_example(word_collection.vocabulary.word(word_id), word_class);
+    }
+    
+    // Rank the most frequent words of each class from the interned counts
+    vector<uint64_t> frequency_by_id = word_collection.word_frequencies();
+    vector<FrequentWordCandidate> basic_word_candidates;
+    vector<FrequentWordCandidate> advanced_word_candidates;
+    for (uint32_t word_id = 0; word_id < frequency_by_id.size(); word_id++) {
+        if (word_classes_by_id[word_id] == VocabularyWordClass::Basic) {
+            basic_word_candidates.push_back({word_collection.vocabulary.word(word_id), frequency_by_id[word_id]});
+        } else if (word_classes_by_id[word_id] == VocabularyWordClass::Advanced) {
+            advanced_word_candidates.push_back({word_collection.vocabulary.word(word_id), frequency_by_id[word_id]});
+        }
+    }
+    passage_metrics.distinct_word_count = word_collection.vocabulary.size();
+    select_most_frequent_words(basic_word_candidates, passage_metrics.frequent_basic_words);
+    select_most_frequent_words(advanced_word_candidates, passage_metrics.frequent_advanced_words);
+    
+    return passage_metrics;
+}
+
+/*
+ * This function generates specific passage improvement recommendations
+ * The system provides actionable guidance based on comprehensive text analysis
+ * Educational recommendations follow pedagogical best practices for writing development
+ */
+PassageImprovementRecommendations generate_passage_improvement_recommendations(
+    uint64_t passage_length, double complexity_score, const vector<VocabularySuggestion>& vocabulary_suggestions,
+    const StyleLintReport& style_report) {
+    PassageImprovementRecommendations improvement_recommendations;
+    
+    // Generate complexity-based improvement strategies
+    if (complexity_score < 3.0) {
+        improvement_recommendations.proficiency_assessment = "Basic writing proficiency detected in passage";
+        improvement_recommendations.primary_recommendation = "Incorporate more sophisticated vocabulary";
+        improvement_recommendations.specific_strategy = "Replace simple words with professional alternatives";
+        if (vocabulary_suggestions.empty()) {
+            improvement_recommendations.example_enhancement = "'use' → 'utilize', 'help' → 'facilitate'";
+        }
+        // Words from the passage itself make the best examples
+        for (size_t suggestion_index = 0; suggestion_index < min<size_t>(2, vocabulary_suggestions.size()); suggestion_index++) {
+            const VocabularySuggestion& vocabulary_suggestion = vocabulary_suggestions[suggestion_index];
+            improvement_recommendations.example_enhancement += suggestion_index > 0 ? ", '" : "'";
+            improvement_recommendations.example_enhancement +=
+                vocabulary_suggestion.word + "' → '" + vocabulary_suggestion.alternatives[0] + "'";
+        }
+    } else if (complexity_score < 6.0) {
+        improvement_recommendations.proficiency_assessment = "Intermediate writing proficiency demonstrated";
+        improvement_recommendations.primary_recommendation = "Enhance sentence structure complexity";
+        improvement_recommendations.specific_strategy = "Combine shorter sentences using advanced conjunctions";
+        improvement_recommendations.example_enhancement = "Add transitional phrases and subordinate clauses";
+    } else {
+        improvement_recommendations.proficiency_assessment = "Advanced writing proficiency achieved";
+        improvement_recommendations.primary_recommendation = "Maintain sophisticated language patterns";
+        improvement_recommendations.specific_strategy = "Focus on precision and contextual appropriateness";
+        improvement_recommendations.example_enhancement = "Refine word choice for maximum impact";
+    }
+    
+    // Provide length-based structural recommendations
+    if (passage_length < 200) {
+        improvement_recommendations.structural_recommendations[0] = "Expand passage length for comprehensive topic coverage";
+        improvement_recommendations.structural_recommendations[1] = "Add supporting details and explanatory content";
+    } else if (passage_length > 500) {
+        improvement_recommendations.structural_recommendations[0] = "Consider paragraph breaks for improved readability";
+        improvement_recommendations.structural_recommendations[1] = "Ensure concise expression without redundancy";
+    } else {
+        improvement_recommendations.structural_recommendations[0] = "Maintain current passage length for optimal readability";
+        improvement_recommendations.structural_recommendations[1] = "Focus on content quality and coherence";
+    }
+    
+    // The most frequent style findings are the cheapest edits to make
+    for (size_t finding_index = 0; finding_index < min(STYLE_RECOMMENDATION_LIMIT, style_report.findings.size()); finding_index++) {
+        improvement_recommendations.style_recommendations.push_back(describe_style_finding(style_report.findings[finding_index]));
+    }
+    
+    return improvement_recommendations;
+}
+
+/*
+ * Name of the band a complexity score falls into, matching the thresholds
+ * used for the improvement recommendations
+ */
+const char* complexity_band_name(double complexity_score) {
+    if (complexity_score < 3.0) {
+        return "basic";
+    } else if (complexity_score < 6.0) {
+        return "intermediate";
+    }
+    return "advanced";
+}
+
+/*
+ * Derive every reported figure from a passage's accumulated metrics
+ * The recommendations are chosen exactly as the text report chooses them;
+ * an open thesaurus adds alternatives for the most frequent basic words,
+ * and a style report adds its most frequent findings
+ */
+AnalysisResult build_analysis_result(PassageAnalysisAccumulator passage_metrics, const SynonymThesaurus* synonym_thesaurus,
+                                     StyleLintReport style_report) {
+    AnalysisResult analysis_result;
+    analysis_result.contains_words = passage_metrics.total_word_count > 0;
+    analysis_result.average_word_length = passage_metrics.average_word_length();
+    analysis_result.advanced_vocabulary_percentage = passage_metrics.advanced_vocabulary_percentage();
+    analysis_result.average_sentence_length = passage_metrics.average_sentence_length();
+    analysis_result.complexity_score = passage_metrics.complexity_score();
+    analysis_result.complexity_band =
+        analysis_result.contains_words ? complexity_band_name(analysis_result.complexity_score) : "";
+    analysis_result.flesch_reading_ease = passage_metrics.flesch_reading_ease();
+    analysis_result.flesch_kincaid_grade = passage_metrics.flesch_kincaid_grade();
+    analysis_result.gunning_fog_index = passage_metrics.gunning_fog_index();
+    analysis_result.smog_index = passage_metrics.smog_index();
+    analysis_result.coleman_liau_index = passage_metrics.coleman_liau_index();
+    if (synonym_thesaurus != nullptr && synonym_thesaurus->is_open()) {
+        analysis_result.vocabulary_suggestions = suggest_word_alternatives(passage_metrics.frequent_basic_words, *synonym_thesaurus);
+    }
+    analysis_result.improvement_recommendations = generate_passage_improvement_recommendations(
+        passage_metrics.passage_length, analysis_result.complexity_score, analysis_result.vocabulary_suggestions, style_report);
+    analysis_result.passage_metrics = move(passage_metrics);
+    analysis_result.style_report = move(style_report);
+    return analysis_result;
+}
+
+/*
+ * Analyze a passage in-process and return its complete result
+ * One thread by default, since an embedding service usually runs its own
+ * workers; zero uses every hardware thread. A cache, when given, answers
+ * repeated passages and stores new results, a thesaurus supplies the
+ * vocabulary suggestions and a style linter the style findings. Cached
+ * style findings are reused only when they were made under the linter's
+ * current rules
+ */
+AnalysisResult analyze_text_passage(string_view text_passage, unsigned analysis_thread_count, AnalysisResultCache* result_cache,
+                                    const SynonymThesaurus* synonym_thesaurus, const StyleLinter* style_linter) {
+    StyleLintReport style_report;
+    PassageAnalysisAccumulator passage_metrics =
+        analyze_passage_through_cache(text_passage, result_cache, analysis_thread_count, style_linter, &style_report);
+    return build_analysis_result(move(passage_metrics), synonym_thesaurus, move(style_report));
+}
+
+/*
+ * Parse an output format name as typed by the user
+ */
+bool parse_report_output_format(string_view format_name, ReportOutputFormat& output_format) {
+    if (format_name == "text") {
+        output_format = ReportOutputFormat::Text;
+    } else if (format_name == "json") {
+        output_format = ReportOutputFormat::JSON;
+    } else if (format_name == "ndjson") {
+        output_format = ReportOutputFormat::NDJSON;
+    } else if (format_name == "csv") {
+        output_format = ReportOutputFormat::CSV;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+StructuredRecordSerializer::StructuredRecordSerializer(string& output_buffer, ReportOutputFormat output_format,
+                                                       bool emit_csv_header)
+    : output_buffer(output_buffer), output_format(output_format), emit_csv_header(emit_csv_header) {}
+
+void StructuredRecordSerializer::begin_record() {
+    if (output_format != ReportOutputFormat::CSV) {
+        output_buffer.push_back('{');
+    }
+    first_field = true;
+}
+
+void StructuredRecordSerializer::end_record() {
+    if (output_format != ReportOutputFormat::CSV) {
+        output_buffer.push_back('}');
+    }
+    first_field = false;
+}
+
+void StructuredRecordSerializer::field_unsigned(const char* field_name, uint64_t field_value, bool value_present) {
+    if (!field_selected(field_name)) {
+        return;
+    }
+    begin_field(field_name);
+    if (emit_csv_header) {
+        return;
+    }
+    if (!value_present) {
+        append_missing_value();
+        return;
+    }
+    char digits[24];
+    to_chars_result conversion = to_chars(digits, digits + sizeof(digits), field_value);
+    output_buffer.append(digits, conversion.ptr);
+}
+
+void StructuredRecordSerializer::field_decimal(const char* field_name, double field_value, bool value_present) {
+    if (!field_selected(field_name)) {
+        return;
+    }
+    begin_field(field_name);
+    if (emit_csv_header) {
+        return;
+    }
+    if (!value_present || !isfinite(field_value)) {
+        append_missing_value();
+        return;
+    }
+    // Shortest representation that reads back to the same double
+    char digits[32];
+    to_chars_result conversion = to_chars(digits, digits + sizeof(digits), field_value);
+    output_buffer.append(digits, conversion.ptr);
+}
+
+void StructuredRecordSerializer::field_boolean(const char* field_name, bool field_value, bool value_present) {
+    if (!field_selected(field_name)) {
+        return;
+    }
+    begin_field(field_name);
+    if (emit_csv_header) {
+        return;
+    }
+    if (!value_present) {
+        append_missing_value();
+        return;
+    }
+    output_buffer.append(field_value ? "true" : "false");
+}
+
+void StructuredRecordSerializer::field_text(const char* field_name, string_view field_value, bool value_present) {
+    if (!field_selected(field_name)) {
+        return;
+    }
+    begin_field(field_name);
+    if (emit_csv_header) {
+        return;
+    }
+    if (!value_present) {
+        append_missing_value();
+    } else if (output_format == ReportOutputFormat::CSV) {
+        append_csv_text(field_value);
+    } else {
+        append_json_text(field_value);
+    }
+}
+
+bool StructuredRecordSerializer::field_selected(const char* field_name) const {
+    return selected_field_names == nullptr ||
+           find(selected_field_names->begin(), selected_field_names->end(), field_name) != selected_field_names->end();
+}
+
+void StructuredRecordSerializer::begin_field(const char* field_name) {
+    if (!first_field) {
+        output_buffer.push_back(',');
+    }
+    first_field = false;
+
+    if (output_format == ReportOutputFormat::CSV) {
+        if (emit_csv_header) {
+            output_buffer.append(field_name);
+        }
+        return;
+    }
+    output_buffer.push_back('"');
+    output_buffer.append(field_name);
+    output_buffer.append("\":");
+}
+
+void StructuredRecordSerializer::append_missing_value() {
+    // CSV leaves the cell empty; JSON has no NaN, so absent values are null
+    if (output_format != ReportOutputFormat::CSV) {
+        output_buffer.append("null");
+    }
+}
+
+void StructuredRecordSerializer::append_json_text(string_view field_value) {
+    static const char HEXADECIMAL_DIGITS[] = "0123456789abcdef";
+    output_buffer.push_back('"');
+    for (char character : field_value) {
+        unsigned char byte_value = static_cast<unsigned char>(character);
+        if (character == '"' || character == '\\') {
+            output_buffer.push_back('\\');
+            output_buffer.push_back(character);
+        } else if (byte_value < 0x20) {
+            output_buffer.append("\\u00");
+            output_buffer.push_back(HEXADECIMAL_DIGITS[byte_value >> 4]);
+            output_buffer.push_back(HEXADECIMAL_DIGITS[byte_value & 0x0F]);
+        } else {
+            output_buffer.push_back(character);
+        }
+    }
+    output_buffer.push_back('"');
+}
+
+void StructuredRecordSerializer::append_csv_text(string_view field_value) {
+    if (field_value.find_first_of(",\"\r\n") == string_view::npos) {
+        output_buffer.append(field_value);
+        return;
+    }
+    output_buffer.push_back('"');
+    for (char character : field_value) {
+        if (character == '"') {
+            output_buffer.push_back('"');
+        }
+        output_buffer.push_back(character);
+    }
+    output_buffer.push_back('"');
+}
+
+/*
+ * Write a most-frequent list as space separated word:count pairs
+ */
+static void format_frequent_word_list(const vector<FrequentWord>& frequent_words, string& formatted_list) {
+    formatted_list.clear();
+    char count_digits[24];
+    for (const FrequentWord& frequent_word : frequent_words) {
+        if (!formatted_list.empty()) {
+            formatted_list.push_back(' ');
+        }
+        formatted_list.append(frequent_word.word);
+        formatted_list.push_back(':');
+        char* digits_end = to_chars(count_digits, count_digits + sizeof(count_digits), frequent_word.occurrence_count).ptr;
+        formatted_list.append(count_digits, digits_end);
+    }
+}
+
+/*
+ * Serialize every reported passage metric as fields of the current record
+ * Metrics that are undefined for a passage without words are left empty,
+ * and a missing accumulator (a skipped document) leaves every field empty
+ */
+static void serialize_passage_metric_fields(StructuredRecordSerializer& record_serializer,
+                                            const PassageAnalysisAccumulator* passage_metrics) {
+    static const PassageAnalysisAccumulator EMPTY_PASSAGE_METRICS;
+    bool metrics_present = passage_metrics != nullptr;
+    bool words_present = metrics_present && passage_metrics->total_word_count > 0;
+    const PassageAnalysisAccumulator& metrics = metrics_present ? *passage_metrics : EMPTY_PASSAGE_METRICS;
+    double complexity_score = words_present ? metrics.complexity_score() : 0.0;
+
+    record_serializer.field_unsigned("total_words", metrics.total_word_count, metrics_present);
+    record_serializer.field_unsigned("total_characters", metrics.total_character_count, metrics_present);
+    record_serializer.field_decimal("average_word_length", words_present ? metrics.average_word_length() : 0.0, words_present);
+    record_serializer.field_unsigned("minimum_word_length", metrics.minimum_word_length, words_present);
+    record_serializer.field_unsigned("maximum_word_length", metrics.maximum_word_length, words_present);
+    record_serializer.field_decimal("advanced_vocabulary_ratio", words_present ? metrics.advanced_vocabulary_percentage() : 0.0,
+                                    words_present);
+    record_serializer.field_unsigned("basic_vocabulary_count", metrics.basic_vocabulary_count, metrics_present);
+    record_serializer.field_unsigned("advanced_vocabulary_count", metrics.advanced_vocabulary_count, metrics_present);
+    record_serializer.field_unsigned("distinct_words", metrics.distinct_word_count, metrics_present);
+    record_serializer.field_decimal("type_token_ratio", words_present ? metrics.type_token_ratio() : 0.0, words_present);
+    // Reused across records so the lists allocate only while the buffer grows
+    static thread_local string formatted_word_list;
+    format_frequent_word_list(metrics.frequent_basic_words, formatted_word_list);
+    record_serializer.field_text("frequent_basic_words", formatted_word_list, metrics_present);
+    format_frequent_word_list(metrics.frequent_advanced_words, formatted_word_list);
+    record_serializer.field_text("frequent_advanced_words", formatted_word_list, metrics_present);
+    record_serializer.field_boolean("vocabulary_estimated", metrics.vocabulary_estimated, metrics_present);
+    record_serializer.field_unsigned("sentence_count", metrics.sentence_count, metrics_present);
+    record_serializer.field_decimal("average_sentence_length", metrics.average_sentence_length(), metrics_present);
+    bool sentences_present = metrics_present && metrics.sentence_count > 0;
+    const SentenceLengthDistribution& word_lengths = metrics.sentence_word_lengths;
+    const SentenceLengthDistribution& character_lengths = metrics.sentence_character_lengths;
+    record_serializer.field_decimal("sentence_word_mean", sentences_present ? word_lengths.mean() : 0.0, sentences_present);
+    record_serializer.field_decimal("sentence_word_stddev", sentences_present ? word_lengths.standard_deviation() : 0.0,
+                                    sentences_present);
+    record_serializer.field_unsigned("sentence_word_median", word_lengths.percentile(0.5), sentences_present);
+    record_serializer.field_unsigned("sentence_word_p90", word_lengths.percentile(0.9), sentences_present);
+    record_serializer.field_unsigned("sentence_word_max", word_lengths.longest_length, sentences_present);
+    record_serializer.field_decimal("sentence_character_mean", sentences_present ? character_lengths.mean() : 0.0,
+                                    sentences_present);
+    record_serializer.field_decimal("sentence_character_stddev",
+                                    sentences_present ? character_lengths.standard_deviation() : 0.0, sentences_present);
+    record_serializer.field_unsigned("sentence_character_median", character_lengths.percentile(0.5), sentences_present);
+    record_serializer.field_unsigned("sentence_character_p90", character_lengths.percentile(0.9), sentences_present);
+    record_serializer.field_unsigned("sentence_character_max", character_lengths.longest_length, sentences_present);
+    record_serializer.field_unsigned("comma_count", metrics.comma_count, metrics_present);
+    record_serializer.field_unsigned("semicolon_count", metrics.semicolon_count, metrics_present);
+    record_serializer.field_decimal("complexity_score", complexity_score, words_present);
+    record_serializer.field_text("complexity_band", complexity_band_name(complexity_score), words_present);
+    record_serializer.field_unsigned("syllable_count", metrics.syllable_count, metrics_present);
+    record_serializer.field_unsigned("polysyllabic_word_count", metrics.polysyllabic_word_count, metrics_present);
+    record_serializer.field_decimal("flesch_reading_ease", words_present ? metrics.flesch_reading_ease() : 0.0, words_present);
+    record_serializer.field_decimal("flesch_kincaid_grade", words_present ? metrics.flesch_kincaid_grade() : 0.0, words_present);
+    record_serializer.field_decimal("gunning_fog_index", words_present ? metrics.gunning_fog_index() : 0.0, words_present);
+    record_serializer.field_decimal("smog_index", words_present ? metrics.smog_index() : 0.0, words_present);
+    record_serializer.field_decimal("coleman_liau_index", words_present ? metrics.coleman_liau_index() : 0.0, words_present);
+}
+
+/*
+ * Write style findings as phrase:count pairs separated by semicolons,
+ * since the phrases themselves may contain spaces
+ */
+static void format_style_finding_list(const vector<StyleFinding>& style_findings, string& formatted_list) {
+    formatted_list.clear();
+    char count_digits[24];
+    for (const StyleFinding& style_finding : style_findings) {
+        if (!formatted_list.empty()) {
+            formatted_list.push_back(';');
+        }
+        formatted_list.append(style_finding.style_rule.phrase);
+        formatted_list.push_back(':');
+        char* digits_end = to_chars(count_digits, count_digits + sizeof(count_digits), style_finding.match_count).ptr;
+        formatted_list.append(count_digits, digits_end);
+    }
+}
+
+/*
+ * Serialize a document's style findings: the total, one count per
+ * category and the findings most frequent first. Every field is left
+ * empty when the document was not linted
+ */
+static void serialize_style_finding_fields(StructuredRecordSerializer& record_serializer, const StyleLintReport* style_report) {
+    static const StyleLintReport UNCHECKED_STYLE_REPORT;
+    static const char* const CATEGORY_FIELD_NAMES[STYLE_ISSUE_CATEGORY_COUNT] = {"style_wordy_count", "style_cliche_count",
+                                                                                "style_filler_count", "style_hedging_count"};
+    bool style_checked = style_report != nullptr && style_report->checked_rule_count > 0;
+    const StyleLintReport& report = style_checked ? *style_report : UNCHECKED_STYLE_REPORT;
+
+    record_serializer.field_unsigned("style_match_count", report.total_match_count, style_checked);
+    for (size_t category_index = 0; category_index < STYLE_ISSUE_CATEGORY_COUNT; category_index++) {
+        record_serializer.field_unsigned(CATEGORY_FIELD_NAMES[category_index], report.category_match_counts[category_index],
+                                         style_checked);
+    }
+    static thread_local string formatted_finding_list;
+    format_style_finding_list(report.findings, formatted_finding_list);
+    record_serializer.field_text("style_findings", formatted_finding_list, style_checked);
+}
+
+/*
+ * Serialize one document as a flat record: identity, status, metrics,
+ * then style findings
+ */
+static void serialize_document_record(StructuredRecordSerializer& record_serializer,
+                                      const DocumentAnalysisResult& document_result) {
+    record_serializer.begin_record();
+    record_serializer.field_text("document", document_result.document_path);
+    record_serializer.field_unsigned("bytes", document_result.document_bytes);
+    record_serializer.field_boolean("analyzed", document_result.analysis_succeeded);
+    record_serializer.field_text("error", document_result.error_description, !document_result.analysis_succeeded);
+    serialize_passage_metric_fields(record_serializer,
+                                    document_result.analysis_succeeded ? &document_result.passage_metrics : nullptr);
+    serialize_style_finding_fields(record_serializer,
+                                   document_result.analysis_succeeded ? &document_result.style_report : nullptr);
+    record_serializer.end_record();
+}
+
+/*
+ * This function appends document records in a machine-readable format
+ * JSON wraps the records in a documents array followed by a corpus
+ * summary and, on request, the pipeline statistics gathered so far.
+ * NDJSON writes one record per line and CSV adds a header row.
+ * A metric selection keeps only those fields plus the document identity
+ */
+void render_structured_document_report(string& output_buffer, ReportOutputFormat output_format,
+                                       const vector<DocumentAnalysisResult>& document_results, double elapsed_seconds,
+                                       const vector<string>& selected_metrics, bool include_pipeline_statistics) {
+    TEXT_ANALYSER_STAGE_SCOPE(rendering_stage, PipelineStage::Rendering);
+    vector<string> selected_field_names;
+    if (!selected_metrics.empty()) {
+        selected_field_names = {"document", "analyzed"};
+        selected_field_names.insert(selected_field_names.end(), selected_metrics.begin(), selected_metrics.end());
+    }
+    const vector<string>* field_selection = selected_metrics.empty() ? nullptr : &selected_field_names;
+
+    StructuredRecordSerializer record_serializer(output_buffer, output_format);
+    record_serializer.select_fields(field_selection);
+
+    if (output_format == ReportOutputFormat::CSV) {
+        StructuredRecordSerializer header_serializer(output_buffer, output_format, true);
+        header_serializer.select_fields(field_selection);
+        serialize_document_record(header_serializer, DocumentAnalysisResult());
+        output_buffer.push_back('\n');
+        for (const DocumentAnalysisResult& document_result : document_results) {
+            serialize_document_record(record_serializer, document_result);
+            output_buffer.push_back('\n');
+        }
+        return;
+    }
+
+    if (output_format == ReportOutputFormat::NDJSON) {
+        for (const DocumentAnalysisResult& document_result : document_results) {
+            serialize_document_record(record_serializer, document_result);
+            output_buffer.push_back('\n');
+        }
+        return;
+    }
+
+    uint64_t analyzed_document_count = 0;
+    uint64_t corpus_bytes = 0;
+    uint64_t corpus_words = 0;
+    uint64_t corpus_sentences = 0;
+    output_buffer.append("{\"documents\":[");
+    for (size_t document_index = 0; document_index < document_results.size(); document_index++) {
+        const DocumentAnalysisResult& document_result = document_results[document_index];
+        if (document_index > 0) {
+            output_buffer.push_back(',');
+        }
+        serialize_document_record(record_serializer, document_result);
+        if (document_result.analysis_succeeded) {
+            analyzed_document_count++;
+            corpus_bytes += document_result.document_bytes;
+            corpus_words += document_result.passage_metrics.total_word_count;
+            corpus_sentences += document_result.passage_metrics.sentence_count;
+        }
+    }
+    output_buffer.append("],\"summary\":");
+
+    StructuredRecordSerializer summary_serializer(output_buffer, output_format);
+    summary_serializer.begin_record();
+    summary_serializer.field_unsigned("documents", document_results.size());
+    summary_serializer.field_unsigned("documents_analyzed", analyzed_document_count);
+    summary_serializer.field_unsigned("total_bytes", corpus_bytes);
+    summary_serializer.field_unsigned("total_words", corpus_words);
+    summary_serializer.field_unsigned("total_sentences", corpus_sentences);
+    summary_serializer.field_decimal("elapsed_seconds", elapsed_seconds);
+    summary_serializer.end_record();
+#if TEXT_ANALYSER_INSTRUMENTATION
+    if (include_pipeline_statistics) {
+        output_buffer.append(",\"pipeline_statistics\":");
+        serialize_pipeline_statistics(output_buffer);
+    }
+#else
+    (void)include_pipeline_statistics;
+#endif
+    output_buffer.append("}\n");
+}
+
+/*
+ * Names of every field a structured document record can contain
+ * Taken from the CSV header so the list always matches the serializer
+ */
+vector<string> structured_report_field_names() {
+    string header_text;
+    StructuredRecordSerializer header_serializer(header_text, ReportOutputFormat::CSV, true);
+    serialize_document_record(header_serializer, DocumentAnalysisResult());
+
+    vector<string> field_names;
+    size_t field_start = 0;
+    while (field_start <= header_text.size()) {
+        size_t field_end = header_text.find(',', field_start);
+        if (field_end == string::npos) {
+            field_end = header_text.size();
+        }
+        field_names.emplace_back(header_text, field_start, field_end - field_start);
+        field_start = field_end + 1;
+    }
+    return field_names;
+}
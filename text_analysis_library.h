@@ -0,0 +1,1194 @@
+/*
+ * Text analysis library
+ * Code hints and optimizations by artlest
+ *
+ * Every analysis engine of the passage analysis tool, for programs that
+ * analyze text in-process. Results come back as plain structs and nothing
+ * in the library writes to the console; the interactive and command-line
+ * program in "WRITING HELPER AND ANALYSER BY ARTLEST.cpp" is a front-end
+ * over this interface.
+ *
+ * Library object:   g++ -std=c++17 -O2 -pthread -c text_analysis_library.cpp
+ * Console program:  g++ -std=c++17 -O2 -pthread "WRITING HELPER AND ANALYSER BY ARTLEST.cpp" text_analysis_library.cpp
+ */
+
+#ifndef TEXT_ANALYSIS_LIBRARY_H
+#define TEXT_ANALYSIS_LIBRARY_H
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <string_view>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <list>
+#include <unordered_map>
+
+// Document files are memory-mapped where POSIX mmap is available
+#if defined(__unix__) || defined(__APPLE__)
+#define TEXT_ANALYSER_POSIX_MMAP 1
+#else
+#define TEXT_ANALYSER_POSIX_MMAP 0
+#endif
+
+// Pipeline stage instrumentation for --stats; build with -DTEXT_ANALYSER_INSTRUMENTATION=0 to compile it out
+#ifndef TEXT_ANALYSER_INSTRUMENTATION
+#define TEXT_ANALYSER_INSTRUMENTATION 1
+#endif
+
+/*
+ * Tokenizer implementations selectable at runtime
+ * All kernels produce identical token streams; they differ only in speed
+ */
+enum class TokenizerKernel {
+    Scalar,
+    SSE2,
+    AVX2,
+    AVX512
+};
+
+/*
+ * Report formats; everything except Text is meant for other programs
+ */
+enum class ReportOutputFormat {
+    Text,
+    JSON,
+    NDJSON,
+    CSV
+};
+
+/*
+ * Compact location of one normalized word inside the tokenizer buffer
+ * Offsets are 32-bit so the span array stays small on very large passages
+ */
+struct WordTokenSpan {
+    uint32_t normalized_offset;
+    uint32_t word_length;
+};
+
+/*
+ * Zero-copy view over the words extracted from a passage
+ * All normalized characters live in one contiguous buffer and each word is
+ * exposed as a string_view into it, so tokenization never allocates per word
+ */
+class TokenizedPassage {
+public:
+    class const_iterator {
+    public:
+        const_iterator(const char* character_base, const WordTokenSpan* span_position)
+            : character_base(character_base), span_position(span_position) {}
+
+        std::string_view operator*() const {
+            return std::string_view(character_base + span_position->normalized_offset, span_position->word_length);
+        }
+        const_iterator& operator++() {
+            ++span_position;
+            return *this;
+        }
+        bool operator!=(const const_iterator& other) const { return span_position != other.span_position; }
+        bool operator==(const const_iterator& other) const { return span_position == other.span_position; }
+
+    private:
+        const char* character_base;
+        const WordTokenSpan* span_position;
+    };
+
+    size_t size() const { return word_spans.size(); }
+    bool empty() const { return word_spans.empty(); }
+    size_t memory_footprint_bytes() const { return normalized_character_capacity + word_spans.capacity() * sizeof(WordTokenSpan); }
+
+    std::string_view operator[](size_t word_index) const {
+        const WordTokenSpan& span = word_spans[word_index];
+        return std::string_view(normalized_word_characters.get() + span.normalized_offset, span.word_length);
+    }
+
+    const_iterator begin() const { return const_iterator(normalized_word_characters.get(), word_spans.data()); }
+    const_iterator end() const { return const_iterator(normalized_word_characters.get(), word_spans.data() + word_spans.size()); }
+
+private:
+    std::unique_ptr<char[]> normalized_word_characters;
+    size_t normalized_character_capacity = 0;
+    std::vector<WordTokenSpan> word_spans;
+
+    friend TokenizedPassage extract_words_with_kernel(std::string_view text_passage, TokenizerKernel tokenizer_kernel);
+};
+
+/*
+ * Bump allocator for interned word characters
+ * Words are copied into large blocks and never freed individually, so
+ * each distinct word costs its letters plus no allocator overhead
+ */
+class VocabularyArena {
+public:
+    static constexpr size_t ARENA_BLOCK_BYTES = 64 * 1024;
+
+    const char* store_characters(std::string_view word_characters);
+    size_t reserved_bytes() const { return arena_blocks.size() * ARENA_BLOCK_BYTES + oversized_word_bytes; }
+
+private:
+    std::vector<std::unique_ptr<char[]>> arena_blocks;
+    std::vector<std::unique_ptr<char[]>> oversized_words;
+    char* current_block = nullptr;
+    size_t block_used_bytes = ARENA_BLOCK_BYTES;
+    size_t oversized_word_bytes = 0;
+};
+
+/*
+ * Interning table that maps each distinct normalized word to a 32-bit ID
+ * IDs are dense and assigned in order of first occurrence; lookups use an
+ * open-addressing table of IDs with the word hash kept per ID
+ */
+class InternedVocabulary {
+public:
+    static constexpr uint32_t EMPTY_SLOT = UINT32_MAX;
+
+    uint32_t intern(std::string_view normalized_word);
+    std::string_view word(uint32_t word_id) const { return words_by_id[word_id]; }
+    // Length in characters; differs from word(word_id).size() for non-ASCII words
+    size_t character_count(uint32_t word_id) const { return character_counts_by_id[word_id]; }
+    size_t size() const { return words_by_id.size(); }
+    size_t memory_footprint_bytes() const;
+
+private:
+    void grow_slot_table();
+
+    VocabularyArena character_arena;
+    std::vector<std::string_view> words_by_id;
+    std::vector<uint32_t> character_counts_by_id;
+    std::vector<uint64_t> hashes_by_id;
+    std::vector<uint32_t> slot_ids;
+};
+
+/*
+ * Passage represented as interned word IDs in passage order
+ * On natural text the ID array is a fraction of the size of the spans and
+ * normalized characters, and per-word frequency counts become a simple
+ * indexed increment
+ */
+struct InternedTokenStream {
+    InternedVocabulary vocabulary;
+    std::vector<uint32_t> word_ids;
+
+    size_t size() const { return word_ids.size(); }
+    size_t word_length(size_t token_index) const { return vocabulary.character_count(word_ids[token_index]); }
+    std::vector<uint64_t> word_frequencies() const;
+    size_t memory_footprint_bytes() const { return vocabulary.memory_footprint_bytes() + word_ids.capacity() * sizeof(uint32_t); }
+};
+
+/*
+ * Vocabulary class of a word, as decided by classify_vocabulary_word
+ */
+enum class VocabularyWordClass : uint8_t {
+    Basic,
+    Intermediate,
+    Advanced
+};
+
+/*
+ * Flat open-addressing table counting the occurrences of each normalized word
+ * Every slot has one control byte holding seven bits of the word hash, and
+ * a probe compares a whole group of sixteen control bytes at once, so a
+ * lookup usually reads one group and one matching entry. Entries live in
+ * their slots; entries() includes the empty ones, whose count is zero. A
+ * count lowered to zero leaves its entry in place but out of
+ * distinct_word_count() and every frequency summary
+ */
+class WordFrequencyTable {
+public:
+    static constexpr size_t PROBE_GROUP_SLOTS = 16;
+    static constexpr uint8_t EMPTY_CONTROL_BYTE = 0x80;
+
+    struct WordEntry {
+        std::string_view word;
+        uint64_t word_hash;
+        uint64_t occurrence_count;
+        size_t character_count;
+        uint32_t syllable_count;         // Estimated once, when the word is first stored
+        VocabularyWordClass word_class;  // Likewise classified once
+    };
+
+    const WordEntry& record_word(std::string_view normalized_word, size_t character_count, uint64_t occurrence_count = 1);
+    void remove_word(std::string_view normalized_word, size_t character_count);
+    void merge_following_table(const WordFrequencyTable& following_table);
+    uint64_t distinct_word_count() const { return present_word_count; }
+    const std::vector<WordEntry>& entries() const { return slot_entries; }
+
+private:
+    WordEntry& find_or_insert_entry(std::string_view normalized_word, uint64_t word_hash, size_t character_count);
+    size_t claim_empty_slot(uint64_t word_hash);
+    void grow_slot_table();
+
+    VocabularyArena character_arena;
+    std::vector<uint8_t> control_bytes;
+    std::vector<WordEntry> slot_entries;
+    size_t occupied_slot_count = 0;
+    uint64_t present_word_count = 0;
+};
+
+/*
+ * Space-Saving summary of the most frequent words in an unbounded stream
+ * Exactly COUNTER_CAPACITY words are tracked. An untracked word takes over
+ * the smallest counter and inherits its count as overestimate, so every
+ * estimated count exceeds the true count by at most
+ * recorded_word_count() / COUNTER_CAPACITY, and every word occurring more
+ * often than that is guaranteed to be tracked. Counters are kept ranked
+ * by count, so the smallest is always last and an increment only swaps a
+ * counter to the front of its run of equal counts; words are found through
+ * an open-addressing index
+ */
+class HeavyHitterSketch {
+public:
+    static constexpr size_t COUNTER_CAPACITY = 1024;
+    static constexpr size_t INDEX_SLOTS = 4 * COUNTER_CAPACITY;
+    static constexpr uint32_t EMPTY_INDEX_SLOT = UINT32_MAX;
+
+    struct WordCounter {
+        std::string word;
+        uint64_t word_hash = 0;
+        size_t character_count = 0;
+        uint64_t estimated_count = 0;
+        uint64_t overestimate = 0;
+    };
+
+    HeavyHitterSketch();
+
+    void record_word(std::string_view normalized_word, uint64_t word_hash, size_t character_count);
+    uint64_t recorded_word_count() const { return total_recorded_words; }
+    const std::vector<WordCounter>& counters() const { return word_counters; }
+
+private:
+    size_t find_index_slot(std::string_view normalized_word, uint64_t word_hash) const;
+    void remove_index_slot(size_t slot_index);
+    void increment_counter(uint32_t counter_index);
+
+    std::vector<WordCounter> word_counters;
+    std::vector<uint64_t> ranked_counts;     // Estimated counts, largest first
+    std::vector<uint32_t> ranked_counters;   // Counter index at each rank
+    std::vector<uint32_t> counter_ranks;     // Rank of each counter
+    std::vector<uint32_t> index_slots;       // Counter index per slot, probed linearly
+    uint64_t total_recorded_words = 0;
+};
+
+/*
+ * HyperLogLog estimate of the number of distinct words in a stream
+ * 2^PRECISION_BITS one-byte registers (16 KB) give a relative standard
+ * error of 1.04 / sqrt(16384), about 0.8%, at every cardinality; small
+ * counts are nearly exact
+ */
+class DistinctCountSketch {
+public:
+    static constexpr unsigned PRECISION_BITS = 14;
+
+    DistinctCountSketch() : registers(size_t(1) << PRECISION_BITS, 0) {}
+
+    void record_hash(uint64_t word_hash);
+    uint64_t estimate() const;
+
+private:
+    std::vector<uint8_t> registers;
+};
+
+/*
+ * Fixed-memory stand-in for WordFrequencyTable on unbounded input
+ * Counts distinct words with a DistinctCountSketch and the most frequent
+ * basic and advanced words with one HeavyHitterSketch per class, hashing
+ * each word once for all three
+ */
+class StreamingVocabularySketch {
+public:
+    void record_word(std::string_view normalized_word, size_t character_count, VocabularyWordClass word_class);
+    uint64_t estimated_distinct_words() const { return distinct_words.estimate(); }
+    const HeavyHitterSketch& basic_words() const { return basic_word_counters; }
+    const HeavyHitterSketch& advanced_words() const { return advanced_word_counters; }
+
+private:
+    DistinctCountSketch distinct_words;
+    HeavyHitterSketch basic_word_counters;
+    HeavyHitterSketch advanced_word_counters;
+};
+
+/*
+ * One of the most frequent words of a passage and its occurrence count
+ */
+struct FrequentWord {
+    std::string word;
+    uint64_t occurrence_count = 0;
+
+    bool operator==(const FrequentWord& other) const {
+        return occurrence_count == other.occurrence_count && word == other.word;
+    }
+};
+
+/*
+ * Read-only memory mapping of a text document on disk
+ * The mapped bytes are analyzed in place through contents(), so even very
+ * large documents are never copied into an intermediate string
+ */
+class MappedTextFile {
+public:
+    // Files at least this large may be backed by transparent huge pages
+    static constexpr size_t HUGE_PAGE_THRESHOLD_BYTES = 64 * 1024 * 1024;
+
+    MappedTextFile() = default;
+    ~MappedTextFile() { release_mapping(); }
+    MappedTextFile(const MappedTextFile&) = delete;
+    MappedTextFile& operator=(const MappedTextFile&) = delete;
+
+    bool open_document(const std::string& document_path, bool request_huge_pages);
+    std::string_view contents() const { return std::string_view(mapped_bytes, mapped_length); }
+    const std::string& last_error() const { return error_description; }
+
+private:
+    void release_mapping();
+
+    const char* mapped_bytes = nullptr;
+    size_t mapped_length = 0;
+    std::string error_description;
+#if !TEXT_ANALYSER_POSIX_MMAP
+    std::vector<char> fallback_buffer;
+#endif
+};
+
+/*
+ * Synonym dictionary used in place from a prebuilt binary file
+ * The file is memory-mapped and only its header is checked, so opening a
+ * dictionary of any size costs one mmap. Headwords are found through the
+ * minimal perfect hash stored in the file: one hash, two table loads and
+ * one compare per lookup. build_thesaurus_file() writes the format
+ */
+class SynonymThesaurus {
+public:
+    static constexpr uint32_t FILE_FORMAT_VERSION = 1;
+
+    bool open_thesaurus(const std::string& thesaurus_path);
+    bool is_open() const { return headword_total != 0; }
+    uint32_t headword_count() const { return headword_total; }
+    const std::string& last_error() const { return error_description; }
+
+    // Views of up to synonym_capacity synonyms of a normalized word, valid while
+    // the thesaurus stays open; returns how many were stored
+    size_t lookup_synonyms(std::string_view normalized_word, std::string_view* synonym_views, size_t synonym_capacity) const;
+
+private:
+    MappedTextFile thesaurus_file;
+    std::string error_description;
+    const unsigned char* bucket_displacements = nullptr;
+    const unsigned char* entry_offsets = nullptr;
+    const unsigned char* entry_records = nullptr;
+    uint64_t entry_record_bytes = 0;
+    uint32_t headword_total = 0;
+    uint32_t bucket_count = 0;
+};
+
+/*
+ * Kinds of phrase the style linter flags
+ */
+enum class StyleIssueCategory {
+    Wordy,
+    Cliche,
+    Filler,
+    Hedging
+};
+const size_t STYLE_ISSUE_CATEGORY_COUNT = 4;
+
+/*
+ * One phrase the style linter looks for
+ * The suggestion is the replacement offered, empty when the phrase
+ * should simply be cut or reworded
+ */
+struct StyleRule {
+    StyleIssueCategory category = StyleIssueCategory::Wordy;
+    std::string phrase;
+    std::string suggestion;
+};
+
+/*
+ * A style rule that matched a passage, with its number of matches
+ */
+struct StyleFinding {
+    StyleRule style_rule;
+    uint64_t match_count = 0;
+};
+
+/*
+ * One match: the finding it belongs to and the bytes of the phrase
+ */
+struct StyleMatch {
+    uint32_t finding_index = 0;
+    uint64_t start_offset = 0;
+    uint64_t byte_length = 0;
+};
+
+/*
+ * Everything the style linter found in a passage
+ * Counts are exact; only the first MATCH_RECORD_LIMIT matches keep their
+ * offsets, so a huge document cannot grow the report without bound
+ */
+struct StyleLintReport {
+    static constexpr size_t MATCH_RECORD_LIMIT = 4096;
+
+    std::vector<StyleFinding> findings;    // Most frequent first
+    std::vector<StyleMatch> matches;       // In the order the matches end
+    uint64_t checked_rule_count = 0;  // Zero when the passage was not linted
+    uint64_t rule_set_fingerprint = 0;  // Identifies the rules applied, so cached reports can be checked
+    uint64_t total_match_count = 0;
+    uint64_t category_match_counts[STYLE_ISSUE_CATEGORY_COUNT] = {};
+};
+
+/*
+ * Multi-phrase style linter over an Aho-Corasick automaton
+ * Phrases match whole words, ignoring ASCII case and collapsing runs of
+ * whitespace, so "In order\n to" matches "in order to". The automaton is
+ * flattened into one table with a row of SYMBOL_COUNT transitions per
+ * state, failure links already folded in, so linting reads one table
+ * entry per byte in a single pass. Rules come from the built-in list and
+ * from rule files; lint_passage() may run on many threads at once
+ */
+class StyleLinter {
+public:
+    static constexpr size_t SYMBOL_COUNT = 32;
+    static constexpr size_t PHRASE_SYMBOL_LIMIT = 62;
+
+    explicit StyleLinter(bool include_builtin_rules = true);
+
+    bool load_rule_file(const std::string& rule_path, std::string& error_description);
+    bool add_rule(const StyleRule& style_rule, std::string& error_description);
+    size_t rule_count() const { return style_rules.size(); }
+    uint64_t rule_set_fingerprint() const { return rule_fingerprint; }
+    StyleLintReport lint_passage(std::string_view text_passage) const;
+
+private:
+    friend class StyleLintScan;
+
+    bool insert_rule(const StyleRule& style_rule, std::string& error_description);
+    void build_automaton();
+
+    std::vector<StyleRule> style_rules;
+    uint64_t rule_fingerprint = 0;          // Hash of every rule's category, phrase and suggestion
+    std::vector<std::string> rule_phrase_symbols;     // Each phrase as automaton symbols
+    std::unordered_map<std::string, uint32_t> rule_index_by_phrase;
+    std::vector<uint32_t> state_transitions;     // SYMBOL_COUNT per state, flagged when the target reports a match
+    std::vector<uint32_t> state_rule_indices;    // Rule whose phrase ends in each state, if any
+    std::vector<uint32_t> state_output_links;    // Next state on the failure chain that ends a phrase
+};
+
+/*
+ * Style lint of a passage that arrives in pieces, as the streaming
+ * analyzer reads it; lint_passage() is one piece and finish()
+ * Phrases may span pieces and match offsets count from the first byte of
+ * the first piece. The linter must outlive the scan
+ */
+class StyleLintScan {
+public:
+    explicit StyleLintScan(const StyleLinter& style_linter);
+
+    void scan_text_piece(std::string_view text_piece);
+    StyleLintReport finish();
+
+private:
+    static constexpr size_t SYMBOL_RING_SIZE = 64;  // Holds the longest phrase and both boundaries
+
+    const StyleLinter& style_linter;
+    std::vector<uint64_t> rule_match_counts;
+    std::vector<StyleMatch> rule_matches;
+    uint64_t match_offset_ring[SYMBOL_RING_SIZE];
+    uint8_t match_symbol_ring[SYMBOL_RING_SIZE];
+    uint64_t symbol_index = 0;
+    uint64_t scanned_byte_count = 0;
+    uint32_t automaton_state = 0;
+    uint8_t previous_symbol = 0;
+};
+
+/*
+ * Distribution of sentence lengths, counted in words or in characters
+ * Lengths below EXACT_LENGTH_LIMIT get a bucket each; longer ones share
+ * BUCKETS_PER_OCTAVE buckets per power of two, so their percentiles are
+ * within about 3%. Buckets exist only up to the longest length recorded,
+ * which keeps the partials of short chunks small
+ */
+struct SentenceLengthDistribution {
+    static constexpr uint64_t EXACT_LENGTH_LIMIT = 64;
+    static constexpr unsigned BUCKETS_PER_OCTAVE = 16;
+
+    uint64_t sentence_count = 0;
+    uint64_t length_sum = 0;
+    uint64_t squared_length_sum = 0;
+    uint64_t longest_length = 0;
+    std::vector<uint64_t> bucket_counts;
+
+    void record_length(uint64_t sentence_length);
+    void merge(const SentenceLengthDistribution& other_distribution);
+    double mean() const { return static_cast<double>(length_sum) / sentence_count; }
+    double standard_deviation() const;
+    uint64_t percentile(double percentile_rank) const;
+
+    bool operator==(const SentenceLengthDistribution& other) const {
+        return sentence_count == other.sentence_count && length_sum == other.length_sum &&
+               squared_length_sum == other.squared_length_sum && longest_length == other.longest_length &&
+               bucket_counts == other.bucket_counts;
+    }
+};
+
+/*
+ * One sentence found by segment_sentences
+ * The span runs from the first non-whitespace byte of the sentence to the
+ * end of its closing punctuation; words and characters are counted as in
+ * PassageAnalysisAccumulator
+ */
+struct SentenceSpan {
+    uint64_t start_offset = 0;
+    uint64_t byte_length = 0;
+    uint64_t word_count = 0;
+    uint64_t character_count = 0;
+};
+
+/*
+ * Sentence boundary detector compiled to a byte-level state machine
+ * A sentence ends at the first ASCII whitespace byte after a run of '.',
+ * '!', '?' or U+2026, optionally followed by closing quotes or brackets.
+ * A lone period ends nothing after a listed abbreviation, an initial or a
+ * dotted initialism such as "e.g.", and terminals inside a token, as in
+ * "3.14", end nothing either. Text is fed in blocks of at most 64 bytes;
+ * while no terminal run is open only the bytes flagged in candidate_mask
+ * are examined, so a block without terminals costs one test. The last
+ * bytes of every block are kept for the abbreviation lookback, so the
+ * text may be split into blocks anywhere
+ */
+class SentenceBoundaryScanner {
+public:
+    SentenceBoundaryScanner() { memset(preceding_bytes, ' ', sizeof(preceding_bytes)); }
+
+    // Returns the whitespace bytes of the block that end a sentence, bit i for byte i
+    uint64_t scan_block(const unsigned char* block_bytes, size_t block_length, uint64_t candidate_mask);
+    // Ends the text; returns whether its end also ends a sentence
+    bool finish();
+
+private:
+    bool ends_abbreviation(const unsigned char* block_bytes, size_t period_position) const;
+
+    uint8_t scanner_state = 0;
+    unsigned char preceding_bytes[16];  // The bytes just before the next block
+};
+
+/*
+ * Every metric reported for a passage, gathered by one accumulator
+ * The fused engine fills all fields in a single pass over the bytes; the
+ * individual stage functions fill the subset they are responsible for
+ */
+struct PassageAnalysisAccumulator {
+    // Number of example words kept per vocabulary class for the suggestions
+    static constexpr size_t VOCABULARY_EXAMPLE_LIMIT = 5;
+    // Number of most frequent words reported per vocabulary class
+    static constexpr size_t FREQUENT_WORD_LIMIT = 10;
+
+    // Word statistics over the tokenized passage
+    uint64_t total_word_count = 0;
+    uint64_t total_character_count = 0;
+    int minimum_word_length = 999;
+    int maximum_word_length = 0;
+    uint64_t long_word_count = 0;            // Words over 7 letters, for the advanced ratio
+    uint64_t advanced_vocabulary_count = 0;  // Words classified advanced, see classify_vocabulary_word
+    uint64_t basic_vocabulary_count = 0;     // Words classified basic
+    double complexity_accumulator = 0.0;
+    uint64_t syllable_count = 0;             // Estimated, see estimate_syllable_count
+    uint64_t polysyllabic_word_count = 0;    // Words of three or more syllables
+
+    // Punctuation statistics over the raw passage
+    uint64_t passage_length = 0;
+    uint64_t sentence_count = 0;
+    uint64_t comma_count = 0;
+    uint64_t semicolon_count = 0;
+
+    // Lengths of the sentences found by SentenceBoundaryScanner; sentences without words are not counted
+    SentenceLengthDistribution sentence_word_lengths;
+    SentenceLengthDistribution sentence_character_lengths;
+
+    // Chunk partials only: the sentence before the chunk's first boundary and
+    // the totals at its last one; finish_sentences() counts both open sentences
+    bool sentence_boundary_seen = false;
+    uint64_t leading_sentence_words = 0;
+    uint64_t leading_sentence_characters = 0;
+    uint64_t sentence_start_word_count = 0;
+    uint64_t sentence_start_character_count = 0;
+
+    // First words of each vocabulary class, in passage order
+    std::vector<std::string> basic_vocabulary_examples;
+    std::vector<std::string> advanced_vocabulary_examples;
+
+    // Word frequency summary of the whole passage; most frequent first, ties alphabetical.
+    // When vocabulary_estimated, counts are the sketch's guaranteed lower bounds
+    uint64_t distinct_word_count = 0;
+    std::vector<FrequentWord> frequent_basic_words;
+    std::vector<FrequentWord> frequent_advanced_words;
+    bool vocabulary_estimated = false;  // Summary taken from a StreamingVocabularySketch
+
+    void record_word(std::string_view normalized_word);
+    void record_word_length(size_t word_length, VocabularyWordClass word_class);
+    void record_word_syllables(size_t word_syllable_count) {
+        syllable_count += word_syllable_count;
+        polysyllabic_word_count += word_syllable_count >= 3;
+    }
+    void record_vocabulary_example(std::string_view normalized_word, VocabularyWordClass word_class);
+    void record_sentence(uint64_t sentence_words, uint64_t sentence_characters);
+    void close_sentence();
+    void finish_sentences();
+    void merge_following_chunk(const PassageAnalysisAccumulator& following_chunk);
+    void summarize_word_frequencies(const WordFrequencyTable& word_frequencies);
+    void summarize_vocabulary_sketch(const StreamingVocabularySketch& vocabulary_sketch);
+    bool needs_vocabulary_examples() const {
+        return basic_vocabulary_examples.size() < VOCABULARY_EXAMPLE_LIMIT ||
+               advanced_vocabulary_examples.size() < VOCABULARY_EXAMPLE_LIMIT;
+    }
+
+    double average_word_length() const { return static_cast<double>(total_character_count) / total_word_count; }
+    double advanced_vocabulary_percentage() const { return (static_cast<double>(long_word_count) / total_word_count) * 100.0; }
+    double average_sentence_length() const { return static_cast<double>(passage_length) / std::max<uint64_t>(sentence_count, 1); }
+    double complexity_score() const { return std::min((complexity_accumulator / total_word_count) / 8.0, 10.0); }
+    double type_token_ratio() const { return static_cast<double>(distinct_word_count) / total_word_count; }
+
+    // Standard readability formulas; sentence counts are clamped to one as for average_sentence_length
+    double words_per_sentence() const { return static_cast<double>(total_word_count) / std::max<uint64_t>(sentence_count, 1); }
+    double syllables_per_word() const { return static_cast<double>(syllable_count) / total_word_count; }
+    double flesch_reading_ease() const { return 206.835 - 1.015 * words_per_sentence() - 84.6 * syllables_per_word(); }
+    double flesch_kincaid_grade() const { return 0.39 * words_per_sentence() + 11.8 * syllables_per_word() - 15.59; }
+    double gunning_fog_index() const {
+        return 0.4 * (words_per_sentence() + 100.0 * static_cast<double>(polysyllabic_word_count) / total_word_count);
+    }
+    double smog_index() const {
+        double polysyllables_per_thirty_sentences =
+            static_cast<double>(polysyllabic_word_count) * 30.0 / std::max<uint64_t>(sentence_count, 1);
+        return 1.0430 * std::sqrt(polysyllables_per_thirty_sentences) + 3.1291;
+    }
+    double coleman_liau_index() const {
+        double letters_per_hundred_words = 100.0 * static_cast<double>(total_character_count) / total_word_count;
+        double sentences_per_hundred_words = 100.0 * static_cast<double>(sentence_count) / total_word_count;
+        return 0.0588 * letters_per_hundred_words - 0.296 * sentences_per_hundred_words - 15.8;
+    }
+};
+
+/*
+ * Passage metrics for input that arrives in pieces and is never held whole
+ * Pieces may split words and UTF-8 sequences anywhere. Every count matches
+ * the single-pass engine exactly; the distinct and most frequent words
+ * come from a StreamingVocabularySketch, so memory stays fixed however
+ * long the stream runs. finish() is called once, after the last piece
+ */
+class StreamingPassageAnalyzer {
+public:
+    StreamingPassageAnalyzer();
+    ~StreamingPassageAnalyzer();
+    StreamingPassageAnalyzer(const StreamingPassageAnalyzer&) = delete;
+    StreamingPassageAnalyzer& operator=(const StreamingPassageAnalyzer&) = delete;
+
+    void append_text(std::string_view text_piece);
+    PassageAnalysisAccumulator finish();
+
+private:
+    struct StreamingSinkState;
+
+    void scan_text_piece(std::string_view text_piece);
+
+    PassageAnalysisAccumulator passage_metrics;
+    StreamingVocabularySketch vocabulary_sketch;
+    std::unique_ptr<StreamingSinkState> sink_state;
+    unsigned char carried_bytes[8] = {};  // Unfinished UTF-8 sequence held back from the last piece
+    size_t carried_byte_count = 0;
+    uint64_t streamed_byte_count = 0;
+};
+
+/*
+ * Editable document text stored as a piece table
+ * The original text is never modified; inserted text is appended to an
+ * add buffer and the document is the ordered list of pieces over both
+ */
+class PieceTableDocument {
+public:
+    explicit PieceTableDocument(std::string original_text = "");
+
+    void insert_text(size_t insertion_offset, std::string_view inserted_text);
+    void erase_text(size_t erase_offset, size_t erase_length);
+    std::string extract_text(size_t range_offset, size_t range_length) const;
+    std::string text() const { return extract_text(0, document_length); }
+    size_t size() const { return document_length; }
+    size_t piece_count() const { return document_pieces.size(); }
+
+private:
+    struct DocumentPiece {
+        bool from_add_buffer;
+        size_t buffer_offset;
+        size_t piece_length;
+    };
+
+    size_t split_piece_at(size_t document_offset);
+    const char* piece_characters(const DocumentPiece& document_piece) const {
+        return (document_piece.from_add_buffer ? add_buffer : original_buffer).data() + document_piece.buffer_offset;
+    }
+
+    std::string original_buffer;
+    std::string add_buffer;
+    std::vector<DocumentPiece> document_pieces;
+    size_t document_length = 0;
+};
+
+/*
+ * Passage metrics kept up to date across edits
+ * The document is cut into sentence segments, each holding its own partial
+ * metrics. Segments live in an implicit treap ordered by position whose
+ * nodes also hold the merged metrics of their subtree, so an edit
+ * re-analyzes only the segments around it and refreshes O(log n) merges.
+ * The complexity sum is merged by tree shape rather than word order, so it
+ * can differ from the batch engines in the last bits. Word frequencies
+ * live in one document-wide table: an edit removes the words of the old
+ * region and adds those of the new one, and the frequency summary is
+ * rebuilt only when passage_metrics() is next called
+ */
+class IncrementalPassageAnalyzer {
+public:
+    explicit IncrementalPassageAnalyzer(std::string initial_text = "");
+    ~IncrementalPassageAnalyzer();
+    IncrementalPassageAnalyzer(const IncrementalPassageAnalyzer&) = delete;
+    IncrementalPassageAnalyzer& operator=(const IncrementalPassageAnalyzer&) = delete;
+
+    void insert_text(size_t insertion_offset, std::string_view inserted_text) { replace_text(insertion_offset, 0, inserted_text); }
+    void erase_text(size_t erase_offset, size_t erase_length) { replace_text(erase_offset, erase_length, ""); }
+    void replace_text(size_t edit_offset, size_t erased_length, std::string_view inserted_text);
+
+    const PassageAnalysisAccumulator& passage_metrics() const;
+    std::string text() const { return document.text(); }
+    size_t size() const { return document.size(); }
+    size_t segment_count() const;
+    uint64_t last_reanalyzed_bytes() const { return last_reanalyzed_byte_count; }
+
+private:
+    struct SegmentNode;
+
+    static void refresh_segment_node(SegmentNode& segment_node);
+    static std::unique_ptr<SegmentNode> merge_segment_trees(std::unique_ptr<SegmentNode> leading_tree,
+                                                            std::unique_ptr<SegmentNode> following_tree);
+    static void split_segment_tree(std::unique_ptr<SegmentNode> segment_tree, size_t leading_segment_count,
+                                   std::unique_ptr<SegmentNode>& leading_tree, std::unique_ptr<SegmentNode>& following_tree);
+    std::unique_ptr<SegmentNode> build_segment_tree(std::string_view region_text);
+    size_t locate_segment(size_t document_offset, size_t& segment_start, size_t& segment_length) const;
+
+    PieceTableDocument document;
+    std::unique_ptr<SegmentNode> segment_tree;
+    WordFrequencyTable document_word_frequencies;
+    mutable PassageAnalysisAccumulator summarized_document_metrics;
+    mutable bool document_summary_current = false;
+    uint64_t last_reanalyzed_byte_count = 0;
+    uint32_t priority_state = 0x9e3779b9u;
+};
+
+/*
+ * Thread pool with one task deque per worker and work stealing
+ * Workers take their newest local task first and steal the oldest task
+ * of another worker when their own deque runs dry, so a worker that
+ * splits a huge document into chunk tasks shares them with idle peers
+ */
+class WorkStealingThreadPool {
+public:
+    explicit WorkStealingThreadPool(unsigned worker_count);
+    ~WorkStealingThreadPool();
+    WorkStealingThreadPool(const WorkStealingThreadPool&) = delete;
+    WorkStealingThreadPool& operator=(const WorkStealingThreadPool&) = delete;
+
+    // Tasks submitted from a worker go to its own deque, others round-robin
+    void submit(std::function<void()> task);
+    void wait_until_idle();
+    unsigned worker_count() const { return static_cast<unsigned>(worker_threads.size()); }
+
+private:
+    struct WorkerQueue {
+        std::mutex queue_mutex;
+        std::deque<std::function<void()>> queued_tasks;
+    };
+
+    void worker_loop(unsigned worker_index);
+    bool try_acquire_task(unsigned worker_index, std::function<void()>& acquired_task);
+
+    std::vector<std::unique_ptr<WorkerQueue>> worker_queues;
+    std::vector<std::thread> worker_threads;
+    std::atomic<size_t> queued_task_count{0};
+    std::atomic<size_t> unfinished_task_count{0};
+    std::atomic<unsigned> next_submission_queue{0};
+    std::mutex idle_mutex;
+    std::condition_variable work_available;
+    std::condition_variable all_tasks_finished;
+    bool shutting_down = false;
+
+    static thread_local WorkStealingThreadPool* current_pool;
+    static thread_local unsigned current_worker_index;
+};
+
+/*
+ * Draws one progress update; final_update is set on the last call of a run
+ */
+using ProgressRenderFunction = void (*)(uint64_t processed_bytes, uint64_t total_bytes, uint64_t completed_work_units,
+                                        uint64_t total_work_units, const char* work_unit_label, double elapsed_seconds,
+                                        bool final_update);
+
+/*
+ * Live progress report for long-running analysis work
+ * Worker threads add processed bytes and completed work units (chunks or
+ * documents) through atomics; the render function is called at most every
+ * RENDER_INTERVAL, and a null render function disables reporting entirely
+ */
+class ProgressReporter {
+public:
+    static constexpr std::chrono::milliseconds RENDER_INTERVAL{100};
+
+    ProgressReporter(uint64_t total_bytes, uint64_t total_work_units, const char* work_unit_label,
+                     ProgressRenderFunction render_function);
+
+    void add_processed_bytes(uint64_t processed_byte_count);
+    void complete_work_unit();
+    void finish();
+
+private:
+    void render_if_due(bool force_render);
+
+    ProgressRenderFunction render_function;
+    uint64_t total_bytes;
+    uint64_t total_work_units;
+    const char* work_unit_label;
+    std::chrono::steady_clock::time_point start_time;
+    std::atomic<uint64_t> processed_bytes{0};
+    std::atomic<uint64_t> completed_work_units{0};
+    std::atomic<int64_t> next_render_nanoseconds{0};
+    std::mutex render_mutex;
+};
+
+/*
+ * 128-bit hash identifying a passage by its exact bytes
+ */
+struct PassageContentHash {
+    uint64_t low_bits = 0;
+    uint64_t high_bits = 0;
+
+    bool operator==(const PassageContentHash& other) const {
+        return low_bits == other.low_bits && high_bits == other.high_bits;
+    }
+};
+
+struct PassageContentHashHasher {
+    size_t operator()(const PassageContentHash& content_hash) const { return static_cast<size_t>(content_hash.low_bits); }
+};
+
+/*
+ * Counters describing how well the result cache is working
+ */
+struct AnalysisCacheStatistics {
+    uint64_t memory_hits = 0;
+    uint64_t disk_hits = 0;
+    uint64_t misses = 0;
+    uint64_t stores = 0;
+    uint64_t evictions = 0;
+    uint64_t resident_entries = 0;
+    uint64_t disk_evictions = 0;
+    uint64_t disk_entries = 0;
+    uint64_t disk_bytes = 0;
+};
+
+/*
+ * Content-addressed cache of passage analysis results
+ * The memory tier is an LRU list bounded by maximum_entry_count entries;
+ * the optional disk tier keeps one small file per passage hash in
+ * disk_directory so results survive restarts. The disk tier is bounded by
+ * maximum_disk_bytes: files are indexed by modification time when the
+ * cache opens, a hit refreshes the time, and the least recently used files
+ * are deleted once a store exceeds the bound. Style reports are kept with
+ * the metrics, so a hit skips the lint pass too. Entries that fail to decode,
+ * such as those of an older DISK_FORMAT_VERSION, are deleted when looked
+ * up. All methods are thread safe
+ */
+class AnalysisResultCache {
+public:
+    // Raised whenever the encoded accumulator fields change
+    static constexpr uint32_t DISK_FORMAT_VERSION = 9;
+    static constexpr uint64_t DEFAULT_DISK_BYTE_LIMIT = 256ULL * 1024 * 1024;
+
+    explicit AnalysisResultCache(size_t maximum_entry_count, const std::string& disk_directory = "",
+                                 uint64_t maximum_disk_bytes = DEFAULT_DISK_BYTE_LIMIT);
+    AnalysisResultCache(const AnalysisResultCache&) = delete;
+    AnalysisResultCache& operator=(const AnalysisResultCache&) = delete;
+
+    // With a style linter, an entry counts only if it was linted under the same rules
+    bool lookup(const PassageContentHash& content_hash, PassageAnalysisAccumulator& cached_metrics,
+                const StyleLinter* style_linter = nullptr, StyleLintReport* cached_style_report = nullptr);
+    void store(const PassageContentHash& content_hash, const PassageAnalysisAccumulator& passage_metrics,
+               const StyleLintReport& style_report = StyleLintReport());
+    AnalysisCacheStatistics statistics() const;
+
+private:
+    struct CachedPassageAnalysis {
+        PassageAnalysisAccumulator passage_metrics;
+        StyleLintReport style_report;  // Unchecked when the passage was stored without a linter
+    };
+    using ResidentEntry = std::pair<PassageContentHash, CachedPassageAnalysis>;
+    using DiskEntry = std::pair<PassageContentHash, uint64_t>;  // File size in bytes
+
+    void insert_resident_entry(const PassageContentHash& content_hash, CachedPassageAnalysis cached_analysis);
+    std::string disk_entry_path(const PassageContentHash& content_hash) const;
+    void index_disk_directory();
+    bool load_disk_entry(const PassageContentHash& content_hash, CachedPassageAnalysis& cached_analysis);
+    void save_disk_entry(const PassageContentHash& content_hash, const CachedPassageAnalysis& cached_analysis);
+    void record_disk_entry(const PassageContentHash& content_hash, uint64_t entry_byte_count);
+    void forget_disk_entry(const PassageContentHash& content_hash);
+    void trim_disk_entries();
+
+    size_t maximum_entry_count;
+    std::string disk_directory;
+    uint64_t maximum_disk_bytes;
+    mutable std::mutex cache_mutex;
+    std::list<ResidentEntry> recency_list;  // Most recently used first
+    std::unordered_map<PassageContentHash, std::list<ResidentEntry>::iterator, PassageContentHashHasher> resident_entries;
+    std::list<DiskEntry> disk_recency_list;  // Most recently used first
+    std::unordered_map<PassageContentHash, std::list<DiskEntry>::iterator, PassageContentHashHasher> disk_entries;
+    uint64_t disk_entry_bytes = 0;
+    AnalysisCacheStatistics cache_statistics;
+};
+
+/*
+ * Outcome of analyzing one document of a batch corpus
+ */
+struct DocumentAnalysisResult {
+    // Marks a document whose bytes appeared nowhere earlier in the batch
+    static constexpr size_t NO_DUPLICATE_DOCUMENT = SIZE_MAX;
+
+    std::string document_path;
+    uint64_t document_bytes = 0;
+    bool analysis_succeeded = false;
+    std::string error_description;
+    PassageAnalysisAccumulator passage_metrics;
+    StyleLintReport style_report;  // Unchecked unless a style linter was given
+    PassageContentHash content_hash;
+    size_t duplicate_of_document = NO_DUPLICATE_DOCUMENT;
+    bool served_from_cache = false;
+};
+
+/*
+ * Recommendation texts chosen for a passage from its complexity and length
+ */
+struct PassageImprovementRecommendations {
+    const char* proficiency_assessment = "";
+    const char* primary_recommendation = "";
+    const char* specific_strategy = "";
+    std::string example_enhancement;  // Drawn from the thesaurus when one is given
+    const char* structural_recommendations[2] = {"", ""};
+    std::vector<std::string> style_recommendations;  // One per most frequent style finding
+};
+
+/*
+ * Thesaurus alternatives for one of a passage's most frequent basic words
+ * Only single-word synonyms longer than the word itself are offered
+ */
+struct VocabularySuggestion {
+    static constexpr size_t ALTERNATIVE_LIMIT = 3;
+
+    std::string word;
+    uint64_t occurrence_count = 0;
+    std::vector<std::string> alternatives;
+};
+
+/*
+ * Complete analysis of one passage, as handed to embedding programs
+ * The ratios follow the accumulator's definitions, so the length-based
+ * ones are NaN for a passage without words; contains_words tells them apart
+ */
+struct AnalysisResult {
+    PassageAnalysisAccumulator passage_metrics;
+    bool contains_words = false;
+    double average_word_length = 0.0;
+    double advanced_vocabulary_percentage = 0.0;
+    double average_sentence_length = 0.0;
+    double complexity_score = 0.0;
+    const char* complexity_band = "";  // Empty for a passage without words
+    double flesch_reading_ease = 0.0;
+    double flesch_kincaid_grade = 0.0;
+    double gunning_fog_index = 0.0;
+    double smog_index = 0.0;
+    double coleman_liau_index = 0.0;
+    PassageImprovementRecommendations improvement_recommendations;
+    std::vector<VocabularySuggestion> vocabulary_suggestions;  // Empty without a thesaurus
+    StyleLintReport style_report;                         // Empty without a style linter
+};
+
+#if TEXT_ANALYSER_INSTRUMENTATION
+/*
+ * Pipeline stages timed and counted under --stats
+ * Tokenization and scoring run as one fused pass, so they share a stage
+ */
+enum class PipelineStage {
+    Input,
+    Analysis,
+    Rendering,
+    Output
+};
+const size_t PIPELINE_STAGE_COUNT = 4;
+
+/*
+ * Totals for one pipeline stage across every thread of a run
+ */
+struct PipelineStageCounters {
+    std::atomic<uint64_t> invocation_count{0};
+    std::atomic<uint64_t> elapsed_nanoseconds{0};
+    std::atomic<uint64_t> processed_bytes{0};
+    std::atomic<uint64_t> processed_tokens{0};
+    std::atomic<uint64_t> allocation_count{0};
+    std::atomic<uint64_t> allocated_bytes{0};
+};
+
+/*
+ * Records one stage invocation from construction to destruction
+ * Allocations are those made on the constructing thread while the scope
+ * is alive. With instrumentation switched off at runtime the scope only
+ * tests one flag
+ */
+class PipelineStageScope {
+public:
+    explicit PipelineStageScope(PipelineStage pipeline_stage);
+    ~PipelineStageScope();
+    PipelineStageScope(const PipelineStageScope&) = delete;
+    PipelineStageScope& operator=(const PipelineStageScope&) = delete;
+
+    void add_processed_bytes(uint64_t byte_count) { processed_bytes += byte_count; }
+    void add_processed_tokens(uint64_t token_count) { processed_tokens += token_count; }
+
+private:
+    PipelineStage pipeline_stage;
+    bool recording;
+    std::chrono::steady_clock::time_point stage_start;
+    uint64_t processed_bytes = 0;
+    uint64_t processed_tokens = 0;
+    uint64_t allocation_count_at_start = 0;
+    uint64_t allocated_bytes_at_start = 0;
+};
+
+#define TEXT_ANALYSER_STAGE_SCOPE(scope_name, pipeline_stage) PipelineStageScope scope_name(pipeline_stage)
+#define TEXT_ANALYSER_STAGE_BYTES(scope_name, byte_count) scope_name.add_processed_bytes(byte_count)
+#define TEXT_ANALYSER_STAGE_TOKENS(scope_name, token_count) scope_name.add_processed_tokens(token_count)
+#else
+#define TEXT_ANALYSER_STAGE_SCOPE(scope_name, pipeline_stage)
+#define TEXT_ANALYSER_STAGE_BYTES(scope_name, byte_count)
+#define TEXT_ANALYSER_STAGE_TOKENS(scope_name, token_count)
+#endif
+
+/*
+ * Appends flat JSON or CSV records straight into a report buffer
+ * Numbers are converted with to_chars into stack storage, so a record
+ * allocates nothing once the buffer has grown to its working size. A CSV
+ * header is produced by serializing any record with emit_csv_header set,
+ * which keeps the columns in step with the fields
+ */
+class StructuredRecordSerializer {
+public:
+    StructuredRecordSerializer(std::string& output_buffer, ReportOutputFormat output_format, bool emit_csv_header = false);
+
+    void begin_record();
+    void end_record();
+    void field_unsigned(const char* field_name, uint64_t field_value, bool value_present = true);
+    void field_decimal(const char* field_name, double field_value, bool value_present = true);
+    void field_boolean(const char* field_name, bool field_value, bool value_present = true);
+    void field_text(const char* field_name, std::string_view field_value, bool value_present = true);
+    // Restrict output to the named fields; null selects every field
+    void select_fields(const std::vector<std::string>* selected_field_names) { this->selected_field_names = selected_field_names; }
+
+private:
+    bool field_selected(const char* field_name) const;
+    void begin_field(const char* field_name);
+    void append_missing_value();
+    void append_json_text(std::string_view field_value);
+    void append_csv_text(std::string_view field_value);
+
+    std::string& output_buffer;
+    ReportOutputFormat output_format;
+    bool emit_csv_header;
+    bool first_field = true;
+    const std::vector<std::string>* selected_field_names = nullptr;
+};
+
+// Heap allocation counters, advanced by a program that replaces operator new
+extern std::atomic<bool> allocation_counting_enabled;
+extern std::atomic<uint64_t> counted_allocation_count;
+extern std::atomic<uint64_t> counted_allocation_bytes;
+extern thread_local uint64_t thread_allocation_count;
+extern thread_local uint64_t thread_allocated_bytes;
+
+#if TEXT_ANALYSER_INSTRUMENTATION
+// Stage totals, recorded only once instrumentation is switched on
+extern std::atomic<bool> pipeline_instrumentation_enabled;
+extern PipelineStageCounters pipeline_stage_counters[PIPELINE_STAGE_COUNT];
+#endif
+
+// Function prototypes for the library interface
+TokenizedPassage extract_words_from_passage(std::string_view text_passage);
+TokenizedPassage extract_words_with_kernel(std::string_view text_passage, TokenizerKernel tokenizer_kernel);
+bool tokenizer_kernel_supported(TokenizerKernel tokenizer_kernel);
+TokenizerKernel active_tokenizer_kernel();
+const char* tokenizer_kernel_name(TokenizerKernel tokenizer_kernel);
+InternedTokenStream intern_words_from_passage(std::string_view text_passage);
+size_t estimate_syllable_count(std::string_view normalized_word);
+VocabularyWordClass classify_vocabulary_word(std::string_view normalized_word, size_t character_count);
+double calculate_readability_complexity_score(const InternedTokenStream& word_collection);
+PassageAnalysisAccumulator perform_comprehensive_text_analysis(const InternedTokenStream& word_collection,
+                                                               std::string_view original_passage);
+PassageAnalysisAccumulator analyze_sentence_structure(std::string_view text_passage);
+std::vector<SentenceSpan> segment_sentences(std::string_view text_passage);
+PassageAnalysisAccumulator suggest_vocabulary_enhancements(const InternedTokenStream& word_collection);
+PassageImprovementRecommendations generate_passage_improvement_recommendations(
+    uint64_t passage_length, double complexity_score, const std::vector<VocabularySuggestion>& vocabulary_suggestions = {},
+    const StyleLintReport& style_report = {});
+std::vector<VocabularySuggestion> suggest_word_alternatives(const std::vector<FrequentWord>& frequent_words,
+                                                            const SynonymThesaurus& synonym_thesaurus);
+bool build_thesaurus_file(const std::vector<std::string>& source_paths, const std::string& thesaurus_path,
+                          std::string& error_description);
+const char* style_issue_category_name(StyleIssueCategory style_issue_category);
+const char* complexity_band_name(double complexity_score);
+PassageAnalysisAccumulator analyze_passage_in_single_pass(std::string_view text_passage,
+                                                          ProgressReporter* progress_reporter = nullptr);
+PassageAnalysisAccumulator analyze_passage_in_parallel(std::string_view text_passage, unsigned analysis_thread_count,
+                                                       ProgressReporter* progress_reporter = nullptr);
+unsigned resolve_analysis_thread_count(unsigned analysis_thread_count);
+size_t parallel_chunk_count(size_t passage_length, unsigned analysis_thread_count);
+AnalysisResult build_analysis_result(PassageAnalysisAccumulator passage_metrics,
+                                    const SynonymThesaurus* synonym_thesaurus = nullptr,
+                                    StyleLintReport style_report = {});
+AnalysisResult analyze_text_passage(std::string_view text_passage, unsigned analysis_thread_count = 1,
+                                    AnalysisResultCache* result_cache = nullptr,
+                                    const SynonymThesaurus* synonym_thesaurus = nullptr,
+                                    const StyleLinter* style_linter = nullptr);
+PassageContentHash hash_passage_content(std::string_view text_passage);
+PassageAnalysisAccumulator analyze_passage_through_cache(std::string_view text_passage, AnalysisResultCache* result_cache,
+                                                         unsigned analysis_thread_count,
+                                                         const StyleLinter* style_linter = nullptr,
+                                                         StyleLintReport* style_report = nullptr);
+bool collect_corpus_document_paths(const std::string& corpus_source, std::vector<std::string>& document_paths,
+                                   std::string& error_description);
+std::vector<DocumentAnalysisResult> analyze_document_corpus(const std::vector<std::string>& document_paths,
+                                                            unsigned analysis_thread_count,
+                                                            AnalysisResultCache* result_cache = nullptr,
+                                                            ProgressRenderFunction progress_render_function = nullptr,
+                                                            const StyleLinter* style_linter = nullptr);
+DocumentAnalysisResult analyze_document_stream(const std::string& document_path, const StyleLinter* style_linter = nullptr);
+bool parse_report_output_format(std::string_view format_name, ReportOutputFormat& output_format);
+std::vector<std::string> structured_report_field_names();
+void render_structured_document_report(std::string& output_buffer, ReportOutputFormat output_format,
+                                       const std::vector<DocumentAnalysisResult>& document_results, double elapsed_seconds,
+                                       const std::vector<std::string>& selected_metrics = {},
+                                       bool include_pipeline_statistics = false);
+#if TEXT_ANALYSER_INSTRUMENTATION
+void enable_pipeline_instrumentation();
+const char* pipeline_stage_name(PipelineStage pipeline_stage);
+void serialize_pipeline_statistics(std::string& output_buffer);
+#endif
+
+#endif  // TEXT_ANALYSIS_LIBRARY_H